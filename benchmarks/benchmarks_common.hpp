@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+
+namespace Fge::Benchmarks
+{
+
+/**
+ * @return Wall time of one call of function in milliseconds
+ */
+template <typename TFunction> double measure_ms(TFunction function)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const auto start = Clock::now();
+  function();
+  const auto end = Clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace Fge::Benchmarks
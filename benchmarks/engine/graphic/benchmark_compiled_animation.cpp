@@ -0,0 +1,134 @@
+#include "graphic/compiled_animation.hpp"
+
+#include <iomanip>
+
+using namespace Fge;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+template <typename TFunction>
+double measure(int call_count, TFunction function)
+{
+  const auto start = Clock::now();
+  for (int i = 0; i < call_count; ++i)
+  {
+    function(i);
+  }
+  const auto end = Clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         call_count;
+}
+
+/**
+ * Clip with keys at random rotations. Like in most exported clips only the
+ * root moves and scales stay constant.
+ */
+Animation create_animation(unsigned tracks_count,
+                           unsigned keys_count,
+                           double   duration_in_seconds)
+{
+  std::mt19937                          random(42);
+  std::uniform_real_distribution<float> angle(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> offset(-0.1f, 0.1f);
+
+  std::vector<std::optional<Animation::BoneTransform>> tracks;
+  for (unsigned i = 0; i < tracks_count; ++i)
+  {
+    Animation::BoneTransform track{};
+    for (unsigned k = 0; k < keys_count; ++k)
+    {
+      const auto time = duration_in_seconds * k / (keys_count - 1);
+
+      track.bone_rotation.push_back(
+          {time,
+           glm::angleAxis(angle(random),
+                          glm::normalize(glm::vec3(
+                              angle(random), angle(random), angle(random))))});
+      track.bone_translation.push_back(
+          {time, i == 0 ? glm::vec3(offset(random), 0.0f, 0.0f) : UP_VEC});
+      track.bone_scaling.push_back({time, glm::vec3(1.0f)});
+    }
+    tracks.emplace_back(track);
+  }
+
+  return Animation("Clip", duration_in_seconds, 1.0, tracks);
+}
+
+std::size_t get_memory_size(const Animation &animation)
+{
+  auto size = animation.get_tracks().size() *
+              sizeof(std::optional<Animation::BoneTransform>);
+  for (const auto &track : animation.get_tracks())
+  {
+    if (track.has_value())
+    {
+      size += track->bone_rotation.size() * sizeof(Animation::BoneRotation) +
+              track->bone_translation.size() *
+                  sizeof(Animation::BoneTranslation) +
+              track->bone_scaling.size() * sizeof(Animation::BoneScaling);
+    }
+  }
+  return size;
+}
+
+void run(const std::string &name,
+         unsigned           tracks_count,
+         unsigned           keys_count,
+         double             duration_in_seconds)
+{
+  constexpr int sample_count = 100000;
+
+  const auto              animation = create_animation(
+      tracks_count, keys_count, duration_in_seconds);
+  const CompiledAnimation compiled(animation);
+
+  std::vector<glm::mat4> transforms(tracks_count);
+  float                  checksum = 0.0f;
+
+  // Advance by an uneven step, so samples fall between keys and frames
+  const auto time_at = [&](int i) {
+    return std::fmod(i * 0.0137, duration_in_seconds);
+  };
+
+  const auto animation_ns = measure(sample_count, [&](int i) {
+    const auto time = time_at(i);
+    for (unsigned j = 0; j < tracks_count; ++j)
+    {
+      transforms[j] = animation.get_track(j).value().interpolate(time);
+    }
+    checksum += transforms[tracks_count - 1][3][1];
+  });
+
+  const auto compiled_ns = measure(sample_count, [&](int i) {
+    compiled.sample(time_at(i), transforms.data());
+    checksum += transforms[tracks_count - 1][3][1];
+  });
+
+  std::cout << name << ": " << tracks_count << " tracks, " << keys_count
+            << " keys, " << compiled.get_frame_count() << " frames\n";
+  std::cout << "  memory:   animation " << get_memory_size(animation)
+            << " bytes, compiled " << compiled.get_memory_size()
+            << " bytes\n";
+  std::cout << "  sampling: animation " << animation_ns << " ns, compiled "
+            << compiled_ns << " ns\n";
+  std::cout << "  (" << checksum << ")\n";
+}
+
+} // namespace
+
+int main()
+{
+  std::cout << std::fixed << std::setprecision(2);
+
+  // Same shape as the clip in res/meshes/character.dae
+  run("character.dae", 16, 5, 0.8333);
+
+  // Baked clip with a key every frame
+  run("baked", 60, 121, 4.0);
+
+  return 0;
+}
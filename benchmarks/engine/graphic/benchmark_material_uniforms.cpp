@@ -0,0 +1,263 @@
+#include "graphic/uniform_block.hpp"
+
+#include <iomanip>
+
+using namespace Fge;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int uniform_count = 32;
+
+/**
+ * Does no GL calls. The name based setters hash the name like the location
+ * cache of the OpenGL shader did, so only CPU overhead gets measured.
+ */
+class NullShader : public Shader
+{
+public:
+  NullShader()
+  {
+    for (int i = 0; i < uniform_count; ++i)
+    {
+      locations["uniform_" + std::to_string(i)] = i;
+    }
+  }
+
+  uint32_t get_id() const override { return 0; }
+
+  void bind() const override {}
+
+  void unbind() const override {}
+
+  int32_t get_uniform_location(const std::string &name) const override
+  {
+    const auto iter = locations.find(name);
+    return iter == locations.end() ? -1 : iter->second;
+  }
+
+  void set_uniform(int32_t     location,
+                   UniformType type,
+                   const void *data,
+                   uint32_t    count) override
+  {
+    sink += location + static_cast<int>(type) + count +
+            *static_cast<const uint8_t *>(data);
+  }
+
+  void set_uniform(const std::string &name, bool value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, int32_t value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, const glm::mat4 &value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, float value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, const glm::vec2 &value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, const glm::ivec2 &value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, const glm::vec3 &value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, const glm::vec4 &value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, const glm::mat2 &value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &name, const glm::mat3 &value) override
+  {
+    set(name, &value);
+  }
+
+  void set_uniform(const std::string &           name,
+                   const std::vector<glm::mat4> &value) override
+  {
+    set(name, value.data());
+  }
+
+  uint64_t sink = 0;
+
+private:
+  std::unordered_map<std::string, int32_t> locations;
+
+  void set(const std::string &name, const void *data)
+  {
+    sink += get_uniform_location(name) + *static_cast<const uint8_t *>(data);
+  }
+};
+
+/**
+ * The uniform storage of Material before handles were introduced. Kept
+ * here as baseline.
+ */
+class LegacyUniformBase
+{
+public:
+  virtual ~LegacyUniformBase() = default;
+
+  virtual void set(Shader &shader) = 0;
+};
+
+template <typename T> class LegacyUniform : public LegacyUniformBase
+{
+public:
+  LegacyUniform(const std::string &name, const T &value)
+      : name(name),
+        value(value)
+  {
+  }
+
+  void update(const T &value) { this->value = value; }
+
+  void set(Shader &shader) override { shader.set_uniform(name, value); }
+
+  const std::string &get_name() const { return name; }
+
+private:
+  std::string name;
+  T           value;
+};
+
+class LegacyMaterial
+{
+public:
+  template <typename T>
+  void set_uniform(const std::string &name, const T &value)
+  {
+    for (auto uniform : uniforms)
+    {
+      auto casted_uniform = std::static_pointer_cast<LegacyUniform<T>>(uniform);
+      if (name == casted_uniform->get_name())
+      {
+        casted_uniform->update(value);
+        return;
+      }
+    }
+
+    uniforms.emplace_back(std::make_shared<LegacyUniform<T>>(name, value));
+  }
+
+  void bind(Shader &shader)
+  {
+    for (auto &uniform : uniforms)
+    {
+      uniform->set(shader);
+    }
+  }
+
+private:
+  std::vector<std::shared_ptr<LegacyUniformBase>> uniforms;
+};
+
+std::vector<std::string> create_names()
+{
+  std::vector<std::string> names;
+  for (int i = 0; i < uniform_count; ++i)
+  {
+    names.push_back("uniform_" + std::to_string(i));
+  }
+  return names;
+}
+
+/**
+ * Every frame each material gets all its uniforms set and is bound once.
+ *
+ * @return Average time per material and frame in nanoseconds
+ */
+template <typename TFunction>
+double measure(int material_count, int frame_count, TFunction frame)
+{
+  const auto start = Clock::now();
+  for (int i = 0; i < frame_count; ++i)
+  {
+    frame(static_cast<float>(i));
+  }
+  const auto end = Clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         (static_cast<double>(frame_count) * material_count);
+}
+
+} // namespace
+
+int main()
+{
+  constexpr int frame_count = 200;
+
+  const auto names  = create_names();
+  auto       shader = std::make_shared<NullShader>();
+
+  std::cout << uniform_count << " uniforms per material\n";
+  std::cout << "materials  string ns  handle ns\n";
+
+  for (int material_count = 100; material_count <= 10000; material_count *= 10)
+  {
+    std::vector<LegacyMaterial> legacy_materials(material_count);
+    std::vector<UniformBlock>   blocks(material_count);
+
+    // Handles are resolved once, so they are just 0 to uniform_count - 1
+    for (auto &block : blocks)
+    {
+      for (const auto &name : names)
+      {
+        block.get_handle<glm::vec4>(name);
+      }
+    }
+
+    const auto legacy_ns = measure(material_count, frame_count, [&](float t) {
+      for (auto &material : legacy_materials)
+      {
+        for (const auto &name : names)
+        {
+          material.set_uniform(name, glm::vec4(t));
+        }
+        material.bind(*shader);
+      }
+    });
+
+    const auto handle_ns = measure(material_count, frame_count, [&](float t) {
+      for (auto &block : blocks)
+      {
+        for (int i = 0; i < uniform_count; ++i)
+        {
+          block.set(static_cast<UniformHandle>(i), glm::vec4(t));
+        }
+        block.bind(shader);
+      }
+    });
+
+    std::cout << std::setw(9) << material_count << "  " << std::setw(9)
+              << std::fixed << std::setprecision(1) << legacy_ns << "  "
+              << std::setw(9) << handle_ns << "\n";
+  }
+
+  return shader->sink == 42 ? 1 : 0;
+}
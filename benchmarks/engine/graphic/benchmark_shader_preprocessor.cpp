@@ -0,0 +1,110 @@
+#include "benchmarks_common.hpp"
+#include "graphic/shader_preprocessor.hpp"
+
+#include <iomanip>
+
+using namespace Fge;
+using namespace Fge::Benchmarks;
+
+namespace
+{
+
+/**
+ * Writes a binary tree of includes. Every file has some lines of code and
+ * includes its two children, the leaves include a shared file with
+ * #pragma once.
+ *
+ * @return Path of the root shader
+ */
+std::filesystem::path write_tree(const std::filesystem::path &directory,
+                                 int                          depth,
+                                 int                          lines_per_file)
+{
+  std::filesystem::create_directories(directory);
+
+  const auto write_lines = [&](std::ofstream &file, const std::string &name) {
+    for (int i = 0; i < lines_per_file; ++i)
+    {
+      file << "vec4 " << name << "_" << i << "(vec4 v) { return v * " << i
+           << ".0; }\n";
+    }
+  };
+
+  {
+    std::ofstream file(directory / "common.glsl");
+    file << "#pragma once\n";
+    write_lines(file, "common");
+  }
+
+  const int file_count = (1 << depth) - 1;
+  for (int i = file_count - 1; i >= 0; --i)
+  {
+    const auto    name = "node_" + std::to_string(i);
+    std::ofstream file(directory / (i == 0 ? "main.frag" : name + ".glsl"));
+    if (i == 0)
+    {
+      file << "#version 460 core\n";
+    }
+
+    const int children[] = {2 * i + 1, 2 * i + 2};
+    for (const auto child : children)
+    {
+      if (child < file_count)
+      {
+        file << "#include \"node_" << child << ".glsl\"\n";
+      }
+      else
+      {
+        file << "#include \"common.glsl\"\n";
+      }
+    }
+    write_lines(file, name);
+  }
+
+  return directory / "main.frag";
+}
+
+} // namespace
+
+/**
+ * Preprocesses shaders with include trees of growing depth. Cold is the
+ * first call that reads and parses every file, warm reuses the parsed files
+ * like the renderer does for every further variant.
+ */
+int main()
+{
+  const auto directory =
+      std::filesystem::temp_directory_path() / "fge_benchmark_shaders";
+  const int lines_per_file = 50;
+  const int warm_runs      = 20;
+
+  std::cout << std::fixed << std::setprecision(3);
+
+  for (int depth = 2; depth <= 10; depth += 2)
+  {
+    std::filesystem::remove_all(directory);
+    const auto shader_path = write_tree(directory, depth, lines_per_file);
+
+    ShaderPreprocessor preprocessor({directory});
+    std::size_t        size = 0;
+
+    const auto cold_ms = measure_ms([&]() {
+      size = preprocessor.preprocess(shader_path, {"SKINNED"}).code.size();
+    });
+    const auto warm_total_ms = measure_ms([&]() {
+      for (int i = 0; i < warm_runs; ++i)
+      {
+        preprocessor.preprocess(shader_path, {"SKINNED"});
+      }
+    });
+    const auto warm_ms = warm_total_ms / warm_runs;
+
+    std::cout << "depth " << depth << ", " << (1 << depth) - 1 << " files, "
+              << size / 1024 << " KiB: cold " << cold_ms << " ms, warm "
+              << warm_ms << " ms\n";
+  }
+
+  std::filesystem::remove_all(directory);
+
+  return 0;
+}
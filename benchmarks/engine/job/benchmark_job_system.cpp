@@ -0,0 +1,120 @@
+#include "job/job_system.hpp"
+
+#include <iomanip>
+
+using namespace Fge;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_nanos(Clock::time_point start)
+{
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start)
+          .count());
+}
+
+/**
+ * Schedules empty jobs to measure the cost of pushing, stealing and
+ * finishing a job.
+ */
+double measure_dispatch(JobSystem &job_system, int job_count)
+{
+  const auto start   = Clock::now();
+  auto       counter = std::make_shared<JobCounter>();
+  for (int i = 0; i < job_count; ++i)
+  {
+    job_system.schedule([]() {}, counter);
+  }
+  job_system.wait(counter);
+
+  return elapsed_nanos(start) / job_count;
+}
+
+void kernel(std::vector<float> &values, std::size_t begin, std::size_t end)
+{
+  for (auto i = begin; i < end; ++i)
+  {
+    auto value = values[i];
+    for (int j = 0; j < 64; ++j)
+    {
+      value = std::sqrt(value * 1.0001f + 0.5f);
+    }
+    values[i] = value;
+  }
+}
+
+double measure_serial(std::size_t count)
+{
+  std::vector<float> values(count, 1.0f);
+
+  const auto start = Clock::now();
+  kernel(values, 0, count);
+
+  return elapsed_nanos(start) / 1.0e6;
+}
+
+/**
+ * Runs the same amount of arithmetic as measure_serial() through
+ * parallel_for to see how it scales with the thread count.
+ */
+double measure_parallel_for(JobSystem &job_system, std::size_t count)
+{
+  std::vector<float> values(count, 1.0f);
+
+  const auto start = Clock::now();
+  job_system.parallel_for(
+      count, 1024, [&values](std::size_t begin, std::size_t end) {
+        kernel(values, begin, end);
+      });
+
+  return elapsed_nanos(start) / 1.0e6;
+}
+
+} // namespace
+
+int main()
+{
+  constexpr int         dispatch_job_count = 100000;
+  constexpr std::size_t for_count          = 1 << 20;
+
+  const std::size_t max_workers =
+      std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+  std::cout << "threads  dispatch ns/job  parallel_for ms  speedup\n";
+
+  // 1, 2, 4, ... workers and finally all of them
+  std::vector<std::size_t> worker_counts;
+  for (std::size_t workers = 1; workers < max_workers; workers *= 2)
+  {
+    worker_counts.push_back(workers);
+  }
+  worker_counts.push_back(max_workers);
+
+  const auto serial_ms = measure_serial(for_count);
+  std::cout << std::setw(7) << 1 << "  " << std::setw(15) << "-" << "  "
+            << std::setw(15) << std::fixed << std::setprecision(1) << serial_ms
+            << "  " << std::setw(7) << std::setprecision(2) << 1.0 << "\n";
+
+  for (const auto workers : worker_counts)
+  {
+    JobSystem job_system(workers);
+
+    // Warm up so threads are running and allocations are done
+    measure_dispatch(job_system, 1000);
+    measure_parallel_for(job_system, for_count / 16);
+
+    const auto dispatch_ns = measure_dispatch(job_system, dispatch_job_count);
+    const auto parallel_for_ms = measure_parallel_for(job_system, for_count);
+
+    std::cout << std::setw(7) << job_system.get_thread_count() << "  "
+              << std::setw(15) << std::fixed << std::setprecision(1)
+              << dispatch_ns << "  " << std::setw(15) << parallel_for_ms
+              << "  " << std::setw(7) << std::setprecision(2)
+              << serial_ms / parallel_for_ms << "\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include "log/log.hpp"
+
+#include <iomanip>
+#include <numeric>
+
+using namespace Fge;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Swallows everything, so only the cost of the logging calls and the queue
+ * gets measured.
+ */
+class NullLogSink : public LogSink
+{
+};
+
+/**
+ * Every thread logs call_count trace messages at the same time.
+ *
+ * @return Average wall time of one call in nanoseconds
+ */
+double measure_log_call(std::size_t thread_count, int call_count)
+{
+  std::atomic<bool>        start{false};
+  std::vector<std::thread> threads;
+  std::vector<double>      thread_nanos(thread_count);
+
+  for (std::size_t t = 0; t < thread_count; ++t)
+  {
+    threads.emplace_back([&, t]() {
+      while (!start)
+      {
+        std::this_thread::yield();
+      }
+
+      const auto begin = Clock::now();
+      for (int i = 0; i < call_count; ++i)
+      {
+        trace("Benchmark", FMT_STRING("Frame {} took {} ms"), i, 16.6f);
+      }
+      const auto end = Clock::now();
+
+      thread_nanos[t] =
+          std::chrono::duration<double, std::nano>(end - begin).count() /
+          call_count;
+    });
+  }
+
+  start = true;
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  return std::accumulate(thread_nanos.begin(), thread_nanos.end(), 0.0) /
+         thread_count;
+}
+
+} // namespace
+
+int main()
+{
+  constexpr int call_count = 200000;
+
+  std::cout << "threads  ns/call\n";
+
+  for (std::size_t thread_count = 1; thread_count <= 16; thread_count *= 2)
+  {
+    start_logger<NullLogSink>(LogType::Trace, LogMode::Async);
+    const auto nanos = measure_log_call(thread_count, call_count);
+    terminate_logger();
+
+    std::cout << std::setw(7) << thread_count << "  " << std::setw(7)
+              << std::fixed << std::setprecision(1) << nanos << "\n";
+  }
+
+  return 0;
+}
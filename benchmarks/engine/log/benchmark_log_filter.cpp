@@ -0,0 +1,76 @@
+#include "log/log.hpp"
+
+#include <iomanip>
+
+using namespace Fge;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The logging API before tags were interned and levels filtered at compile
+ * time. Kept here as baseline.
+ */
+template <class... Targs>
+void legacy_trace(const std::string &tag,
+                  const std::string &format_string,
+                  Targs &&... args)
+{
+  if (LogType::Trace > log_level.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  const auto log_msg = fmt::format(format_string, std::forward<Targs>(args)...);
+  std::cerr << tag << log_msg;
+}
+
+template <typename TFunction>
+double measure(int call_count, TFunction function)
+{
+  const auto start = Clock::now();
+  for (int i = 0; i < call_count; ++i)
+  {
+    function(i);
+  }
+  const auto end = Clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         call_count;
+}
+
+class NullLogSink : public LogSink
+{
+};
+
+} // namespace
+
+int main()
+{
+  constexpr int call_count = 10000000;
+
+  // Trace is disabled at runtime for all variants
+  start_logger<NullLogSink>(LogType::Info, LogMode::Sync);
+
+  const auto legacy_ns = measure(call_count, [](int i) {
+    legacy_trace("Renderer", "Register renderable {}", i);
+  });
+
+  const auto runtime_ns = measure(call_count, [](int i) {
+    trace("Renderer", FMT_STRING("Register renderable {}"), i);
+  });
+
+  std::cout << "Trace compiled in: "
+            << (LogType::Trace <= log_max_level ? "yes" : "no")
+            << " (FGE_LOG_MAX_LEVEL " << FGE_LOG_MAX_LEVEL << ")\n";
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "disabled trace, std::string API: " << legacy_ns << " ns/call\n";
+  std::cout << "disabled trace, current API:     " << runtime_ns
+            << " ns/call\n";
+
+  terminate_logger();
+
+  return 0;
+}
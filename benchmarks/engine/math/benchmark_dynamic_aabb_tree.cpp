@@ -0,0 +1,150 @@
+#include "math/dynamic_aabb_tree.hpp"
+
+#include <iomanip>
+
+using namespace Fge;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+template <typename TFunction>
+double measure(int call_count, TFunction function)
+{
+  const auto start = Clock::now();
+  for (int i = 0; i < call_count; ++i)
+  {
+    function(i);
+  }
+  const auto end = Clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+         call_count;
+}
+
+Aabb create_box(const glm::vec3 &center, float half_size)
+{
+  Aabb aabb{};
+  aabb.min = center - glm::vec3(half_size);
+  aabb.max = center + glm::vec3(half_size);
+
+  return aabb;
+}
+
+void run(std::size_t actor_count)
+{
+  constexpr int query_count = 1000;
+
+  // Constant density, so results per query stay comparable between sizes
+  const auto world_size = 10.0f * std::cbrt(static_cast<float>(actor_count));
+
+  std::mt19937                          random(42);
+  std::uniform_real_distribution<float> position(-world_size, world_size);
+  std::uniform_real_distribution<float> size(0.2f, 1.0f);
+
+  std::vector<Aabb> boxes;
+  DynamicAabbTree   tree;
+  for (std::size_t i = 0; i < actor_count; ++i)
+  {
+    boxes.push_back(create_box(
+        glm::vec3(position(random), position(random), position(random)),
+        size(random)));
+    tree.create_proxy(boxes.back(), i);
+  }
+
+  std::vector<Aabb> query_boxes;
+  std::vector<Ray>  rays;
+  for (int i = 0; i < query_count; ++i)
+  {
+    query_boxes.push_back(create_box(
+        glm::vec3(position(random), position(random), position(random)),
+        5.0f));
+
+    auto &ray     = rays.emplace_back();
+    ray.origin    = glm::vec3(position(random), position(random), -world_size);
+    ray.direction = glm::vec3(0.0f, 0.0f, 1.0f);
+  }
+
+  std::size_t found = 0;
+
+  const auto brute_box_us = measure(query_count, [&](int i) {
+    for (const auto &box : boxes)
+    {
+      found += box.overlaps(query_boxes[i]);
+    }
+  });
+
+  const auto tree_box_us = measure(query_count, [&](int i) {
+    tree.query(query_boxes[i], [&](int32_t /*proxy*/) {
+      ++found;
+      return true;
+    });
+  });
+
+  const auto brute_ray_us = measure(query_count, [&](int i) {
+    auto closest = rays[i].max_distance;
+    for (const auto &box : boxes)
+    {
+      float distance = 0.0f;
+      if (intersects(rays[i], box, distance))
+      {
+        closest = std::min(closest, distance);
+      }
+    }
+    found += closest < rays[i].max_distance;
+  });
+
+  const auto tree_ray_us = measure(query_count, [&](int i) {
+    tree.raycast(rays[i], [&](const Ray &ray, int32_t proxy) {
+      float distance = 0.0f;
+      if (intersects(ray, boxes[tree.get_user_data(proxy)], distance))
+      {
+        ++found;
+        return distance;
+      }
+      return ray.max_distance;
+    });
+  });
+
+  std::vector<std::pair<float, std::size_t>> distances;
+  const auto brute_nearest_us = measure(query_count, [&](int i) {
+    const auto point = query_boxes[i].get_center();
+    distances.clear();
+    for (std::size_t j = 0; j < boxes.size(); ++j)
+    {
+      distances.emplace_back(boxes[j].get_distance2(point), j);
+    }
+    std::partial_sort(
+        distances.begin(), distances.begin() + 8, distances.end());
+    found += distances[0].second;
+  });
+
+  std::vector<int32_t> nearest;
+  const auto           tree_nearest_us = measure(query_count, [&](int i) {
+    tree.query_nearest(query_boxes[i].get_center(), 8, nearest);
+    found += nearest.size();
+  });
+
+  std::cout << actor_count << " actors (tree height " << tree.get_height()
+            << ")\n";
+  std::cout << "  box query:  brute force " << brute_box_us << " us, tree "
+            << tree_box_us << " us\n";
+  std::cout << "  ray cast:   brute force " << brute_ray_us << " us, tree "
+            << tree_ray_us << " us\n";
+  std::cout << "  8 nearest:  brute force " << brute_nearest_us
+            << " us, tree " << tree_nearest_us << " us\n";
+  std::cout << "  (" << found << ")\n";
+}
+
+} // namespace
+
+int main()
+{
+  std::cout << std::fixed << std::setprecision(2);
+
+  run(10000);
+  run(100000);
+
+  return 0;
+}
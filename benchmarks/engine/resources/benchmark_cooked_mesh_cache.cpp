@@ -0,0 +1,114 @@
+#include "benchmarks_common.hpp"
+#include "log/log.hpp"
+#include "resources/cooked_mesh_cache.hpp"
+#include "resources/mesh_importer.hpp"
+#include "resources/skinned_mesh_importer.hpp"
+
+#include <iomanip>
+
+using namespace Fge;
+using namespace Fge::Benchmarks;
+
+namespace
+{
+
+class NullLogSink : public LogSink
+{
+};
+
+struct Times
+{
+  double cold_ms{};
+  double warm_ms{};
+};
+
+/**
+ * Cold is the Assimp import plus storing the entry, what the first start
+ * pays. Warm is loading the stored entry, what every later start pays.
+ */
+template <typename TImport, typename TStore, typename TLoad>
+Times run(TImport import, TStore store, TLoad load)
+{
+  Times times{};
+  times.cold_ms = measure_ms([&]() { store(import()); });
+  times.warm_ms = measure_ms([&]() {
+    if (!load())
+    {
+      throw std::runtime_error("Stored entry could not be loaded");
+    }
+  });
+
+  return times;
+}
+
+} // namespace
+
+/**
+ * Loads every mesh in res/meshes once cold and once warm. Meshes with a
+ * skeleton are also loaded as skinned mesh.
+ *
+ * Usage: BenchmarkEngineResourcesCookedMeshCache [meshes directory]
+ */
+int main(int argc, char **argv)
+{
+  const std::filesystem::path meshes_path = argc > 1 ? argv[1] : "res/meshes";
+  const auto                  cache_path =
+      std::filesystem::temp_directory_path() / "fge_benchmark_cooked_meshes";
+
+  // Meshes of res/meshes with a skeleton
+  const std::vector<std::string> skinned_meshes{"character.dae"};
+
+  start_logger<NullLogSink>(LogType::Error, LogMode::Sync);
+
+  std::filesystem::remove_all(cache_path);
+  CookedMeshCache cache(cache_path);
+
+  std::vector<std::pair<std::string, Times>> results;
+  for (const auto &entry : std::filesystem::directory_iterator(meshes_path))
+  {
+    const auto &source_path = entry.path();
+    const auto  name        = source_path.filename().string();
+
+    results.emplace_back(
+        name,
+        run([&]() { return import_mesh_from_file(source_path.string()); },
+            [&](const MeshData &data) {
+              cache.store_mesh(name, source_path, data);
+            },
+            [&]() { return cache.load_mesh(name, source_path).has_value(); }));
+
+    if (std::find(skinned_meshes.begin(), skinned_meshes.end(), name) !=
+        skinned_meshes.end())
+    {
+      results.emplace_back(
+          name + " (skinned)",
+          run(
+              [&]() {
+                return import_skinned_mesh_from_file(source_path.string());
+              },
+              [&](const SkinnedMeshData &data) {
+                cache.store_skinned_mesh(name, source_path, data);
+              },
+              [&]() {
+                return cache.load_skinned_mesh(name, source_path).has_value();
+              }));
+    }
+  }
+
+  std::filesystem::remove_all(cache_path);
+  terminate_logger();
+
+  Times total{};
+  std::cout << std::fixed << std::setprecision(3);
+  for (const auto &[name, times] : results)
+  {
+    std::cout << name << ": cold " << times.cold_ms << " ms, warm "
+              << times.warm_ms << " ms\n";
+    total.cold_ms += times.cold_ms;
+    total.warm_ms += times.warm_ms;
+  }
+  std::cout << "total: cold " << total.cold_ms << " ms, warm "
+            << total.warm_ms << " ms\n";
+
+  return 0;
+}
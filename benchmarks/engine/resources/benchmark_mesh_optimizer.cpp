@@ -0,0 +1,63 @@
+#include "benchmarks_common.hpp"
+#include "log/log.hpp"
+#include "resources/mesh_importer.hpp"
+#include "resources/mesh_optimizer.hpp"
+
+#include <iomanip>
+
+using namespace Fge;
+using namespace Fge::Benchmarks;
+
+namespace
+{
+
+class NullLogSink : public LogSink
+{
+};
+
+} // namespace
+
+/**
+ * Imports every mesh in res/meshes as it is stored in the file, optimizes
+ * its sub meshes and reports the vertex cache efficiency before and after
+ * and the triangles of the generated LODs.
+ *
+ * Usage: BenchmarkEngineResourcesMeshOptimizer [meshes directory]
+ */
+int main(int argc, char **argv)
+{
+  const std::filesystem::path meshes_path = argc > 1 ? argv[1] : "res/meshes";
+
+  start_logger<NullLogSink>(LogType::Error, LogMode::Sync);
+
+  std::cout << std::fixed << std::setprecision(3);
+  for (const auto &entry : std::filesystem::directory_iterator(meshes_path))
+  {
+    const auto name = entry.path().filename().string();
+    auto       data = import_mesh_from_file(entry.path().string(), false);
+
+    for (auto &sub_mesh : data.sub_meshes)
+    {
+      MeshOptimizationReport report{};
+      const auto             optimize_ms =
+          measure_ms([&]() { report = optimize_sub_mesh(sub_mesh); });
+
+      std::cout << name << " " << sub_mesh.name << ": "
+                << report.lod_triangle_counts.front() << " triangles, "
+                << report.vertex_count_before << " -> "
+                << report.vertex_count_after << " vertices, ACMR "
+                << report.before.acmr << " -> " << report.after.acmr
+                << ", ATVR " << report.before.atvr << " -> "
+                << report.after.atvr << ", LOD triangles";
+      for (const auto triangle_count : report.lod_triangle_counts)
+      {
+        std::cout << " " << triangle_count;
+      }
+      std::cout << ", " << optimize_ms << " ms\n";
+    }
+  }
+
+  terminate_logger();
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+#include "benchmarks_common.hpp"
+#include "job/job_system.hpp"
+#include "resources/texture_data.hpp"
+
+#include <iomanip>
+#include <numeric>
+
+using namespace Fge;
+using namespace Fge::Benchmarks;
+
+namespace
+{
+
+/**
+ * Decodes the images and generates their mip chains, like the resource
+ * manager does before uploading.
+ *
+ * @return Number of bytes of all levels
+ */
+std::size_t load(const std::vector<std::string> &paths,
+                 JobSystem *                     job_system)
+{
+  std::vector<std::size_t> sizes(paths.size());
+
+  const auto load_range = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      sizes[i] = load_texture2d_data(paths[i], true).pixels.size();
+    }
+  };
+
+  if (job_system)
+  {
+    job_system->parallel_for(paths.size(), 1, load_range);
+  }
+  else
+  {
+    load_range(0, paths.size());
+  }
+
+  return std::accumulate(sizes.begin(), sizes.end(), std::size_t{0});
+}
+
+} // namespace
+
+/**
+ * Loads every image of a directory one after another on one thread and in
+ * parallel on the job system. Reports the best of several rounds.
+ *
+ * Usage: BenchmarkEngineResourcesTextureData [textures directory]
+ */
+int main(int argc, char **argv)
+{
+  const std::filesystem::path textures_path =
+      argc > 1 ? argv[1] : "res/textures";
+
+  std::vector<std::string> paths;
+  for (const auto &entry : std::filesystem::directory_iterator(textures_path))
+  {
+    if (entry.is_regular_file())
+    {
+      paths.push_back(entry.path().string());
+    }
+  }
+
+  JobSystem job_system;
+
+  // Untimed, so no run pays for reading the files into the disk cache
+  const auto bytes = load(paths, nullptr);
+
+  // Alternate which one goes first, so neither always profits from the other
+  constexpr int round_count = 4;
+  auto          serial_ms   = std::numeric_limits<double>::max();
+  auto          parallel_ms = std::numeric_limits<double>::max();
+  for (int round = 0; round < round_count; ++round)
+  {
+    const auto measure_serial = [&]() {
+      serial_ms =
+          std::min(serial_ms, measure_ms([&]() { load(paths, nullptr); }));
+    };
+    const auto measure_parallel = [&]() {
+      parallel_ms = std::min(parallel_ms,
+                             measure_ms([&]() { load(paths, &job_system); }));
+    };
+
+    if (round % 2 == 0)
+    {
+      measure_serial();
+      measure_parallel();
+    }
+    else
+    {
+      measure_parallel();
+      measure_serial();
+    }
+  }
+
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << paths.size() << " textures, " << bytes / (1024 * 1024)
+            << " MiB with mip chains\n";
+  std::cout << "serial: " << serial_ms << " ms\n";
+  std::cout << "parallel (" << job_system.get_thread_count()
+            << " threads): " << parallel_ms << " ms\n";
+
+  return 0;
+}
@@ -1,7 +1,15 @@
 game = {
-   frametime = 1 / 60,
+   frametime = 1 / 60, -- Time one simulation tick advances
+   max_fixed_steps = 5, -- Maximum simulation ticks per rendered frame
+   max_fps = 0, -- Render rate limit, 0 means unlimited
    log_level = "Debug", -- Debug, Trace, Info, Warning, Error
-   log_mode = "SYNC" -- ASYNC, SYNC
+   log_mode = "SYNC", -- ASYNC, SYNC
+   log_latency_ms = 100, -- Maximum delay of async log messages
+   worker_threads = 0 -- 0 picks one less than the hardware threads
+}
+
+graphic = {
+   lod_bias = 1.0 -- Higher values switch to coarser mesh LODs sooner
 }
 
 opengl = {
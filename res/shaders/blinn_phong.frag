@@ -1,6 +1,6 @@
 #version 460 core
 
-#define MAX_POINT_LIGHTS_COUNT 5
+#include "frame_uniforms.glsl"
 
 in VS_OUT
 {
@@ -11,23 +11,6 @@ in VS_OUT
 
 layout (location = 0) out vec4 out_color;
 
-struct PointLight
-{
-  vec3 position;
-  vec3 ambient_color;
-  vec3 diffuse_color;
-  vec3 specular_color;
-};
-
-struct DirectionalLight
-{
-  vec3 direction;
-  vec3 ambient_color;
-  vec3 diffuse_color;
-  vec3 specular_color;
-};
-
-
 #ifdef DIFFUSE_TEX
 uniform sampler2D in_diffuse_tex;
 #else // DIFFUSE_TEX
@@ -36,12 +19,6 @@ uniform vec3 in_diffuse_color = vec3(0.6);
 
 uniform float specular_power = 200.0f;
 
-uniform int point_light_count;
-uniform PointLight point_lights[MAX_POINT_LIGHTS_COUNT];
-
-uniform bool directional_light_enabled;
-uniform DirectionalLight directional_light;
-
 void main()
 {
   vec3 diffuse_color;
@@ -62,27 +39,27 @@ void main()
   // Point lights
   for (int i = 0; i < point_light_count; ++i)
   {
-    vec3 L = normalize(point_lights[i].position - fs_in.position);
+    vec3 L = normalize(point_lights[i].position.xyz - fs_in.position);
     vec3 H = normalize(L + V);
 
     // Compute lightning
-    vec3 ambient = ambient_color * point_lights[i].ambient_color;
-    vec3 diffuse = max(dot(N, L), 0.0) * diffuse_color * point_lights[i].diffuse_color;
-    vec3 specular = pow(max(dot(N, H), 0.0), specular_power) * specular_color * point_lights[i].specular_color;
+    vec3 ambient = ambient_color * point_lights[i].ambient_color.rgb;
+    vec3 diffuse = max(dot(N, L), 0.0) * diffuse_color * point_lights[i].diffuse_color.rgb;
+    vec3 specular = pow(max(dot(N, H), 0.0), specular_power) * specular_color * point_lights[i].specular_color.rgb;
 
     color += ambient + diffuse + specular;
   }
 
   // Directional light
-  if (directional_light_enabled)
+  if (directional_light_enabled != 0)
   {
-    vec3 L = normalize(-directional_light.direction);
+    vec3 L = normalize(-directional_light.direction.xyz);
     vec3 H = normalize(L + V);
 
     // Compute lightning
-    vec3 ambient = ambient_color * directional_light.ambient_color;
-    vec3 diffuse = max(dot(N, L), 0.0) * diffuse_color * directional_light.diffuse_color;
-    vec3 specular = pow(max(dot(N, H), 0.0), specular_power) * specular_color * directional_light.specular_color;
+    vec3 ambient = ambient_color * directional_light.ambient_color.rgb;
+    vec3 diffuse = max(dot(N, L), 0.0) * diffuse_color * directional_light.diffuse_color.rgb;
+    vec3 specular = pow(max(dot(N, H), 0.0), specular_power) * specular_color * directional_light.specular_color.rgb;
 
     color += ambient + diffuse + specular;
   }
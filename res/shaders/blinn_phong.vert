@@ -1,21 +1,18 @@
 #version 460 core
 
-#define MAX_BONES 35
+#include "frame_uniforms.glsl"
+#include "vertex_packing.glsl"
 
 #ifdef SKINNED
 layout(location = 0) in vec3 in_position;
-layout(location = 1) in vec3 in_normal;
-layout(location = 2) in vec3 in_tangent;
-layout(location = 3) in vec3 in_bitangent;
-layout(location = 4) in ivec4 in_skin_bones;
-layout(location = 5) in vec4 in_skin_weights;
-layout(location = 6) in vec2 in_tex_coord;
+layout(location = 1) in vec4 in_normal_tangent;
+layout(location = 2) in uvec4 in_skin_bones;
+layout(location = 3) in vec4 in_skin_weights;
+layout(location = 4) in vec2 in_tex_coord;
 #else // SKINNED
 layout (location = 0) in vec3 in_position;
-layout (location = 1) in vec3 in_normal;
-layout (location = 2) in vec3 in_tangent;
-layout (location = 3) in vec3 in_bitangent;
-layout (location = 4) in vec2 in_tex_coord;
+layout (location = 1) in vec4 in_normal_tangent;
+layout (location = 2) in vec2 in_tex_coord;
 #endif // SKINNED
 
 out VS_OUT
@@ -25,29 +22,39 @@ out VS_OUT
   vec2 tex_coord;
 } vs_out;
 
-uniform mat4 projection_mat;
-uniform mat4 view_mat;
-
+#ifdef INSTANCED
+// Per instance attribute, takes the locations 8 to 11
+layout (location = 8) in mat4 in_world_mat;
+#else // INSTANCED
 uniform mat4 world_mat;
+#endif // INSTANCED
 #ifdef SKINNED
-uniform mat4 bones[MAX_BONES];
+// Index of the first bone of this mesh in the bone palette
+uniform int first_bone;
 #endif // SKINNED
 
 void main()
 {
+  vec3 decoded_normal = decode_normal(in_normal_tangent);
+
   #ifdef SKINNED
-  mat4 bone_transform = bones[in_skin_bones.x] * in_skin_weights.x;
-  bone_transform += bones[in_skin_bones.y] * in_skin_weights.y;
-  bone_transform += bones[in_skin_bones.z] * in_skin_weights.z;
-  bone_transform += bones[in_skin_bones.w] * in_skin_weights.w;
+  ivec4 skin_bones = first_bone + ivec4(in_skin_bones);
+  mat3x4 bone_transform = bones[skin_bones.x] * in_skin_weights.x;
+  bone_transform += bones[skin_bones.y] * in_skin_weights.y;
+  bone_transform += bones[skin_bones.z] * in_skin_weights.z;
+  bone_transform += bones[skin_bones.w] * in_skin_weights.w;
 
-  vec4 position = bone_transform * vec4(in_position, 1.0);
-  vec3 normal = vec3(bone_transform * vec4(in_normal, 0.0));
+  vec4 position = vec4(vec4(in_position, 1.0) * bone_transform, 1.0);
+  vec3 normal = vec4(decoded_normal, 0.0) * bone_transform;
   #else // SKINNED
   vec4 position = vec4(in_position, 1.0);
-  vec3 normal = in_normal;
+  vec3 normal = decoded_normal;
   #endif // SKINNED
 
+  #ifdef INSTANCED
+  mat4 world_mat = in_world_mat;
+  #endif // INSTANCED
+
   mat4 view_world_mat = view_mat * world_mat;
 
   vec4 P = view_world_mat * position;
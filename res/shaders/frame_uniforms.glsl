@@ -0,0 +1,46 @@
+#pragma once
+
+// Per frame data shared by all shaders. Must match
+// src/engine/graphic/frame_uniforms.hpp
+
+#define MAX_POINT_LIGHTS_COUNT 5
+
+struct PointLight
+{
+  vec4 position;
+  vec4 ambient_color;
+  vec4 diffuse_color;
+  vec4 specular_color;
+};
+
+struct DirectionalLight
+{
+  vec4 direction;
+  vec4 ambient_color;
+  vec4 diffuse_color;
+  vec4 specular_color;
+};
+
+layout (std140, binding = 0) uniform Camera
+{
+  mat4 projection_mat;
+  mat4 view_mat;
+  vec4 camera_position;
+};
+
+layout (std140, binding = 1) uniform Lights
+{
+  PointLight point_lights[MAX_POINT_LIGHTS_COUNT];
+  DirectionalLight directional_light;
+  int point_light_count;
+  int directional_light_enabled;
+};
+
+#ifdef SKINNED
+// Bones of all skinned meshes. Every column holds a row of an affine bone
+// transform, so vec4(p, 1.0) * bone is the transformed point.
+layout (std430, binding = 2) readonly buffer BonePalette
+{
+  mat3x4 bones[];
+};
+#endif // SKINNED
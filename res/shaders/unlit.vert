@@ -2,8 +2,7 @@
 
 layout (location = 0) in vec3 in_position;
 
-uniform mat4 projection_mat;
-uniform mat4 view_mat;
+#include "frame_uniforms.glsl"
 
 uniform mat4 world_mat;
 
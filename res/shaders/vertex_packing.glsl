@@ -0,0 +1,25 @@
+#pragma once
+
+// Decodes vertex attributes packed by src/engine/graphic/vertex_packing.cpp.
+// Only the normal is decoded, no shader uses the tangent frame yet.
+
+vec2 sign_not_zero(vec2 value)
+{
+  return vec2(value.x >= 0.0 ? 1.0 : -1.0, value.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 decode_octahedral(vec2 encoded)
+{
+  vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+  if (direction.z < 0.0)
+  {
+    direction.xy = (1.0 - abs(encoded.yx)) * sign_not_zero(encoded);
+  }
+
+  return normalize(direction);
+}
+
+vec3 decode_normal(vec4 normal_tangent)
+{
+  return decode_octahedral(normal_tangent.xy);
+}
@@ -48,6 +48,11 @@ void EditorLayer::init()
 
   // ----------------------------- BEGIN TEST SCENE ---------------------------
 
+  // Decodes the textures of the scene in parallel, instead of one after
+  // another while the meshes load
+  app->get_resource_manager()->preload_textures2d({"character_diffuse.png"},
+                                                  true);
+
   auto scene     = std::make_shared<Scene>();
   auto actor     = scene->add_actor<Actor>();
   auto mesh_comp = actor->add_component<MeshComponent>();
@@ -156,6 +161,7 @@ void EditorLayer::imgui_render()
   const auto &camera_info = camera_controller.get_camera_info();
 
   scene_viewport.draw(camera_info);
+  profiler_view.draw();
 
   // bool show = true;
   // ImGui::ShowDemoWindow(&show);
@@ -234,7 +240,7 @@ void EditorLayer::unregister_grid()
 {
   if (grid_registered)
   {
-    trace("EditorLayer", "Unregister grid");
+    trace("EditorLayer", FMT_STRING("Unregister grid"));
 
     auto app      = Application::get_instance();
     auto renderer = app->get_graphic_manager()->get_renderer();
@@ -248,7 +254,7 @@ void EditorLayer::register_grid()
 {
   if (!grid_registered)
   {
-    trace("EditorLayer", "Register grid");
+    trace("EditorLayer", FMT_STRING("Register grid"));
 
     auto app      = Application::get_instance();
     auto renderer = app->get_graphic_manager()->get_renderer();
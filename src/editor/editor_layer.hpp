@@ -6,6 +6,7 @@
 #include "graphic/render_view.hpp"
 #include "graphic/window.hpp"
 #include "imgui_views/dockspace.hpp"
+#include "imgui_views/profiler_view.hpp"
 #include "imgui_views/viewport.hpp"
 #include "layer.hpp"
 
@@ -44,6 +45,7 @@ private:
   // ImGui Views
   EditorViews::DockSpace     dockspace;
   EditorViews::SceneViewport scene_viewport;
+  EditorViews::ProfilerView  profiler_view;
 
   std::unique_ptr<Grid>       grid{};
   bool                        grid_registered = false;
@@ -0,0 +1,227 @@
+#include "profiler_view.hpp"
+#include "application.hpp"
+#include "graphic/imgui.hpp"
+#include "log/log.hpp"
+
+namespace Fge::EditorViews
+{
+
+namespace
+{
+
+constexpr float row_height = 20.0f;
+
+float nanos_to_millis(int64_t nanos) { return nanos / 1.0e6f; }
+
+ImU32 get_zone_color(const char *name)
+{
+  // Names are literals, so the pointer is stable and good enough as hash
+  const auto hash = std::hash<const void *>{}(name);
+  return IM_COL32(100 + hash % 120, 100 + (hash >> 8) % 120, 180, 255);
+}
+
+} // namespace
+
+void ProfilerView::draw()
+{
+  ImGui::Begin("Profiler");
+
+  auto &profiler = Profiler::get_instance();
+
+  bool paused = profiler.is_paused();
+  if (ImGui::Checkbox("Pause", &paused))
+  {
+    profiler.set_paused(paused);
+  }
+
+  ImGui::SameLine();
+  if (ImGui::Button("Export trace"))
+  {
+    export_trace();
+  }
+
+  const auto dropped_zone_count = profiler.get_dropped_zone_count();
+  ImGui::SameLine();
+  ImGui::Text("Dropped zones: %llu",
+              static_cast<unsigned long long>(dropped_zone_count));
+
+  draw_render_stats();
+
+  const auto &frames = profiler.get_frames();
+  if (frames.empty())
+  {
+    ImGui::End();
+    return;
+  }
+
+  draw_frame_times(frames);
+
+  // Follow the latest frame unless the user picked one while paused
+  if (!paused || selected_frame < 0 ||
+      static_cast<std::size_t>(selected_frame) >= frames.size())
+  {
+    selected_frame = static_cast<int>(frames.size()) - 1;
+  }
+
+  draw_flame_graph(frames[selected_frame]);
+
+  ImGui::End();
+}
+
+void ProfilerView::draw_render_stats()
+{
+  auto renderer =
+      Application::get_instance()->get_graphic_manager()->get_renderer();
+  const auto &stats = renderer->get_render_stats();
+
+  ImGui::Text("Draw calls: %u (%u instanced, %u instances)",
+              stats.draw_call_count,
+              stats.instanced_draw_call_count,
+              stats.instance_count);
+  ImGui::Text("Program changes: %u  Vertex array changes: %u  "
+              "Texture changes: %u  Elided changes: %u",
+              stats.program_change_count,
+              stats.vertex_array_change_count,
+              stats.texture_change_count,
+              stats.elided_change_count);
+  ImGui::Text("Visible: %u  Culled: %u",
+              stats.visible_count,
+              stats.culled_count);
+  ImGui::Text("Triangles: %u (%u at full detail)",
+              stats.triangle_count,
+              stats.full_detail_triangle_count);
+}
+
+void ProfilerView::draw_frame_times(const std::deque<ProfileFrame> &frames)
+{
+  std::vector<float> frame_times;
+  frame_times.reserve(frames.size());
+  for (const auto &frame : frames)
+  {
+    frame_times.push_back(nanos_to_millis(frame.end_time - frame.begin_time));
+  }
+
+  const auto width = ImGui::GetContentRegionAvail().x;
+  ImGui::PlotHistogram("##frame_times",
+                       frame_times.data(),
+                       static_cast<int>(frame_times.size()),
+                       0,
+                       "Frame times (click to select, pause first)",
+                       0.0f,
+                       FLT_MAX,
+                       ImVec2(width, 60.0f));
+
+  if (ImGui::IsItemClicked())
+  {
+    const auto item_min = ImGui::GetItemRectMin();
+    const auto item_max = ImGui::GetItemRectMax();
+    const auto mouse_x  = ImGui::GetIO().MousePos.x;
+    const auto t        = (mouse_x - item_min.x) / (item_max.x - item_min.x);
+
+    selected_frame = std::clamp(static_cast<int>(t * frame_times.size()),
+                                0,
+                                static_cast<int>(frame_times.size()) - 1);
+  }
+}
+
+void ProfilerView::draw_flame_graph(const ProfileFrame &frame)
+{
+  const auto frame_duration = frame.end_time - frame.begin_time;
+  ImGui::Text("Frame: %.3f ms", nanos_to_millis(frame_duration));
+
+  if (frame_duration <= 0)
+  {
+    return;
+  }
+
+  ImGui::BeginChild("##flame_graph",
+                    ImVec2(0.0f, 0.0f),
+                    false,
+                    ImGuiWindowFlags_HorizontalScrollbar);
+
+  auto *     draw_list = ImGui::GetWindowDrawList();
+  const auto origin    = ImGui::GetCursorScreenPos();
+  const auto width     = ImGui::GetContentRegionAvail().x;
+  const auto mouse_pos = ImGui::GetIO().MousePos;
+
+  const auto time_to_x = [&](int64_t time) {
+    return origin.x +
+           width * float(time - frame.begin_time) / float(frame_duration);
+  };
+
+  // Zones are sorted by thread, so lanes can be stacked while iterating
+  float    lane_y       = origin.y;
+  uint32_t lane_depth   = 0;
+  uint32_t lane_thread  = frame.zones.empty() ? 0 : frame.zones[0].thread_index;
+  bool     lane_started = false;
+
+  for (const auto &zone : frame.zones)
+  {
+    if (zone.thread_index != lane_thread)
+    {
+      lane_y += (lane_depth + 2) * row_height;
+      lane_depth   = 0;
+      lane_thread  = zone.thread_index;
+      lane_started = false;
+    }
+
+    if (!lane_started)
+    {
+      draw_list->AddText(ImVec2(origin.x, lane_y),
+                         IM_COL32_WHITE,
+                         fmt::format("Thread {}", lane_thread).c_str());
+      lane_started = true;
+    }
+    lane_depth = std::max(lane_depth, zone.depth);
+
+    const auto x0 = time_to_x(zone.begin_time);
+    const auto x1 = time_to_x(zone.end_time);
+    const auto y0 = lane_y + (zone.depth + 1) * row_height;
+    const auto y1 = y0 + row_height - 1.0f;
+
+    const ImVec2 min(x0, y0);
+    const ImVec2 max(std::max(x1, x0 + 1.0f), y1);
+    draw_list->AddRectFilled(min, max, get_zone_color(zone.name));
+
+    const auto text_width = ImGui::CalcTextSize(zone.name).x;
+    if (max.x - min.x > text_width + 4.0f)
+    {
+      draw_list->AddText(
+          ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32_BLACK, zone.name);
+    }
+
+    if (mouse_pos.x >= min.x && mouse_pos.x <= max.x && mouse_pos.y >= min.y &&
+        mouse_pos.y <= max.y)
+    {
+      ImGui::SetTooltip("%s\n%.3f ms",
+                        zone.name,
+                        nanos_to_millis(zone.end_time - zone.begin_time));
+    }
+  }
+
+  lane_y += (lane_depth + 2) * row_height;
+  ImGui::Dummy(ImVec2(width, lane_y - origin.y));
+
+  ImGui::EndChild();
+}
+
+void ProfilerView::export_trace()
+{
+  auto       app      = Application::get_instance();
+  const auto filepath = app->get_file_manager()->get_app_cache_path() /
+                        "profiler_trace.json";
+
+  try
+  {
+    Profiler::get_instance().export_chrome_trace(filepath);
+    info("ProfilerView", FMT_STRING("Exported trace to {}"), filepath.string());
+  }
+  catch (const std::exception &exception)
+  {
+    error("ProfilerView",
+          FMT_STRING("Could not export trace: {}"),
+          exception.what());
+  }
+}
+
+} // namespace Fge::EditorViews
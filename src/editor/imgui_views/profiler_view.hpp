@@ -0,0 +1,31 @@
+#pragma once
+
+#include "profiler/profiler.hpp"
+#include "std.hpp"
+
+namespace Fge::EditorViews
+{
+
+/**
+ * Shows the frame times of the recorded frames and a flame graph of the
+ * selected frame with one lane per thread.
+ */
+class ProfilerView
+{
+public:
+  void draw();
+
+private:
+  // Index into the recorded frames, -1 follows the latest frame
+  int selected_frame = -1;
+
+  void draw_render_stats();
+
+  void draw_frame_times(const std::deque<ProfileFrame> &frames);
+
+  void draw_flame_graph(const ProfileFrame &frame);
+
+  void export_trace();
+};
+
+} // namespace Fge::EditorViews
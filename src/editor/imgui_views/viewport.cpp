@@ -2,6 +2,7 @@
 #include "application.hpp"
 #include "graphic/camera.hpp"
 #include "graphic/imgui.hpp"
+#include "scene/scene_manager.hpp"
 
 namespace Fge::EditorViews
 {
@@ -37,6 +38,24 @@ void SceneViewport::draw(const CameraInfo &camera_info)
                ImVec2(0, 1),
                ImVec2(1, 0));
 
+  const auto image_pos = ImGui::GetItemRectMin();
+  if (ImGui::IsItemClicked(0))
+  {
+    const auto mouse_pos = ImGui::GetMousePos();
+    pick_actor(camera_info,
+               mouse_pos.x - image_pos.x,
+               mouse_pos.y - image_pos.y);
+  }
+
+  if (auto actor = selected_actor.lock())
+  {
+    const auto label = "Selected: " + actor->get_name();
+    ImGui::GetWindowDrawList()->AddText(ImVec2(image_pos.x + 8.0f,
+                                               image_pos.y + 8.0f),
+                                        IM_COL32_WHITE,
+                                        label.c_str());
+  }
+
   ImGui::End();
   ImGui::PopStyleVar();
 }
@@ -50,6 +69,35 @@ void SceneViewport::recreate_projection_mat(const CameraInfo &camera_info)
                        500.0f);
 }
 
+void SceneViewport::pick_actor(const CameraInfo &camera_info, float x, float y)
+{
+  auto app   = Application::get_instance();
+  auto scene = app->get_scene_manager()->get_scene();
+  if (!scene)
+  {
+    selected_actor.reset();
+    return;
+  }
+
+  // Unproject the points on the near and the far plane below the mouse. The
+  // image is drawn flipped, so y points down in the viewport but up in
+  // normalized device coordinates.
+  const auto ndc_x = 2.0f * x / viewport_width - 1.0f;
+  const auto ndc_y = 1.0f - 2.0f * y / viewport_height;
+
+  const auto inverse_mat = glm::inverse(projection_mat * camera_info.view_mat);
+  auto       near_point  = inverse_mat * glm::vec4(ndc_x, ndc_y, -1.0f, 1.0f);
+  auto       far_point   = inverse_mat * glm::vec4(ndc_x, ndc_y, 1.0f, 1.0f);
+  near_point /= near_point.w;
+  far_point /= far_point.w;
+
+  Ray ray{};
+  ray.origin    = glm::vec3(near_point);
+  ray.direction = glm::normalize(glm::vec3(far_point - near_point));
+
+  selected_actor = scene->raycast(ray);
+}
+
 void SceneViewport::create_scene_render_view()
 {
   auto app             = Application::get_instance();
@@ -3,6 +3,7 @@
 #include "graphic/camera_controller.hpp"
 #include "graphic/render_view.hpp"
 #include "math/math.hpp"
+#include "scene/actor.hpp"
 #include "std.hpp"
 
 namespace Fge::EditorViews
@@ -30,9 +31,17 @@ private:
 
   std::shared_ptr<RenderView> scene_render_view{};
 
+  std::weak_ptr<Actor> selected_actor{};
+
   void recreate_projection_mat(const CameraInfo &camera_info);
 
   void create_scene_render_view();
+
+  /**
+   * Selects the actor under the given position. The position is in pixels
+   * relative to the top left corner of the viewport.
+   */
+  void pick_actor(const CameraInfo &camera_info, float x, float y);
 };
 
 } // namespace Fge::EditorViews
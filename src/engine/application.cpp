@@ -4,13 +4,16 @@
 #include "log/io_log_sink.hpp"
 #include "log/log.hpp"
 #include "physic/physic_manager.hpp"
+#include "profiler/profiler.hpp"
 #include "scene/scene_manager.hpp"
-#include "util/time.hpp"
 #include <exception>
 
 namespace Fge
 {
 
+// Time per frame for creating the GL objects of background loads
+constexpr std::chrono::microseconds resource_upload_budget(2000);
+
 std::once_flag               Application::instance_created{};
 std::shared_ptr<Application> Application::instance{};
 
@@ -67,7 +70,26 @@ void Application::init_logging()
     log_mode = LogMode::Sync;
   }
 
-  start_logger<IOLogSink>(log_level, log_mode);
+  const auto log_latency = std::chrono::milliseconds(
+      config_manager->get_config()["game"]["log_latency_ms"].get_or(100));
+
+  start_logger<IOLogSink>(log_level, log_mode, log_latency);
+}
+
+void Application::init_main_loop()
+{
+  auto game_config = config_manager->get_config()["game"];
+
+  fixed_frametime = game_config["frametime"].get_or(1.0f / 60.0f);
+  if (fixed_frametime <= 0.0f)
+  {
+    throw std::runtime_error("game.frametime needs to be greater than zero");
+  }
+
+  max_fixed_steps = std::max(game_config["max_fixed_steps"].get_or(5), 1);
+
+  const float max_fps = game_config["max_fps"].get_or(0.0f);
+  min_frame_duration  = max_fps > 0.0f ? 1.0f / max_fps : 0.0f;
 }
 
 void Application::init_application(int /*argc*/, char ** /*argv*/)
@@ -88,6 +110,17 @@ void Application::init_application(int /*argc*/, char ** /*argv*/)
     // Logging system can now setted up
     init_logging();
 
+    // Create job system, 0 worker threads picks a count based on the cores
+    const auto worker_threads = std::max(
+        config_manager->get_config()["game"]["worker_threads"].get_or(0), 0);
+    job_system =
+        std::make_shared<JobSystem>(static_cast<std::size_t>(worker_threads));
+    trace("Application",
+          FMT_STRING("Started job system with {} threads"),
+          job_system->get_thread_count());
+
+    init_main_loop();
+
     // Create resource manager
     resource_manager = std::make_shared<ResourceManager>();
 
@@ -105,7 +138,9 @@ void Application::init_application(int /*argc*/, char ** /*argv*/)
   }
   catch (std::exception &e)
   {
-    error("Application", "Unhandled exception while init: {}", e.what());
+    error("Application",
+          FMT_STRING("Unhandled exception while init: {}"),
+          e.what());
     std::exit(EXIT_FAILURE);
   }
 }
@@ -121,7 +156,9 @@ void Application::terminate_application()
 {
   scene_manager->terminate();
   physic_manager->terminate();
+  resource_manager->terminate();
   graphic_manager->terminate();
+  job_system = nullptr;
   terminate_logger();
 }
 
@@ -133,7 +170,9 @@ int Application::run()
   }
   catch (std::exception &e)
   {
-    error("Application", "Could not init graphic manager: {}", e.what());
+    error("Application",
+          FMT_STRING("Could not init graphic manager: {}"),
+          e.what());
     std::exit(EXIT_FAILURE);
   }
 
@@ -143,7 +182,9 @@ int Application::run()
   }
   catch (std::exception &e)
   {
-    error("Application", "Could not init physic manager: {}", e.what());
+    error("Application",
+          FMT_STRING("Could not init physic manager: {}"),
+          e.what());
     std::exit(EXIT_FAILURE);
   }
 
@@ -153,7 +194,7 @@ int Application::run()
   }
   catch (std::exception &e)
   {
-    error("Application", "Could not init layers: {}", e.what());
+    error("Application", FMT_STRING("Could not init layers: {}"), e.what());
     std::exit(EXIT_FAILURE);
   }
 
@@ -173,34 +214,111 @@ int Application::run()
 
 void Application::main_loop()
 {
-  double last_time = get_current_time_millis() / 1000.0;
+  using Clock        = std::chrono::steady_clock;
+  using Milliseconds = std::chrono::duration<float, std::milli>;
+
+  auto   last_time   = Clock::now();
+  double accumulator = 0.0;
 
   while (!close_app)
   {
-    double current_time = double(get_current_time_millis()) / 1000.0;
-    delta_time          = static_cast<float>(current_time - last_time);
+    const auto frame_start = Clock::now();
+    delta_time = std::chrono::duration<float>(frame_start - last_time).count();
+    last_time  = frame_start;
+
+    // Never try to catch up more than max_fixed_steps ticks per frame,
+    // otherwise a slow frame makes the next one even slower
+    accumulator += delta_time;
+    const double max_accumulated = double(fixed_frametime) * max_fixed_steps;
+    if (accumulator > max_accumulated)
+    {
+      frame_stats.dropped_tick_count +=
+          uint64_t((accumulator - max_accumulated) / fixed_frametime);
+      accumulator = max_accumulated;
+    }
+
+    frame_stats.frame_tick_count = 0;
+    while (accumulator >= fixed_frametime)
+    {
+      fixed_update();
+      accumulator -= fixed_frametime;
+      ++frame_stats.tick_count;
+      ++frame_stats.frame_tick_count;
+    }
+    interpolation_alpha = float(accumulator / fixed_frametime);
+
+    const auto update_start = Clock::now();
+    update();
+
+    const auto render_start = Clock::now();
+    render();
+    const auto render_end = Clock::now();
+
+    frame_stats.fixed_update_time =
+        Milliseconds(update_start - frame_start).count();
+    frame_stats.update_time = Milliseconds(render_start - update_start).count();
+    frame_stats.render_time = Milliseconds(render_end - render_start).count();
+    frame_stats.frame_time  = Milliseconds(render_end - frame_start).count();
+    ++frame_stats.frame_count;
+
+    FGE_PROFILE_END_FRAME();
+
+    // Limit the render rate. The simulation does not care as it only
+    // advances in fixed steps.
+    if (min_frame_duration > 0.0f)
+    {
+      std::this_thread::sleep_until(
+          frame_start + std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<float>(min_frame_duration)));
+    }
+  }
 
-    scene_manager->on_update(delta_time);
-    layer_stack.on_update(delta_time);
-    physic_manager->update(delta_time);
+  terminate_application();
+}
 
-    graphic_manager->begin_render();
+void Application::fixed_update()
+{
+  FGE_PROFILE_SCOPE("Application::fixed_update");
 
-    layer_stack.on_render();
-    physic_manager->render();
+  scene_manager->on_fixed_update(fixed_frametime);
+  layer_stack.on_fixed_update(fixed_frametime);
+  physic_manager->update(fixed_frametime);
+}
+
+void Application::update()
+{
+  FGE_PROFILE_SCOPE("Application::update");
+
+  // Components pick up meshes that got ready this frame in their update
+  resource_manager->process_uploads(resource_upload_budget);
+
+  scene_manager->on_update(delta_time);
+  layer_stack.on_update(delta_time);
+}
+
+void Application::render()
+{
+  FGE_PROFILE_SCOPE("Application::render");
 
+  graphic_manager->begin_render();
+
+  scene_manager->on_render();
+  layer_stack.on_render();
+  physic_manager->render();
+
+  {
+    FGE_PROFILE_SCOPE("Application::imgui_render");
     graphic_manager->begin_imgui_render();
     layer_stack.on_imgui_render();
     graphic_manager->end_imgui_render();
+  }
 
-    graphic_manager->end_render();
+  graphic_manager->end_render();
 
+  {
+    FGE_PROFILE_SCOPE("Application::flush");
     graphic_manager->flush();
-
-    last_time = current_time;
   }
-
-  terminate_application();
 }
 
 void Application::push_layer(std::unique_ptr<Layer> layer)
@@ -4,6 +4,7 @@
 #include "event/event_manager.hpp"
 #include "file/file_manager.hpp"
 #include "graphic/graphic_manager.hpp"
+#include "job/job_system.hpp"
 #include "layer.hpp"
 #include "layer_stack.hpp"
 #include "physic/physic_manager.hpp"
@@ -14,6 +15,23 @@
 namespace Fge
 {
 
+/**
+ * Counters and timings of the main loop. Timings are in milliseconds and
+ * refer to the last frame.
+ */
+struct FrameStats
+{
+  uint64_t frame_count        = 0;
+  uint64_t tick_count         = 0;
+  uint64_t dropped_tick_count = 0;
+  uint32_t frame_tick_count   = 0;
+
+  float fixed_update_time = 0.0f;
+  float update_time       = 0.0f;
+  float render_time       = 0.0f;
+  float frame_time        = 0.0f;
+};
+
 class Application
 {
 public:
@@ -49,10 +67,25 @@ public:
 
   std::shared_ptr<PhysicManager> get_physic_manager() { return physic_manager; }
 
+  std::shared_ptr<JobSystem> get_job_system() { return job_system; }
+
   void close();
 
   float get_delta_time() const { return delta_time; }
 
+  /**
+   * @return Time that one simulation tick advances
+   */
+  float get_fixed_frametime() const { return fixed_frametime; }
+
+  /**
+   * Progress between the last and the next simulation tick in [0, 1). Can be
+   * used to interpolate state that is advanced in fixed steps.
+   */
+  float get_interpolation_alpha() const { return interpolation_alpha; }
+
+  const FrameStats &get_frame_stats() const { return frame_stats; }
+
 private:
   static std::once_flag               instance_created;
   static std::shared_ptr<Application> instance;
@@ -66,11 +99,19 @@ private:
   std::shared_ptr<GraphicManager>  graphic_manager{};
   std::shared_ptr<SceneManager>    scene_manager{};
   std::shared_ptr<PhysicManager>   physic_manager{};
+  std::shared_ptr<JobSystem>       job_system{};
 
   bool close_app = false;
 
   float delta_time = 0.0f;
 
+  float fixed_frametime     = 1.0f / 60.0f;
+  int   max_fixed_steps     = 5;
+  float min_frame_duration  = 0.0f;
+  float interpolation_alpha = 0.0f;
+
+  FrameStats frame_stats{};
+
   Application();
 
   Application(const Application &other) = default;
@@ -82,6 +123,14 @@ private:
   void main_loop();
 
   void init_logging();
+
+  void init_main_loop();
+
+  void fixed_update();
+
+  void update();
+
+  void render();
 };
 
 } // namespace Fge
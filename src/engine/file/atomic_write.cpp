@@ -0,0 +1,42 @@
+#include "atomic_write.hpp"
+
+namespace Fge
+{
+
+void write_file_atomic(const std::filesystem::path &filepath,
+                       const std::vector<uint8_t> & data)
+{
+  // Writers of the same file on other threads must not share the temporary
+  // file, the last rename wins
+  std::ostringstream temp_suffix;
+  temp_suffix << '.' << std::hex
+              << std::hash<std::thread::id>()(std::this_thread::get_id())
+              << ".tmp";
+
+  auto temp_path = filepath;
+  temp_path += temp_suffix.str();
+
+  std::error_code error;
+  std::filesystem::create_directories(filepath.parent_path(), error);
+
+  std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(data.data()),
+             static_cast<std::streamsize>(data.size()));
+  file.close();
+  if (!file)
+  {
+    std::filesystem::remove(temp_path, error);
+    throw std::runtime_error("Could not write file: " + temp_path.string());
+  }
+
+  std::filesystem::rename(temp_path, filepath, error);
+  if (error)
+  {
+    const auto message = error.message();
+    std::filesystem::remove(temp_path, error);
+    throw std::runtime_error("Could not write file: " + filepath.string() +
+                             ": " + message);
+  }
+}
+
+} // namespace Fge
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Writes the file through a temporary file and a rename, so readers never
+ * see a half written file. Creates missing parent directories.
+ *
+ * @throws std::runtime_error If the file can't be written
+ */
+void write_file_atomic(const std::filesystem::path &filepath,
+                       const std::vector<uint8_t> & data);
+
+} // namespace Fge
@@ -0,0 +1,75 @@
+#include "mapped_file.hpp"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+namespace Fge
+{
+
+#ifdef WIN32
+
+MappedFile::MappedFile(const std::filesystem::path &filepath)
+{
+  std::ifstream file(filepath, std::ios::binary);
+  if (!file.is_open())
+  {
+    throw std::runtime_error("Could not open file: " + filepath.string());
+  }
+
+  buffer.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+  data = buffer.data();
+  size = buffer.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#else // WIN32
+
+MappedFile::MappedFile(const std::filesystem::path &filepath)
+{
+  const auto fd = open(filepath.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    throw std::runtime_error("Could not open file: " + filepath.string());
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1)
+  {
+    close(fd);
+    throw std::runtime_error("Could not stat file: " + filepath.string());
+  }
+  size = static_cast<std::size_t>(file_stat.st_size);
+
+  // Mapping zero bytes fails, an empty file is an empty view
+  if (size > 0)
+  {
+    const auto mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+      close(fd);
+      throw std::runtime_error("Could not map file: " + filepath.string());
+    }
+    data = static_cast<const uint8_t *>(mapping);
+  }
+
+  // The mapping stays valid without the descriptor
+  close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data)
+  {
+    munmap(const_cast<uint8_t *>(data), size);
+  }
+}
+
+#endif // WIN32
+
+} // namespace Fge
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Read only view of a whole file. The pages are mapped and only read from
+ * disk when they are touched, so nothing gets copied up front.
+ */
+class MappedFile
+{
+public:
+  /**
+   * @throws std::runtime_error If the file can't be opened or mapped
+   */
+  explicit MappedFile(const std::filesystem::path &filepath);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const uint8_t *get_data() const { return data; }
+
+  std::size_t get_size() const { return size; }
+
+private:
+  const uint8_t *data = nullptr;
+  std::size_t    size = 0;
+
+#ifdef WIN32
+  // Read into memory instead
+  std::vector<uint8_t> buffer;
+#endif // WIN32
+};
+
+} // namespace Fge
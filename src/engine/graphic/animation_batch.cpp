@@ -0,0 +1,81 @@
+#include "animation_batch.hpp"
+#include "profiler/profiler.hpp"
+
+namespace Fge
+{
+
+void AnimationBatch::clear()
+{
+  skeletons.clear();
+  palette_offsets.clear();
+}
+
+std::size_t AnimationBatch::add(Skeleton &skeleton)
+{
+  const auto offset = palette_offsets.empty()
+                          ? std::size_t(0)
+                          : palette_offsets.back() +
+                                skeletons.back()->get_bones_count();
+
+  skeletons.push_back(&skeleton);
+  palette_offsets.push_back(offset);
+
+  return skeletons.size() - 1;
+}
+
+void AnimationBatch::evaluate(
+    double                            current_time_in_seconds,
+    const std::shared_ptr<JobSystem> &job_system)
+{
+  FGE_PROFILE_SCOPE("AnimationBatch::evaluate");
+
+  if (skeletons.empty())
+  {
+    return;
+  }
+
+  // Changes skeleton state, so it stays on the calling thread
+  for (auto skeleton : skeletons)
+  {
+    skeleton->stop_finished_animation(current_time_in_seconds);
+  }
+
+  const auto bones_count =
+      palette_offsets.back() + skeletons.back()->get_bones_count();
+  bone_palette.resize(bones_count);
+  packed_palette.resize(bones_count);
+
+  const auto evaluate_range = [&](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i)
+    {
+      const auto offset     = palette_offsets[i];
+      const auto transforms = bone_palette.data() + offset;
+      skeletons[i]->compute_bone_transforms(current_time_in_seconds,
+                                            transforms);
+
+      // The last row of a bone transform is always (0, 0, 0, 1)
+      for (uint32_t j = 0; j < skeletons[i]->get_bones_count(); ++j)
+      {
+        const auto &transform = transforms[j];
+        auto &      packed    = packed_palette[offset + j];
+        for (int row = 0; row < 3; ++row)
+        {
+          packed.rows[row] = glm::vec4(transform[0][row],
+                                       transform[1][row],
+                                       transform[2][row],
+                                       transform[3][row]);
+        }
+      }
+    }
+  };
+
+  if (!job_system || skeletons.size() <= batch_size)
+  {
+    evaluate_range(0, skeletons.size());
+    return;
+  }
+
+  job_system->parallel_for(skeletons.size(), batch_size, evaluate_range);
+}
+
+} // namespace Fge
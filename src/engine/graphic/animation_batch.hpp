@@ -0,0 +1,94 @@
+#pragma once
+
+#include "frame_uniforms.hpp"
+#include "job/job_system.hpp"
+#include "math/math.hpp"
+#include "skeleton.hpp"
+#include "std.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+/**
+ * Evaluates the poses of many skeletons in one go.
+ *
+ * Every skeleton owns a fixed range of one contiguous bone palette. The
+ * ranges are assigned in the order the skeletons were added, before any
+ * work is split up, and each skeleton is evaluated by exactly one thread
+ * into its own range. The palette is therefore the same for any number of
+ * threads.
+ *
+ * Next to the full matrices the batch keeps the palette in the layout the
+ * shaders read, three rows per bone. It is filled by the same jobs.
+ */
+class AnimationBatch
+{
+public:
+  void clear();
+
+  /**
+   * The skeleton must stay alive until the batch got cleared.
+   *
+   * @return Index of the skeleton in the batch
+   */
+  std::size_t add(Skeleton &skeleton);
+
+  /**
+   * Stops finished animations and writes the bone transforms of all
+   * skeletons at the given time to the palettes.
+   *
+   * @param job_system Spreads the skeletons over its threads. Evaluates on
+   * the calling thread if null.
+   */
+  void evaluate(double                            current_time_in_seconds,
+                const std::shared_ptr<JobSystem> &job_system = {});
+
+  std::size_t get_count() const { return skeletons.size(); }
+
+  /**
+   * First bone transform of the skeleton with the index.
+   */
+  const glm::mat4 *get_bone_transforms(std::size_t index) const
+  {
+    FGE_ASSERT(index < skeletons.size());
+    return bone_palette.data() + palette_offsets[index];
+  }
+
+  /**
+   * Index of the first bone of the skeleton with the index in the palettes.
+   */
+  uint32_t get_first_bone(std::size_t index) const
+  {
+    FGE_ASSERT(index < skeletons.size());
+    return static_cast<uint32_t>(palette_offsets[index]);
+  }
+
+  uint32_t get_bones_count(std::size_t index) const
+  {
+    FGE_ASSERT(index < skeletons.size());
+    return skeletons[index]->get_bones_count();
+  }
+
+  const std::vector<glm::mat4> &get_bone_palette() const
+  {
+    return bone_palette;
+  }
+
+  const std::vector<BoneUniforms> &get_packed_palette() const
+  {
+    return packed_palette;
+  }
+
+private:
+  // Skeletons per job. Most skeletons have a few dozen bones, so a batch
+  // of this size is worth more than the scheduling.
+  static constexpr std::size_t batch_size = 16;
+
+  std::vector<Skeleton *>   skeletons;
+  std::vector<std::size_t>  palette_offsets;
+  std::vector<glm::mat4>    bone_palette;
+  std::vector<BoneUniforms> packed_palette;
+};
+
+} // namespace Fge
@@ -0,0 +1,429 @@
+#include "compiled_animation.hpp"
+
+namespace Fge
+{
+
+namespace
+{
+
+// Components other than the largest one are at most 1/sqrt(2)
+constexpr float rotation_component_max = 0.70710678f;
+constexpr float rotation_steps         = 32767.0f;
+constexpr float vector_steps           = 65535.0f;
+
+constexpr float rotation_epsilon = 1.0e-6f;
+constexpr float vector_epsilon   = 1.0e-5f;
+
+/**
+ * Interpolates between the keys around the time. Times outside the keys
+ * get the first or last key.
+ */
+template <typename TKey, typename TValue, typename TLerp>
+TValue sample_keys(const std::vector<TKey> &keys,
+                   TValue TKey::*           value,
+                   double                   time,
+                   TLerp                    lerp)
+{
+  FGE_ASSERT(!keys.empty());
+
+  if (time <= keys.front().time)
+  {
+    return keys.front().*value;
+  }
+  if (time >= keys.back().time)
+  {
+    return keys.back().*value;
+  }
+
+  const auto next_iter = std::upper_bound(
+      keys.begin(), keys.end(), time, [](double time, const TKey &key) {
+        return time < key.time;
+      });
+  const auto &next     = *next_iter;
+  const auto &previous = *(next_iter - 1);
+
+  const auto factor =
+      static_cast<float>((time - previous.time) / (next.time - previous.time));
+  return lerp(previous.*value, next.*value, factor);
+}
+
+glm::quat nlerp(const glm::quat &start, glm::quat end, float factor)
+{
+  // Take the short way around
+  if (glm::dot(start, end) < 0.0f)
+  {
+    end = -end;
+  }
+
+  return glm::normalize(start * (1.0f - factor) + end * factor);
+}
+
+glm::vec3 lerp(const glm::vec3 &start, const glm::vec3 &end, float factor)
+{
+  return start + (end - start) * factor;
+}
+
+void encode_rotation(const glm::quat &rotation, uint16_t *result)
+{
+  const float components[4]{rotation.x, rotation.y, rotation.z, rotation.w};
+
+  int largest = 0;
+  for (int i = 1; i < 4; ++i)
+  {
+    if (std::abs(components[i]) > std::abs(components[largest]))
+    {
+      largest = i;
+    }
+  }
+
+  // q and -q are the same rotation, so the left out component can be
+  // assumed to be positive
+  const auto sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+  // Two bits index of the left out component, then 15 bits per component
+  uint64_t packed = static_cast<uint64_t>(largest);
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+    {
+      continue;
+    }
+
+    const auto value = std::clamp(
+        sign * components[i] / rotation_component_max, -1.0f, 1.0f);
+    packed = (packed << 15) |
+             static_cast<uint64_t>(
+                 std::lround((value + 1.0f) * 0.5f * rotation_steps));
+  }
+
+  result[0] = static_cast<uint16_t>(packed >> 32);
+  result[1] = static_cast<uint16_t>(packed >> 16);
+  result[2] = static_cast<uint16_t>(packed);
+}
+
+glm::quat decode_rotation(const uint16_t *data)
+{
+  const auto packed = (static_cast<uint64_t>(data[0]) << 32) |
+                      (static_cast<uint64_t>(data[1]) << 16) |
+                      static_cast<uint64_t>(data[2]);
+
+  const auto largest = static_cast<int>(packed >> 45) & 3;
+
+  float components[4]{};
+  float sum   = 0.0f;
+  int   shift = 30;
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i == largest)
+    {
+      continue;
+    }
+
+    const auto value =
+        static_cast<float>((packed >> shift) & 0x7fff) / rotation_steps;
+    components[i] = (value * 2.0f - 1.0f) * rotation_component_max;
+    sum += components[i] * components[i];
+    shift -= 15;
+  }
+  components[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+  return glm::quat(components[3], components[0], components[1], components[2]);
+}
+
+bool is_constant(const std::vector<glm::quat> &rotations)
+{
+  return std::all_of(
+      rotations.begin(), rotations.end(), [&](const glm::quat &rotation) {
+        return std::abs(glm::dot(rotations.front(), rotation)) >=
+               1.0f - rotation_epsilon;
+      });
+}
+
+bool is_constant(const std::vector<glm::vec3> &vectors)
+{
+  return std::all_of(
+      vectors.begin(), vectors.end(), [&](const glm::vec3 &vector) {
+        const auto difference = glm::abs(vector - vectors.front());
+        return std::max({difference.x, difference.y, difference.z}) <=
+               vector_epsilon;
+      });
+}
+
+} // namespace
+
+CompiledAnimation::CompiledAnimation(const Animation &animation,
+                                     double           sample_rate)
+    : name(animation.get_name()),
+      duration(animation.get_duration()),
+      ticks_per_second(animation.get_ticks_per_second())
+{
+  FGE_ASSERT(sample_rate > 0.0);
+
+  // Same default as the skeleton uses for playback
+  const auto ticks = ticks_per_second != 0 ? ticks_per_second : 25.0;
+
+  // At least two frames, so there always is a frame after the first one
+  const auto intervals =
+      std::max(1.0, std::ceil(duration / ticks * sample_rate));
+  frame_count    = static_cast<uint32_t>(intervals) + 1;
+  frame_interval = duration / intervals;
+
+  struct ResampledTrack
+  {
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> translations;
+    std::vector<glm::vec3> scales;
+  };
+
+  std::vector<ResampledTrack> resampled_tracks;
+
+  const auto &animation_tracks = animation.get_tracks();
+  tracked_bones.resize(animation_tracks.size(), 0);
+
+  for (std::size_t i = 0; i < animation_tracks.size(); ++i)
+  {
+    if (!animation_tracks[i].has_value())
+    {
+      continue;
+    }
+    const auto &animation_track = animation_tracks[i].value();
+
+    ResampledTrack resampled{};
+    for (uint32_t frame = 0; frame < frame_count; ++frame)
+    {
+      const auto time = frame * frame_interval;
+
+      resampled.rotations.push_back(
+          sample_keys(animation_track.bone_rotation,
+                      &Animation::BoneRotation::rotation,
+                      time,
+                      [](const glm::quat &start,
+                         const glm::quat &end,
+                         float            factor) {
+                        return glm::normalize(glm::slerp(start, end, factor));
+                      }));
+      resampled.translations.push_back(
+          sample_keys(animation_track.bone_translation,
+                      &Animation::BoneTranslation::position,
+                      time,
+                      lerp));
+      resampled.scales.push_back(sample_keys(animation_track.bone_scaling,
+                                             &Animation::BoneScaling::scale,
+                                             time,
+                                             lerp));
+    }
+
+    // Channels that change get a place in the frame, the others a constant
+    Track track{};
+    track.bone_index = static_cast<uint32_t>(i);
+
+    if (is_constant(resampled.rotations))
+    {
+      track.rotation = static_cast<uint32_t>(constant_rotations.size());
+      constant_rotations.push_back(resampled.rotations.front());
+    }
+    else
+    {
+      track.animated_flags |= rotation_animated;
+      track.rotation = frame_stride;
+      frame_stride += 3;
+    }
+
+    const auto add_vector_channel = [&](const std::vector<glm::vec3> &vectors,
+                                        uint8_t   animated_flag,
+                                        uint32_t &channel) {
+      if (is_constant(vectors))
+      {
+        channel = static_cast<uint32_t>(constant_vectors.size());
+        constant_vectors.push_back(vectors.front());
+        return;
+      }
+
+      QuantizedRange range{};
+      range.min = vectors.front();
+      auto max  = vectors.front();
+      for (const auto &vector : vectors)
+      {
+        range.min = glm::min(range.min, vector);
+        max       = glm::max(max, vector);
+      }
+      range.step   = (max - range.min) / vector_steps;
+      range.offset = frame_stride;
+      frame_stride += 3;
+
+      track.animated_flags |= animated_flag;
+      channel = static_cast<uint32_t>(ranges.size());
+      ranges.push_back(range);
+    };
+
+    add_vector_channel(
+        resampled.translations, translation_animated, track.translation);
+    add_vector_channel(resampled.scales, scale_animated, track.scale);
+
+    tracks.push_back(track);
+    tracked_bones[i] = 1;
+    resampled_tracks.push_back(std::move(resampled));
+  }
+
+  // Interleave the animated channels of all tracks per frame
+  frames.resize(static_cast<std::size_t>(frame_count) * frame_stride);
+
+  const auto encode_vector = [](const QuantizedRange &range,
+                                const glm::vec3 &     vector,
+                                uint16_t *            result) {
+    for (int i = 0; i < 3; ++i)
+    {
+      result[i] =
+          range.step[i] > 0.0f
+              ? static_cast<uint16_t>(std::lround(
+                    std::clamp((vector[i] - range.min[i]) / range.step[i],
+                               0.0f,
+                               vector_steps)))
+              : uint16_t(0);
+    }
+  };
+
+  for (uint32_t frame = 0; frame < frame_count; ++frame)
+  {
+    const auto frame_data = frames.data() + frame * frame_stride;
+
+    for (std::size_t i = 0; i < tracks.size(); ++i)
+    {
+      const auto &track     = tracks[i];
+      const auto &resampled = resampled_tracks[i];
+
+      if (track.animated_flags & rotation_animated)
+      {
+        encode_rotation(resampled.rotations[frame],
+                        frame_data + track.rotation);
+      }
+      if (track.animated_flags & translation_animated)
+      {
+        const auto &range = ranges[track.translation];
+        encode_vector(range,
+                      resampled.translations[frame],
+                      frame_data + range.offset);
+      }
+      if (track.animated_flags & scale_animated)
+      {
+        const auto &range = ranges[track.scale];
+        encode_vector(
+            range, resampled.scales[frame], frame_data + range.offset);
+      }
+    }
+  }
+}
+
+void CompiledAnimation::sample(double     time_in_ticks,
+                               glm::mat4 *local_transforms) const
+{
+  // Frames around the time
+  const auto position =
+      frame_interval > 0.0
+          ? std::clamp(time_in_ticks / frame_interval,
+                       0.0,
+                       static_cast<double>(frame_count - 1))
+          : 0.0;
+  const auto frame =
+      std::min(static_cast<uint32_t>(position), frame_count - 2);
+  const auto factor = static_cast<float>(position - frame);
+
+  const auto frame0 = frames.data() + frame * frame_stride;
+  const auto frame1 = frame0 + frame_stride;
+
+  const auto decode_vector = [](const QuantizedRange &range,
+                                const uint16_t *      data) {
+    return range.min + range.step * glm::vec3(data[0], data[1], data[2]);
+  };
+
+  const auto sample_vector = [&](uint32_t channel, bool animated) {
+    if (!animated)
+    {
+      return constant_vectors[channel];
+    }
+
+    const auto &range = ranges[channel];
+    return lerp(decode_vector(range, frame0 + range.offset),
+                decode_vector(range, frame1 + range.offset),
+                factor);
+  };
+
+  for (const auto &track : tracks)
+  {
+    const auto rotation =
+        track.animated_flags & rotation_animated
+            ? nlerp(decode_rotation(frame0 + track.rotation),
+                    decode_rotation(frame1 + track.rotation),
+                    factor)
+            : constant_rotations[track.rotation];
+    const auto translation = sample_vector(
+        track.translation, track.animated_flags & translation_animated);
+    const auto scale =
+        sample_vector(track.scale, track.animated_flags & scale_animated);
+
+    // Same as translate * rotate * scale, without the matrix products
+    auto &transform = local_transforms[track.bone_index];
+    transform       = glm::toMat4(rotation);
+    transform[0] *= scale.x;
+    transform[1] *= scale.y;
+    transform[2] *= scale.z;
+    transform[3] = glm::vec4(translation, 1.0f);
+  }
+}
+
+std::size_t CompiledAnimation::get_memory_size() const
+{
+  return tracks.size() * sizeof(Track) + tracked_bones.size() +
+         constant_rotations.size() * sizeof(glm::quat) +
+         constant_vectors.size() * sizeof(glm::vec3) +
+         ranges.size() * sizeof(QuantizedRange) +
+         frames.size() * sizeof(uint16_t);
+}
+
+void CompiledAnimation::write(BinaryWriter &writer) const
+{
+  writer.write_string(name);
+  writer.write(duration);
+  writer.write(ticks_per_second);
+  writer.write(frame_count);
+  writer.write(frame_interval);
+  writer.write(frame_stride);
+
+  writer.write_vector(tracks);
+  writer.write_vector(tracked_bones);
+  writer.write_vector(constant_rotations);
+  writer.write_vector(constant_vectors);
+  writer.write_vector(ranges);
+  writer.write_vector(frames);
+}
+
+CompiledAnimation CompiledAnimation::read(BinaryReader &reader)
+{
+  CompiledAnimation animation;
+  animation.name             = reader.read_string();
+  animation.duration         = reader.read<double>();
+  animation.ticks_per_second = reader.read<double>();
+  animation.frame_count      = reader.read<uint32_t>();
+  animation.frame_interval   = reader.read<double>();
+  animation.frame_stride     = reader.read<uint32_t>();
+
+  animation.tracks             = reader.read_vector<Track>();
+  animation.tracked_bones      = reader.read_vector<uint8_t>();
+  animation.constant_rotations = reader.read_vector<glm::quat>();
+  animation.constant_vectors   = reader.read_vector<glm::vec3>();
+  animation.ranges             = reader.read_vector<QuantizedRange>();
+  animation.frames             = reader.read_vector<uint16_t>();
+
+  // Sampling reads two frames
+  if (animation.frame_count < 2 ||
+      animation.frames.size() !=
+          static_cast<std::size_t>(animation.frame_count) *
+              animation.frame_stride)
+  {
+    throw std::runtime_error("Compiled animation has broken frames");
+  }
+
+  return animation;
+}
+
+} // namespace Fge
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "animation.hpp"
+#include "math/math.hpp"
+#include "std.hpp"
+#include "util/assert.hpp"
+#include "util/binary_stream.hpp"
+
+namespace Fge
+{
+
+/**
+ * Animation clip in the format used for playback.
+ *
+ * All tracks are resampled at a fixed rate, so the frames around a time are
+ * found with one division instead of a search through the keys. Channels
+ * that do not change are stored once. The animated channels of all tracks
+ * are interleaved per frame, so sampling reads two short runs of memory:
+ *
+ * - Rotations take 48 bits. The largest component is left out and restored
+ *   from the unit length, the other three get 15 bits each.
+ * - Translations and scales take 16 bits per component, relative to the
+ *   range the channel covers.
+ */
+class CompiledAnimation
+{
+public:
+  static constexpr double default_sample_rate = 30.0;
+
+  /**
+   * @param sample_rate Frames per second of animation time
+   */
+  explicit CompiledAnimation(
+      const Animation &animation,
+      double           sample_rate = default_sample_rate);
+
+  const std::string &get_name() const { return name; }
+
+  double get_duration() const { return duration; }
+
+  double get_ticks_per_second() const { return ticks_per_second; }
+
+  uint32_t get_frame_count() const { return frame_count; }
+
+  bool has_track(unsigned bone_index) const
+  {
+    return bone_index < tracked_bones.size() && tracked_bones[bone_index];
+  }
+
+  /**
+   * Writes the local transform of every bone with a track. Entries of other
+   * bones are left as they are.
+   *
+   * @param time_in_ticks Clamped to the duration
+   */
+  void sample(double time_in_ticks, glm::mat4 *local_transforms) const;
+
+  /**
+   * Bytes used by the tracks and frames, without the name.
+   */
+  std::size_t get_memory_size() const;
+
+  /**
+   * Stores the clip as it is, read() restores it without resampling.
+   */
+  void write(BinaryWriter &writer) const;
+
+  static CompiledAnimation read(BinaryReader &reader);
+
+private:
+  static constexpr uint8_t rotation_animated    = 1 << 0;
+  static constexpr uint8_t translation_animated = 1 << 1;
+  static constexpr uint8_t scale_animated       = 1 << 2;
+
+  struct Track
+  {
+    uint32_t bone_index{};
+
+    // Animated rotations: offset in a frame. Animated translations and
+    // scales: index of their range. Constant channels: index of the
+    // constant.
+    uint32_t rotation{};
+    uint32_t translation{};
+    uint32_t scale{};
+
+    uint8_t animated_flags{};
+  };
+
+  struct QuantizedRange
+  {
+    glm::vec3 min{};
+    glm::vec3 step{};
+
+    // Offset in a frame
+    uint32_t offset{};
+  };
+
+  std::string name;
+  double      duration{};
+  double      ticks_per_second{};
+
+  uint32_t frame_count = 1;
+  double   frame_interval{};
+
+  std::vector<Track>          tracks;
+  std::vector<uint8_t>        tracked_bones;
+  std::vector<glm::quat>      constant_rotations;
+  std::vector<glm::vec3>      constant_vectors;
+  std::vector<QuantizedRange> ranges;
+
+  // Animated channels of all tracks, frame after frame
+  uint32_t              frame_stride = 0;
+  std::vector<uint16_t> frames;
+
+  CompiledAnimation() = default;
+};
+
+} // namespace Fge
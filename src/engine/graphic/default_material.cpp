@@ -6,17 +6,45 @@
 namespace Fge
 {
 
-DefaultMaterial::DefaultMaterial() : MeshMaterial("Default Material") {}
+DefaultMaterial::DefaultMaterial() : MeshMaterial("Default Material")
+{
+  init_uniform_handles();
+}
+
+void DefaultMaterial::init_uniform_handles()
+{
+  world_mat_handle  = get_uniform_handle<glm::mat4>("world_mat");
+  first_bone_handle = get_uniform_handle<int32_t>("first_bone");
+
+  // The instanced shader reads the world matrix from a vertex attribute
+  uniforms.set_per_instance(world_mat_handle);
+  // Differs per skinned mesh, the bone palette itself is shared
+  uniforms.set_per_instance(first_bone_handle);
+}
 
 void DefaultMaterial::bind(uint32_t texture_bind_point)
+{
+  bind_uniforms(get_shader(), texture_bind_point);
+}
+
+std::shared_ptr<Shader> DefaultMaterial::get_shader()
+{
+  if (shader_changed)
+  {
+    regenerate_shader();
+  }
+
+  return shader;
+}
+
+std::shared_ptr<Shader> DefaultMaterial::get_instanced_shader()
 {
   if (shader_changed)
   {
     regenerate_shader();
   }
 
-  shader->bind();
-  bind_uniforms(shader, texture_bind_point);
+  return instanced_shader;
 }
 
 void DefaultMaterial::set_skinned_mesh(bool value)
@@ -32,12 +60,12 @@ void DefaultMaterial::set_rigid_mesh(bool /*value*/) {}
 
 void DefaultMaterial::set_world_matrix(const glm::mat4 &world_mat)
 {
-  set_uniform("world_mat", world_mat);
+  set_uniform(world_mat_handle, world_mat);
 }
 
-void DefaultMaterial::set_bone_transforms(const std::vector<glm::mat4> &bones)
+void DefaultMaterial::set_first_bone(uint32_t first_bone)
 {
-  set_uniform("bones", bones);
+  set_uniform(first_bone_handle, static_cast<int32_t>(first_bone));
 }
 
 void DefaultMaterial::set_ambient_texture(std::shared_ptr<Texture2D> tex)
@@ -81,9 +109,21 @@ void DefaultMaterial::regenerate_shader()
   auto app      = Application::get_instance();
   auto renderer = app->get_graphic_manager()->get_renderer();
 
-  shader         = renderer->create_shader("blinn_phong.vert",
+  shader = renderer->create_shader("blinn_phong.vert",
                                    "blinn_phong.frag",
                                    shader_defines);
+
+  // Bones differ per instance, so skinned meshes are not instanced
+  instanced_shader = nullptr;
+  if (!shader_defines_contains("SKINNED"))
+  {
+    auto instanced_defines = shader_defines;
+    instanced_defines.push_back("INSTANCED");
+    instanced_shader = renderer->create_shader("blinn_phong.vert",
+                                               "blinn_phong.frag",
+                                               instanced_defines);
+  }
+
   shader_changed = false;
 }
 
@@ -91,18 +131,14 @@ std::shared_ptr<Material> DefaultMaterial::clone()
 {
   auto new_material = std::make_shared<DefaultMaterial>();
 
-  new_material->set_world_matrix(glm::mat4(1.0f));
-
   for (const auto &define : shader_defines)
   {
     new_material->shader_defines.push_back(define);
   }
 
-  for (const auto &uniform : uniforms)
-  {
-    auto new_uniform = uniform->clone();
-    new_material->uniforms.push_back(new_uniform);
-  }
+  new_material->uniforms = uniforms;
+  new_material->init_uniform_handles();
+  new_material->set_world_matrix(glm::mat4(1.0f));
 
   return new_material;
 }
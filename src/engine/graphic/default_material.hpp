@@ -15,13 +15,17 @@ public:
 
   void bind(uint32_t texture_bind_point = 0) override;
 
+  std::shared_ptr<Shader> get_shader() override;
+
+  std::shared_ptr<Shader> get_instanced_shader() override;
+
   void set_skinned_mesh(bool value) override;
 
   void set_rigid_mesh(bool value) override;
 
   void set_world_matrix(const glm::mat4 &world_mat) override;
 
-  void set_bone_transforms(const std::vector<glm::mat4> &bones) override;
+  void set_first_bone(uint32_t first_bone) override;
 
   void set_ambient_texture(std::shared_ptr<Texture2D> tex);
 
@@ -35,11 +39,17 @@ public:
 
 private:
   std::shared_ptr<Shader> shader;
+  std::shared_ptr<Shader> instanced_shader;
 
   std::vector<std::string> shader_defines;
 
   bool shader_changed = true;
 
+  UniformHandle world_mat_handle  = invalid_uniform_handle;
+  UniformHandle first_bone_handle = invalid_uniform_handle;
+
+  void init_uniform_handles();
+
   void regenerate_shader();
 
   bool shader_defines_contains(const std::string &define);
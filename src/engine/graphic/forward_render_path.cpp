@@ -1,70 +1,286 @@
-#include <fmt/core.h>
-
-#include "application.hpp"
 #include "forward_render_path.hpp"
-#include "glm/gtx/string_cast.hpp"
-#include "graphic/directional_light.hpp"
+#include "application.hpp"
 #include "graphic/material.hpp"
-#include "graphic/point_light.hpp"
-#include "log/log.hpp"
-#include <vector>
-
-// This value must be the same like in the corresponding shaders
-#define MAX_POINT_LIGHTS_COUNT 5
+#include "profiler/profiler.hpp"
 
 namespace Fge
 {
 
-void ForwardRenderPath::set_lightning_uniforms(
-    Material &                                      material,
-    const std::vector<std::shared_ptr<PointLight>> &point_lights)
+namespace
+{
+
+// Screen space error in pixels a LOD may have at a LOD bias of one
+constexpr float lod_error_pixels = 1.0f;
+
+} // namespace
+
+ForwardRenderPath::ForwardRenderPath(float lod_bias)
+    : lod_bias(lod_bias)
+{
+}
+
+void ForwardRenderPath::init_uniform_buffers(Renderer &renderer)
+{
+  if (camera_uniform_buffer)
+  {
+    return;
+  }
+
+  camera_uniform_buffer =
+      renderer.create_uniform_buffer(sizeof(CameraUniforms));
+  light_uniform_buffer = renderer.create_uniform_buffer(sizeof(LightUniforms));
+}
+
+void ForwardRenderPath::update_camera_uniforms(const glm::mat4 & projection_mat,
+                                               const CameraInfo &camera_info)
+{
+  camera_uniforms.projection_mat = projection_mat;
+  camera_uniforms.view_mat       = camera_info.view_mat;
+  camera_uniforms.position       = glm::vec4(camera_info.position, 1.0f);
+
+  camera_uniform_buffer->set_data(camera_uniforms);
+  camera_uniform_buffer->bind(camera_uniforms_binding);
+}
+
+void ForwardRenderPath::update_light_uniforms(
+    const glm::mat4 &                                     view_mat,
+    const std::vector<std::shared_ptr<PointLight>> &      point_lights,
+    const std::vector<std::shared_ptr<DirectionalLight>> &directional_lights)
 {
+  // Shading happens in view space, so the lights get transformed once here
+  // instead of once per fragment
   int32_t point_light_count = 0;
-  for (uint32_t i = 0; i < point_lights.size() && i < MAX_POINT_LIGHTS_COUNT;
-       ++i)
+  for (const auto &point_light : point_lights)
   {
-    material.set_uniform(
-        fmt::format("point_lights[{}].position", static_cast<int32_t>(i)),
-        point_lights[i]->position);
-    material.set_uniform(
-        fmt::format("point_lights[{}].ambient_color", static_cast<int32_t>(i)),
-        point_lights[i]->ambient_color);
-    material.set_uniform(
-        fmt::format("point_lights[{}].diffuse_color", static_cast<int32_t>(i)),
-        point_lights[i]->diffuse_color);
-    material.set_uniform(
-        fmt::format("point_lights[{}].specular_color", static_cast<int32_t>(i)),
-        point_lights[i]->specular_color);
+    if (point_light_count == max_point_light_count)
+    {
+      break;
+    }
+
+    auto &uniforms          = light_uniforms.point_lights[point_light_count];
+    uniforms.position       = view_mat * glm::vec4(point_light->position, 1.0f);
+    uniforms.ambient_color  = glm::vec4(point_light->ambient_color, 1.0f);
+    uniforms.diffuse_color  = glm::vec4(point_light->diffuse_color, 1.0f);
+    uniforms.specular_color = glm::vec4(point_light->specular_color, 1.0f);
 
     ++point_light_count;
   }
+  light_uniforms.point_light_count = point_light_count;
+
+  light_uniforms.directional_light_enabled = !directional_lights.empty();
+  if (!directional_lights.empty())
+  {
+    const auto &directional_light = directional_lights[0];
+    auto &      uniforms          = light_uniforms.directional_light;
 
-  material.set_uniform("point_light_count", point_light_count);
+    uniforms.direction =
+        glm::vec4(glm::mat3(view_mat) * directional_light->direction, 0.0f);
+    uniforms.ambient_color = glm::vec4(directional_light->ambient_color, 1.0f);
+    uniforms.diffuse_color = glm::vec4(directional_light->diffuse_color, 1.0f);
+    uniforms.specular_color =
+        glm::vec4(directional_light->specular_color, 1.0f);
+  }
+
+  light_uniform_buffer->set_data(light_uniforms);
+  light_uniform_buffer->bind(light_uniforms_binding);
 }
 
-void ForwardRenderPath::set_lightning_uniforms(
-    Material &                                            material,
-    const std::vector<std::shared_ptr<DirectionalLight>> &directional_lights)
+void ForwardRenderPath::cull(
+    const std::vector<std::shared_ptr<RenderInfo>> &renderables,
+    const Frustum &                                 frustum)
 {
-  if (directional_lights.size() == 0)
+  FGE_PROFILE_SCOPE("ForwardRenderPath::cull");
+
+  visible_renderables.clear();
+  bounded_renderables.clear();
+  bounding_spheres.clear();
+
+  for (const auto &renderable : renderables)
   {
-    material.set_uniform("directional_light_enabled", false);
-    return;
+    if (renderable->has_bounds())
+    {
+      bounded_renderables.push_back(renderable.get());
+      bounding_spheres.push(renderable->get_world_bounds().sphere);
+    }
+    else
+    {
+      visible_renderables.push_back(renderable.get());
+    }
   }
 
-  material.set_uniform("directional_light.direction",
-                       directional_lights[0]->direction);
+  // Spheres first, four at a time. The tighter box test only runs for the
+  // spheres that intersect.
+  frustum.intersects(bounding_spheres, sphere_visibility);
 
-  material.set_uniform("directional_light.ambient_color",
-                       directional_lights[0]->ambient_color);
+  for (std::size_t i = 0; i < bounded_renderables.size(); ++i)
+  {
+    auto renderable = bounded_renderables[i];
+    if (sphere_visibility[i] &&
+        frustum.intersects(renderable->get_world_bounds().aabb))
+    {
+      visible_renderables.push_back(renderable);
+    }
+  }
+}
+
+void ForwardRenderPath::select_lods(Renderer &        renderer,
+                                    const glm::mat4 & projection_mat,
+                                    const CameraInfo &camera_info,
+                                    uint32_t          height)
+{
+  FGE_PROFILE_SCOPE("ForwardRenderPath::select_lods");
 
-  material.set_uniform("directional_light.diffuse_color",
-                       directional_lights[0]->diffuse_color);
+  const auto projection_scale =
+      projection_mat[1][1] * static_cast<float>(height) * 0.5f;
+  const auto max_error_pixels = lod_error_pixels * lod_bias;
 
-  material.set_uniform("directional_light.specular_color",
-                       directional_lights[0]->specular_color);
+  uint32_t full_detail_triangle_count = 0;
+  uint32_t triangle_count             = 0;
+  for (auto renderable : visible_renderables)
+  {
+    if (!renderable->get_lods().empty() && renderable->has_bounds())
+    {
+      const auto projected_radius =
+          get_projected_radius(renderable->get_world_bounds().sphere,
+                               camera_info.position,
+                               projection_scale);
+      renderable->set_current_lod(select_lod(renderable->get_lods(),
+                                             renderable->get_current_lod(),
+                                             projected_radius,
+                                             max_error_pixels));
+    }
 
-  material.set_uniform("directional_light_enabled", true);
+    if (renderable->get_draw_mode() == DrawMode::TRIANGLES)
+    {
+      full_detail_triangle_count +=
+          renderable->get_full_detail_index_count() / 3;
+      triangle_count += renderable->get_index_count() / 3;
+    }
+  }
+
+  renderer.add_lod_result(full_detail_triangle_count, triangle_count);
+}
+
+void ForwardRenderPath::fill_render_queue(const glm::mat4 &view_mat)
+{
+  render_queue.clear();
+
+  for (auto renderable : visible_renderables)
+  {
+    auto &     material = *renderable->get_material();
+    const auto position = view_mat * renderable->get_world_matrix()[3];
+
+    // Instances of a material are separate materials with equal values. Sort
+    // them by their values instead of their id, so they end up next to each
+    // other.
+    auto     shader      = material.get_instanced_shader();
+    uint32_t material_id = 0;
+    if (shader && renderable->get_index_buffer())
+    {
+      material_id = material.get_instancing_hash();
+    }
+    else
+    {
+      shader      = material.get_shader();
+      material_id = material.get_id();
+    }
+
+    // The camera looks down the negative z axis
+    const auto sort_key =
+        RenderQueue::make_sort_key(shader->get_id(),
+                                   material_id,
+                                   renderable->get_vertex_array()->get_id(),
+                                   -position.z);
+
+    render_queue.push(sort_key, *renderable);
+  }
+
+  render_queue.sort();
+}
+
+bool ForwardRenderPath::can_draw_instanced(RenderInfo &first,
+                                           RenderInfo &other)
+{
+  return first.get_index_buffer() &&
+         first.get_vertex_array() == other.get_vertex_array() &&
+         first.get_index_buffer() == other.get_index_buffer() &&
+         first.get_first_index() == other.get_first_index() &&
+         first.get_index_count() == other.get_index_count() &&
+         first.get_draw_mode() == other.get_draw_mode() &&
+         first.get_material()->is_instance_compatible(*other.get_material());
+}
+
+void ForwardRenderPath::build_draw_batches()
+{
+  draw_batches.clear();
+  instance_world_mats.clear();
+
+  const auto &commands = render_queue.get_commands();
+
+  std::size_t begin = 0;
+  while (begin < commands.size())
+  {
+    auto &first = *commands[begin].render_info;
+
+    auto end = begin + 1;
+    while (end < commands.size() &&
+           can_draw_instanced(first, *commands[end].render_info))
+    {
+      ++end;
+    }
+
+    const auto count = static_cast<uint32_t>(end - begin);
+    if (count == 1)
+    {
+      draw_batches.push_back({&first, 0, 0});
+    }
+    else
+    {
+      const auto first_instance =
+          static_cast<uint32_t>(instance_world_mats.size());
+      for (auto i = begin; i < end; ++i)
+      {
+        instance_world_mats.push_back(
+            commands[i].render_info->get_world_matrix());
+      }
+      draw_batches.push_back({&first, first_instance, count});
+    }
+
+    begin = end;
+  }
+}
+
+void ForwardRenderPath::draw(Renderer &renderer, const DrawBatch &draw_batch)
+{
+  auto renderable = draw_batch.render_info;
+  auto material   = renderable->get_material();
+
+  if (draw_batch.instance_count > 0)
+  {
+    renderer.draw_instanced(*renderable->get_vertex_array(),
+                            *renderable->get_index_buffer(),
+                            *material,
+                            renderable->get_draw_mode(),
+                            renderable->get_first_index(),
+                            renderable->get_index_count(),
+                            draw_batch.first_instance,
+                            draw_batch.instance_count);
+  }
+  else if (renderable->get_index_buffer())
+  {
+    renderer.draw(*renderable->get_vertex_array(),
+                  *renderable->get_index_buffer(),
+                  *material,
+                  renderable->get_draw_mode(),
+                  renderable->get_first_index(),
+                  renderable->get_index_count());
+  }
+  else
+  {
+    renderer.draw(*renderable->get_vertex_array(),
+                  *material,
+                  renderable->get_draw_mode());
+  }
 }
 
 void ForwardRenderPath::render(const glm::mat4 & projection_mat,
@@ -72,41 +288,43 @@ void ForwardRenderPath::render(const glm::mat4 & projection_mat,
                                uint32_t          width,
                                uint32_t          height)
 {
+  FGE_PROFILE_SCOPE("ForwardRenderPath::render");
+
   auto app             = Application::get_instance();
   auto graphic_manager = app->get_graphic_manager();
   auto renderer        = graphic_manager->get_renderer();
 
+  init_uniform_buffers(*renderer);
+
   renderer->clear_color();
   renderer->clear_depth();
   renderer->set_viewport(0, 0, width, height);
 
-  const auto &renderables        = renderer->get_renderables();
-  const auto &point_lights       = renderer->get_point_lights();
-  const auto &directional_lights = renderer->get_directional_lights();
+  // Per frame data goes to the GPU once. Per draw only the world matrix,
+  // which is part of the material, remains.
+  update_camera_uniforms(projection_mat, camera_info);
+  update_light_uniforms(camera_info.view_mat,
+                        renderer->get_point_lights(),
+                        renderer->get_directional_lights());
 
-  const auto view_mat = camera_info.view_mat;
+  const auto &renderables = renderer->get_renderables();
+  cull(renderables, Frustum(projection_mat * camera_info.view_mat));
+  renderer->add_culling_result(
+      static_cast<uint32_t>(visible_renderables.size()),
+      static_cast<uint32_t>(renderables.size() - visible_renderables.size()));
 
-  for (auto renderable : renderables)
-  {
-    auto material = renderable->get_material();
-    material->set_uniform("projection_mat", projection_mat);
-    material->set_uniform("view_mat", view_mat);
-    set_lightning_uniforms(*material, point_lights);
-    set_lightning_uniforms(*material, directional_lights);
+  select_lods(*renderer, projection_mat, camera_info, height);
 
-    if (renderable->get_index_buffer())
-    {
-      renderer->draw(*renderable->get_vertex_array(),
-                     *renderable->get_index_buffer(),
-                     *material,
-                     renderable->get_draw_mode());
-    }
-    else
-    {
-      renderer->draw(*renderable->get_vertex_array(),
-                     *material,
-                     renderable->get_draw_mode());
-    }
+  fill_render_queue(camera_info.view_mat);
+
+  // Renderables that share a mesh and equal material values become one
+  // instanced draw. Their world matrices go to the GPU in one upload.
+  build_draw_batches();
+  renderer->upload_instance_data(instance_world_mats);
+
+  for (const auto &draw_batch : draw_batches)
+  {
+    draw(*renderer, draw_batch);
   }
 }
 
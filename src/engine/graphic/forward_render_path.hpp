@@ -1,8 +1,12 @@
 #pragma once
 
 #include "graphic/directional_light.hpp"
-#include "graphic/material.hpp"
+#include "graphic/frame_uniforms.hpp"
 #include "graphic/point_light.hpp"
+#include "graphic/render_queue.hpp"
+#include "graphic/renderer.hpp"
+#include "graphic/uniform_buffer.hpp"
+#include "math/frustum.hpp"
 #include "render_path.hpp"
 
 namespace Fge
@@ -11,18 +15,79 @@ namespace Fge
 class ForwardRenderPath : public RenderPath
 {
 public:
+  /**
+   * @param lod_bias Scales the screen space error the LODs may have. Higher
+   * values switch to coarser LODs sooner.
+   */
+  explicit ForwardRenderPath(float lod_bias = 1.0f);
+
   void render(const glm::mat4 & projection_mat,
               const CameraInfo &camera_info,
               uint32_t          width,
               uint32_t          height) override;
 
 private:
-  void set_lightning_uniforms(
-      Material &                                      material,
-      const std::vector<std::shared_ptr<PointLight>> &point_lights);
+  /**
+   * A regular draw if instance_count is zero, otherwise an instanced draw
+   * of consecutive render queue entries.
+   */
+  struct DrawBatch
+  {
+    RenderInfo *render_info{};
+    uint32_t    first_instance{};
+    uint32_t    instance_count{};
+  };
+
+  float lod_bias = 1.0f;
+
+  std::shared_ptr<UniformBuffer> camera_uniform_buffer;
+  std::shared_ptr<UniformBuffer> light_uniform_buffer;
+
+  CameraUniforms camera_uniforms{};
+  LightUniforms  light_uniforms{};
+
+  RenderQueue render_queue;
+
+  std::vector<RenderInfo *> visible_renderables;
+  std::vector<RenderInfo *> bounded_renderables;
+  SphereBatch               bounding_spheres;
+  std::vector<uint8_t>      sphere_visibility;
+
+  std::vector<DrawBatch> draw_batches;
+  std::vector<glm::mat4> instance_world_mats;
+
+  void init_uniform_buffers(Renderer &renderer);
+
+  /**
+   * Collects the renderables whose bounds intersect the frustum, plus all
+   * renderables without bounds.
+   */
+  void cull(const std::vector<std::shared_ptr<RenderInfo>> &renderables,
+            const Frustum &                                 frustum);
+
+  /**
+   * Picks the LOD of every visible renderable from its size on screen and
+   * counts the triangles it saves.
+   */
+  void select_lods(Renderer &        renderer,
+                   const glm::mat4 & projection_mat,
+                   const CameraInfo &camera_info,
+                   uint32_t          height);
+
+  void fill_render_queue(const glm::mat4 &view_mat);
+
+  void build_draw_batches();
+
+  static bool can_draw_instanced(RenderInfo &first, RenderInfo &other);
+
+  void draw(Renderer &renderer, const DrawBatch &draw_batch);
+
+  void update_camera_uniforms(const glm::mat4 & projection_mat,
+                              const CameraInfo &camera_info);
 
-  void set_lightning_uniforms(
-      Material &                                            material,
+  void update_light_uniforms(
+      const glm::mat4 &                                     view_mat,
+      const std::vector<std::shared_ptr<PointLight>> &      point_lights,
       const std::vector<std::shared_ptr<DirectionalLight>> &directional_lights);
 };
 
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "math/math.hpp"
+#include "std.hpp"
+
+namespace Fge
+{
+
+// These values must match res/shaders/frame_uniforms.glsl
+constexpr uint32_t camera_uniforms_binding = 0;
+constexpr uint32_t light_uniforms_binding  = 1;
+constexpr uint32_t bone_palette_binding    = 2;
+constexpr int32_t  max_point_light_count   = 5;
+
+/**
+ * std140 mirror of the Camera uniform block. Uploaded once per frame.
+ */
+struct CameraUniforms
+{
+  glm::mat4 projection_mat{1.0f};
+  glm::mat4 view_mat{1.0f};
+  glm::vec4 position{};
+};
+
+/**
+ * std140 mirror of the PointLight struct. Colors and positions are stored
+ * as vec4, so no member depends on std140 vec3 padding rules. The position
+ * is in view space.
+ */
+struct PointLightUniforms
+{
+  glm::vec4 position{};
+  glm::vec4 ambient_color{};
+  glm::vec4 diffuse_color{};
+  glm::vec4 specular_color{};
+};
+
+/**
+ * std140 mirror of the DirectionalLight struct. The direction is in view
+ * space.
+ */
+struct DirectionalLightUniforms
+{
+  glm::vec4 direction{};
+  glm::vec4 ambient_color{};
+  glm::vec4 diffuse_color{};
+  glm::vec4 specular_color{};
+};
+
+/**
+ * std140 mirror of the Lights uniform block. Uploaded once per frame.
+ */
+struct LightUniforms
+{
+  PointLightUniforms       point_lights[max_point_light_count]{};
+  DirectionalLightUniforms directional_light{};
+  int32_t                  point_light_count         = 0;
+  int32_t                  directional_light_enabled = 0;
+  int32_t                  padding[2]{};
+};
+
+/**
+ * std430 mirror of one bone of the BonePalette buffer. Holds the first three
+ * rows of an affine bone transform, the last row is always (0, 0, 0, 1).
+ */
+struct BoneUniforms
+{
+  glm::vec4 rows[3]{};
+};
+
+static_assert(sizeof(CameraUniforms) == 144,
+              "CameraUniforms does not match std140 layout");
+static_assert(offsetof(LightUniforms, directional_light) == 320,
+              "LightUniforms does not match std140 layout");
+static_assert(offsetof(LightUniforms, point_light_count) == 384,
+              "LightUniforms does not match std140 layout");
+static_assert(sizeof(LightUniforms) == 400,
+              "LightUniforms does not match std140 layout");
+static_assert(sizeof(BoneUniforms) == 48,
+              "BoneUniforms does not match std430 layout");
+
+} // namespace Fge
@@ -17,7 +17,9 @@ void GraphicManager::create_window()
 
   renderer = std::make_shared<Gl::Renderer>();
 
-  render_path = std::make_shared<ForwardRenderPath>();
+  auto config_manager = Application::get_instance()->get_config_manager();
+  render_path         = std::make_shared<ForwardRenderPath>(
+      config_manager->get_config()["graphic"]["lod_bias"].get_or(1.0f));
 
   window = glfw_window;
 
@@ -108,8 +110,8 @@ void GraphicManager::end_imgui_render()
   ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
-void GraphicManager::begin_render() {}
+void GraphicManager::begin_render() { renderer->begin_render(); }
 
-void GraphicManager::end_render() {}
+void GraphicManager::end_render() { renderer->end_render(); }
 
 } // namespace Fge
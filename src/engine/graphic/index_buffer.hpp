@@ -5,6 +5,16 @@
 namespace Fge
 {
 
+enum class IndexType
+{
+  UInt16,
+  UInt32
+};
+
+/**
+ * Indices are stored with 16 bits if all of them fit, which halves the
+ * memory the vertex fetch reads them from.
+ */
 class IndexBuffer
 {
 public:
@@ -18,6 +28,8 @@ public:
 
   virtual uint32_t get_count() const = 0;
 
+  virtual IndexType get_index_type() const = 0;
+
 private:
   IndexBuffer(const IndexBuffer &) = delete;
 
@@ -1,19 +1,36 @@
 #include "material.hpp"
+#include "util/assert.hpp"
 
 namespace Fge
 {
 
-Material::Material(const std::string &name) : name(name) {}
+Material::Material(const std::string &name) : name(name)
+{
+  static std::atomic<uint32_t> next_id{1};
+  id = next_id++;
+}
 
 uint32_t Material::bind_uniforms(std::shared_ptr<Shader> shader,
-                                 uint32_t texture_bind_point) const
+                                 uint32_t                texture_bind_point)
 {
   shader->bind();
-  for (auto &uniform : uniforms)
-  {
-    texture_bind_point = uniform->set(*shader);
-  }
-  return texture_bind_point;
+  return uniforms.bind(shader, texture_bind_point);
+}
+
+void Material::bind_instanced(uint32_t texture_bind_point)
+{
+  auto shader = get_instanced_shader();
+  FGE_ASSERT(shader);
+
+  bind_uniforms(shader, texture_bind_point);
+}
+
+bool Material::is_instance_compatible(Material &other)
+{
+  const auto shader = get_instanced_shader();
+
+  return shader && shader == other.get_instanced_shader() &&
+         uniforms.has_same_shared_values(other.uniforms);
 }
 
 void Material::unbind() const {}
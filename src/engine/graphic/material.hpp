@@ -3,106 +3,76 @@
 #include "shader.hpp"
 #include "std.hpp"
 #include "texture.hpp"
+#include "uniform_block.hpp"
 
 namespace Fge
 {
 
-class UniformBase
-{
-public:
-  virtual ~UniformBase() = default;
-
-  virtual uint32_t set(Shader &shader, uint32_t texture_bind_point = 0) = 0;
-
-  virtual std::shared_ptr<UniformBase> clone() = 0;
-};
-
-template <typename T> class Uniform : public UniformBase
+class Material
 {
 public:
-  Uniform(const std::string &name, const T &value) : name(name), value(value) {}
-
-  void update(const T &value) { this->value = value; }
-
-  virtual uint32_t set(Shader &shader, uint32_t texture_bind_point = 0) override
-  {
-    shader.set_uniform(name, value);
-    return texture_bind_point;
-  }
-
-  const std::string &get_name() const { return name; }
+  Material(const std::string &name);
 
-  std::shared_ptr<UniformBase> clone() override
-  {
-    auto new_uniform = std::make_shared<Uniform<T>>(name, value);
+  virtual ~Material() = default;
 
-    return new_uniform;
-  }
+  std::string get_name() const { return name; }
 
-private:
-  std::string name;
-  T           value;
-};
+  /**
+   * Unique id of the material. Used to group draws by material.
+   */
+  uint32_t get_id() const { return id; }
+
+  /**
+   * Shader the material binds. Creates it if it is out of date.
+   */
+  virtual std::shared_ptr<Shader> get_shader() = 0;
+
+  /**
+   * Variant of the shader that reads the world matrix per instance.
+   *
+   * @return nullptr if the material can't be drawn instanced
+   */
+  virtual std::shared_ptr<Shader> get_instanced_shader() { return nullptr; }
+
+  /**
+   * Binds the instanced shader together with the uniforms of this material.
+   */
+  void bind_instanced(uint32_t texture_bind_point = 0);
+
+  /**
+   * Materials that can be drawn in one instanced draw have the same hash.
+   */
+  uint32_t get_instancing_hash() { return uniforms.get_shared_hash(); }
+
+  /**
+   * @return True if both materials use the same instanced shader with the
+   * same uniform values, apart from the per instance ones
+   */
+  bool is_instance_compatible(Material &other);
 
-template <> class Uniform<std::shared_ptr<Texture2D>> : public UniformBase
-{
-public:
-  Uniform(const std::string &name, const std::shared_ptr<Texture2D> &value)
-      : name(name),
-        value(value)
-  {
-  }
+  virtual void unbind() const;
 
-  void update(const std::shared_ptr<Texture2D> &value) { this->value = value; }
+  virtual void bind(uint32_t texture_bind_point = 0) = 0;
 
-  virtual uint32_t set(Shader &shader, uint32_t texture_bind_point = 0) override
+  /**
+   * Resolves a uniform name to a handle. Do this once and keep the handle
+   * for uniforms that are set often.
+   */
+  template <typename T>
+  UniformHandle get_uniform_handle(const std::string &name)
   {
-    value->bind(texture_bind_point);
-    shader.set_uniform(name, static_cast<int32_t>(texture_bind_point));
-    ++texture_bind_point;
-    return texture_bind_point;
+    return uniforms.get_handle<T>(name);
   }
 
-  const std::string &get_name() const { return name; }
-
-  std::shared_ptr<UniformBase> clone() override
+  template <typename T> void set_uniform(UniformHandle handle, const T &value)
   {
-    auto new_uniform =
-        std::make_shared<Uniform<std::shared_ptr<Texture2D>>>(name, value);
-
-    return new_uniform;
+    uniforms.set(handle, value);
   }
 
-private:
-  std::string                name;
-  std::shared_ptr<Texture2D> value;
-};
-
-class Material
-{
-public:
-  Material(const std::string &name);
-
-  virtual ~Material() = default;
-
-  std::string get_name() const { return name; }
-
-  virtual void unbind() const;
-
-  virtual void bind(uint32_t texture_bind_point = 0) = 0;
-
   template <typename T>
   void set_uniform(const std::string &name, const T &value)
   {
-    auto uniform = find_instance_uniform<T>(name);
-    if (uniform)
-    {
-      uniform->update(value);
-      return;
-    }
-
-    uniform = std::make_shared<Uniform<T>>(name, value);
-    uniforms.emplace_back(uniform);
+    uniforms.set(get_uniform_handle<T>(name), value);
   }
 
   virtual void reload();
@@ -111,27 +81,13 @@ public:
 
 protected:
   std::string name;
+  uint32_t    id{};
 
-  virtual uint32_t bind_uniforms(std::shared_ptr<Shader>,
-                                 uint32_t texture_bind_point = 0) const;
+  virtual uint32_t bind_uniforms(std::shared_ptr<Shader> shader,
+                                 uint32_t texture_bind_point = 0);
 
 protected:
-  std::vector<std::shared_ptr<UniformBase>> uniforms;
-
-  template <typename T>
-  std::shared_ptr<Uniform<T>> find_instance_uniform(const std::string &name)
-  {
-    for (auto uniform : uniforms)
-    {
-      auto casted_uniform = std::static_pointer_cast<Uniform<T>>(uniform);
-      if (name == casted_uniform->get_name())
-      {
-        return casted_uniform;
-      }
-    }
-
-    return nullptr;
-  }
+  UniformBlock uniforms;
 };
 
 } // namespace Fge
@@ -8,9 +8,14 @@ namespace Fge
 
 SubMesh::SubMesh(const std::string &                       name,
                  std::shared_ptr<std::vector<VertexPNTBT>> vertices,
+                 const std::vector<PackedVertexPNTBT> &    packed_vertices,
                  std::shared_ptr<std::vector<uint32_t>>    indices,
                  std::shared_ptr<MeshMaterial>             material)
-    : SubMeshBase<VertexPNTBT>(name, vertices, indices, material)
+    : SubMeshBase<VertexPNTBT>(name,
+                               vertices,
+                               packed_vertices,
+                               indices,
+                               material)
 {
 }
 
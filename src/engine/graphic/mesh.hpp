@@ -10,6 +10,7 @@ class SubMesh : public SubMeshBase<VertexPNTBT>
 public:
   SubMesh(const std::string &                       name,
           std::shared_ptr<std::vector<VertexPNTBT>> vertices,
+          const std::vector<PackedVertexPNTBT> &    packed_vertices,
           std::shared_ptr<std::vector<uint32_t>>    indices,
           std::shared_ptr<MeshMaterial>             material);
 
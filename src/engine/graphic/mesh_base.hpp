@@ -2,8 +2,11 @@
 
 #include "application.hpp"
 #include "index_buffer.hpp"
+#include "math/bounds.hpp"
+#include "mesh_lod.hpp"
 #include "mesh_material.hpp"
 #include "vertex_array.hpp"
+#include "vertex_packing.hpp"
 #include "vertices.hpp"
 
 namespace Fge
@@ -12,10 +15,15 @@ namespace Fge
 template <typename TVertex> class SubMeshBase
 {
 public:
-  SubMeshBase(const std::string &                    name,
-              std::shared_ptr<std::vector<TVertex>>  vertices,
-              std::shared_ptr<std::vector<uint32_t>> indices,
-              std::shared_ptr<MeshMaterial>          material)
+  /**
+   * Uploads packed_vertices, the packed form of vertices. The caller packs
+   * them, so that this can happen off the render thread.
+   */
+  SubMeshBase(const std::string &                       name,
+              std::shared_ptr<std::vector<TVertex>>     vertices,
+              const std::vector<PackedVertex<TVertex>> &packed_vertices,
+              std::shared_ptr<std::vector<uint32_t>>    indices,
+              std::shared_ptr<MeshMaterial>             material)
       : name(name),
         vertices(vertices),
         indices(indices),
@@ -27,7 +35,8 @@ public:
 
     vertex_array = renderer->create_vertex_array();
 
-    auto vertex_buffer = renderer->create_vertex_buffer(*vertices);
+    FGE_ASSERT(packed_vertices.size() == vertices->size());
+    auto vertex_buffer = renderer->create_vertex_buffer(packed_vertices);
 
     index_buffer = renderer->create_index_buffer(*indices);
 
@@ -64,6 +73,21 @@ public:
 
   std::shared_ptr<std::vector<uint32_t>> get_indices() { return indices; }
 
+  /**
+   * Bounds of the vertices in model space. Computed once at import.
+   */
+  void set_bounds(const Bounds &bounds) { this->bounds = bounds; }
+
+  const Bounds &get_bounds() const { return bounds; }
+
+  /**
+   * Index ranges of the LODs, full detail first. Empty if all indices are
+   * one LOD.
+   */
+  void set_lods(const std::vector<MeshLod> &lods) { this->lods = lods; }
+
+  const std::vector<MeshLod> &get_lods() const { return lods; }
+
 private:
   std::string name;
 
@@ -74,6 +98,10 @@ private:
   std::shared_ptr<IndexBuffer> index_buffer{};
 
   std::shared_ptr<MeshMaterial> material{};
+
+  Bounds bounds{};
+
+  std::vector<MeshLod> lods{};
 };
 
 template <typename TVertex> class MeshBase
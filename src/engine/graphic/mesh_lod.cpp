@@ -0,0 +1,47 @@
+#include "mesh_lod.hpp"
+
+namespace Fge
+{
+
+float get_projected_radius(const BoundingSphere &sphere,
+                           const glm::vec3 &     camera_position,
+                           float                 projection_scale)
+{
+  const auto distance = glm::length(sphere.center - camera_position);
+  if (distance <= sphere.radius)
+  {
+    return std::numeric_limits<float>::infinity();
+  }
+
+  return sphere.radius / distance * projection_scale;
+}
+
+uint32_t select_lod(const std::vector<MeshLod> &lods,
+                    uint32_t                    current_lod,
+                    float                       projected_radius,
+                    float                       max_error_pixels)
+{
+  if (lods.empty())
+  {
+    return 0;
+  }
+
+  const auto get_error_pixels = [&](uint32_t lod) {
+    return lods[lod].error * projected_radius;
+  };
+
+  auto lod = std::min(current_lod, static_cast<uint32_t>(lods.size() - 1));
+  while (lod > 0 && get_error_pixels(lod) > max_error_pixels)
+  {
+    --lod;
+  }
+  while (lod + 1 < lods.size() &&
+         get_error_pixels(lod + 1) <= max_error_pixels * lod_hysteresis)
+  {
+    ++lod;
+  }
+
+  return lod;
+}
+
+} // namespace Fge
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "math/bounds.hpp"
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Range of the index buffer that draws one level of detail of a sub mesh.
+ * All LODs of a sub mesh share its vertices.
+ */
+struct MeshLod
+{
+  uint32_t first_index{};
+  uint32_t index_count{};
+
+  // Distance of the LOD to the full detail surface, relative to the radius
+  // of the bounding sphere
+  float error{};
+};
+
+/**
+ * A coarser LOD gets picked once its error is this much below the allowed
+ * error, so the LOD doesn't flip back and forth at the threshold.
+ */
+constexpr float lod_hysteresis = 0.75f;
+
+/**
+ * Radius of the sphere on screen in pixels.
+ *
+ * @param projection_scale projection_mat[1][1] times half the viewport
+ * height.
+ * @return Infinity if the camera is inside the sphere.
+ */
+float get_projected_radius(const BoundingSphere &sphere,
+                           const glm::vec3 &     camera_position,
+                           float                 projection_scale);
+
+/**
+ * Picks the coarsest LOD whose error covers at most max_error_pixels on
+ * screen, starting from the current one.
+ */
+uint32_t select_lod(const std::vector<MeshLod> &lods,
+                    uint32_t                    current_lod,
+                    float                       projected_radius,
+                    float                       max_error_pixels);
+
+} // namespace Fge
@@ -19,7 +19,11 @@ public:
 
   virtual void set_world_matrix(const glm::mat4 &world_mat) = 0;
 
-  virtual void set_bone_transforms(const std::vector<glm::mat4> &bones) = 0;
+  /**
+   * @param first_bone Index of the first bone of the mesh in the bone
+   * palette of the frame
+   */
+  virtual void set_first_bone(uint32_t first_bone) = 0;
 };
 
 } // namespace Fge
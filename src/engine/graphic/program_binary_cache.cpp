@@ -0,0 +1,123 @@
+#include "program_binary_cache.hpp"
+#include "file/atomic_write.hpp"
+#include "file/mapped_file.hpp"
+#include "log/log.hpp"
+#include "util/binary_stream.hpp"
+
+#include <iomanip>
+
+namespace Fge
+{
+
+namespace
+{
+
+// "FGEP" in a little endian file
+constexpr uint32_t program_binary_magic = 0x50454746;
+
+uint64_t hash_fnv1a(const std::string &value)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (const auto c : value)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(const std::filesystem::path &cache_path)
+    : cache_path(cache_path)
+{
+}
+
+std::optional<ProgramBinary> ProgramBinaryCache::load(const std::string &key)
+{
+  const auto entry_path = get_entry_path(key);
+
+  std::error_code error;
+  if (!std::filesystem::exists(entry_path, error))
+  {
+    return std::nullopt;
+  }
+
+  try
+  {
+    const MappedFile file(entry_path);
+    BinaryReader     reader(file.get_data(), file.get_size());
+
+    if (reader.read<uint32_t>() != program_binary_magic ||
+        reader.read<uint32_t>() != format_version)
+    {
+      trace("ProgramBinaryCache",
+            FMT_STRING("Entry is stale: {}"),
+            entry_path.string());
+      return std::nullopt;
+    }
+
+    // The file name is only a hash of the key
+    if (reader.read_string() != key)
+    {
+      return std::nullopt;
+    }
+
+    ProgramBinary binary{};
+    binary.format     = reader.read<uint32_t>();
+    binary.compile_ms = reader.read<double>();
+    binary.data       = reader.read_vector<uint8_t>();
+
+    return binary;
+  }
+  catch (const std::exception &exception)
+  {
+    warning("ProgramBinaryCache",
+            FMT_STRING("Could not read entry {}: {}"),
+            entry_path.string(),
+            exception.what());
+    return std::nullopt;
+  }
+}
+
+void ProgramBinaryCache::store(const std::string &  key,
+                               const ProgramBinary &binary)
+{
+  BinaryWriter writer;
+  writer.write<uint32_t>(program_binary_magic);
+  writer.write<uint32_t>(format_version);
+  writer.write_string(key);
+  writer.write<uint32_t>(binary.format);
+  writer.write<double>(binary.compile_ms);
+  writer.write_vector(binary.data);
+
+  try
+  {
+    write_file_atomic(get_entry_path(key), writer.get_data());
+  }
+  catch (const std::exception &exception)
+  {
+    warning("ProgramBinaryCache",
+            FMT_STRING("Could not write entry: {}"),
+            exception.what());
+  }
+}
+
+void ProgramBinaryCache::remove(const std::string &key)
+{
+  std::error_code error;
+  std::filesystem::remove(get_entry_path(key), error);
+}
+
+std::filesystem::path
+ProgramBinaryCache::get_entry_path(const std::string &key) const
+{
+  std::stringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash_fnv1a(key)
+       << ".bin";
+
+  return cache_path / name.str();
+}
+
+} // namespace Fge
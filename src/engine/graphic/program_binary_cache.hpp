@@ -0,0 +1,58 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Linked shader program in the format of the driver.
+ */
+struct ProgramBinary
+{
+  uint32_t             format{};
+  std::vector<uint8_t> data;
+
+  // Time compiling and linking took, what loading the binary saves
+  double compile_ms{};
+};
+
+/**
+ * Linked shader programs in the app cache directory.
+ *
+ * Entries are keyed by everything the program depends on, the preprocessed
+ * sources and the driver. A driver can still reject a binary, e.g. after an
+ * update, the entry gets replaced once the program is compiled again.
+ */
+class ProgramBinaryCache
+{
+public:
+  /**
+   * Bump on every change of the format.
+   */
+  static constexpr uint32_t format_version = 1;
+
+  explicit ProgramBinaryCache(const std::filesystem::path &cache_path);
+
+  /**
+   * @return Nothing if there is no entry for the key or it can't be read
+   */
+  std::optional<ProgramBinary> load(const std::string &key);
+
+  /**
+   * Failing to write only gets logged.
+   */
+  void store(const std::string &key, const ProgramBinary &binary);
+
+  /**
+   * Removes an entry the driver rejected.
+   */
+  void remove(const std::string &key);
+
+private:
+  std::filesystem::path cache_path;
+
+  std::filesystem::path get_entry_path(const std::string &key) const;
+};
+
+} // namespace Fge
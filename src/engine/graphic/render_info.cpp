@@ -1,4 +1,5 @@
 #include "render_info.hpp"
+#include "util/assert.hpp"
 
 namespace Fge
 {
@@ -19,4 +20,60 @@ RenderInfo::RenderInfo(std::shared_ptr<VertexArray> vertex_array,
 {
 }
 
+void RenderInfo::set_world_matrix(const glm::mat4 &world_mat)
+{
+  this->world_mat = world_mat;
+
+  if (bounds_set)
+  {
+    world_bounds.aabb   = transform_aabb(local_bounds.aabb, world_mat);
+    world_bounds.sphere = transform_sphere(local_bounds.sphere, world_mat);
+  }
+}
+
+void RenderInfo::set_local_bounds(const Bounds &local_bounds)
+{
+  this->local_bounds = local_bounds;
+  bounds_set         = true;
+
+  set_world_matrix(world_mat);
+}
+
+void RenderInfo::set_lods(const std::vector<MeshLod> &lods)
+{
+  this->lods  = lods;
+  current_lod = 0;
+}
+
+void RenderInfo::set_current_lod(uint32_t current_lod)
+{
+  FGE_ASSERT(current_lod == 0 || current_lod < lods.size());
+  this->current_lod = current_lod;
+}
+
+uint32_t RenderInfo::get_first_index() const
+{
+  return lods.empty() ? 0 : lods[current_lod].first_index;
+}
+
+uint32_t RenderInfo::get_index_count() const
+{
+  if (!lods.empty())
+  {
+    return lods[current_lod].index_count;
+  }
+
+  return index_buffer ? index_buffer->get_count() : 0;
+}
+
+uint32_t RenderInfo::get_full_detail_index_count() const
+{
+  if (!lods.empty())
+  {
+    return lods.front().index_count;
+  }
+
+  return index_buffer ? index_buffer->get_count() : 0;
+}
+
 } // namespace Fge
@@ -2,7 +2,9 @@
 
 #include "graphic/index_buffer.hpp"
 #include "graphic/material.hpp"
+#include "graphic/mesh_lod.hpp"
 #include "graphic/vertex_array.hpp"
+#include "math/bounds.hpp"
 
 namespace Fge
 {
@@ -33,11 +35,65 @@ public:
 
   DrawMode get_draw_mode() const { return draw_mode; }
 
+  /**
+   * World matrix of the last update. Used to sort draws by depth and to move
+   * the bounds into world space.
+   */
+  void set_world_matrix(const glm::mat4 &world_mat);
+
+  const glm::mat4 &get_world_matrix() const { return world_mat; }
+
+  /**
+   * Bounds in model space. Render infos without bounds are never culled.
+   */
+  void set_local_bounds(const Bounds &local_bounds);
+
+  bool has_bounds() const { return bounds_set; }
+
+  /**
+   * Local bounds transformed by the world matrix.
+   */
+  const Bounds &get_world_bounds() const { return world_bounds; }
+
+  /**
+   * Index ranges of the LODs, full detail first. Without LODs the whole
+   * index buffer gets drawn.
+   */
+  void set_lods(const std::vector<MeshLod> &lods);
+
+  const std::vector<MeshLod> &get_lods() const { return lods; }
+
+  /**
+   * LOD of the last frame. Kept, so the selection can tell which way it
+   * switches.
+   */
+  void set_current_lod(uint32_t current_lod);
+
+  uint32_t get_current_lod() const { return current_lod; }
+
+  /**
+   * Range of the index buffer the current LOD draws.
+   */
+  uint32_t get_first_index() const;
+
+  uint32_t get_index_count() const;
+
+  uint32_t get_full_detail_index_count() const;
+
 private:
   std::shared_ptr<VertexArray>  vertex_array{};
   std::shared_ptr<IndexBuffer>  index_buffer{};
   std::shared_ptr<Material>     material{};
 
+  glm::mat4 world_mat{1.0f};
+
+  Bounds local_bounds{};
+  Bounds world_bounds{};
+  bool   bounds_set = false;
+
+  std::vector<MeshLod> lods{};
+  uint32_t             current_lod = 0;
+
   DrawMode draw_mode = DrawMode::TRIANGLES;
 };
 
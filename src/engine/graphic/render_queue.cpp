@@ -0,0 +1,37 @@
+#include "render_queue.hpp"
+
+namespace Fge
+{
+
+uint64_t RenderQueue::make_sort_key(uint32_t shader_id,
+                                    uint32_t material_id,
+                                    uint32_t vertex_array_id,
+                                    float    depth)
+{
+  // The bits of a positive float sort like its value, so the upper 16 bits
+  // are a coarse but monotonic depth
+  depth = std::max(depth, 0.0f);
+  uint32_t depth_bits{};
+  std::memcpy(&depth_bits, &depth, sizeof(depth_bits));
+
+  return (static_cast<uint64_t>(shader_id & 0xffff) << 48) |
+         (static_cast<uint64_t>(material_id & 0xffff) << 32) |
+         (static_cast<uint64_t>(vertex_array_id & 0xffff) << 16) |
+         static_cast<uint64_t>(depth_bits >> 16);
+}
+
+void RenderQueue::push(uint64_t sort_key, RenderInfo &render_info)
+{
+  commands.push_back({sort_key, &render_info});
+}
+
+void RenderQueue::sort()
+{
+  std::sort(commands.begin(),
+            commands.end(),
+            [](const RenderCommand &a, const RenderCommand &b) {
+              return a.sort_key < b.sort_key;
+            });
+}
+
+} // namespace Fge
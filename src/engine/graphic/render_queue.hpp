@@ -0,0 +1,50 @@
+#pragma once
+
+#include "render_info.hpp"
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * One draw of a frame. The sort key decides the submit order.
+ */
+struct RenderCommand
+{
+  uint64_t    sort_key{};
+  RenderInfo *render_info{};
+};
+
+/**
+ * Collects the draws of a frame and orders them so that draws sharing a
+ * shader, material and vertex array are submitted next to each other.
+ */
+class RenderQueue
+{
+public:
+  /**
+   * Builds a key that sorts by shader, then material, then vertex array and
+   * then front to back. Each id takes 16 bits. Ids that don't fit only
+   * weaken the grouping, the draws stay correct.
+   *
+   * @param depth View space distance to the camera. Negative values are
+   * treated as zero.
+   */
+  static uint64_t make_sort_key(uint32_t shader_id,
+                                uint32_t material_id,
+                                uint32_t vertex_array_id,
+                                float    depth);
+
+  void clear() { commands.clear(); }
+
+  void push(uint64_t sort_key, RenderInfo &render_info);
+
+  void sort();
+
+  const std::vector<RenderCommand> &get_commands() const { return commands; }
+
+private:
+  std::vector<RenderCommand> commands;
+};
+
+} // namespace Fge
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * What the renderer sent to the GPU during one frame.
+ */
+struct RenderStats
+{
+  uint32_t draw_call_count           = 0;
+  uint32_t instanced_draw_call_count = 0;
+  uint32_t instance_count            = 0;
+  uint32_t program_change_count      = 0;
+  uint32_t vertex_array_change_count = 0;
+  uint32_t texture_change_count      = 0;
+  uint32_t visible_count             = 0;
+  uint32_t culled_count              = 0;
+
+  // Triangles of the visible renderables at full detail and at their LODs
+  uint32_t full_detail_triangle_count = 0;
+  uint32_t triangle_count             = 0;
+
+  // State changes skipped because the state was already set
+  uint32_t elided_change_count = 0;
+};
+
+/**
+ * How shader variants got created since the start.
+ */
+struct ShaderCacheStats
+{
+  // Materials that got a variant that was already created
+  uint32_t variant_hit_count = 0;
+
+  // Variants that got loaded from the program binary cache
+  uint32_t binary_hit_count = 0;
+
+  // Variants that had to be compiled
+  uint32_t binary_miss_count = 0;
+
+  double compile_ms     = 0.0;
+  double binary_load_ms = 0.0;
+
+  // What compiling the loaded variants took when they were stored
+  double saved_compile_ms = 0.0;
+};
+
+} // namespace Fge
@@ -83,7 +83,8 @@ void RenderView::recreate_target_framebuffer(uint32_t width,
   auto renderer = app->get_graphic_manager()->get_renderer();
 
   trace("RenderView",
-        "Recreate target framebuffer with width: {}, height: {}, samples: {}",
+        FMT_STRING("Recreate target framebuffer with width: {}, height: {}, "
+                   "samples: {}"),
         width,
         height,
         samples);
@@ -1,14 +1,17 @@
 #pragma once
 
 #include "directional_light.hpp"
+#include "graphic/frame_uniforms.hpp"
 #include "graphic/framebuffer.hpp"
 #include "graphic/render_info.hpp"
+#include "graphic/render_stats.hpp"
 #include "graphic/renderbuffer.hpp"
 #include "graphic/texture.hpp"
 #include "index_buffer.hpp"
 #include "point_light.hpp"
 #include "spot_light.hpp"
 #include "std.hpp"
+#include "uniform_buffer.hpp"
 #include "vertex_array.hpp"
 #include "vertices.hpp"
 
@@ -45,19 +48,22 @@ public:
   create_index_buffer(const std::vector<uint32_t> &indices) = 0;
 
   virtual std::shared_ptr<VertexBuffer>
-  create_vertex_buffer(const std::vector<VertexPNTBT> &vertices) = 0;
+  create_vertex_buffer(const std::vector<PackedVertexPNTBT> &vertices) = 0;
 
   virtual std::shared_ptr<VertexBuffer>
   create_vertex_buffer(const std::vector<VertexP> &vertices) = 0;
 
   virtual std::shared_ptr<VertexBuffer>
-  create_vertex_buffer(const std::vector<VertexPNTBBWT> &vertices) = 0;
+  create_vertex_buffer(const std::vector<PackedVertexPNTBBWT> &vertices) = 0;
 
   virtual std::shared_ptr<Shader>
   create_shader(const std::string &             vertex_shader_filename,
                 const std::string &             fragment_shader_filename,
                 const std::vector<std::string> &shader_defines) = 0;
 
+  virtual std::shared_ptr<UniformBuffer>
+  create_uniform_buffer(std::size_t size) = 0;
+
   virtual std::shared_ptr<Texture2D>
   create_texture2d(const Texture2DConfig &config) = 0;
 
@@ -100,18 +106,70 @@ public:
   virtual const std::vector<std::shared_ptr<SpotLight>> &
   get_spot_lights() const = 0;
 
+  /**
+   * Draws index_count indices of the index buffer, starting at first_index.
+   */
   virtual void draw(const VertexArray &vertex_array,
                     const IndexBuffer &index_buffer,
                     Material &         material,
-                    DrawMode           draw_mode) = 0;
+                    DrawMode           draw_mode,
+                    uint32_t           first_index,
+                    uint32_t           index_count) = 0;
 
   virtual void draw(const VertexArray &vertex_array,
                     Material &         material,
                     DrawMode           draw_mode) = 0;
 
+  /**
+   * Uploads the world matrices of all instanced draws of a frame. Instanced
+   * draws address them by their first instance.
+   */
+  virtual void
+  upload_instance_data(const std::vector<glm::mat4> &world_mats) = 0;
+
+  /**
+   * Uploads the bones of all skinned meshes of a frame. Skinned draws
+   * address them by the first bone of their mesh.
+   */
+  virtual void upload_bone_palette(const std::vector<BoneUniforms> &bones) = 0;
+
+  /**
+   * Draws instance_count instances with the instanced shader of the
+   * material. Instance i uses the world matrix first_instance + i of the
+   * last upload.
+   */
+  virtual void draw_instanced(const VertexArray &vertex_array,
+                              const IndexBuffer &index_buffer,
+                              Material &         material,
+                              DrawMode           draw_mode,
+                              uint32_t           first_index,
+                              uint32_t           index_count,
+                              uint32_t           first_instance,
+                              uint32_t           instance_count) = 0;
+
+  /**
+   * Counts renderables that passed or failed frustum culling this frame.
+   */
+  virtual void add_culling_result(uint32_t visible_count,
+                                  uint32_t culled_count) = 0;
+
+  /**
+   * Counts triangles of the visible renderables at full detail and at the
+   * LODs that got selected this frame.
+   */
+  virtual void add_lod_result(uint32_t full_detail_triangle_count,
+                              uint32_t triangle_count) = 0;
+
   virtual void
   set_viewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
+  /**
+   * Stats of the last completed frame.
+   */
+  virtual const RenderStats &get_render_stats() const = 0;
+
+  virtual const ShaderCacheStats &get_shader_cache_stats() const = 0;
+
   virtual void terminate() = 0;
 };
 
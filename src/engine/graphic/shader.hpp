@@ -6,6 +6,26 @@
 namespace Fge
 {
 
+/**
+ * Data type of a uniform value. Values are passed to the shader as tightly
+ * packed arrays of the matching glm type. Bool values are packed as int32_t
+ * and textures are set as their int32_t texture unit.
+ */
+enum class UniformType
+{
+  Bool,
+  Int,
+  Float,
+  Vec2,
+  IVec2,
+  Vec3,
+  Vec4,
+  Mat2,
+  Mat3,
+  Mat4,
+  Texture2D
+};
+
 class Shader
 {
 public:
@@ -17,6 +37,23 @@ public:
 
   virtual void unbind() const = 0;
 
+  /**
+   * Location of an active uniform, looked up in the table the shader built
+   * when it got linked. Array uniforms can be found by their plain name.
+   *
+   * @return Location or -1 if the uniform is not active
+   */
+  virtual int32_t get_uniform_location(const std::string &name) const = 0;
+
+  /**
+   * Sets count values of type at location. The shader doesn't need to be
+   * bound.
+   */
+  virtual void set_uniform(int32_t     location,
+                           UniformType type,
+                           const void *data,
+                           uint32_t    count = 1) = 0;
+
   virtual void set_uniform(const std::string &name, bool value) = 0;
 
   virtual void set_uniform(const std::string &name, int32_t value) = 0;
@@ -1,292 +1,349 @@
 #include "shader_preprocessor.hpp"
-#include "shader.hpp"
+#include "profiler/profiler.hpp"
 
 namespace Fge
 {
 
-std::string
-get_sub_string(const std::string &str, const size_t start_index, size_t count)
+namespace
 {
-  return str.substr(start_index, count);
-}
 
-std::string strip_file_from_path(const std::string &path_with_file)
+std::string_view trim_start(std::string_view text)
 {
-  std::string path{};
+  const auto begin = text.find_first_not_of(" \t");
+  return begin == std::string_view::npos ? std::string_view()
+                                         : text.substr(begin);
+}
 
-  size_t path_with_file_end = path_with_file.length();
+std::string_view trim(std::string_view text)
+{
+  text           = trim_start(text);
+  const auto end = text.find_last_not_of(" \t\r");
+  return end == std::string_view::npos ? std::string_view()
+                                       : text.substr(0, end + 1);
+}
 
-  size_t i = 0;
-  while (path_with_file_end - i > 0 &&
-         path_with_file[path_with_file_end - i] != '/')
+/**
+ * @return The rest of the line after "#name", nothing if the line is no
+ * such directive
+ */
+std::optional<std::string_view> match_directive(std::string_view   line,
+                                                const std::string &name)
+{
+  line = trim_start(line);
+  if (line.empty() || line[0] != '#')
   {
-    ++i;
+    return std::nullopt;
   }
 
-  return get_sub_string(path_with_file, 0, path_with_file_end - i + 1);
-}
+  line = trim_start(line.substr(1));
+  if (line.compare(0, name.size(), name) != 0)
+  {
+    return std::nullopt;
+  }
 
-ShaderPreprocessor::ShaderPreprocessor(
-    const std::vector<std::string> &absolute_include_base_paths)
-    : absolute_include_base_paths(absolute_include_base_paths)
-{
-  for (auto &include : absolute_include_base_paths)
+  const auto rest = line.substr(name.size());
+  if (!rest.empty() && rest[0] != ' ' && rest[0] != '\t' && rest[0] != '\r')
   {
-    if (!(include[include.length() - 1] == '/'))
-    {
-      std::cout << "Absolute include must end with /\n";
-      std::exit(EXIT_FAILURE);
-    }
+    return std::nullopt;
   }
+
+  return trim(rest);
 }
 
-void ShaderPreprocessor::set_define(const std::string &define)
+bool is_enclosed(std::string_view text, char open, char close)
 {
-  defines.push_back(define);
+  return text.size() >= 2 && text.front() == open && text.back() == close;
 }
 
-bool match(const std::string  str,
-           const size_t       start_index,
-           const std::string &word_match)
+bool is_blank_or_comment(std::string_view line)
 {
-  assert(start_index < str.length());
-  assert(word_match.length() > 0);
+  line = trim(line);
+  return line.empty() || line.compare(0, 2, "//") == 0;
+}
 
-  size_t i = 0;
-  while (start_index + i < str.length() &&
-         str[start_index + i] == word_match[i])
+/**
+ * Include guards are an #ifndef and #define of the same name before
+ * anything else and an #endif after everything else.
+ */
+bool has_include_guard(const std::vector<std::string_view> &lines)
+{
+  std::vector<std::string_view> significant;
+  for (const auto &line : lines)
   {
-    ++i;
+    if (!is_blank_or_comment(line))
+    {
+      significant.push_back(line);
+    }
   }
 
-  if (i == word_match.length())
+  if (significant.size() < 3)
   {
-    return true;
+    return false;
   }
 
-  return false;
+  const auto guard  = match_directive(significant[0], "ifndef");
+  const auto define = match_directive(significant[1], "define");
+
+  return guard && !guard->empty() && define && *define == *guard &&
+         match_directive(significant.back(), "endif");
 }
 
-enum class IncludeType
+std::string read_file(const std::string &path)
 {
-  Absolute,
-  Relative
-};
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+  {
+    throw std::runtime_error("Could not read shader " + path);
+  }
 
-struct Include
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+ShaderPreprocessor::ShaderPreprocessor(
+    const std::vector<std::filesystem::path> &include_paths)
+    : include_paths(include_paths)
 {
-  IncludeType include_type{};
-  std::string path{};
-  size_t      include_begin{};
-  size_t      include_end{};
-  size_t      length{};
-};
+}
 
-std::string
-ShaderPreprocessor::insert_include_content(const std::string &shader_code,
-                                           size_t             include_begin,
-                                           size_t             include_end,
-                                           const std::string &include_content)
+PreprocessedShader
+ShaderPreprocessor::preprocess(const std::filesystem::path &   shader_path,
+                               const std::vector<std::string> &defines)
 {
-  auto before_include = get_sub_string(shader_code, 0, include_begin);
+  FGE_PROFILE_SCOPE("ShaderPreprocessor::preprocess");
 
-  // assert(shader_code[include_end + 1] == '\n');
+  const auto path = std::filesystem::weakly_canonical(shader_path).string();
+  const auto file = get_file(path);
 
-  if (include_end + 2 < shader_code.length())
+  Output output{};
+  if (file->once)
   {
-    auto after_include =
-        get_sub_string(shader_code, include_end + 2, shader_code.length());
-    // return before_include + "\n" + include_content + "\n" + after_include;
-    return before_include + include_content + after_include;
+    output.included_once.insert(path);
   }
 
-  // return before_include + "\n" + include_content + "\n";
-  return before_include + include_content;
-}
+  auto &code = output.shader.code;
 
-std::optional<std::string> get_file_content(const std::string &filepath)
-{
-  std::ifstream ifs(filepath);
-  if (!ifs.is_open())
+  // #version has to come before anything else
+  if (!file->version.empty())
+  {
+    code += file->version;
+  }
+  for (const auto &define : defines)
   {
-    return {};
+    code += "#define " + define + "\n";
   }
-  std::string str((std::istreambuf_iterator<char>(ifs)),
-                  std::istreambuf_iterator<char>());
-  return str;
+
+  emit_file(path, *file, output);
+
+  return std::move(output.shader);
 }
 
-std::string ShaderPreprocessor::resolve_includes(const std::string &shader_path,
-                                                 const std::string &shader_code)
+ShaderPreprocessor::ParsedFile
+ShaderPreprocessor::parse(const std::string &code)
 {
-  std::vector<Include> includes;
-  size_t               current_line = 0;
+  std::vector<std::string_view> lines;
+  for (std::size_t begin = 0; begin < code.size();)
+  {
+    auto end = code.find('\n', begin);
+    if (end == std::string::npos)
+    {
+      end = code.size();
+    }
+    lines.emplace_back(code.data() + begin, end - begin);
+    begin = end + 1;
+  }
+
+  ParsedFile file{};
+  file.once = has_include_guard(lines);
 
-  assert(shader_path[shader_path.length() - 1] == '/');
+  std::size_t first_line = 0;
+  if (!lines.empty() && match_directive(lines[0], "version"))
+  {
+    file.version = std::string(lines[0]) + "\n";
+    first_line   = 1;
+  }
+
+  std::string text;
+  uint32_t    text_line = static_cast<uint32_t>(first_line + 1);
 
-  for (size_t i = 0; i < shader_code.length(); ++i)
+  for (std::size_t i = first_line; i < lines.size(); ++i)
   {
-    if (shader_code[i] == '\n')
+    const auto line_number = static_cast<uint32_t>(i + 1);
+
+    // Left as an empty line, so the line numbers stay the same
+    const auto pragma = match_directive(lines[i], "pragma");
+    if (pragma && *pragma == "once")
+    {
+      file.once = true;
+      text += "\n";
+      continue;
+    }
+
+    const auto include = match_directive(lines[i], "include");
+    if (!include)
     {
-      ++current_line;
+      text += lines[i];
+      text += "\n";
+      continue;
     }
 
-    if (i == 0 || shader_code[i - 1] == '\n')
+    const auto path      = *include;
+    const bool quoted    = is_enclosed(path, '"', '"');
+    const bool bracketed = is_enclosed(path, '<', '>');
+    if (!quoted && !bracketed)
     {
-      if (match(shader_code, i, "#include"))
-      {
-        size_t length = 8;
-
-        Include include{};
-        include.include_begin = i;
-
-        // Get path
-        size_t j = i + 8;
-        while (j < shader_code.length() &&
-               (shader_code[j] == ' ' || shader_code[j] == '\t'))
-        {
-          ++j;
-          ++length;
-        }
-
-        char include_end_sign;
-        if (shader_code[j] == '"')
-        {
-          include.include_type = IncludeType::Relative;
-          include_end_sign     = '"';
-        }
-        else if (shader_code[j] == '<')
-        {
-          include.include_type = IncludeType::Absolute;
-          include_end_sign     = '>';
-        }
-        else
-        {
-          throw std::runtime_error("Misformed include on line " +
-                                   std::to_string(current_line));
-        }
-
-        size_t       k          = 0;
-        const size_t path_begin = j + 1;
-        while (path_begin + k < shader_code.length() &&
-               shader_code[path_begin + k] != include_end_sign)
-        {
-          ++k;
-          ++length;
-        }
-        if (!(path_begin + k < shader_code.length() &&
-              shader_code[path_begin + k] == include_end_sign))
-        {
-          throw std::runtime_error("Misformed include on line " +
-                                   std::to_string(current_line));
-        }
-
-        include.include_end = path_begin + k;
-
-        include.path = get_sub_string(shader_code, path_begin, k);
-
-        include.length = length;
-
-        includes.push_back(include);
-      }
+      throw std::runtime_error("Misformed include on line " +
+                               std::to_string(line_number));
     }
+
+    file.texts.push_back(std::move(text));
+    file.text_lines.push_back(text_line);
+    file.includes.push_back(Include{
+        std::string(path.substr(1, path.size() - 2)), quoted, line_number});
+
+    text      = {};
+    text_line = line_number + 1;
+  }
+
+  file.texts.push_back(std::move(text));
+  file.text_lines.push_back(text_line);
+
+  return file;
+}
+
+std::shared_ptr<const ShaderPreprocessor::ParsedFile>
+ShaderPreprocessor::get_file(const std::string &path)
+{
+  std::error_code error;
+  const auto      write_time = std::filesystem::last_write_time(path, error);
+  if (error)
+  {
+    throw std::runtime_error("Could not read shader " + path);
   }
 
-  size_t      offset          = 0;
-  std::string new_shader_code = shader_code;
-  for (auto &include : includes)
+  auto &cached = files[path];
+  if (!cached || cached->write_time != write_time)
   {
-    std::string include_content;
-    switch (include.include_type)
+    ParsedFile file{};
+    try
     {
-    case IncludeType::Absolute:
+      file = parse(read_file(path));
+    }
+    catch (const std::runtime_error &exception)
     {
-      bool found = false;
-      for (auto &absolute_include_path : absolute_include_base_paths)
-      {
-        auto content = get_file_content(absolute_include_path + include.path);
-        if (content.has_value())
-        {
-          auto content_to_include = content.value();
-
-          include_content = resolve_includes(
-              strip_file_from_path(absolute_include_path + include.path),
-              content_to_include);
-          found = true;
-          break;
-        }
-      }
-      if (!found)
-      {
-        throw std::runtime_error("Absolute included file " + include.path +
-                                 " not found");
-      }
+      throw std::runtime_error(path + ": " + exception.what());
     }
-    break;
 
-    case IncludeType::Relative:
+    file.write_time = write_time;
+    cached          = std::make_shared<const ParsedFile>(std::move(file));
+  }
+
+  return cached;
+}
+
+std::string
+ShaderPreprocessor::resolve_include(const std::string &including_path,
+                                    const Include &    include) const
+{
+  std::error_code error;
+
+  if (include.relative)
+  {
+    const auto path =
+        std::filesystem::path(including_path).parent_path() / include.path;
+    if (std::filesystem::exists(path, error))
     {
-      auto content = get_file_content(shader_path + include.path);
-      if (content.has_value())
-      {
-        auto content_to_include = content.value();
-
-        include_content =
-            resolve_includes(strip_file_from_path(shader_path + include.path),
-                             content_to_include);
-        break;
-      }
-      throw std::runtime_error("Relative included file " + include.path +
-                               " not found");
+      return std::filesystem::weakly_canonical(path).string();
     }
-    break;
 
-    default:
-      assert(0 && "No such include type");
-    }
+    throw std::runtime_error("Relative included file " + include.path +
+                             " not found");
+  }
 
-    auto old_shader_code = new_shader_code;
-    new_shader_code      = insert_include_content(new_shader_code,
-                                             include.include_begin + offset,
-                                             include.include_end + offset,
-                                             include_content);
-    offset += include_content.length() - include.length - 3;
+  for (const auto &include_path : include_paths)
+  {
+    const auto path = include_path / include.path;
+    if (std::filesystem::exists(path, error))
+    {
+      return std::filesystem::weakly_canonical(path).string();
+    }
   }
 
-  return new_shader_code;
+  throw std::runtime_error("Absolute included file " + include.path +
+                           " not found");
 }
 
-std::string ShaderPreprocessor::add_defines(const std::string &shader_code)
+void ShaderPreprocessor::emit_file(const std::string &path,
+                                   const ParsedFile & file,
+                                   Output &           output)
 {
-  uint32_t i = 0;
-  while (shader_code[i] != '\n')
+  auto &stack = output.include_stack;
+  if (std::find(stack.begin(), stack.end(), path) != stack.end())
   {
-    ++i;
+    throw std::runtime_error("Shader " + path + " includes itself");
   }
-  if (shader_code.length() == i)
+  stack.push_back(path);
+
+  auto index_iter = output.file_indices.find(path);
+  if (index_iter == output.file_indices.end())
   {
-    assert(0 && "Just one line in shader code");
+    const auto index = static_cast<int>(output.shader.files.size());
+    index_iter       = output.file_indices.emplace(path, index).first;
+    output.shader.files.push_back(path);
   }
+  const auto file_index = std::to_string(index_iter->second);
 
-  std::string define_string;
-  for (auto &define : defines)
+  auto &code = output.shader.code;
+  for (std::size_t i = 0; i < file.texts.size(); ++i)
   {
-    define_string += "#define " + define + "\n";
-  }
+    if (!file.texts[i].empty())
+    {
+      code += "#line " + std::to_string(file.text_lines[i]) + " " +
+              file_index + "\n";
+      code += file.texts[i];
+    }
 
-  auto version_string = get_sub_string(shader_code, 0, i + 2);
-  auto after_version = get_sub_string(shader_code, i + 1, shader_code.length());
+    if (i == file.includes.size())
+    {
+      break;
+    }
 
-  return version_string + define_string + after_version;
+    const auto &include      = file.includes[i];
+    const auto  include_path = resolve_include(path, include);
+    if (output.included_once.count(include_path) > 0)
+    {
+      continue;
+    }
+
+    const auto included_file = get_file(include_path);
+    if (!included_file->version.empty())
+    {
+      throw std::runtime_error("Included shader " + include_path +
+                               " has a #version directive");
+    }
+    if (included_file->once)
+    {
+      output.included_once.insert(include_path);
+    }
+
+    emit_file(include_path, *included_file, output);
+  }
+
+  stack.pop_back();
 }
 
-std::string ShaderPreprocessor::preprocess(const std::string &shader_path,
-                                           const std::string &shader_code)
+std::string describe_source_strings(const PreprocessedShader &shader)
 {
-  auto new_shader_code = resolve_includes(shader_path, shader_code);
-  new_shader_code      = add_defines(new_shader_code);
+  std::string description;
+  for (std::size_t i = 0; i < shader.files.size(); ++i)
+  {
+    description += (i > 0 ? ", " : "") + std::to_string(i) + ": " +
+                   shader.files[i];
+  }
 
-  return new_shader_code;
+  return description;
 }
 
 } // namespace Fge
@@ -5,30 +5,108 @@
 namespace Fge
 {
 
+/**
+ * Shader source ready to be compiled.
+ */
+struct PreprocessedShader
+{
+  std::string code;
+
+  // Source string numbers of the #line directives index into this
+  std::vector<std::string> files;
+};
+
+/**
+ * Resolves #include directives of GLSL shaders and adds defines.
+ *
+ * Every file is split at its includes once and kept until it changes on
+ * disk, so shaders that share includes don't read and scan them again.
+ * Files with #pragma once or an include guard are included once per shader.
+ *
+ * A #line directive is emitted after every include, so compiler errors name
+ * the line in the file it came from. The source string number of the
+ * directive is an index into PreprocessedShader::files.
+ */
 class ShaderPreprocessor
 {
 public:
-  ShaderPreprocessor(
-      const std::vector<std::string> &absolute_include_base_paths);
+  /**
+   * @param include_paths Directories that get searched for includes in
+   * angle brackets. Includes in quotes are relative to the including file.
+   */
+  explicit ShaderPreprocessor(
+      const std::vector<std::filesystem::path> &include_paths);
 
-  void set_define(const std::string &define);
-
-  std::string preprocess(const std::string &shader_path,
-                         const std::string &shader_code);
+  /**
+   * The defines get added after the #version directive.
+   *
+   * @throws std::runtime_error If a file can't be read, an include is
+   * misformed or a file includes itself
+   */
+  PreprocessedShader preprocess(const std::filesystem::path &   shader_path,
+                                const std::vector<std::string> &defines);
 
 private:
-  std::vector<std::string> absolute_include_base_paths;
-  std::vector<std::string> defines;
+  struct Include
+  {
+    std::string path;
+    bool        relative = true;
+    uint32_t    line{};
+  };
+
+  /**
+   * A file split at its includes.
+   */
+  struct ParsedFile
+  {
+    std::filesystem::file_time_type write_time{};
+
+    std::string version;
 
-  std::string resolve_includes(const std::string &shader_path,
-                               const std::string &shader_code);
+    // Text around the includes, one more text than includes
+    std::vector<std::string> texts;
+    std::vector<uint32_t>    text_lines;
+    std::vector<Include>     includes;
 
-  std::string insert_include_content(const std::string &shader_code,
-                                     size_t             include_begin,
-                                     size_t             include_end,
-                                     const std::string &include_content);
+    // #pragma once or an include guard
+    bool once = false;
+  };
 
-  std::string add_defines(const std::string &shader_code);
+  /**
+   * State of one preprocess call.
+   */
+  struct Output
+  {
+    PreprocessedShader                   shader;
+    std::unordered_set<std::string>      included_once;
+    std::vector<std::string>             include_stack;
+    std::unordered_map<std::string, int> file_indices;
+  };
+
+  std::vector<std::filesystem::path> include_paths;
+
+  // Keyed by the canonical path
+  std::unordered_map<std::string, std::shared_ptr<const ParsedFile>> files;
+
+  static ParsedFile parse(const std::string &code);
+
+  /**
+   * @return The parsed file, parsed again if it changed on disk
+   */
+  std::shared_ptr<const ParsedFile> get_file(const std::string &path);
+
+  std::string resolve_include(const std::string &including_path,
+                              const Include &    include) const;
+
+  void emit_file(const std::string &path,
+                 const ParsedFile & file,
+                 Output &           output);
 };
 
+/**
+ * @return Which file each source string number stands for, to read
+ * compiler errors with
+ */
+std::string describe_source_strings(const PreprocessedShader &shader);
+
 } // namespace Fge
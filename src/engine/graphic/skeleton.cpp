@@ -1,154 +1,133 @@
 #include "skeleton.hpp"
+#include "profiler/profiler.hpp"
 #include "util/assert.hpp"
 
 namespace Fge
 {
 
-Skeleton::Skeleton(const std::vector<Bone> &bones) : bones(bones)
+Skeleton::Skeleton(std::shared_ptr<const SkeletonAsset> asset)
+    : asset(std::move(asset))
 {
-  transforms.resize(bones.size());
+  FGE_ASSERT(this->asset);
+}
 
-  transforms_identity.reserve(bones.size());
-  for (unsigned i = 0; i < bones.size(); ++i)
-  {
-    transforms_identity.push_back(glm::mat4(1.0f));
-  }
+void Skeleton::play_animation(AnimationHandle handle,
+                              double          current_time_in_seconds)
+{
+  play(handle, false, current_time_in_seconds);
 }
 
-int Skeleton::get_bone_index(const std::string &name)
+void Skeleton::play_animation_endless(AnimationHandle handle,
+                                      double          current_time_in_seconds)
 {
-  for (unsigned i = 0; i < bones.size(); ++i)
+  play(handle, true, current_time_in_seconds);
+}
+
+void Skeleton::play(AnimationHandle handle,
+                    bool            endless,
+                    double          current_time_in_seconds)
+{
+  if (handle >= asset->get_animations_count())
   {
-    if (name == bones[i].name)
-    {
-      return i;
-    }
+    return;
   }
 
-  return -1;
+  animation_start_time = current_time_in_seconds;
+  endless_animation    = endless;
+  active_animation     = handle;
 }
 
-void Skeleton::play_animation(const std::string &name,
-                              double             current_time_in_seconds)
+void Skeleton::stop_current_animation()
 {
-  int animation_index = get_index_of_animation_by_name(name);
-  if (animation_index == -1)
+  active_animation     = SkeletonAsset::invalid_animation_handle;
+  animation_start_time = 0.0;
+  endless_animation    = false;
+}
+
+void Skeleton::stop_finished_animation(double current_time_in_seconds)
+{
+  if (active_animation != SkeletonAsset::invalid_animation_handle &&
+      get_animation_time(current_time_in_seconds) < 0.0)
   {
-    return;
+    stop_current_animation();
   }
+}
 
-  animation_start_time   = current_time_in_seconds;
-  endless_animation      = false;
-  active_animation_index = animation_index;
+const std::vector<glm::mat4> &
+Skeleton::compute_bone_transforms(double current_time_in_seconds)
+{
+  stop_finished_animation(current_time_in_seconds);
+
+  // Only sized on demand, batched evaluation writes elsewhere
+  transforms.resize(asset->get_bones_count());
+  compute_bone_transforms(current_time_in_seconds, transforms.data());
+
+  return transforms;
 }
 
-void Skeleton::play_animation_endless(const std::string &name,
-                                      double current_time_in_seconds)
+void Skeleton::compute_bone_transforms(double     current_time_in_seconds,
+                                       glm::mat4 *result) const
 {
-  int animation_index = get_index_of_animation_by_name(name);
-  if (animation_index == -1)
+  FGE_PROFILE_SCOPE("Skeleton::compute_bone_transforms");
+
+  const auto bones_count    = asset->get_bones_count();
+  const auto animation_time = get_animation_time(current_time_in_seconds);
+  if (animation_time < 0.0)
   {
+    std::fill(result, result + bones_count, glm::mat4(1.0f));
     return;
   }
 
-  animation_start_time   = current_time_in_seconds;
-  endless_animation      = true;
-  active_animation_index = animation_index;
-}
+  const auto &animation = asset->get_animation(active_animation);
 
-int Skeleton::get_index_of_animation_by_name(const std::string &name)
-{
-  for (unsigned i = 0; i < animations.size(); ++i)
+  // Local transforms first, bones without track keep their bind pose
+  for (unsigned i = 0; i < bones_count; ++i)
   {
-    if (animations[i].get_name() == name)
+    if (!animation.has_track(i))
     {
-      return i;
+      result[i] = asset->get_bone(i).local_bind_pose;
     }
   }
-  return -1;
-}
+  animation.sample(animation_time, result);
 
-void Skeleton::stop_current_animation()
-{
-  active_animation_index = -1;
-  animation_start_time   = 0.0f;
-  endless_animation      = false;
+  // Parents come before their children
+  for (unsigned i = 1; i < bones_count; ++i)
+  {
+    result[i] = result[asset->get_bone(i).parent_index] * result[i];
+  }
+
+  for (unsigned i = 0; i < bones_count; ++i)
+  {
+    result[i] = result[i] * asset->get_bone(i).global_inv_bind_pose;
+  }
 }
 
-const std::vector<glm::mat4> &
-Skeleton::compute_bone_transforms(double current_time_in_seconds)
+double Skeleton::get_animation_time(double current_time_in_seconds) const
 {
-  if (active_animation_index == -1)
+  if (active_animation == SkeletonAsset::invalid_animation_handle)
   {
-    return transforms_identity;
+    return -1.0;
   }
 
-  FGE_ASSERT(0 <= active_animation_index &&
-             static_cast<std::size_t>(active_animation_index) <
-                 animations.size());
-
-  const auto &animation = animations[active_animation_index];
+  const auto &animation = asset->get_animation(active_animation);
 
   double ticks_per_second = animation.get_ticks_per_second();
   ticks_per_second        = ticks_per_second != 0 ? ticks_per_second : 25.0f;
   ticks_per_second *= animation_speed;
 
+  // A time sampled just before the animation got started counts as its start
   const auto current_time_in_ticks =
-      (current_time_in_seconds - animation_start_time) * ticks_per_second;
+      std::max(0.0, current_time_in_seconds - animation_start_time) *
+      ticks_per_second;
 
   // Is animation over?
   if (!endless_animation &&
       current_time_in_ticks >= animation.get_duration())
   {
-    active_animation_index = -1;
-    animation_start_time   = 0.0f;
-    endless_animation      = false;
-    return transforms_identity;
-  }
-
-  const auto animation_time =
-      std::fmod(current_time_in_ticks, animation.get_duration());
-
-  // Compute the bone transformations
-  // Root node is special
-  const auto &track = animation.get_track(0);
-  if (track.has_value())
-  {
-    transforms[0] = track.value().interpolate(animation_time);
-  }
-  else
-  {
-    transforms[0] = bones[0].local_bind_pose;
-  }
-
-  for (unsigned i = 1; i < bones.size(); ++i)
-  {
-    auto &      bone  = bones[i];
-    const auto &track = animation.get_track(i);
-
-    if (track.has_value())
-    {
-      transforms[i] = transforms[bone.parent_index] *
-                      track.value().interpolate(animation_time);
-    }
-    else
-    {
-      transforms[i] = transforms[bone.parent_index] * bone.local_bind_pose;
-    }
-  }
-
-  for (unsigned i = 0; i < bones.size(); ++i)
-  {
-    const auto &bone = bones[i];
-    transforms[i]    = transforms[i] * bone.global_inv_bind_pose;
+    return -1.0;
   }
 
-  return transforms;
-}
-
-void Skeleton::add_animation(Animation &animation)
-{
-  animations.push_back(animation);
+  return std::fmod(current_time_in_ticks, animation.get_duration());
 }
 
 } // namespace Fge
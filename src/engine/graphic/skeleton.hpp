@@ -1,54 +1,89 @@
 #pragma once
 
-#include "animation.hpp"
 #include "math/math.hpp"
+#include "skeleton_asset.hpp"
 #include "std.hpp"
 
 namespace Fge
 {
 
+/**
+ * Playback state of one skeleton instance. Bones and animations live in the
+ * shared asset, so copies are cheap.
+ */
 class Skeleton
 {
 public:
-  struct Bone
+  using AnimationHandle = SkeletonAsset::AnimationHandle;
+
+  explicit Skeleton(std::shared_ptr<const SkeletonAsset> asset);
+
+  const std::shared_ptr<const SkeletonAsset> &get_asset() const
   {
-    std::string name;
-    int         parent_index = -1;
-    glm::mat4   local_bind_pose;
-    glm::mat4   global_inv_bind_pose;
-  };
+    return asset;
+  }
 
-  Skeleton(const std::vector<Bone> &bones);
+  int get_bone_index(const std::string &name) const
+  {
+    return asset->get_bone_index(name);
+  }
 
-  int get_bone_index(const std::string &name);
+  unsigned get_bones_count() const { return asset->get_bones_count(); }
 
-  unsigned get_bones_count() const { return bones.size(); }
+  AnimationHandle find_animation(const std::string &name) const
+  {
+    return asset->find_animation(name);
+  }
 
-  void play_animation(const std::string &name, double current_time_in_seconds);
+  /**
+   * Does nothing if the handle is invalid.
+   */
+  void play_animation(AnimationHandle handle, double current_time_in_seconds);
 
-  void play_animation_endless(const std::string &name,
-                              double             current_time_in_seconds);
+  void play_animation_endless(AnimationHandle handle,
+                              double          current_time_in_seconds);
 
   void stop_current_animation();
 
+  void set_animation_speed(double speed) { animation_speed = speed; }
+
+  /**
+   * Stops the active animation if it is not endless and over at the given
+   * time.
+   */
+  void stop_finished_animation(double current_time_in_seconds);
+
   const std::vector<glm::mat4> &
   compute_bone_transforms(double current_time_in_seconds);
 
-  void add_animation(Animation &animation);
+  /**
+   * Writes the transforms of all bones at the given time to result, which
+   * must have room for get_bones_count() matrices. Does not change the
+   * skeleton, so several skeletons can be evaluated on different threads.
+   * Finished animations yield identity transforms.
+   */
+  void compute_bone_transforms(double     current_time_in_seconds,
+                               glm::mat4 *result) const;
 
 private:
-  std::vector<Bone> bones;
+  std::shared_ptr<const SkeletonAsset> asset;
 
+  // Pose of the last compute_bone_transforms call that returned a vector
   std::vector<glm::mat4> transforms;
-  std::vector<glm::mat4> transforms_identity;
 
-  double                          animation_speed        = 1.0f;
-  double                          animation_start_time   = 0.0f;
-  bool                            endless_animation      = false;
-  int                             active_animation_index = -1;
-  std::vector<Animation>          animations;
+  double          animation_speed      = 1.0;
+  double          animation_start_time = 0.0;
+  bool            endless_animation    = false;
+  AnimationHandle active_animation = SkeletonAsset::invalid_animation_handle;
+
+  void play(AnimationHandle handle,
+            bool            endless,
+            double          current_time_in_seconds);
 
-  int get_index_of_animation_by_name(const std::string &name);
+  /**
+   * @return Negative if no animation is active or the active one is over
+   */
+  double get_animation_time(double current_time_in_seconds) const;
 };
 
 } // namespace Fge
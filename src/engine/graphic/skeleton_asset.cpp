@@ -0,0 +1,49 @@
+#include "skeleton_asset.hpp"
+
+namespace Fge
+{
+
+SkeletonAsset::SkeletonAsset(const std::vector<Bone> &bones) : bones(bones)
+{
+  for (unsigned i = 1; i < bones.size(); ++i)
+  {
+    FGE_ASSERT(bones[i].parent_index >= 0 &&
+               static_cast<unsigned>(bones[i].parent_index) < i);
+  }
+}
+
+int SkeletonAsset::get_bone_index(const std::string &name) const
+{
+  for (unsigned i = 0; i < bones.size(); ++i)
+  {
+    if (name == bones[i].name)
+    {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+SkeletonAsset::AnimationHandle
+SkeletonAsset::add_animation(const CompiledAnimation &animation)
+{
+  const auto handle = static_cast<AnimationHandle>(animations.size());
+  animations.push_back(animation);
+
+  // Names should be unique. If not, the first animation with the name is
+  // found.
+  animation_handles.emplace(animation.get_name(), handle);
+
+  return handle;
+}
+
+SkeletonAsset::AnimationHandle
+SkeletonAsset::find_animation(const std::string &name) const
+{
+  const auto iter = animation_handles.find(name);
+  return iter != animation_handles.end() ? iter->second
+                                         : invalid_animation_handle;
+}
+
+} // namespace Fge
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "compiled_animation.hpp"
+#include "math/math.hpp"
+#include "std.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+/**
+ * Bones and animation clips of a skeleton. They don't change once the asset
+ * is loaded, so all instances of a mesh share one asset and only keep their
+ * own playback state.
+ */
+class SkeletonAsset
+{
+public:
+  using AnimationHandle = uint32_t;
+
+  static constexpr AnimationHandle invalid_animation_handle =
+      std::numeric_limits<AnimationHandle>::max();
+
+  struct Bone
+  {
+    std::string name;
+    int         parent_index = -1;
+    glm::mat4   local_bind_pose;
+    glm::mat4   global_inv_bind_pose;
+  };
+
+  /**
+   * Parents must come before their children.
+   */
+  explicit SkeletonAsset(const std::vector<Bone> &bones);
+
+  /**
+   * @return -1 if there is no bone with the name
+   */
+  int get_bone_index(const std::string &name) const;
+
+  unsigned get_bones_count() const { return bones.size(); }
+
+  const Bone &get_bone(unsigned index) const
+  {
+    FGE_ASSERT(index < bones.size());
+    return bones[index];
+  }
+
+  /**
+   * Only meant for loading. The asset must not change once it is shared.
+   */
+  AnimationHandle add_animation(const CompiledAnimation &animation);
+
+  /**
+   * Resolve handles once and keep them, playing by handle does no lookup.
+   *
+   * @return Invalid handle if there is no animation with the name
+   */
+  AnimationHandle find_animation(const std::string &name) const;
+
+  const CompiledAnimation &get_animation(AnimationHandle handle) const
+  {
+    FGE_ASSERT(handle < animations.size());
+    return animations[handle];
+  }
+
+  std::size_t get_animations_count() const { return animations.size(); }
+
+private:
+  std::vector<Bone>              bones;
+  std::vector<CompiledAnimation> animations;
+
+  std::unordered_map<std::string, AnimationHandle> animation_handles;
+};
+
+} // namespace Fge
@@ -9,9 +9,14 @@ namespace Fge
 SkinnedSubMesh::SkinnedSubMesh(
     const std::string &                         name,
     std::shared_ptr<std::vector<VertexPNTBBWT>> vertices,
+    const std::vector<PackedVertexPNTBBWT> &    packed_vertices,
     std::shared_ptr<std::vector<uint32_t>>      indices,
     std::shared_ptr<MeshMaterial>               material)
-    : SubMeshBase<VertexPNTBBWT>(name, vertices, indices, material)
+    : SubMeshBase<VertexPNTBBWT>(name,
+                                 vertices,
+                                 packed_vertices,
+                                 indices,
+                                 material)
 {
   material->set_skinned_mesh(true);
 }
@@ -44,17 +49,27 @@ SkinnedMesh::SkinnedMesh(
 }
 
 void SkinnedMesh::play_animation(const std::string &name)
+{
+  play_animation(skeleton.find_animation(name));
+}
+
+void SkinnedMesh::play_animation(Skeleton::AnimationHandle handle)
 {
   double current_time = static_cast<double>(get_current_time_millis());
   current_time /= 1000;
-  skeleton.play_animation(name, current_time);
+  skeleton.play_animation(handle, current_time);
 }
 
 void SkinnedMesh::play_animation_endless(const std::string &name)
+{
+  play_animation_endless(skeleton.find_animation(name));
+}
+
+void SkinnedMesh::play_animation_endless(Skeleton::AnimationHandle handle)
 {
   double current_time = static_cast<double>(get_current_time_millis());
   current_time /= 1000;
-  skeleton.play_animation_endless(name, current_time);
+  skeleton.play_animation_endless(handle, current_time);
 }
 
 void SkinnedMesh::stop_current_animation()
@@ -11,6 +11,7 @@ class SkinnedSubMesh : public SubMeshBase<VertexPNTBBWT>
 public:
   SkinnedSubMesh(const std::string &                         name,
                  std::shared_ptr<std::vector<VertexPNTBBWT>> vertices,
+                 const std::vector<PackedVertexPNTBBWT> &    packed_vertices,
                  std::shared_ptr<std::vector<uint32_t>>      indices,
                  std::shared_ptr<MeshMaterial>               material);
 
@@ -30,13 +31,17 @@ public:
 
   void play_animation(const std::string &name);
 
+  void play_animation(Skeleton::AnimationHandle handle);
+
   void play_animation_endless(const std::string &name);
 
+  void play_animation_endless(Skeleton::AnimationHandle handle);
+
   void stop_current_animation();
 
   const std::vector<glm::mat4> &compute_bone_transforms();
 
-  const Skeleton &get_skeleton() { return skeleton; }
+  Skeleton &get_skeleton() { return skeleton; }
 
 protected:
   Skeleton skeleton;
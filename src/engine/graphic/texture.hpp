@@ -33,7 +33,7 @@ struct Texture2DConfig
   std::string   name{};
   uint32_t      width{};
   uint32_t      height{};
-  void *        data{};
+  const void *  data{};
   ImageFormat   format = ImageFormat::Rgb;
 
   WrapMode      wrap_s          = WrapMode::Repeat;
@@ -44,6 +44,10 @@ struct Texture2DConfig
 
   bool     generate_mipmap = false;
   uint32_t samples         = 0;
+
+  // Levels 1 and up, each half the size of the level before. Uploaded
+  // instead of generating the mipmap.
+  std::vector<const void *> mip_data{};
 };
 
 class Texture2D
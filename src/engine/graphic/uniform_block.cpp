@@ -0,0 +1,272 @@
+#include "uniform_block.hpp"
+
+namespace Fge
+{
+
+UniformHandle UniformBlock::get_handle(const std::string &name,
+                                       UniformType        type)
+{
+  for (std::size_t i = 0; i < slots.size(); ++i)
+  {
+    if (slots[i].name == name)
+    {
+      FGE_ASSERT(slots[i].type == type);
+      return static_cast<UniformHandle>(i);
+    }
+  }
+
+  auto &slot = slots.emplace_back();
+  slot.name  = name;
+  slot.type  = type;
+
+  if (type == UniformType::Texture2D)
+  {
+    slot.offset = static_cast<uint32_t>(textures.size());
+    textures.emplace_back();
+  }
+
+  locations_dirty   = true;
+  shared_hash_dirty = true;
+
+  return static_cast<UniformHandle>(slots.size() - 1);
+}
+
+void UniformBlock::set(UniformHandle                 handle,
+                       const std::vector<glm::mat4> &value)
+{
+  set_data(handle,
+           UniformType::Mat4,
+           value.data(),
+           static_cast<uint32_t>(value.size()));
+}
+
+void UniformBlock::set(UniformHandle                     handle,
+                       const std::shared_ptr<Texture2D> &value)
+{
+  FGE_ASSERT(handle < slots.size());
+
+  auto &slot = slots[handle];
+  FGE_ASSERT(slot.type == UniformType::Texture2D);
+
+  textures[slot.offset] = value;
+  slot.count            = value ? 1 : 0;
+  shared_hash_dirty     = shared_hash_dirty || !slot.per_instance;
+}
+
+void UniformBlock::set_data(UniformHandle handle,
+                            UniformType   type,
+                            const void *  value,
+                            uint32_t      count)
+{
+  FGE_ASSERT(handle < slots.size());
+
+  auto &slot = slots[handle];
+  FGE_ASSERT(slot.type == type);
+
+  const auto size = get_type_size(type) * count;
+
+  // Grow by appending. The old range is left unused, which only happens
+  // when arrays get bigger.
+  if (count > slot.capacity)
+  {
+    // Keep every value 16 byte aligned
+    const auto offset = (data.size() + 15) & ~std::size_t(15);
+    data.resize(offset + size);
+
+    slot.offset   = static_cast<uint32_t>(offset);
+    slot.capacity = count;
+  }
+
+  std::memcpy(data.data() + slot.offset, value, size);
+  slot.count        = count;
+  shared_hash_dirty = shared_hash_dirty || !slot.per_instance;
+}
+
+uint32_t UniformBlock::bind(const std::shared_ptr<Shader> &shader,
+                            uint32_t                       texture_bind_point)
+{
+  if (shader != resolved_shader)
+  {
+    resolved_shader = shader;
+    locations_dirty = true;
+  }
+
+  if (locations_dirty)
+  {
+    resolve_locations();
+  }
+
+  for (const auto &slot : slots)
+  {
+    if (slot.location < 0 || slot.count == 0)
+    {
+      continue;
+    }
+
+    if (slot.type == UniformType::Texture2D)
+    {
+      const auto bind_point = static_cast<int32_t>(texture_bind_point);
+      textures[slot.offset]->bind(texture_bind_point);
+      shader->set_uniform(slot.location, slot.type, &bind_point);
+      ++texture_bind_point;
+      continue;
+    }
+
+    shader->set_uniform(slot.location,
+                        slot.type,
+                        data.data() + slot.offset,
+                        slot.count);
+  }
+
+  return texture_bind_point;
+}
+
+void UniformBlock::set_per_instance(UniformHandle handle)
+{
+  FGE_ASSERT(handle < slots.size());
+
+  slots[handle].per_instance = true;
+  shared_hash_dirty          = true;
+}
+
+uint32_t UniformBlock::get_shared_hash()
+{
+  if (!shared_hash_dirty)
+  {
+    return shared_hash;
+  }
+
+  // FNV-1a over the type, count and value of every shared uniform
+  uint32_t   hash       = 2166136261u;
+  const auto hash_bytes = [&hash](const void *bytes, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      hash = (hash ^ static_cast<const uint8_t *>(bytes)[i]) * 16777619u;
+    }
+  };
+
+  for (const auto &slot : slots)
+  {
+    if (slot.per_instance)
+    {
+      continue;
+    }
+
+    hash_bytes(&slot.type, sizeof(slot.type));
+    hash_bytes(&slot.count, sizeof(slot.count));
+    if (slot.type == UniformType::Texture2D)
+    {
+      const auto texture = textures[slot.offset].get();
+      hash_bytes(&texture, sizeof(texture));
+    }
+    else
+    {
+      hash_bytes(data.data() + slot.offset,
+                 get_type_size(slot.type) * slot.count);
+    }
+  }
+
+  shared_hash       = hash;
+  shared_hash_dirty = false;
+
+  return shared_hash;
+}
+
+bool UniformBlock::has_same_shared_values(const UniformBlock &other) const
+{
+  if (slots.size() != other.slots.size())
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < slots.size(); ++i)
+  {
+    const auto &slot       = slots[i];
+    const auto &other_slot = other.slots[i];
+
+    if (slot.type != other_slot.type ||
+        slot.per_instance != other_slot.per_instance ||
+        slot.name != other_slot.name)
+    {
+      return false;
+    }
+
+    if (slot.per_instance)
+    {
+      continue;
+    }
+
+    if (slot.count != other_slot.count)
+    {
+      return false;
+    }
+
+    if (slot.type == UniformType::Texture2D)
+    {
+      if (textures[slot.offset] != other.textures[other_slot.offset])
+      {
+        return false;
+      }
+      continue;
+    }
+
+    if (std::memcmp(data.data() + slot.offset,
+                    other.data.data() + other_slot.offset,
+                    get_type_size(slot.type) * slot.count) != 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void UniformBlock::resolve_locations()
+{
+  for (auto &slot : slots)
+  {
+    slot.location =
+        resolved_shader ? resolved_shader->get_uniform_location(slot.name) : -1;
+  }
+  locations_dirty = false;
+}
+
+uint32_t UniformBlock::get_type_size(UniformType type)
+{
+  switch (type)
+  {
+  case UniformType::Bool:
+  case UniformType::Int:
+  case UniformType::Texture2D:
+    return sizeof(int32_t);
+
+  case UniformType::Float:
+    return sizeof(float);
+
+  case UniformType::Vec2:
+    return sizeof(glm::vec2);
+
+  case UniformType::IVec2:
+    return sizeof(glm::ivec2);
+
+  case UniformType::Vec3:
+    return sizeof(glm::vec3);
+
+  case UniformType::Vec4:
+    return sizeof(glm::vec4);
+
+  case UniformType::Mat2:
+    return sizeof(glm::mat2);
+
+  case UniformType::Mat3:
+    return sizeof(glm::mat3);
+
+  case UniformType::Mat4:
+    return sizeof(glm::mat4);
+
+  default:
+    FGE_FAIL("No such uniform type");
+  }
+}
+
+} // namespace Fge
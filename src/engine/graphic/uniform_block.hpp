@@ -0,0 +1,142 @@
+#pragma once
+
+#include "math/math.hpp"
+#include "shader.hpp"
+#include "std.hpp"
+#include "texture.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+/**
+ * Index of a uniform inside a UniformBlock. Stays valid for the lifetime of
+ * the block and in copies of it.
+ */
+using UniformHandle = uint32_t;
+
+constexpr UniformHandle invalid_uniform_handle =
+    std::numeric_limits<UniformHandle>::max();
+
+/**
+ * Maps a C++ value type to its UniformType and to the type it is stored as.
+ */
+template <typename T> struct UniformTraits;
+
+#define FGE_UNIFORM_TRAITS(TYPE, UNIFORM_TYPE, STORAGE_TYPE)                   \
+  template <> struct UniformTraits<TYPE>                                       \
+  {                                                                            \
+    static constexpr UniformType type = UNIFORM_TYPE;                          \
+    using StorageType                 = STORAGE_TYPE;                          \
+  };
+
+FGE_UNIFORM_TRAITS(bool, UniformType::Bool, int32_t)
+FGE_UNIFORM_TRAITS(int32_t, UniformType::Int, int32_t)
+FGE_UNIFORM_TRAITS(float, UniformType::Float, float)
+FGE_UNIFORM_TRAITS(glm::vec2, UniformType::Vec2, glm::vec2)
+FGE_UNIFORM_TRAITS(glm::ivec2, UniformType::IVec2, glm::ivec2)
+FGE_UNIFORM_TRAITS(glm::vec3, UniformType::Vec3, glm::vec3)
+FGE_UNIFORM_TRAITS(glm::vec4, UniformType::Vec4, glm::vec4)
+FGE_UNIFORM_TRAITS(glm::mat2, UniformType::Mat2, glm::mat2)
+FGE_UNIFORM_TRAITS(glm::mat3, UniformType::Mat3, glm::mat3)
+FGE_UNIFORM_TRAITS(glm::mat4, UniformType::Mat4, glm::mat4)
+FGE_UNIFORM_TRAITS(std::vector<glm::mat4>, UniformType::Mat4, glm::mat4)
+FGE_UNIFORM_TRAITS(std::shared_ptr<Texture2D>, UniformType::Texture2D, int32_t)
+
+#undef FGE_UNIFORM_TRAITS
+
+/**
+ * Uniform values of a material, stored in one flat byte block.
+ *
+ * Names get resolved to handles once, when the uniform is added. Shader
+ * locations get resolved once per shader. Setting a value is a copy into
+ * the block and binding is a loop over all uniforms without any string
+ * lookups.
+ */
+class UniformBlock
+{
+public:
+  /**
+   * Returns the handle of the uniform with the given name. The uniform gets
+   * added if it doesn't exist yet. It has no value until it is set, and
+   * uniforms without value are not sent to the shader.
+   */
+  template <typename T> UniformHandle get_handle(const std::string &name)
+  {
+    return get_handle(name, UniformTraits<T>::type);
+  }
+
+  UniformHandle get_handle(const std::string &name, UniformType type);
+
+  template <typename T> void set(UniformHandle handle, const T &value)
+  {
+    using StorageType = typename UniformTraits<T>::StorageType;
+
+    const StorageType storage_value = static_cast<StorageType>(value);
+    set_data(handle, UniformTraits<T>::type, &storage_value, 1);
+  }
+
+  void set(UniformHandle handle, const std::vector<glm::mat4> &value);
+
+  void set(UniformHandle handle, const std::shared_ptr<Texture2D> &value);
+
+  /**
+   * Sends all uniforms that have a value to the shader. Locations are
+   * resolved again if the shader differs from the last call.
+   *
+   * @return Next free texture bind point
+   */
+  uint32_t bind(const std::shared_ptr<Shader> &shader,
+                uint32_t                       texture_bind_point = 0);
+
+  /**
+   * Marks a uniform whose value differs per drawn instance, like the world
+   * matrix. It is left out when blocks get compared.
+   */
+  void set_per_instance(UniformHandle handle);
+
+  /**
+   * Hash of all uniforms that are not per instance. Blocks with the same
+   * shared values have the same hash.
+   */
+  uint32_t get_shared_hash();
+
+  /**
+   * @return True if all uniforms that are not per instance have the same
+   * names and values in both blocks
+   */
+  bool has_same_shared_values(const UniformBlock &other) const;
+
+  std::size_t get_count() const { return slots.size(); }
+
+private:
+  struct Slot
+  {
+    std::string name{};
+    UniformType type{};
+    uint32_t    offset{};
+    uint32_t    count{};
+    uint32_t    capacity{};
+    int32_t     location     = -1;
+    bool        per_instance = false;
+  };
+
+  std::vector<Slot>                       slots;
+  std::vector<uint8_t>                    data;
+  std::vector<std::shared_ptr<Texture2D>> textures;
+  std::shared_ptr<Shader>                 resolved_shader;
+  bool                                    locations_dirty   = true;
+  bool                                    shared_hash_dirty = true;
+  uint32_t                                shared_hash{};
+
+  void set_data(UniformHandle handle,
+                UniformType   type,
+                const void *  value,
+                uint32_t      count);
+
+  void resolve_locations();
+
+  static uint32_t get_type_size(UniformType type);
+};
+
+} // namespace Fge
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * GPU buffer holding uniform block data shared by all shaders that declare
+ * a block with the same binding point.
+ */
+class UniformBuffer
+{
+public:
+  UniformBuffer() = default;
+
+  virtual ~UniformBuffer() = default;
+
+  /**
+   * Copies size bytes from data into the buffer, starting at offset.
+   */
+  virtual void
+  set_data(const void *data, std::size_t size, std::size_t offset = 0) = 0;
+
+  /**
+   * Makes the buffer available to all uniform blocks declared with
+   * `layout (std140, binding = binding_point)`.
+   */
+  virtual void bind(uint32_t binding_point) const = 0;
+
+  virtual std::size_t get_size() const = 0;
+
+  template <typename T> void set_data(const T &data)
+  {
+    set_data(&data, sizeof(T));
+  }
+
+private:
+  UniformBuffer(const UniformBuffer &other) = delete;
+
+  void operator=(const UniformBuffer &other) = delete;
+};
+
+} // namespace Fge
@@ -14,11 +14,18 @@ UnlitMaterial::UnlitMaterial() : MeshMaterial("Unlit Material")
   shader = renderer->create_shader("unlit.vert",
                                    "unlit.frag",
                                    std::vector<std::string>{});
+
+  init_uniform_handles();
+}
+
+void UnlitMaterial::init_uniform_handles()
+{
+  world_mat_handle = get_uniform_handle<glm::mat4>("world_mat");
+  color_handle     = get_uniform_handle<glm::vec3>("color");
 }
 
 void UnlitMaterial::bind(uint32_t texture_bind_point)
 {
-  shader->bind();
   bind_uniforms(shader, texture_bind_point);
 }
 
@@ -31,16 +38,15 @@ void UnlitMaterial::set_rigid_mesh(bool /*value*/) {}
 
 void UnlitMaterial::set_world_matrix(const glm::mat4 &world_mat)
 {
-  set_uniform("world_mat", world_mat);
+  set_uniform(world_mat_handle, world_mat);
 }
 
 void UnlitMaterial::set_color(const glm::vec3 &color)
 {
-  set_uniform("color", color);
+  set_uniform(color_handle, color);
 }
 
-void UnlitMaterial::set_bone_transforms(
-    const std::vector<glm::mat4> & /*bones*/)
+void UnlitMaterial::set_first_bone(uint32_t /*first_bone*/)
 {
   FGE_FAIL("Unlit Material can not handle bones");
 }
@@ -49,14 +55,10 @@ std::shared_ptr<Material> UnlitMaterial::clone()
 {
   auto new_material = std::make_shared<UnlitMaterial>();
 
+  new_material->uniforms = uniforms;
+  new_material->init_uniform_handles();
   new_material->set_world_matrix(glm::mat4(1.0f));
 
-  for (const auto &uniform : uniforms)
-  {
-    auto new_uniform = uniform->clone();
-    new_material->uniforms.push_back(new_uniform);
-  }
-
   return new_material;
 }
 
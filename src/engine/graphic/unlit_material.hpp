@@ -11,13 +11,15 @@ public:
 
   void bind(uint32_t texture_bind_point = 0) override;
 
+  std::shared_ptr<Shader> get_shader() override { return shader; }
+
   void set_skinned_mesh(bool value) override;
 
   void set_rigid_mesh(bool value) override;
 
   void set_world_matrix(const glm::mat4 &world_mat) override;
 
-  void set_bone_transforms(const std::vector<glm::mat4> &bones) override;
+  void set_first_bone(uint32_t first_bone) override;
 
   void set_color(const glm::vec3 &color);
 
@@ -25,6 +27,11 @@ public:
 
 private:
   std::shared_ptr<Shader> shader{};
+
+  UniformHandle world_mat_handle = invalid_uniform_handle;
+  UniformHandle color_handle     = invalid_uniform_handle;
+
+  void init_uniform_handles();
 };
 
 } // namespace Fge
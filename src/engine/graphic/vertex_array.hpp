@@ -24,6 +24,8 @@ public:
 
   virtual uint32_t get_count() const = 0;
 
+  virtual uint32_t get_id() const = 0;
+
 private:
   VertexArray(const VertexArray &other) = delete;
 
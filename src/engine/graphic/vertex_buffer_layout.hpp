@@ -51,6 +51,23 @@ public:
 
   virtual void push_int(std::size_t size) = 0;
 
+  /**
+   * Signed 16 bit integers the shader reads as floats in [-1, 1].
+   */
+  virtual void push_short_normalized(std::size_t size) = 0;
+
+  virtual void push_half_float(std::size_t size) = 0;
+
+  /**
+   * Unsigned 8 bit integers the shader reads as integers.
+   */
+  virtual void push_ubyte(std::size_t size) = 0;
+
+  /**
+   * Unsigned 8 bit integers the shader reads as floats in [0, 1].
+   */
+  virtual void push_ubyte_normalized(std::size_t size) = 0;
+
   void set_stride(const std::size_t stride) { this->stride = stride; }
 
 protected:
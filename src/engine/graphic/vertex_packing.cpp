@@ -0,0 +1,164 @@
+#include "vertex_packing.hpp"
+#include "util/assert.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+namespace Fge
+{
+
+namespace
+{
+
+constexpr float snorm16_max = 32767.0f;
+
+float sign_not_zero(float value) { return value < 0.0f ? -1.0f : 1.0f; }
+
+/**
+ * Maps between the lower half of the octahedron and the corners of the
+ * square around the upper half.
+ */
+glm::vec2 fold(const glm::vec2 &value)
+{
+  return glm::vec2((1.0f - std::abs(value.y)) * sign_not_zero(value.x),
+                   (1.0f - std::abs(value.x)) * sign_not_zero(value.y));
+}
+
+glm::u16vec2 pack_tex_coord(const glm::vec2 &tex_coord)
+{
+  return glm::u16vec2(glm::packHalf1x16(tex_coord.x),
+                      glm::packHalf1x16(tex_coord.y));
+}
+
+glm::i16vec4 pack_normal_tangent(const glm::vec3 &normal,
+                                 const glm::vec3 &tangent,
+                                 const glm::vec3 &bitangent)
+{
+  const auto encoded_normal  = encode_octahedral(normal);
+  const auto encoded_tangent = encode_octahedral(tangent);
+
+  const auto handedness =
+      glm::dot(glm::cross(normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+
+  // Kept above zero, so the sign survives the quantization
+  const auto tangent_y =
+      std::max(encoded_tangent.y * 0.5f + 0.5f, 1.0f / snorm16_max);
+
+  return glm::i16vec4(pack_snorm16(encoded_normal.x),
+                      pack_snorm16(encoded_normal.y),
+                      pack_snorm16(encoded_tangent.x),
+                      pack_snorm16(tangent_y * handedness));
+}
+
+} // namespace
+
+glm::vec2 encode_octahedral(const glm::vec3 &direction)
+{
+  const auto length_sum =
+      std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+  if (length_sum == 0.0f)
+  {
+    return glm::vec2(0.0f);
+  }
+
+  const auto projected = direction / length_sum;
+  const auto encoded   = glm::vec2(projected.x, projected.y);
+
+  return projected.z >= 0.0f ? encoded : fold(encoded);
+}
+
+glm::vec3 decode_octahedral(const glm::vec2 &encoded)
+{
+  glm::vec3 direction(
+      encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+  if (direction.z < 0.0f)
+  {
+    const auto unfolded = fold(encoded);
+    direction           = glm::vec3(unfolded.x, unfolded.y, direction.z);
+  }
+
+  return glm::normalize(direction);
+}
+
+int16_t pack_snorm16(float value)
+{
+  return static_cast<int16_t>(
+      std::round(std::clamp(value, -1.0f, 1.0f) * snorm16_max));
+}
+
+float unpack_snorm16(int16_t value)
+{
+  return std::max(static_cast<float>(value) / snorm16_max, -1.0f);
+}
+
+glm::u8vec4 pack_skin_weights(const glm::vec4 &weights)
+{
+  const auto sum = weights.x + weights.y + weights.z + weights.w;
+  if (sum <= 0.0f)
+  {
+    return glm::u8vec4(255, 0, 0, 0);
+  }
+
+  glm::u8vec4 packed(0);
+  int         total   = 0;
+  int         largest = 0;
+  for (int i = 0; i < 4; ++i)
+  {
+    packed[i] = static_cast<uint8_t>(
+        std::round(std::clamp(weights[i] / sum, 0.0f, 1.0f) * 255.0f));
+    total += packed[i];
+    largest = weights[i] > weights[largest] ? i : largest;
+  }
+
+  // Rounding errors go to the largest weight, where they matter least
+  packed[largest] = static_cast<uint8_t>(packed[largest] + 255 - total);
+
+  return packed;
+}
+
+PackedVertexPNTBT pack_vertex(const VertexPNTBT &vertex)
+{
+  PackedVertexPNTBT packed{};
+  packed.position       = vertex.position;
+  packed.normal_tangent = pack_normal_tangent(
+      vertex.normal, vertex.tangent, vertex.bitangent);
+  packed.tex_coord = pack_tex_coord(vertex.tex_coord);
+
+  return packed;
+}
+
+PackedVertexPNTBBWT pack_vertex(const VertexPNTBBWT &vertex)
+{
+  PackedVertexPNTBBWT packed{};
+  packed.position       = vertex.position;
+  packed.normal_tangent = pack_normal_tangent(
+      vertex.normal, vertex.tangent, vertex.bitangent);
+  packed.skin_weights = pack_skin_weights(vertex.skin_weights);
+  packed.tex_coord    = pack_tex_coord(vertex.tex_coord);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    FGE_ASSERT(vertex.skin_bones[i] >= 0 &&
+               static_cast<std::size_t>(vertex.skin_bones[i]) <
+                   max_packed_bone_count);
+    packed.skin_bones[i] = static_cast<uint8_t>(vertex.skin_bones[i]);
+  }
+
+  return packed;
+}
+
+void unpack_normal_tangent(const glm::i16vec4 &normal_tangent,
+                           glm::vec3 &         normal,
+                           glm::vec3 &         tangent,
+                           glm::vec3 &         bitangent)
+{
+  const auto tangent_y  = unpack_snorm16(normal_tangent.w);
+  const auto handedness = tangent_y < 0.0f ? -1.0f : 1.0f;
+
+  normal  = decode_octahedral(glm::vec2(unpack_snorm16(normal_tangent.x),
+                                       unpack_snorm16(normal_tangent.y)));
+  tangent = decode_octahedral(glm::vec2(unpack_snorm16(normal_tangent.z),
+                                        std::abs(tangent_y) * 2.0f - 1.0f));
+  bitangent = glm::cross(normal, tangent) * handedness;
+}
+
+} // namespace Fge
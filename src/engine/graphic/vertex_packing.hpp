@@ -0,0 +1,68 @@
+#pragma once
+
+#include "std.hpp"
+#include "vertices.hpp"
+
+namespace Fge
+{
+
+/**
+ * Bone indices of packed vertices are 8 bit.
+ */
+constexpr std::size_t max_packed_bone_count = 256;
+
+/**
+ * Maps a direction onto the octahedron unfolded into [-1, 1]^2.
+ * res/shaders/vertex_packing.glsl decodes it.
+ */
+glm::vec2 encode_octahedral(const glm::vec3 &direction);
+
+glm::vec3 decode_octahedral(const glm::vec2 &encoded);
+
+int16_t pack_snorm16(float value);
+
+float unpack_snorm16(int16_t value);
+
+/**
+ * Quantizes the weights to unorm8 so that they still sum up to 255.
+ */
+glm::u8vec4 pack_skin_weights(const glm::vec4 &weights);
+
+/**
+ * The bitangent is not stored. Its sign relative to cross(normal, tangent)
+ * is stored as sign of the last component of normal_tangent. The tangent's
+ * second octahedral coordinate is mapped to [0, 1] for that.
+ */
+PackedVertexPNTBT pack_vertex(const VertexPNTBT &vertex);
+
+PackedVertexPNTBBWT pack_vertex(const VertexPNTBBWT &vertex);
+
+/**
+ * Reverse of the normal and tangent packing, also derives the bitangent.
+ */
+void unpack_normal_tangent(const glm::i16vec4 &normal_tangent,
+                           glm::vec3 &         normal,
+                           glm::vec3 &         tangent,
+                           glm::vec3 &         bitangent);
+
+/**
+ * Layout a vertex of type TVertex gets uploaded with.
+ */
+template <typename TVertex>
+using PackedVertex = decltype(pack_vertex(std::declval<TVertex>()));
+
+template <typename TVertex>
+std::vector<PackedVertex<TVertex>>
+pack_vertices(const std::vector<TVertex> &vertices)
+{
+  std::vector<PackedVertex<TVertex>> packed;
+  packed.reserve(vertices.size());
+  for (const auto &vertex : vertices)
+  {
+    packed.push_back(pack_vertex(vertex));
+  }
+
+  return packed;
+}
+
+} // namespace Fge
@@ -37,4 +37,34 @@ struct VertexPNTBBWT
   glm::vec2  tex_coord    = glm::vec2(0.0f);
 };
 
+/**
+ * VertexPNTBT as it gets uploaded.
+ *
+ * Normal and tangent are octahedral encoded snorm16 pairs. The sign of the
+ * last component is the handedness the bitangent is derived with, see
+ * vertex_packing.hpp. The texture coordinates are half floats.
+ */
+struct PackedVertexPNTBT
+{
+  glm::vec3    position{0.0f};
+  glm::i16vec4 normal_tangent{0};
+  glm::u16vec2 tex_coord{0};
+};
+
+/**
+ * VertexPNTBBWT as it gets uploaded. Packed like PackedVertexPNTBT, the
+ * bone indices are 8 bit and the weights unorm8.
+ */
+struct PackedVertexPNTBBWT
+{
+  glm::vec3    position{0.0f};
+  glm::i16vec4 normal_tangent{0};
+  glm::u8vec4  skin_bones{0};
+  glm::u8vec4  skin_weights{0};
+  glm::u16vec2 tex_coord{0};
+};
+
+static_assert(sizeof(PackedVertexPNTBT) == 24);
+static_assert(sizeof(PackedVertexPNTBBWT) == 32);
+
 } // namespace Fge
@@ -0,0 +1,301 @@
+#include "job_system.hpp"
+#include "profiler/profiler.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+namespace
+{
+
+// Identifies the queue of the current thread. Threads that are not workers of
+// a job system use slot 0.
+thread_local const JobSystem *current_job_system = nullptr;
+thread_local std::size_t      current_queue_index = 0;
+
+} // namespace
+
+JobSystem::JobSystem(std::size_t worker_count)
+{
+  if (worker_count == 0)
+  {
+    const std::size_t hardware_threads = std::thread::hardware_concurrency();
+    worker_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+  }
+
+  // Slot 0 belongs to threads that are not workers
+  for (std::size_t i = 0; i < worker_count + 1; ++i)
+  {
+    queues.push_back(std::make_unique<JobQueue>());
+  }
+
+  for (std::size_t i = 1; i < worker_count + 1; ++i)
+  {
+    workers.emplace_back(&JobSystem::worker_main, this, i);
+  }
+}
+
+JobSystem::~JobSystem()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    running = false;
+  }
+  sleep_condition.notify_all();
+
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+}
+
+std::shared_ptr<JobCounter>
+JobSystem::schedule(JobFunction function, std::shared_ptr<JobCounter> counter)
+{
+  FGE_ASSERT(function);
+
+  if (!counter)
+  {
+    counter = std::make_shared<JobCounter>();
+  }
+
+  counter->pending.fetch_add(1, std::memory_order_relaxed);
+  push_job(Job{std::move(function), counter});
+
+  return counter;
+}
+
+std::shared_ptr<JobCounter>
+JobSystem::schedule_after(const std::shared_ptr<JobCounter> &dependency,
+                          JobFunction                        function)
+{
+  FGE_ASSERT(dependency);
+  FGE_ASSERT(function);
+
+  auto counter = std::make_shared<JobCounter>();
+  counter->pending.fetch_add(1, std::memory_order_relaxed);
+  Job job{std::move(function), counter};
+
+  {
+    std::lock_guard<std::mutex> lock(dependency->mutex);
+    if (!dependency->is_done())
+    {
+      dependency->continuations.push_back(std::move(job));
+      return counter;
+    }
+  }
+
+  push_job(std::move(job));
+  return counter;
+}
+
+void JobSystem::wait(const std::shared_ptr<JobCounter> &counter)
+{
+  FGE_ASSERT(counter);
+
+  while (!counter->is_done())
+  {
+    if (!try_execute_job())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> lock(counter->mutex);
+    exception = counter->exception;
+  }
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+void JobSystem::parallel_for(
+    std::size_t                                                     count,
+    std::size_t                                                     batch_size,
+    const std::function<void(std::size_t begin, std::size_t end)> &function)
+{
+  if (count == 0)
+  {
+    return;
+  }
+  batch_size = std::max<std::size_t>(batch_size, 1);
+
+  // Not worth to go through the queues for a single batch
+  if (count <= batch_size)
+  {
+    function(0, count);
+    return;
+  }
+
+  auto counter = std::make_shared<JobCounter>();
+  for (std::size_t begin = batch_size; begin < count; begin += batch_size)
+  {
+    const auto end = std::min(begin + batch_size, count);
+    schedule([&function, begin, end]() { function(begin, end); }, counter);
+  }
+
+  // The first batch runs right here while the workers pick up the rest. The
+  // queued batches reference function, so they have to finish before an
+  // exception of the first batch leaves this frame.
+  try
+  {
+    function(0, batch_size);
+  }
+  catch (...)
+  {
+    try
+    {
+      wait(counter);
+    }
+    catch (...)
+    {
+      // The exception of the first batch wins, like wait keeps the first
+    }
+    throw;
+  }
+
+  wait(counter);
+}
+
+void JobSystem::worker_main(std::size_t index)
+{
+  current_job_system  = this;
+  current_queue_index = index;
+
+  while (running)
+  {
+    Job job;
+    if (pop_job(index, job))
+    {
+      execute_job(job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    ++sleeping_workers;
+    sleep_condition.wait(lock, [this]() {
+      return !running || queued_jobs.load() > 0;
+    });
+    --sleeping_workers;
+  }
+}
+
+std::size_t JobSystem::get_queue_index() const
+{
+  return current_job_system == this ? current_queue_index : 0;
+}
+
+void JobSystem::push_job(Job job)
+{
+  auto &queue = *queues[get_queue_index()];
+  {
+    // Counted under the lock, so a thief that takes the job decrements only
+    // after this increment and the counter never wraps
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+    ++queued_jobs;
+  }
+
+  // A worker increments sleeping_workers before it checks queued_jobs, so
+  // either it sees the new job or we see it sleeping
+  if (sleeping_workers.load() > 0)
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    sleep_condition.notify_one();
+  }
+}
+
+bool JobSystem::pop_job(std::size_t index, Job &job)
+{
+  if (queued_jobs.load() == 0)
+  {
+    return false;
+  }
+
+  // Own queue first, newest job as its data is most likely still in cache
+  {
+    auto &                      queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty())
+    {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+      --queued_jobs;
+      return true;
+    }
+  }
+
+  // Steal the oldest job from somebody else
+  for (std::size_t i = 1; i < queues.size(); ++i)
+  {
+    auto &                      queue = *queues[(index + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty())
+    {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+      --queued_jobs;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool JobSystem::try_execute_job()
+{
+  Job job;
+  if (!pop_job(get_queue_index(), job))
+  {
+    return false;
+  }
+
+  execute_job(job);
+  return true;
+}
+
+void JobSystem::execute_job(Job &job)
+{
+  FGE_PROFILE_SCOPE("JobSystem::execute_job");
+
+  try
+  {
+    job.function();
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(job.counter->mutex);
+    if (!job.counter->exception)
+    {
+      job.counter->exception = std::current_exception();
+    }
+  }
+
+  finish_job(job.counter);
+}
+
+void JobSystem::finish_job(const std::shared_ptr<JobCounter> &counter)
+{
+  if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+  {
+    return;
+  }
+
+  // schedule_after() checks the counter under the same lock, so a
+  // continuation is either collected here or pushed directly by the caller
+  std::vector<Job> continuations;
+  {
+    std::lock_guard<std::mutex> lock(counter->mutex);
+    continuations.swap(counter->continuations);
+  }
+
+  for (auto &continuation : continuations)
+  {
+    push_job(std::move(continuation));
+  }
+}
+
+} // namespace Fge
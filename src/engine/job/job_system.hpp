@@ -0,0 +1,133 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+using JobFunction = std::function<void()>;
+
+class JobCounter;
+
+struct Job
+{
+  JobFunction                 function;
+  std::shared_ptr<JobCounter> counter;
+};
+
+/**
+ * Tracks a group of jobs. The counter is done as soon as all jobs that were
+ * scheduled with it finished. Jobs scheduled to run after the counter are
+ * kicked off by the worker that finishes the last job of the group.
+ */
+class JobCounter
+{
+public:
+  bool is_done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+  friend class JobSystem;
+
+  std::atomic<int> pending{0};
+
+  std::mutex         mutex;
+  std::vector<Job>   continuations;
+  std::exception_ptr exception;
+};
+
+/**
+ * Work stealing job system.
+ *
+ * Every worker owns a deque. A worker pushes and pops jobs at the back of its
+ * own deque and steals from the front of the deques of other workers when it
+ * runs out of work. Threads that are not workers (e.g. the main thread) share
+ * slot 0. Waiting on a counter executes other jobs instead of blocking.
+ */
+class JobSystem
+{
+public:
+  /**
+   * @param worker_count Number of worker threads to start. 0 means one less
+   * than the number of hardware threads, so the calling thread keeps a core.
+   */
+  explicit JobSystem(std::size_t worker_count = 0);
+
+  ~JobSystem();
+
+  JobSystem(const JobSystem &other) = delete;
+
+  JobSystem &operator=(const JobSystem &other) = delete;
+
+  /**
+   * Schedules a job. If a counter is given the job gets added to its group,
+   * otherwise a new counter is created.
+   *
+   * @return Counter that can be waited on
+   */
+  std::shared_ptr<JobCounter>
+  schedule(JobFunction function, std::shared_ptr<JobCounter> counter = {});
+
+  /**
+   * Schedules a job that runs once all jobs of the dependency finished.
+   *
+   * @return Counter of the new job
+   */
+  std::shared_ptr<JobCounter>
+  schedule_after(const std::shared_ptr<JobCounter> &dependency,
+                 JobFunction                        function);
+
+  /**
+   * Executes jobs until the counter is done. Rethrows the first exception a
+   * job of the group has thrown.
+   */
+  void wait(const std::shared_ptr<JobCounter> &counter);
+
+  /**
+   * Splits [0, count) into batches of batch_size and calls
+   * function(begin, end) for every batch in parallel. Returns once all
+   * batches are done, also if a batch throws. The calling thread takes part
+   * in the work.
+   */
+  void parallel_for(
+      std::size_t                                                count,
+      std::size_t                                                batch_size,
+      const std::function<void(std::size_t begin, std::size_t end)> &function);
+
+  /**
+   * @return Number of threads executing jobs, including the calling thread
+   */
+  std::size_t get_thread_count() const { return queues.size(); }
+
+private:
+  struct JobQueue
+  {
+    std::mutex      mutex;
+    std::deque<Job> jobs;
+  };
+
+  std::vector<std::unique_ptr<JobQueue>> queues;
+  std::vector<std::thread>               workers;
+
+  std::atomic<bool>        running{true};
+  std::atomic<std::size_t> queued_jobs{0};
+  std::atomic<std::size_t> sleeping_workers{0};
+
+  std::mutex              sleep_mutex;
+  std::condition_variable sleep_condition;
+
+  void worker_main(std::size_t index);
+
+  std::size_t get_queue_index() const;
+
+  void push_job(Job job);
+
+  bool pop_job(std::size_t index, Job &job);
+
+  bool try_execute_job();
+
+  void execute_job(Job &job);
+
+  void finish_job(const std::shared_ptr<JobCounter> &counter);
+};
+
+} // namespace Fge
@@ -3,61 +3,134 @@
 namespace Fge
 {
 
-std::thread              log_thread;
-std::mutex               log_mutex;
-std::vector<LogInfo>     log_queue;
-std::mutex               sink_mutex;
-std::unique_ptr<LogSink> sink;
-LogMode                  logging_mode;
-
-bool    stop_logging = false;
-LogType log_level    = LogType::Debug;
+std::thread                                log_thread;
+std::unique_ptr<MpscRingBuffer<LogRecord>> log_queue;
+std::mutex                                 log_wakeup_mutex;
+std::condition_variable                    log_wakeup;
+std::atomic<bool>                          log_flush_requested{false};
+std::mutex                                 sink_mutex;
+std::unique_ptr<LogSink>                   sink;
+std::atomic<LogMode>                       logging_mode{LogMode::Sync};
+
+std::atomic<bool>    stop_logging{false};
+std::atomic<LogType> log_level{LogType::Debug};
 
 void terminate_logger()
 {
 #ifndef FGE_LOG_DISABLE
 
-  trace("Log", "Stop logging system");
+  trace("Log", FMT_STRING("Stop logging system"));
   stop_logging = true;
-  log_thread.join();
+
+  if (log_thread.joinable())
+  {
+    request_log_flush();
+    log_thread.join();
+  }
+
+  // Nobody drains the queue anymore
+  logging_mode = LogMode::Sync;
 
 #endif
 }
 
 void set_log_level(LogType type) { log_level = type; }
 
-void watch_log_queue()
+std::string_view intern_log_tag(std::string_view name)
+{
+  // Nodes of an unordered_set never move, so views into them stay valid
+  static std::mutex                      mutex;
+  static std::unordered_set<std::string> tags;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return *tags.emplace(name).first;
+}
+
+void start_log_thread(std::chrono::milliseconds latency, std::size_t capacity)
 {
-  using namespace std::chrono_literals;
+  if (!log_queue || log_queue->capacity() < capacity)
+  {
+    log_queue = std::make_unique<MpscRingBuffer<LogRecord>>(capacity);
+  }
+
+  log_thread = std::thread(watch_log_queue, latency);
+}
 
-  while (!stop_logging || log_queue.size() > 20000)
+void request_log_flush()
+{
+  // Skip the lock if a flush is already pending
+  if (log_flush_requested.exchange(true))
   {
-    process_log_queue();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(log_wakeup_mutex);
+  }
+  log_wakeup.notify_one();
+}
+
+void watch_log_queue(std::chrono::milliseconds latency)
+{
+  while (!stop_logging)
+  {
+    {
+      std::unique_lock<std::mutex> lock(log_wakeup_mutex);
+      log_wakeup.wait_for(lock, latency, []() {
+        return log_flush_requested.load() || stop_logging.load();
+      });
+    }
+    log_flush_requested = false;
 
-    std::this_thread::sleep_for(1s);
+    process_log_queue();
   }
+
   // Empty queue
   process_log_queue();
 }
 
 void process_log_queue()
 {
-  if (log_queue.size() == 0)
+  if (!log_queue)
   {
     return;
   }
 
-  log_mutex.lock();
-
-  const std::vector<LogInfo> log_queue_copy(std::move(log_queue));
-  log_queue.clear();
+  // Only the log thread drains, so the batch can be reused
+  static std::vector<LogInfo> log_infos;
+  log_infos.clear();
+
+  const auto read_record = [](LogRecord &record) {
+    auto &info      = log_infos.emplace_back();
+    info.time_point = record.time_point;
+    info.type       = record.type;
+    info.thread_id  = record.thread_id;
+    info.msg.assign(record.msg.data(), record.msg_size);
+    if (record.truncated)
+    {
+      info.msg += "...";
+    }
+    info.tag.assign(record.tag.data(), record.tag.size());
+  };
+
+  // Bounded, so producers that never stop can not keep us here forever
+  for (std::size_t i = 0; i < log_queue->capacity(); ++i)
+  {
+    if (!log_queue->try_pop(read_record))
+    {
+      break;
+    }
+  }
 
-  log_mutex.unlock();
+  if (log_infos.empty())
+  {
+    return;
+  }
 
   sink_mutex.lock();
   if (sink)
   {
-    sink->process_log_info(log_queue_copy);
+    sink->process_log_info(log_infos);
   }
   sink_mutex.unlock();
 }
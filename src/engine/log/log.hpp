@@ -1,10 +1,11 @@
 ﻿#pragma once
 
-#include <fmt/core.h>
+#include <fmt/format.h>
 
 #include "log_sink.hpp"
 #include "std.hpp"
 #include "util/assert.hpp"
+#include "util/mpsc_ring_buffer.hpp"
 
 namespace Fge
 {
@@ -24,6 +25,63 @@ enum class LogMode
   Async
 };
 
+// Messages above this level are removed at compile time. Release builds
+// keep everything up to Info.
+#ifndef FGE_LOG_MAX_LEVEL
+#ifdef NDEBUG
+#define FGE_LOG_MAX_LEVEL 2
+#else
+#define FGE_LOG_MAX_LEVEL 4
+#endif
+#endif
+
+constexpr LogType log_max_level = static_cast<LogType>(FGE_LOG_MAX_LEVEL);
+
+/**
+ * Returns a view to a copy of name that lives as long as the program. Equal
+ * names return the same view.
+ */
+std::string_view intern_log_tag(std::string_view name);
+
+/**
+ * Tag of a log message. String literals and static constants are referenced
+ * directly, other strings get interned. Either way the tag is just a view
+ * that stays valid, so log calls never copy it.
+ */
+class LogTag
+{
+public:
+  /**
+   * Only meant for string literals. The array is referenced, so it must not
+   * live on the stack.
+   */
+  template <std::size_t N>
+  constexpr LogTag(const char (&name)[N]) : name(name, N - 1)
+  {
+  }
+
+  // Writable arrays are buffers, not literals
+  template <std::size_t N> LogTag(char (&name)[N]) = delete;
+
+  LogTag(const std::string &name) : name(intern_log_tag(name)) {}
+
+  /**
+   * @param name Has to stay valid as long as the program, e.g. a static
+   * constexpr std::string_view
+   */
+  static constexpr LogTag from_static(std::string_view name)
+  {
+    return LogTag(name);
+  }
+
+  std::string_view get_name() const { return name; }
+
+private:
+  std::string_view name;
+
+  constexpr explicit LogTag(std::string_view name) : name(name) {}
+};
+
 struct LogInfo
 {
   std::chrono::time_point<std::chrono::system_clock> time_point;
@@ -33,25 +91,55 @@ struct LogInfo
   std::string                                        tag;
 };
 
-extern std::thread          log_thread;
-extern std::mutex           log_mutex;
-extern std::vector<LogInfo> log_queue;
+/**
+ * Fixed size entry of the async log queue. The message gets formatted in
+ * place by the logging thread, everything else (time, level, thread) is only
+ * turned into text later by the log thread.
+ */
+struct LogRecord
+{
+  static constexpr std::size_t max_msg_size = 256;
+
+  std::chrono::time_point<std::chrono::system_clock> time_point;
+  LogType                                            type = LogType::Debug;
+  std::thread::id                                    thread_id;
+
+  std::string_view               tag;
+  bool                           truncated = false;
+  std::size_t                    msg_size  = 0;
+  std::array<char, max_msg_size> msg;
+};
+
+extern std::thread                                log_thread;
+extern std::unique_ptr<MpscRingBuffer<LogRecord>> log_queue;
+
+extern std::mutex              log_wakeup_mutex;
+extern std::condition_variable log_wakeup;
+extern std::atomic<bool>       log_flush_requested;
 
 extern std::unique_ptr<LogSink> sink;
 extern std::mutex               sink_mutex;
 
-extern LogType log_level;
+extern std::atomic<LogType> log_level;
 
-extern bool stop_logging;
+extern std::atomic<bool> stop_logging;
 
-extern LogMode logging_mode;
+// Read by every log call on any thread
+extern std::atomic<LogMode> logging_mode;
 
 void termination_handler(int signum);
 
-void watch_log_queue();
+void watch_log_queue(std::chrono::milliseconds latency);
 
 void process_log_queue();
 
+void start_log_thread(std::chrono::milliseconds latency, std::size_t capacity);
+
+/**
+ * Wakes up the log thread before its latency passed.
+ */
+void request_log_flush();
+
 template <class T> void set_sink()
 {
   sink_mutex.lock();
@@ -61,52 +149,74 @@ template <class T> void set_sink()
 
 void terminate_logger();
 
-template <class... Targs>
-void error(const std::string &tag,
-           const std::string &format_string,
-           Targs &&... args)
+template <typename S, class... Targs>
+void error([[maybe_unused]] const LogTag &tag,
+           [[maybe_unused]] const S &     format_string,
+           [[maybe_unused]] Targs &&... args)
 {
-  msg(LogType::Error, tag, format_string, std::forward<Targs>(args)...);
+  if constexpr (LogType::Error <= log_max_level)
+  {
+    msg(LogType::Error, tag, format_string, std::forward<Targs>(args)...);
+  }
 }
 
-template <class... Targs>
-void warning(const std::string &tag,
-             const std::string &format_string,
-             Targs &&... args)
+template <typename S, class... Targs>
+void warning([[maybe_unused]] const LogTag &tag,
+             [[maybe_unused]] const S &     format_string,
+             [[maybe_unused]] Targs &&... args)
 {
-  msg(LogType::Warning, tag, format_string, std::forward<Targs>(args)...);
+  if constexpr (LogType::Warning <= log_max_level)
+  {
+    msg(LogType::Warning, tag, format_string, std::forward<Targs>(args)...);
+  }
 }
 
-template <class... Targs>
-void info(const std::string &tag,
-          const std::string &format_string,
-          Targs &&... args)
+template <typename S, class... Targs>
+void info([[maybe_unused]] const LogTag &tag,
+          [[maybe_unused]] const S &     format_string,
+          [[maybe_unused]] Targs &&... args)
 {
-  msg(LogType::Info, tag, format_string, std::forward<Targs>(args)...);
+  if constexpr (LogType::Info <= log_max_level)
+  {
+    msg(LogType::Info, tag, format_string, std::forward<Targs>(args)...);
+  }
 }
 
-template <class... Targs>
-void debug(const std::string &tag,
-           const std::string &format_string,
-           Targs &&... args)
+template <typename S, class... Targs>
+void debug([[maybe_unused]] const LogTag &tag,
+           [[maybe_unused]] const S &     format_string,
+           [[maybe_unused]] Targs &&... args)
 {
-  msg(LogType::Debug, tag, format_string, std::forward<Targs>(args)...);
+  if constexpr (LogType::Debug <= log_max_level)
+  {
+    msg(LogType::Debug, tag, format_string, std::forward<Targs>(args)...);
+  }
 }
 
-template <class... Targs>
-void trace(const std::string &tag,
-           const std::string &format_string,
-           Targs &&... args)
+template <typename S, class... Targs>
+void trace([[maybe_unused]] const LogTag &tag,
+           [[maybe_unused]] const S &     format_string,
+           [[maybe_unused]] Targs &&... args)
 {
-  msg(LogType::Trace, tag, format_string, std::forward<Targs>(args)...);
+  if constexpr (LogType::Trace <= log_max_level)
+  {
+    msg(LogType::Trace, tag, format_string, std::forward<Targs>(args)...);
+  }
 }
 
 void set_log_level(LogType type);
 
+/**
+ * @param latency Maximum time an async message waits before it gets written
+ * @param capacity Number of messages the async queue can hold before logging
+ * threads have to wait for the log thread
+ */
 template <class TLogSink>
-void start_logger(LogType     log_level,
-                  LogMode     log_mode,
-                  std::size_t reserve_count = 2000)
+void start_logger(
+    LogType                   log_level,
+    LogMode                   log_mode,
+    std::chrono::milliseconds latency  = std::chrono::milliseconds(100),
+    std::size_t               capacity = 4096)
 {
 #ifndef FGE_LOG_DISABLE
 
@@ -117,8 +227,7 @@ void start_logger(LogType     log_level,
 
   if (log_mode == LogMode::Async)
   {
-    log_queue.reserve(reserve_count);
-    log_thread = std::thread(watch_log_queue);
+    start_log_thread(latency, capacity);
   }
 
   logging_mode = log_mode;
@@ -137,49 +246,84 @@ void start_logger(LogType     log_level,
     log_mode_str = "unknown";
   }
 
-  trace("Log", "Start logging system in {} mode", log_mode_str);
+  trace("Log", FMT_STRING("Start logging system in {} mode"), log_mode_str);
 
 #endif
 }
 
-template <class... Targs>
-static void msg(LogType            type,
-                const std::string &tag,
-                const std::string &format_string,
+/**
+ * Format strings can be anything fmt accepts. Wrap literals in FMT_STRING()
+ * to have them checked at compile time.
+ */
+template <typename S, class... Targs>
+static void msg(LogType       type,
+                const LogTag &tag,
+                const S &     format_string,
                 Targs &&... args)
 {
 #ifndef FGE_LOG_DISABLE
 
-  if (type > log_level)
+  if (type > log_level.load(std::memory_order_relaxed))
   {
     return;
   }
 
   const auto time_point = std::chrono::system_clock::now();
-  auto       log_msg = fmt::format(format_string, std::forward<Targs>(args)...);
 
-  if (logging_mode == LogMode::Sync)
+  if (logging_mode.load() == LogMode::Sync)
   {
     LogInfo log_info;
     log_info.time_point = time_point;
     log_info.type       = type;
     log_info.thread_id  = std::this_thread::get_id();
-    log_info.msg        = log_msg;
-    log_info.tag        = tag;
-
-    sink->process_log_info(log_info);
+    log_info.msg = fmt::format(format_string, std::forward<Targs>(args)...);
+    log_info.tag = std::string(tag.get_name());
+
+    // Job and loader threads log too
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    if (sink)
+    {
+      sink->process_log_info(log_info);
+    }
   }
   else
   {
-    log_mutex.lock();
-    auto &info = log_queue.emplace_back();
-
-    info.time_point = time_point;
-    info.type       = type;
-    info.thread_id  = std::this_thread::get_id();
-    info.msg        = log_msg;
-    info.tag        = tag;
-    log_mutex.unlock();
+    const auto write_record = [&](LogRecord &record) {
+      record.time_point = time_point;
+      record.type       = type;
+      record.thread_id  = std::this_thread::get_id();
+      record.tag        = tag.get_name();
+
+      try
+      {
+        const auto result = fmt::format_to_n(
+            record.msg.data(), record.msg.size(), format_string, args...);
+        record.msg_size  = std::min(result.size, record.msg.size());
+        record.truncated = result.size > record.msg.size();
+      }
+      catch (...)
+      {
+        // The slot gets published anyway, so leave a readable record behind
+        constexpr std::string_view failed_msg = "Could not format log message";
+        std::copy(failed_msg.begin(), failed_msg.end(), record.msg.begin());
+        record.msg_size  = failed_msg.size();
+        record.truncated = false;
+        throw;
+      }
+    };
+
+    // Queue is full, give the log thread a chance to catch up
+    while (!log_queue->try_push(write_record))
+    {
+      request_log_flush();
+      std::this_thread::yield();
+    }
+
+    if (type == LogType::Error ||
+        log_queue->size() >= log_queue->capacity() / 2)
+    {
+      request_log_flush();
+    }
   }
 
 #endif
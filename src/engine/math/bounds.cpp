@@ -0,0 +1,79 @@
+#include "bounds.hpp"
+
+namespace Fge
+{
+
+Aabb transform_aabb(const Aabb &aabb, const glm::mat4 &transform)
+{
+  if (aabb.is_empty())
+  {
+    return aabb;
+  }
+
+  // Arvo's method. Each output axis is the translation plus, per input axis,
+  // the smaller and the larger of the two scaled extremes.
+  Aabb result{};
+  for (int i = 0; i < 3; ++i)
+  {
+    result.min[i] = transform[3][i];
+    result.max[i] = transform[3][i];
+
+    for (int j = 0; j < 3; ++j)
+    {
+      const auto a = transform[j][i] * aabb.min[j];
+      const auto b = transform[j][i] * aabb.max[j];
+
+      result.min[i] += std::min(a, b);
+      result.max[i] += std::max(a, b);
+    }
+  }
+
+  return result;
+}
+
+BoundingSphere transform_sphere(const BoundingSphere &sphere,
+                                const glm::mat4 &     transform)
+{
+  const auto scale2 =
+      std::max({glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+                glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+                glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))});
+
+  BoundingSphere result{};
+  result.center = glm::vec3(transform * glm::vec4(sphere.center, 1.0f));
+  result.radius = sphere.radius * std::sqrt(scale2);
+
+  return result;
+}
+
+bool intersects(const Ray &ray, const Aabb &aabb, float &distance)
+{
+  auto t_min = 0.0f;
+  auto t_max = ray.max_distance;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    // Division by zero gives infinities, which the comparisons handle. A ray
+    // parallel to a slab then only hits if it starts inside of it.
+    const auto inv_direction = 1.0f / ray.direction[i];
+
+    auto t0 = (aabb.min[i] - ray.origin[i]) * inv_direction;
+    auto t1 = (aabb.max[i] - ray.origin[i]) * inv_direction;
+    if (t0 > t1)
+    {
+      std::swap(t0, t1);
+    }
+
+    t_min = std::max(t_min, t0);
+    t_max = std::min(t_max, t1);
+    if (t_min > t_max)
+    {
+      return false;
+    }
+  }
+
+  distance = t_min;
+  return true;
+}
+
+} // namespace Fge
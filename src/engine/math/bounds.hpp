@@ -0,0 +1,152 @@
+#pragma once
+
+#include "math.hpp"
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Axis aligned bounding box. Empty until a point got added.
+ */
+struct Aabb
+{
+  glm::vec3 min{std::numeric_limits<float>::max()};
+  glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+  void add_point(const glm::vec3 &point)
+  {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+
+  bool is_empty() const
+  {
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+  }
+
+  glm::vec3 get_center() const { return (min + max) * 0.5f; }
+
+  glm::vec3 get_extent() const { return (max - min) * 0.5f; }
+
+  float get_surface_area() const
+  {
+    const auto size = max - min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+  }
+
+  bool contains(const Aabb &other) const
+  {
+    return min.x <= other.min.x && min.y <= other.min.y &&
+           min.z <= other.min.z && other.max.x <= max.x &&
+           other.max.y <= max.y && other.max.z <= max.z;
+  }
+
+  bool overlaps(const Aabb &other) const
+  {
+    return min.x <= other.max.x && other.min.x <= max.x &&
+           min.y <= other.max.y && other.min.y <= max.y &&
+           min.z <= other.max.z && other.min.z <= max.z;
+  }
+
+  /**
+   * Squared distance from the point to the box. Zero if it is inside.
+   */
+  float get_distance2(const glm::vec3 &point) const
+  {
+    const auto offset =
+        glm::max(glm::max(min - point, point - max), glm::vec3(0.0f));
+    return glm::dot(offset, offset);
+  }
+};
+
+inline Aabb merge(const Aabb &a, const Aabb &b)
+{
+  Aabb result{};
+  result.min = glm::min(a.min, b.min);
+  result.max = glm::max(a.max, b.max);
+
+  return result;
+}
+
+struct BoundingSphere
+{
+  glm::vec3 center{0.0f};
+  float     radius = 0.0f;
+};
+
+/**
+ * Half line that starts at origin. Direction needs to be normalized, so
+ * distances along the ray are real distances.
+ */
+struct Ray
+{
+  glm::vec3 origin{0.0f};
+  glm::vec3 direction{0.0f, 0.0f, -1.0f};
+  float     max_distance = std::numeric_limits<float>::max();
+};
+
+/**
+ * Slab test.
+ *
+ * @param distance Distance to the entry point, or zero if the origin is
+ * inside the box
+ *
+ * @return True if the ray hits the box within its max distance
+ */
+bool intersects(const Ray &ray, const Aabb &aabb, float &distance);
+
+/**
+ * Both volumes of a mesh. The sphere is cheaper to test, the box is tighter.
+ */
+struct Bounds
+{
+  Aabb           aabb{};
+  BoundingSphere sphere{};
+};
+
+/**
+ * Bounds of the positions of the given vertices. The sphere is centered at
+ * the box center and encloses every vertex.
+ */
+template <typename TVertex>
+Bounds compute_bounds(const std::vector<TVertex> &vertices)
+{
+  Bounds bounds{};
+
+  for (const auto &vertex : vertices)
+  {
+    bounds.aabb.add_point(vertex.position);
+  }
+
+  if (bounds.aabb.is_empty())
+  {
+    return bounds;
+  }
+
+  bounds.sphere.center = bounds.aabb.get_center();
+
+  float max_distance2 = 0.0f;
+  for (const auto &vertex : vertices)
+  {
+    const auto offset = vertex.position - bounds.sphere.center;
+    max_distance2     = std::max(max_distance2, glm::dot(offset, offset));
+  }
+  bounds.sphere.radius = std::sqrt(max_distance2);
+
+  return bounds;
+}
+
+/**
+ * Box that encloses the given box after the transformation.
+ */
+Aabb transform_aabb(const Aabb &aabb, const glm::mat4 &transform);
+
+/**
+ * Sphere that encloses the given sphere after the transformation. Non
+ * uniform scaling grows the radius by the largest axis scale.
+ */
+BoundingSphere transform_sphere(const BoundingSphere &sphere,
+                                const glm::mat4 &     transform);
+
+} // namespace Fge
@@ -0,0 +1,368 @@
+#include "dynamic_aabb_tree.hpp"
+
+namespace Fge
+{
+
+DynamicAabbTree::DynamicAabbTree(float margin) : margin(margin) {}
+
+int32_t DynamicAabbTree::create_proxy(const Aabb &aabb, std::size_t user_data)
+{
+  const auto proxy = allocate_node();
+
+  auto &node     = nodes[proxy];
+  node.aabb.min  = aabb.min - glm::vec3(margin);
+  node.aabb.max  = aabb.max + glm::vec3(margin);
+  node.user_data = user_data;
+  node.height    = 0;
+
+  insert_leaf(proxy);
+  ++proxy_count;
+
+  return proxy;
+}
+
+void DynamicAabbTree::destroy_proxy(int32_t proxy)
+{
+  FGE_ASSERT(is_proxy(proxy));
+
+  remove_leaf(proxy);
+  free_node(proxy);
+  --proxy_count;
+}
+
+bool DynamicAabbTree::move_proxy(int32_t proxy, const Aabb &aabb)
+{
+  FGE_ASSERT(is_proxy(proxy));
+
+  if (nodes[proxy].aabb.contains(aabb))
+  {
+    return false;
+  }
+
+  remove_leaf(proxy);
+
+  nodes[proxy].aabb.min = aabb.min - glm::vec3(margin);
+  nodes[proxy].aabb.max = aabb.max + glm::vec3(margin);
+
+  insert_leaf(proxy);
+
+  return true;
+}
+
+void DynamicAabbTree::query_nearest(const glm::vec3 &     point,
+                                    std::size_t           count,
+                                    std::vector<int32_t> &result) const
+{
+  result.clear();
+  if (count == 0 || root == null_node)
+  {
+    return;
+  }
+
+  using Entry = std::pair<float, int32_t>;
+
+  // Best first: always open the node closest to the point. Once k leaves
+  // are found, nodes farther away than the k-th leaf can be skipped.
+  std::vector<Entry> open_nodes;
+  std::vector<Entry> best_leaves;
+
+  const auto push_open = [&](int32_t index) {
+    open_nodes.emplace_back(nodes[index].aabb.get_distance2(point), index);
+    std::push_heap(open_nodes.begin(), open_nodes.end(), std::greater<>());
+  };
+
+  push_open(root);
+  while (!open_nodes.empty())
+  {
+    const auto [distance2, index] = open_nodes.front();
+    if (best_leaves.size() == count && distance2 > best_leaves.front().first)
+    {
+      break;
+    }
+
+    std::pop_heap(open_nodes.begin(), open_nodes.end(), std::greater<>());
+    open_nodes.pop_back();
+
+    const auto &node = nodes[index];
+    if (!node.is_leaf())
+    {
+      push_open(node.children[0]);
+      push_open(node.children[1]);
+      continue;
+    }
+
+    // Max heap, so the farthest of the best leaves is on top
+    best_leaves.emplace_back(distance2, index);
+    std::push_heap(best_leaves.begin(), best_leaves.end());
+    if (best_leaves.size() > count)
+    {
+      std::pop_heap(best_leaves.begin(), best_leaves.end());
+      best_leaves.pop_back();
+    }
+  }
+
+  std::sort_heap(best_leaves.begin(), best_leaves.end());
+  result.reserve(best_leaves.size());
+  for (const auto &entry : best_leaves)
+  {
+    result.push_back(entry.second);
+  }
+}
+
+bool DynamicAabbTree::validate() const
+{
+  if (root == null_node)
+  {
+    return proxy_count == 0;
+  }
+
+  bool valid = true;
+  validate(root, null_node, valid);
+
+  return valid;
+}
+
+int32_t DynamicAabbTree::validate(int32_t index,
+                                  int32_t parent,
+                                  bool &  valid) const
+{
+  const auto &node = nodes[index];
+  valid            = valid && node.parent == parent;
+
+  if (node.is_leaf())
+  {
+    valid = valid && node.height == 0;
+    return 0;
+  }
+
+  const auto child0 = node.children[0];
+  const auto child1 = node.children[1];
+
+  const auto height0 = validate(child0, index, valid);
+  const auto height1 = validate(child1, index, valid);
+
+  valid = valid && node.height == 1 + std::max(height0, height1);
+  valid = valid && node.aabb.contains(nodes[child0].aabb);
+  valid = valid && node.aabb.contains(nodes[child1].aabb);
+
+  return node.height;
+}
+
+int32_t DynamicAabbTree::allocate_node()
+{
+  if (free_list == null_node)
+  {
+    nodes.emplace_back();
+    return static_cast<int32_t>(nodes.size() - 1);
+  }
+
+  const auto index = free_list;
+  free_list        = nodes[index].parent;
+  nodes[index]     = Node{};
+
+  return index;
+}
+
+void DynamicAabbTree::free_node(int32_t index)
+{
+  nodes[index].parent = free_list;
+  nodes[index].height = -1;
+  free_list           = index;
+}
+
+void DynamicAabbTree::insert_leaf(int32_t leaf)
+{
+  if (root == null_node)
+  {
+    root               = leaf;
+    nodes[leaf].parent = null_node;
+    return;
+  }
+
+  // Walk down to the sibling that grows the total surface area the least
+  const auto leaf_aabb = nodes[leaf].aabb;
+
+  auto index = root;
+  while (!nodes[index].is_leaf())
+  {
+    const auto &node          = nodes[index];
+    const auto  area          = node.aabb.get_surface_area();
+    const auto  combined_area = merge(node.aabb, leaf_aabb).get_surface_area();
+
+    // Cost of a new parent for this node and the leaf
+    const auto cost = 2.0f * combined_area;
+
+    // Cost every node below pays for the growth of this node
+    const auto inheritance_cost = 2.0f * (combined_area - area);
+
+    const auto descend_cost = [&](int32_t child_index) {
+      const auto &child = nodes[child_index];
+      const auto  merged_area =
+          merge(child.aabb, leaf_aabb).get_surface_area();
+      return child.is_leaf()
+                 ? merged_area + inheritance_cost
+                 : merged_area - child.aabb.get_surface_area() +
+                       inheritance_cost;
+    };
+
+    const auto cost0 = descend_cost(node.children[0]);
+    const auto cost1 = descend_cost(node.children[1]);
+
+    if (cost < cost0 && cost < cost1)
+    {
+      break;
+    }
+
+    index = cost0 < cost1 ? node.children[0] : node.children[1];
+  }
+
+  const auto sibling    = index;
+  const auto new_parent = allocate_node();
+  const auto old_parent = nodes[sibling].parent;
+
+  nodes[new_parent].parent      = old_parent;
+  nodes[new_parent].aabb        = merge(leaf_aabb, nodes[sibling].aabb);
+  nodes[new_parent].height      = nodes[sibling].height + 1;
+  nodes[new_parent].children[0] = sibling;
+  nodes[new_parent].children[1] = leaf;
+
+  if (old_parent == null_node)
+  {
+    root = new_parent;
+  }
+  else if (nodes[old_parent].children[0] == sibling)
+  {
+    nodes[old_parent].children[0] = new_parent;
+  }
+  else
+  {
+    nodes[old_parent].children[1] = new_parent;
+  }
+
+  nodes[sibling].parent = new_parent;
+  nodes[leaf].parent    = new_parent;
+
+  refit(new_parent);
+}
+
+void DynamicAabbTree::remove_leaf(int32_t leaf)
+{
+  if (leaf == root)
+  {
+    root = null_node;
+    return;
+  }
+
+  // The parent goes away and the sibling takes its place
+  const auto parent       = nodes[leaf].parent;
+  const auto grand_parent = nodes[parent].parent;
+  const auto sibling      = nodes[parent].children[0] == leaf
+                                ? nodes[parent].children[1]
+                                : nodes[parent].children[0];
+
+  nodes[sibling].parent = grand_parent;
+  free_node(parent);
+
+  if (grand_parent == null_node)
+  {
+    root = sibling;
+    return;
+  }
+
+  if (nodes[grand_parent].children[0] == parent)
+  {
+    nodes[grand_parent].children[0] = sibling;
+  }
+  else
+  {
+    nodes[grand_parent].children[1] = sibling;
+  }
+
+  refit(grand_parent);
+}
+
+void DynamicAabbTree::refit(int32_t index)
+{
+  while (index != null_node)
+  {
+    index = balance(index);
+
+    auto &      node   = nodes[index];
+    const auto &child0 = nodes[node.children[0]];
+    const auto &child1 = nodes[node.children[1]];
+
+    node.height = 1 + std::max(child0.height, child1.height);
+    node.aabb   = merge(child0.aabb, child1.aabb);
+
+    index = node.parent;
+  }
+}
+
+int32_t DynamicAabbTree::balance(int32_t index)
+{
+  const auto &node = nodes[index];
+  if (node.is_leaf() || node.height < 2)
+  {
+    return index;
+  }
+
+  const auto height_difference =
+      nodes[node.children[1]].height - nodes[node.children[0]].height;
+
+  if (height_difference > 1)
+  {
+    return rotate(index, 1);
+  }
+  if (height_difference < -1)
+  {
+    return rotate(index, 0);
+  }
+
+  return index;
+}
+
+int32_t DynamicAabbTree::rotate(int32_t index, int32_t child_slot)
+{
+  // The higher child c takes the place of node a. Node a keeps its other
+  // child b and gets the lower grandchild, c keeps the higher one.
+  const auto a = index;
+  const auto b = nodes[a].children[1 - child_slot];
+  const auto c = nodes[a].children[child_slot];
+
+  auto f = nodes[c].children[0];
+  auto g = nodes[c].children[1];
+  if (nodes[f].height < nodes[g].height)
+  {
+    std::swap(f, g);
+  }
+
+  nodes[c].children[0] = a;
+  nodes[c].children[1] = f;
+  nodes[c].parent      = nodes[a].parent;
+  nodes[a].parent      = c;
+
+  if (nodes[c].parent == null_node)
+  {
+    root = c;
+  }
+  else if (nodes[nodes[c].parent].children[0] == a)
+  {
+    nodes[nodes[c].parent].children[0] = c;
+  }
+  else
+  {
+    nodes[nodes[c].parent].children[1] = c;
+  }
+
+  nodes[a].children[child_slot] = g;
+  nodes[g].parent               = a;
+
+  nodes[a].aabb   = merge(nodes[b].aabb, nodes[g].aabb);
+  nodes[a].height = 1 + std::max(nodes[b].height, nodes[g].height);
+  nodes[c].aabb   = merge(nodes[a].aabb, nodes[f].aabb);
+  nodes[c].height = 1 + std::max(nodes[a].height, nodes[f].height);
+
+  return c;
+}
+
+} // namespace Fge
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "bounds.hpp"
+#include "std.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+/**
+ * Bounding volume hierarchy for objects that move.
+ *
+ * Leaves store a fat box, the object box grown by a margin. Small moves stay
+ * inside the fat box and cost nothing. Larger moves remove and reinsert the
+ * leaf. Inserts pick the sibling with the least surface area increase and
+ * rotations keep the tree balanced while walking back up.
+ *
+ * Nodes live in one array and reference each other by index. Proxies are
+ * leaf indices and stay valid until they get destroyed.
+ *
+ * Queries use an internal stack, so a tree must not be queried from several
+ * threads at once.
+ */
+class DynamicAabbTree
+{
+public:
+  static constexpr int32_t null_node = -1;
+
+  explicit DynamicAabbTree(float margin = 0.1f);
+
+  /**
+   * @return Proxy of the new leaf
+   */
+  int32_t create_proxy(const Aabb &aabb, std::size_t user_data);
+
+  void destroy_proxy(int32_t proxy);
+
+  /**
+   * Updates the box of the proxy.
+   *
+   * @return True if the leaf got reinserted, false if the fat box still
+   * contained the new box
+   */
+  bool move_proxy(int32_t proxy, const Aabb &aabb);
+
+  std::size_t get_user_data(int32_t proxy) const
+  {
+    FGE_ASSERT(is_proxy(proxy));
+    return nodes[proxy].user_data;
+  }
+
+  const Aabb &get_fat_aabb(int32_t proxy) const
+  {
+    FGE_ASSERT(is_proxy(proxy));
+    return nodes[proxy].aabb;
+  }
+
+  /**
+   * Calls callback(proxy) for every fat box that overlaps the box. The query
+   * stops when the callback returns false.
+   */
+  template <typename TCallback>
+  void query(const Aabb &aabb, TCallback callback) const
+  {
+    traverse(
+        [&aabb](const Aabb &node_aabb) { return node_aabb.overlaps(aabb); },
+        callback);
+  }
+
+  /**
+   * Calls callback(proxy) for every fat box that overlaps the sphere. The
+   * query stops when the callback returns false.
+   */
+  template <typename TCallback>
+  void query(const BoundingSphere &sphere, TCallback callback) const
+  {
+    const auto radius2 = sphere.radius * sphere.radius;
+    traverse(
+        [&sphere, radius2](const Aabb &node_aabb) {
+          return node_aabb.get_distance2(sphere.center) <= radius2;
+        },
+        callback);
+  }
+
+  /**
+   * Calls callback(ray, proxy) for every fat box the ray hits. The callback
+   * returns the new max distance of the ray: the distance of its own hit to
+   * only find closer ones, ray.max_distance to go on unchanged or zero to
+   * stop.
+   */
+  template <typename TCallback>
+  void raycast(const Ray &ray, TCallback callback) const
+  {
+    auto clipped_ray = ray;
+
+    stack.clear();
+    push(root);
+    while (!stack.empty())
+    {
+      const auto  index = pop();
+      const auto &node  = nodes[index];
+
+      float distance = 0.0f;
+      if (!intersects(clipped_ray, node.aabb, distance))
+      {
+        continue;
+      }
+
+      if (!node.is_leaf())
+      {
+        push(node.children[0]);
+        push(node.children[1]);
+        continue;
+      }
+
+      const auto max_distance = callback(clipped_ray, index);
+      if (max_distance <= 0.0f)
+      {
+        return;
+      }
+      clipped_ray.max_distance =
+          std::min(clipped_ray.max_distance, max_distance);
+    }
+  }
+
+  /**
+   * Finds the count proxies whose fat boxes are closest to the point,
+   * nearest first.
+   */
+  void query_nearest(const glm::vec3 &     point,
+                     std::size_t           count,
+                     std::vector<int32_t> &result) const;
+
+  std::size_t get_proxy_count() const { return proxy_count; }
+
+  /**
+   * Height of the root. A single leaf has height zero.
+   */
+  int32_t get_height() const
+  {
+    return root == null_node ? 0 : nodes[root].height;
+  }
+
+  /**
+   * Checks parent links, heights and that every parent box encloses its
+   * children. For tests and debugging.
+   */
+  bool validate() const;
+
+private:
+  struct Node
+  {
+    Aabb        aabb{};
+    std::size_t user_data{};
+
+    // Next free node while the node is on the free list
+    int32_t parent = null_node;
+    int32_t children[2]{null_node, null_node};
+
+    // Leaves have height zero, free nodes -1
+    int32_t height = -1;
+
+    bool is_leaf() const { return children[0] == null_node; }
+  };
+
+  float margin{};
+
+  std::vector<Node> nodes;
+  int32_t           root        = null_node;
+  int32_t           free_list   = null_node;
+  std::size_t       proxy_count = 0;
+
+  mutable std::vector<int32_t> stack;
+
+  bool is_proxy(int32_t proxy) const
+  {
+    return proxy >= 0 && static_cast<std::size_t>(proxy) < nodes.size() &&
+           nodes[proxy].height == 0;
+  }
+
+  void push(int32_t index) const
+  {
+    if (index != null_node)
+    {
+      stack.push_back(index);
+    }
+  }
+
+  int32_t pop() const
+  {
+    const auto index = stack.back();
+    stack.pop_back();
+    return index;
+  }
+
+  template <typename TOverlaps, typename TCallback>
+  void traverse(TOverlaps overlaps, TCallback callback) const
+  {
+    stack.clear();
+    push(root);
+    while (!stack.empty())
+    {
+      const auto  index = pop();
+      const auto &node  = nodes[index];
+
+      if (!overlaps(node.aabb))
+      {
+        continue;
+      }
+
+      if (node.is_leaf())
+      {
+        if (!callback(index))
+        {
+          return;
+        }
+      }
+      else
+      {
+        push(node.children[0]);
+        push(node.children[1]);
+      }
+    }
+  }
+
+  int32_t allocate_node();
+
+  void free_node(int32_t index);
+
+  void insert_leaf(int32_t leaf);
+
+  void remove_leaf(int32_t leaf);
+
+  /**
+   * Refits and balances every node from index up to the root.
+   */
+  void refit(int32_t index);
+
+  /**
+   * Rotates the higher grandchild up if the children of the node differ in
+   * height by more than one.
+   *
+   * @return Index of the node that now is at the position of index
+   */
+  int32_t balance(int32_t index);
+
+  int32_t rotate(int32_t index, int32_t child_slot);
+
+  int32_t validate(int32_t index, int32_t parent, bool &valid) const;
+};
+
+} // namespace Fge
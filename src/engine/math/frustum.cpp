@@ -0,0 +1,134 @@
+#include "frustum.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FGE_FRUSTUM_SSE
+#include <emmintrin.h>
+#endif
+
+namespace Fge
+{
+
+Frustum::Frustum(const glm::mat4 &view_projection_mat)
+{
+  // Gribb and Hartmann. glm matrices are column major, so row i is the i-th
+  // component of every column.
+  const auto &m   = view_projection_mat;
+  const auto  row = [&m](int i) {
+    return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+  };
+
+  const auto row_x = row(0);
+  const auto row_y = row(1);
+  const auto row_z = row(2);
+  const auto row_w = row(3);
+
+  planes[0] = row_w + row_x; // Left
+  planes[1] = row_w - row_x; // Right
+  planes[2] = row_w + row_y; // Bottom
+  planes[3] = row_w - row_y; // Top
+  planes[4] = row_w + row_z; // Near
+  planes[5] = row_w - row_z; // Far
+
+  // Normalized planes give real distances, which the sphere tests need
+  for (auto &plane : planes)
+  {
+    plane = plane / glm::length(glm::vec3(plane));
+  }
+}
+
+bool Frustum::intersects(const BoundingSphere &sphere) const
+{
+  for (const auto &plane : planes)
+  {
+    if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool Frustum::intersects(const Aabb &aabb) const
+{
+  if (aabb.is_empty())
+  {
+    return false;
+  }
+
+  const auto center = aabb.get_center();
+  const auto extent = aabb.get_extent();
+
+  for (const auto &plane : planes)
+  {
+    const auto normal = glm::vec3(plane);
+
+    // Projected half size of the box onto the plane normal
+    const auto radius = glm::dot(extent, glm::abs(normal));
+    if (glm::dot(normal, center) + plane.w < -radius)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void Frustum::intersects(const SphereBatch &   spheres,
+                         std::vector<uint8_t> &visible) const
+{
+  const auto count = spheres.size();
+  visible.resize(count);
+
+  std::size_t begin = 0;
+
+#ifdef FGE_FRUSTUM_SSE
+  // Four spheres against one plane per step
+  for (; begin + 4 <= count; begin += 4)
+  {
+    const auto x      = _mm_loadu_ps(spheres.center_x.data() + begin);
+    const auto y      = _mm_loadu_ps(spheres.center_y.data() + begin);
+    const auto z      = _mm_loadu_ps(spheres.center_z.data() + begin);
+    const auto radius = _mm_loadu_ps(spheres.radius.data() + begin);
+
+    const auto neg_radius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+    auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (const auto &plane : planes)
+    {
+      auto distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)),
+                                 _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+      distance      = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+      distance      = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, neg_radius));
+    }
+
+    const auto mask = _mm_movemask_ps(inside);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      visible[begin + i] = static_cast<uint8_t>((mask >> i) & 1);
+    }
+  }
+#endif
+
+  intersects_scalar(spheres, begin, visible.data());
+}
+
+void Frustum::intersects_scalar(const SphereBatch &spheres,
+                                std::size_t        begin,
+                                uint8_t *          visible) const
+{
+  for (auto i = begin; i < spheres.size(); ++i)
+  {
+    BoundingSphere sphere{};
+    sphere.center = glm::vec3(
+        spheres.center_x[i], spheres.center_y[i], spheres.center_z[i]);
+    sphere.radius = spheres.radius[i];
+
+    visible[i] = intersects(sphere) ? 1 : 0;
+  }
+}
+
+} // namespace Fge
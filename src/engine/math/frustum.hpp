@@ -0,0 +1,78 @@
+#pragma once
+
+#include "bounds.hpp"
+#include "math.hpp"
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Bounding spheres in structure of arrays layout, so that one SIMD register
+ * holds the same component of several spheres.
+ */
+struct SphereBatch
+{
+  std::vector<float> center_x;
+  std::vector<float> center_y;
+  std::vector<float> center_z;
+  std::vector<float> radius;
+
+  void push(const BoundingSphere &sphere)
+  {
+    center_x.push_back(sphere.center.x);
+    center_y.push_back(sphere.center.y);
+    center_z.push_back(sphere.center.z);
+    radius.push_back(sphere.radius);
+  }
+
+  void clear()
+  {
+    center_x.clear();
+    center_y.clear();
+    center_z.clear();
+    radius.clear();
+  }
+
+  std::size_t size() const { return radius.size(); }
+};
+
+/**
+ * The six planes of a camera volume. Tests are conservative: a volume that
+ * is reported outside is never visible, but some volumes near the corners
+ * are reported inside although they are not.
+ */
+class Frustum
+{
+public:
+  Frustum() = default;
+
+  /**
+   * Extracts the planes from a projection * view matrix. The planes are in
+   * world space and point inwards.
+   */
+  explicit Frustum(const glm::mat4 &view_projection_mat);
+
+  bool intersects(const BoundingSphere &sphere) const;
+
+  bool intersects(const Aabb &aabb) const;
+
+  /**
+   * Tests all spheres of the batch. Writes 1 for every sphere that is at
+   * least partially inside and 0 for every other sphere. Uses SSE if the
+   * target supports it.
+   */
+  void intersects(const SphereBatch &   spheres,
+                  std::vector<uint8_t> &visible) const;
+
+  const std::array<glm::vec4, 6> &get_planes() const { return planes; }
+
+private:
+  std::array<glm::vec4, 6> planes{};
+
+  void intersects_scalar(const SphereBatch &spheres,
+                         std::size_t        begin,
+                         uint8_t *          visible) const;
+};
+
+} // namespace Fge
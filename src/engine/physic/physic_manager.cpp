@@ -1,5 +1,6 @@
 #include "physic_manager.hpp"
 #include "platform/bullet/bullet_physic_world.hpp"
+#include "profiler/profiler.hpp"
 
 namespace Fge
 {
@@ -9,9 +10,10 @@ void PhysicManager::init()
   physic_world = std::make_shared<Bullet::BulletPhysicWorld>();
 }
 
-void PhysicManager::update(float delta_time)
+void PhysicManager::update(float frametime)
 {
-  physic_world->update(delta_time);
+  FGE_PROFILE_SCOPE("PhysicManager::update");
+  physic_world->update(frametime);
 }
 
 void PhysicManager::render() { physic_world->render(); }
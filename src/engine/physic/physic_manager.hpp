@@ -10,7 +10,7 @@ class PhysicManager
 public:
   void init();
 
-  void update(float delta_time);
+  void update(float frametime);
 
   void render();
 
@@ -12,7 +12,10 @@ class PhysicWorld
 public:
   virtual ~PhysicWorld() = default;
 
-  virtual void update(float delta_time) = 0;
+  /**
+   * Advances the simulation by exactly one step of the given length.
+   */
+  virtual void update(float frametime) = 0;
 
   virtual void render() = 0;
 
@@ -32,9 +32,12 @@ BulletPhysicWorld::~BulletPhysicWorld()
   delete collision_configuration;
 }
 
-void BulletPhysicWorld::update(float delta_time)
+void BulletPhysicWorld::update(float frametime)
 {
-  dynamics_world->stepSimulation(delta_time);
+  // The application already calls this in fixed steps, so let bullet do
+  // exactly one step without its own accumulator. The rigid body components
+  // interpolate between the steps.
+  dynamics_world->stepSimulation(frametime, 0);
 }
 
 std::shared_ptr<SphereCollisionShape>
@@ -13,7 +13,7 @@ public:
 
   ~BulletPhysicWorld();
 
-  void update(float delta_time) override;
+  void update(float frametime) override;
 
   void render() override;
 
@@ -14,7 +14,10 @@ namespace Fge::Glfw
 
 void glfw_error_callback(int error_code, const char *description)
 {
-  warning("GlfwWindow", "Glfw error {}: {}", error_code, description);
+  warning("GlfwWindow",
+          FMT_STRING("Glfw error {}: {}"),
+          error_code,
+          description);
 }
 
 void window_framebuffer_size_callback(GLFWwindow *window, int width, int height)
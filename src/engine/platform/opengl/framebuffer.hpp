@@ -35,7 +35,7 @@ public:
   Framebuffer(const FramebufferConfigRRT &config)
   {
     glGenFramebuffers(1, &id);
-    trace("Framebuffer", "Create framebuffer with id: {}", id);
+    trace("Framebuffer", FMT_STRING("Create framebuffer with id: {}"), id);
     bind();
 
     FGE_ASSERT(config.color_attachment);
@@ -64,7 +64,7 @@ public:
 
   ~Framebuffer()
   {
-    trace("Framebuffer", "Delete framebuffer id: {}", id);
+    trace("Framebuffer", FMT_STRING("Delete framebuffer id: {}"), id);
     glDeleteFramebuffers(1, &id);
   }
 
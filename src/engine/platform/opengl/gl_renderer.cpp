@@ -4,14 +4,15 @@
 #include "gl.hpp"
 #include "graphic/render_info.hpp"
 #include "graphic/renderbuffer.hpp"
-#include "graphic/shader_preprocessor.hpp"
 #include "graphic/texture.hpp"
 #include "index_buffer.hpp"
 #include "log/log.hpp"
 #include "renderbuffer.hpp"
 #include "shader.hpp"
+#include "state_cache.hpp"
 #include "std.hpp"
 #include "texture2d.hpp"
+#include "uniform_buffer.hpp"
 #include "util/assert.hpp"
 #include "vertex_array.hpp"
 #include "vertex_buffer.hpp"
@@ -34,11 +35,107 @@ GLenum draw_mode_to_gl_draw_mode(DrawMode draw_mode)
   }
 }
 
-Renderer::Renderer() { glEnable(GL_DEPTH_TEST); }
+GLenum index_type_to_gl_type(IndexType index_type)
+{
+  switch (index_type)
+  {
+  case IndexType::UInt16:
+    return GL_UNSIGNED_SHORT;
+
+  case IndexType::UInt32:
+    return GL_UNSIGNED_INT;
+
+  default:
+    FGE_FAIL("No such index type");
+  }
+}
+
+const void *get_index_offset(const Fge::IndexBuffer &index_buffer,
+                             uint32_t                first_index)
+{
+  const auto index_size =
+      index_buffer.get_index_type() == IndexType::UInt16 ? 2 : 4;
+  return reinterpret_cast<const void *>(
+      static_cast<uintptr_t>(first_index) * index_size);
+}
+
+std::filesystem::path get_program_binaries_path()
+{
+  auto file_manager = Application::get_instance()->get_file_manager();
+  return file_manager->get_app_cache_path() / "shaders";
+}
+
+std::string get_gl_string(GLenum name)
+{
+  const auto value = glGetString(name);
+  return value ? reinterpret_cast<const char *>(value) : "";
+}
+
+std::filesystem::path get_shaders_path()
+{
+  return Application::get_instance()->get_file_manager()->get_shaders_path();
+}
+
+Renderer::Renderer()
+    : shader_preprocessor({get_shaders_path()}),
+      program_binaries(get_program_binaries_path())
+{
+  glEnable(GL_DEPTH_TEST);
+
+  GLint binary_format_count = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_format_count);
+  program_binaries_supported = binary_format_count > 0;
+
+  driver_key = get_gl_string(GL_VENDOR) + ";" + get_gl_string(GL_RENDERER) +
+               ";" + get_gl_string(GL_VERSION);
+  trace("Renderer",
+        FMT_STRING("Program binaries supported: {}, driver: {}"),
+        program_binaries_supported,
+        driver_key);
+
+  glGenBuffers(1, &instance_buffer);
+  trace("Renderer",
+        FMT_STRING("Created instance buffer with id: {}"),
+        instance_buffer);
+
+  glGenBuffers(1, &bone_palette_buffer);
+  trace("Renderer",
+        FMT_STRING("Created bone palette buffer with id: {}"),
+        bone_palette_buffer);
+}
 
-void Renderer::begin_render() {}
+void Renderer::begin_render()
+{
+  // Other code, like ImGui, may have changed the bindings in between
+  auto &state_cache = StateCache::get_instance();
+  state_cache.invalidate();
+  state_cache.reset_counts();
+
+  draw_call_count            = 0;
+  instanced_draw_call_count  = 0;
+  drawn_instance_count       = 0;
+  visible_count              = 0;
+  culled_count               = 0;
+  full_detail_triangle_count = 0;
+  triangle_count             = 0;
+}
 
-void Renderer::end_render() {}
+void Renderer::end_render()
+{
+  const auto &counts = StateCache::get_instance().get_counts();
+
+  render_stats.draw_call_count            = draw_call_count;
+  render_stats.instanced_draw_call_count  = instanced_draw_call_count;
+  render_stats.instance_count             = drawn_instance_count;
+  render_stats.program_change_count       = counts.program_change_count;
+  render_stats.vertex_array_change_count  = counts.vertex_array_change_count;
+  render_stats.texture_change_count       = counts.texture_change_count;
+  render_stats.elided_change_count        = counts.elided_change_count;
+  render_stats.visible_count              = visible_count;
+  render_stats.culled_count               = culled_count;
+  render_stats.full_detail_triangle_count = full_detail_triangle_count;
+  render_stats.triangle_count             = triangle_count;
+}
 
 void Renderer::clear_color() { glClear(GL_COLOR_BUFFER_BIT); }
 
@@ -82,7 +179,7 @@ Renderer::create_index_buffer(const std::vector<uint32_t> &indices)
 }
 
 std::shared_ptr<Fge::VertexBuffer>
-Renderer::create_vertex_buffer(const std::vector<VertexPNTBT> &vertices)
+Renderer::create_vertex_buffer(const std::vector<PackedVertexPNTBT> &vertices)
 {
   return std::make_shared<Gl::VertexBufferPNTBT>(vertices);
 }
@@ -94,11 +191,18 @@ Renderer::create_vertex_buffer(const std::vector<VertexP> &vertices)
 }
 
 std::shared_ptr<VertexBuffer>
-Renderer::create_vertex_buffer(const std::vector<VertexPNTBBWT> &vertices)
+Renderer::create_vertex_buffer(
+    const std::vector<PackedVertexPNTBBWT> &vertices)
 {
   return std::make_shared<Gl::VertexBufferPNTBBWT>(vertices);
 }
 
+std::shared_ptr<Fge::UniformBuffer>
+Renderer::create_uniform_buffer(std::size_t size)
+{
+  return std::make_shared<Gl::UniformBuffer>(size);
+}
+
 std::shared_ptr<Fge::Texture2D>
 Renderer::create_texture2d(const Texture2DConfig &config)
 {
@@ -119,7 +223,7 @@ Renderer::create_framebuffer_rrt(const FramebufferConfigRRT &config)
 
 void Renderer::register_renderable(std::shared_ptr<RenderInfo> render_info)
 {
-  trace("Renderer", "Try to register renderable");
+  trace("Renderer", FMT_STRING("Try to register renderable"));
 
   for (auto renderable : renderables)
   {
@@ -129,19 +233,19 @@ void Renderer::register_renderable(std::shared_ptr<RenderInfo> render_info)
     }
   }
 
-  trace("Renderer", "Register renderable");
+  trace("Renderer", FMT_STRING("Register renderable"));
   renderables.push_back(render_info);
 }
 
 void Renderer::unregister_renderable(std::shared_ptr<RenderInfo> render_info)
 {
-  trace("Renderer", "Try to unregister renderable");
+  trace("Renderer", FMT_STRING("Try to unregister renderable"));
 
   for (size_t i = 0; i < renderables.size(); ++i)
   {
     if (renderables[i] == render_info)
     {
-      trace("Renderer", "Unregister renderable");
+      trace("Renderer", FMT_STRING("Unregister renderable"));
       renderables.erase(renderables.begin() + i);
     }
   }
@@ -156,33 +260,111 @@ Renderer::get_renderables() const
 void Renderer::draw(const Fge::VertexArray &vertex_array,
                     const Fge::IndexBuffer &index_buffer,
                     Material &              material,
-                    DrawMode                draw_mode)
+                    DrawMode                draw_mode,
+                    uint32_t                first_index,
+                    uint32_t                index_count)
 {
+  FGE_ASSERT(first_index + index_count <= index_buffer.get_count());
+
+  // Nothing gets unbound, so the state cache can skip the binds of the
+  // next draw if it uses the same state
   material.bind();
   vertex_array.bind();
 
   glDrawElements(draw_mode_to_gl_draw_mode(draw_mode),
-                 index_buffer.get_count(),
-                 GL_UNSIGNED_INT,
-                 nullptr);
-
-  vertex_array.unbind();
-  material.unbind();
+                 index_count,
+                 index_type_to_gl_type(index_buffer.get_index_type()),
+                 get_index_offset(index_buffer, first_index));
+  ++draw_call_count;
 }
 
 void Renderer::draw(const Fge::VertexArray &vertex_array,
                     Material &              material,
                     DrawMode                draw_mode)
 {
-  vertex_array.bind();
   material.bind();
+  vertex_array.bind();
 
   glDrawArrays(draw_mode_to_gl_draw_mode(draw_mode),
                0,
                vertex_array.get_count());
+  ++draw_call_count;
+}
+
+void Renderer::upload_instance_data(const std::vector<glm::mat4> &world_mats)
+{
+  const auto size = world_mats.size() * sizeof(glm::mat4);
+  if (size == 0)
+  {
+    return;
+  }
+
+  if (size > instance_buffer_size)
+  {
+    instance_buffer_size = std::max(size, instance_buffer_size * 2);
+  }
+
+  // Orphan the old storage, so the upload doesn't wait for draws of the
+  // last frame that still read from it
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  glBufferData(GL_ARRAY_BUFFER, instance_buffer_size, nullptr, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, size, world_mats.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Renderer::upload_bone_palette(const std::vector<BoneUniforms> &bones)
+{
+  const auto size = bones.size() * sizeof(BoneUniforms);
+  if (size == 0)
+  {
+    return;
+  }
 
-  material.unbind();
-  vertex_array.unbind();
+  if (size > bone_palette_buffer_size)
+  {
+    bone_palette_buffer_size = std::max(size, bone_palette_buffer_size * 2);
+  }
+
+  // Orphaned like the instance buffer
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, bone_palette_buffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER,
+               bone_palette_buffer_size,
+               nullptr,
+               GL_STREAM_DRAW);
+  glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, bones.data());
+  glBindBufferBase(
+      GL_SHADER_STORAGE_BUFFER, bone_palette_binding, bone_palette_buffer);
+}
+
+void Renderer::draw_instanced(const Fge::VertexArray &vertex_array,
+                              const Fge::IndexBuffer &index_buffer,
+                              Material &              material,
+                              DrawMode                draw_mode,
+                              uint32_t                first_index,
+                              uint32_t                index_count,
+                              uint32_t                first_instance,
+                              uint32_t                instance_count)
+{
+  FGE_ASSERT(first_index + index_count <= index_buffer.get_count());
+
+  const auto &gl_vertex_array =
+      static_cast<const Gl::VertexArray &>(vertex_array);
+  gl_vertex_array.set_instance_buffer(instance_buffer);
+
+  material.bind_instanced();
+  vertex_array.bind();
+
+  glDrawElementsInstancedBaseInstance(draw_mode_to_gl_draw_mode(draw_mode),
+                                      index_count,
+                                      index_type_to_gl_type(
+                                          index_buffer.get_index_type()),
+                                      get_index_offset(index_buffer,
+                                                       first_index),
+                                      instance_count,
+                                      first_instance);
+  ++draw_call_count;
+  ++instanced_draw_call_count;
+  drawn_instance_count += instance_count;
 }
 
 void Renderer::set_viewport(uint32_t x,
@@ -193,40 +375,140 @@ void Renderer::set_viewport(uint32_t x,
   glViewport(x, y, width, height);
 }
 
+void Renderer::add_culling_result(uint32_t visible_count,
+                                  uint32_t culled_count)
+{
+  this->visible_count += visible_count;
+  this->culled_count += culled_count;
+}
+
+void Renderer::add_lod_result(uint32_t full_detail_triangle_count,
+                              uint32_t triangle_count)
+{
+  this->full_detail_triangle_count += full_detail_triangle_count;
+  this->triangle_count += triangle_count;
+}
+
+const RenderStats &Renderer::get_render_stats() const { return render_stats; }
+
+const ShaderCacheStats &Renderer::get_shader_cache_stats() const
+{
+  return shader_cache_stats;
+}
+
 std::shared_ptr<Fge::Shader>
 Renderer::create_shader(const std::string &vertex_shader_filename,
                         const std::string &fragment_shader_filename,
                         const std::vector<std::string> &shader_defines)
 {
-  auto app          = Application::get_instance();
-  auto file_manager = app->get_file_manager();
+  // The order of the defines doesn't matter for the result
+  auto sorted_defines = shader_defines;
+  std::sort(sorted_defines.begin(), sorted_defines.end());
+
+  auto cache_key = vertex_shader_filename + ";" + fragment_shader_filename;
+  for (const auto &define : sorted_defines)
+  {
+    cache_key += ";" + define;
+  }
+
+  auto &cached_shader = shader_cache[cache_key];
+  if (auto shader = cached_shader.lock())
+  {
+    ++shader_cache_stats.variant_hit_count;
+    return shader;
+  }
+
+  const auto shaders_path  = get_shaders_path();
+  const auto vertex_shader = shader_preprocessor.preprocess(
+      shaders_path / vertex_shader_filename, sorted_defines);
+  const auto fragment_shader = shader_preprocessor.preprocess(
+      shaders_path / fragment_shader_filename, sorted_defines);
+
+  std::shared_ptr<Fge::Shader> shader{};
+  try
+  {
+    shader = create_program(vertex_shader.code, fragment_shader.code);
+  }
+  catch (const std::runtime_error &error)
+  {
+    // The errors name files by their source string number
+    throw std::runtime_error(
+        std::string(error.what()) + "\nVertex shader files: " +
+        describe_source_strings(vertex_shader) +
+        "\nFragment shader files: " + describe_source_strings(fragment_shader));
+  }
+
+  cached_shader = shader;
+
+  return shader;
+}
+
+std::shared_ptr<Fge::Shader>
+Renderer::create_program(const std::string &vertex_shader_code,
+                         const std::string &fragment_shader_code)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const auto elapsed_ms = [](Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+  };
 
-  auto vertex_shader_code = file_manager->read_text_file(
-      (file_manager->get_shaders_path() / vertex_shader_filename).string());
-  auto fragment_shader_code = file_manager->read_text_file(
-      (file_manager->get_shaders_path() / fragment_shader_filename).string());
+  // The sources are preprocessed, so the defines and includes are part of it
+  const auto key =
+      driver_key + '\0' + vertex_shader_code + '\0' + fragment_shader_code;
 
-  ShaderPreprocessor shader_preprocessor(std::vector<std::string>{
-      file_manager->get_shaders_path().string() + "/"});
-  for (const auto &define : shader_defines)
+  if (program_binaries_supported)
   {
-    shader_preprocessor.set_define(define);
+    const auto start = Clock::now();
+    if (auto binary = program_binaries.load(key))
+    {
+      try
+      {
+        auto       shader  = std::make_shared<Gl::Shader>(*binary);
+        const auto load_ms = elapsed_ms(start);
+
+        ++shader_cache_stats.binary_hit_count;
+        shader_cache_stats.binary_load_ms += load_ms;
+        shader_cache_stats.saved_compile_ms +=
+            std::max(binary->compile_ms - load_ms, 0.0);
+
+        return shader;
+      }
+      catch (const std::runtime_error &error)
+      {
+        trace("Renderer",
+              FMT_STRING("Compile program again: {}"),
+              error.what());
+        program_binaries.remove(key);
+      }
+    }
   }
 
-  // FIXME: This will fail if shaders are not in base directory
-  vertex_shader_code = shader_preprocessor.preprocess(
-      file_manager->get_shaders_path().string() + "/",
-      vertex_shader_code);
-  fragment_shader_code = shader_preprocessor.preprocess(
-      file_manager->get_shaders_path().string() + "/",
-      fragment_shader_code);
+  const auto start = Clock::now();
+  auto       shader =
+      std::make_shared<Gl::Shader>(vertex_shader_code, fragment_shader_code);
+  const auto compile_ms = elapsed_ms(start);
+
+  ++shader_cache_stats.binary_miss_count;
+  shader_cache_stats.compile_ms += compile_ms;
 
-  return std::make_shared<Gl::Shader>(vertex_shader_code, fragment_shader_code);
+  if (program_binaries_supported)
+  {
+    auto binary       = shader->get_binary();
+    binary.compile_ms = compile_ms;
+    if (!binary.data.empty())
+    {
+      program_binaries.store(key, binary);
+    }
+  }
+
+  return shader;
 }
 
 void Renderer::register_point_light(std::shared_ptr<PointLight> point_light)
 {
-  trace("Renderer", "Try to register point light");
+  trace("Renderer", FMT_STRING("Try to register point light"));
 
   for (auto l : point_lights)
   {
@@ -236,14 +518,14 @@ void Renderer::register_point_light(std::shared_ptr<PointLight> point_light)
     }
   }
 
-  trace("Renderer", "Register point light");
+  trace("Renderer", FMT_STRING("Register point light"));
   point_lights.push_back(point_light);
 }
 
 void Renderer::register_directional_light(
     std::shared_ptr<DirectionalLight> directional_light)
 {
-  trace("Renderer", "Try to register directional light");
+  trace("Renderer", FMT_STRING("Try to register directional light"));
 
   for (auto l : directional_lights)
   {
@@ -253,13 +535,13 @@ void Renderer::register_directional_light(
     }
   }
 
-  trace("Renderer", "Register directional light");
+  trace("Renderer", FMT_STRING("Register directional light"));
   directional_lights.push_back(directional_light);
 }
 
 void Renderer::register_spot_light(std::shared_ptr<SpotLight> spot_light)
 {
-  trace("Renderer", "Try to register spot light");
+  trace("Renderer", FMT_STRING("Try to register spot light"));
 
   for (auto l : spot_lights)
   {
@@ -269,19 +551,19 @@ void Renderer::register_spot_light(std::shared_ptr<SpotLight> spot_light)
     }
   }
 
-  trace("Renderer", "Register spot light");
+  trace("Renderer", FMT_STRING("Register spot light"));
   spot_lights.push_back(spot_light);
 }
 
 void Renderer::unregister_point_light(std::shared_ptr<PointLight> point_light)
 {
-  trace("Renderer", "Try to unregister point light");
+  trace("Renderer", FMT_STRING("Try to unregister point light"));
 
   for (size_t i = 0; i < point_lights.size(); ++i)
   {
     if (point_lights[i] == point_light)
     {
-      trace("Renderer", "Unregister point light");
+      trace("Renderer", FMT_STRING("Unregister point light"));
       point_lights.erase(point_lights.begin() + i);
     }
   }
@@ -290,13 +572,13 @@ void Renderer::unregister_point_light(std::shared_ptr<PointLight> point_light)
 void Renderer::unregister_directional_light(
     std::shared_ptr<DirectionalLight> directional_light)
 {
-  trace("Renderer", "Try to unregister directional light");
+  trace("Renderer", FMT_STRING("Try to unregister directional light"));
 
   for (size_t i = 0; i < directional_lights.size(); ++i)
   {
     if (directional_lights[i] == directional_light)
     {
-      trace("Renderer", "Unregister directional light");
+      trace("Renderer", FMT_STRING("Unregister directional light"));
       directional_lights.erase(directional_lights.begin() + i);
     }
   }
@@ -304,13 +586,13 @@ void Renderer::unregister_directional_light(
 
 void Renderer::unregister_spot_light(std::shared_ptr<SpotLight> spot_light)
 {
-  trace("Renderer", "Try to unregister spot light");
+  trace("Renderer", FMT_STRING("Try to unregister spot light"));
 
   for (size_t i = 0; i < spot_lights.size(); ++i)
   {
     if (spot_lights[i] == spot_light)
     {
-      trace("Renderer", "Unregister spot light");
+      trace("Renderer", FMT_STRING("Unregister spot light"));
       spot_lights.erase(spot_lights.begin() + i);
     }
   }
@@ -335,10 +617,25 @@ const std::vector<std::shared_ptr<SpotLight>> &Renderer::get_spot_lights() const
 
 void Renderer::terminate()
 {
+  glDeleteBuffers(1, &instance_buffer);
+  instance_buffer = 0;
+  glDeleteBuffers(1, &bone_palette_buffer);
+  bone_palette_buffer = 0;
+  shader_cache.clear();
+
+  info("Renderer",
+       FMT_STRING("Shader cache: {} variant hits, {} binary hits, {} "
+                  "compiled in {:.1f} ms, binaries saved {:.1f} ms"),
+       shader_cache_stats.variant_hit_count,
+       shader_cache_stats.binary_hit_count,
+       shader_cache_stats.binary_miss_count,
+       shader_cache_stats.compile_ms,
+       shader_cache_stats.saved_compile_ms);
+
   if (point_lights.size() > 0)
   {
     trace("Renderer",
-          "Terminate cleared {} forgotten point lights",
+          FMT_STRING("Terminate cleared {} forgotten point lights"),
           point_lights.size());
   }
   point_lights.clear();
@@ -346,7 +643,7 @@ void Renderer::terminate()
   if (spot_lights.size() > 0)
   {
     trace("Renderer",
-          "Terminate cleared {} forgotten spot lights",
+          FMT_STRING("Terminate cleared {} forgotten spot lights"),
           spot_lights.size());
   }
   spot_lights.clear();
@@ -354,7 +651,7 @@ void Renderer::terminate()
   if (directional_lights.size() > 0)
   {
     trace("Renderer",
-          "Terminate cleared {} forgotten directional lights",
+          FMT_STRING("Terminate cleared {} forgotten directional lights"),
           directional_lights.size());
   }
   directional_lights.clear();
@@ -362,7 +659,7 @@ void Renderer::terminate()
   if (renderables.size() > 0)
   {
     trace("Renderer",
-          "Terminate cleared {} forgotten renderables",
+          FMT_STRING("Terminate cleared {} forgotten renderables"),
           renderables.size());
   }
   renderables.clear();
@@ -1,8 +1,10 @@
 ﻿#pragma once
 
 #include "graphic/point_light.hpp"
+#include "graphic/program_binary_cache.hpp"
 #include "graphic/render_info.hpp"
 #include "graphic/renderer.hpp"
+#include "graphic/shader_preprocessor.hpp"
 
 namespace Fge::Gl
 {
@@ -37,19 +39,24 @@ public:
   create_index_buffer(const std::vector<uint32_t> &indices) override;
 
   std::shared_ptr<Fge::VertexBuffer>
-  create_vertex_buffer(const std::vector<VertexPNTBT> &vertices) override;
+  create_vertex_buffer(
+      const std::vector<PackedVertexPNTBT> &vertices) override;
 
   std::shared_ptr<Fge::VertexBuffer>
   create_vertex_buffer(const std::vector<VertexP> &vertices) override;
 
   std::shared_ptr<VertexBuffer>
-  create_vertex_buffer(const std::vector<VertexPNTBBWT> &vertices) override;
+  create_vertex_buffer(
+      const std::vector<PackedVertexPNTBBWT> &vertices) override;
 
   std::shared_ptr<Fge::Shader>
   create_shader(const std::string &             vertex_shader_filename,
                 const std::string &             fragment_shader_filename,
                 const std::vector<std::string> &shader_defines) override;
 
+  std::shared_ptr<Fge::UniformBuffer>
+  create_uniform_buffer(std::size_t size) override;
+
   std::shared_ptr<Fge::Texture2D>
   create_texture2d(const Texture2DConfig &config) override;
 
@@ -69,17 +76,42 @@ public:
   void draw(const Fge::VertexArray &vertex_array,
             const Fge::IndexBuffer &index_buffer,
             Material &              material,
-            DrawMode                draw_mode) override;
+            DrawMode                draw_mode,
+            uint32_t                first_index,
+            uint32_t                index_count) override;
 
   void draw(const Fge::VertexArray &vertex_array,
             Material &              material,
             DrawMode                draw_mode) override;
 
+  void upload_instance_data(const std::vector<glm::mat4> &world_mats) override;
+
+  void upload_bone_palette(const std::vector<BoneUniforms> &bones) override;
+
+  void draw_instanced(const Fge::VertexArray &vertex_array,
+                      const Fge::IndexBuffer &index_buffer,
+                      Material &              material,
+                      DrawMode                draw_mode,
+                      uint32_t                first_index,
+                      uint32_t                index_count,
+                      uint32_t                first_instance,
+                      uint32_t                instance_count) override;
+
+  void add_culling_result(uint32_t visible_count,
+                          uint32_t culled_count) override;
+
+  void add_lod_result(uint32_t full_detail_triangle_count,
+                      uint32_t triangle_count) override;
+
   void set_viewport(uint32_t x,
                     uint32_t y,
                     uint32_t width,
                     uint32_t height) override;
 
+  const RenderStats &get_render_stats() const override;
+
+  const ShaderCacheStats &get_shader_cache_stats() const override;
+
   void register_point_light(std::shared_ptr<PointLight> point_light) override;
 
   void register_directional_light(
@@ -111,6 +143,42 @@ private:
   std::vector<std::shared_ptr<PointLight>>       point_lights;
   std::vector<std::shared_ptr<SpotLight>>        spot_lights;
   std::vector<std::shared_ptr<DirectionalLight>> directional_lights;
+
+  // Shaders are shared between materials with the same defines
+  std::unordered_map<std::string, std::weak_ptr<Fge::Shader>> shader_cache;
+
+  // Keeps the parsed shader files between variants
+  ShaderPreprocessor shader_preprocessor;
+
+  ProgramBinaryCache program_binaries;
+
+  // Identifies the driver, binaries only work with the one that made them
+  std::string driver_key;
+  bool        program_binaries_supported = false;
+
+  ShaderCacheStats shader_cache_stats{};
+
+  uint32_t    instance_buffer = 0;
+  std::size_t instance_buffer_size{};
+
+  uint32_t    bone_palette_buffer = 0;
+  std::size_t bone_palette_buffer_size{};
+
+  RenderStats render_stats{};
+  uint32_t    draw_call_count            = 0;
+  uint32_t    instanced_draw_call_count  = 0;
+  uint32_t    drawn_instance_count       = 0;
+  uint32_t    visible_count              = 0;
+  uint32_t    culled_count               = 0;
+  uint32_t    full_detail_triangle_count = 0;
+  uint32_t    triangle_count             = 0;
+
+  /**
+   * Loads the program from the binary cache, or compiles it and stores it.
+   */
+  std::shared_ptr<Fge::Shader>
+  create_program(const std::string &vertex_shader_code,
+                 const std::string &fragment_shader_code);
 };
 
 } // namespace Fge::Gl
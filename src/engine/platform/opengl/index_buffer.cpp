@@ -7,20 +7,36 @@ namespace Fge::Gl
 
 IndexBuffer::IndexBuffer(const std::vector<uint32_t> &indices)
     : Fge::IndexBuffer(indices),
-      indices(indices)
+      count(static_cast<uint32_t>(indices.size()))
 {
   glGenBuffers(1, &id);
-  trace("IndexBuffer", "Created index buffer with id: {}", id);
+  trace("IndexBuffer", FMT_STRING("Created index buffer with id: {}"), id);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-               get_count() * sizeof(unsigned),
-               &indices[0],
-               GL_STATIC_DRAW);
+
+  const auto max_index = std::max_element(indices.begin(), indices.end());
+  if (max_index == indices.end() ||
+      *max_index <= std::numeric_limits<uint16_t>::max())
+  {
+    type = IndexType::UInt16;
+
+    const std::vector<uint16_t> short_indices(indices.begin(), indices.end());
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 short_indices.size() * sizeof(uint16_t),
+                 short_indices.data(),
+                 GL_STATIC_DRAW);
+  }
+  else
+  {
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 indices.size() * sizeof(uint32_t),
+                 indices.data(),
+                 GL_STATIC_DRAW);
+  }
 }
 
 IndexBuffer::~IndexBuffer()
 {
-  trace("IndexBuffer", "Delete index buffer with id: {}", id);
+  trace("IndexBuffer", FMT_STRING("Delete index buffer with id: {}"), id);
   glDeleteBuffers(1, &id);
 }
 
@@ -28,6 +44,8 @@ void IndexBuffer::bind() const { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id); }
 
 void IndexBuffer::unbind() const { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); }
 
-uint32_t IndexBuffer::get_count() const { return indices.size(); }
+uint32_t IndexBuffer::get_count() const { return count; }
+
+IndexType IndexBuffer::get_index_type() const { return type; }
 
 } // namespace Fge::Gl
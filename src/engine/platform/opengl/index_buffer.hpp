@@ -18,9 +18,12 @@ public:
 
   uint32_t get_count() const override;
 
+  IndexType get_index_type() const override;
+
 private:
-  uint32_t                    id = 0;
-  const std::vector<uint32_t> indices;
+  uint32_t  id    = 0;
+  uint32_t  count = 0;
+  IndexType type  = IndexType::UInt32;
 };
 
 } // namespace Fge::Gl
@@ -22,7 +22,7 @@ GLenum renderbuffer_format_to_gl_format(RenderBufferFormat format)
 Renderbuffer::Renderbuffer(const RenderbufferConfig &config) : config(config)
 {
   glGenRenderbuffers(1, &id);
-  trace("Renderbuffer", "Created renderbuffer with id: {}", id);
+  trace("Renderbuffer", FMT_STRING("Created renderbuffer with id: {}"), id);
 
   glBindRenderbuffer(GL_RENDERBUFFER, id);
 
@@ -48,7 +48,7 @@ Renderbuffer::Renderbuffer(const RenderbufferConfig &config) : config(config)
 
 Renderbuffer::~Renderbuffer()
 {
-  trace("Renderbuffer", "Delete renderbuffer with id: {}", id);
+  trace("Renderbuffer", FMT_STRING("Delete renderbuffer with id: {}"), id);
   glDeleteRenderbuffers(1, &id);
 }
 
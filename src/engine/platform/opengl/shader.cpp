@@ -14,7 +14,7 @@ Shader::Shader(const std::string &             vertex_shader_program,
       compile_shader(fragment_shader_program, GL_FRAGMENT_SHADER);
 
   id = glCreateProgram();
-  trace("Shader", "Created shader with id: {}", id);
+  trace("Shader", FMT_STRING("Created shader with id: {}"), id);
   glAttachShader(id, vertex_shader_id);
   glAttachShader(id, fragment_shader_id);
 
@@ -26,6 +26,7 @@ Shader::Shader(const std::string &             vertex_shader_program,
   glLinkProgram(id);
 
   check_for_program_compile_errors(id);
+  load_uniform_locations();
 
   glDeleteShader(vertex_shader_id);
   glDeleteShader(fragment_shader_id);
@@ -49,7 +50,7 @@ Shader::Shader(const std::string &vertexShaderProgram,
   check_for_compile_errors("", fragmentShaderId, ShaderType::FRAGMENT);
 
   id = glCreateProgram();
-  trace("Shader", "Created shader with id: {}", id);
+  trace("Shader", FMT_STRING("Created shader with id: {}"), id);
   glAttachShader(id, vertexShaderId);
   glAttachShader(id, fragmentShaderId);
 
@@ -63,19 +64,160 @@ Shader::Shader(const std::string &vertexShaderProgram,
     glAttachShader(id, geometryShaderId);
   }
 
+  // Lets the renderer store the linked program in the binary cache
+  glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
   glLinkProgram(id);
   check_for_compile_errors("", id, ShaderType::PROGRAMM);
+  load_uniform_locations();
 
   glDeleteShader(vertexShaderId);
   glDeleteShader(fragmentShaderId);
 }
 
+Shader::Shader(const ProgramBinary &binary)
+{
+  id = glCreateProgram();
+  trace("Shader", FMT_STRING("Created shader from binary with id: {}"), id);
+
+  glProgramBinary(id,
+                  binary.format,
+                  binary.data.data(),
+                  static_cast<GLsizei>(binary.data.size()));
+
+  GLint success = GL_FALSE;
+  glGetProgramiv(id, GL_LINK_STATUS, &success);
+  if (!success)
+  {
+    glDeleteProgram(id);
+    throw std::runtime_error("Program binary got rejected by the driver");
+  }
+
+  load_uniform_locations();
+}
+
 Shader::~Shader()
 {
-  trace("Shader", "Delete shader with id: {}", id);
+  trace("Shader", FMT_STRING("Delete shader with id: {}"), id);
+  StateCache::get_instance().on_program_deleted(id);
   glDeleteProgram(id);
 }
 
+ProgramBinary Shader::get_binary() const
+{
+  GLint length = 0;
+  glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+
+  ProgramBinary binary{};
+  binary.data.resize(static_cast<std::size_t>(length));
+
+  GLenum format = 0;
+  glGetProgramBinary(id, length, nullptr, &format, binary.data.data());
+  binary.format = format;
+
+  return binary;
+}
+
+void Shader::load_uniform_locations()
+{
+  GLint uniform_count = 0;
+  glGetProgramInterfaceiv(id, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniform_count);
+
+  const GLenum properties[] = {GL_NAME_LENGTH, GL_LOCATION};
+  std::string  name;
+
+  for (GLint i = 0; i < uniform_count; ++i)
+  {
+    GLint values[2]{};
+    glGetProgramResourceiv(id,
+                           GL_UNIFORM,
+                           i,
+                           2,
+                           properties,
+                           2,
+                           nullptr,
+                           values);
+
+    // Members of uniform blocks have no location
+    const auto location = values[1];
+    if (location < 0)
+    {
+      continue;
+    }
+
+    // The name length includes the null terminator
+    name.resize(values[0]);
+    glGetProgramResourceName(id, GL_UNIFORM, i, values[0], nullptr, &name[0]);
+    name.resize(values[0] - 1);
+
+    uniform_locations[name] = location;
+
+    // Arrays are reported as "name[0]", but get set by their plain name
+    const std::string array_suffix = "[0]";
+    if (name.size() > array_suffix.size() &&
+        name.compare(name.size() - array_suffix.size(),
+                     array_suffix.size(),
+                     array_suffix) == 0)
+    {
+      uniform_locations[name.substr(0, name.size() - array_suffix.size())] =
+          location;
+    }
+  }
+}
+
+void Shader::set_uniform(int32_t     location,
+                         UniformType type,
+                         const void *data,
+                         uint32_t    count)
+{
+  const auto f = static_cast<const GLfloat *>(data);
+  const auto i = static_cast<const GLint *>(data);
+
+  switch (type)
+  {
+  case UniformType::Bool:
+  case UniformType::Int:
+  case UniformType::Texture2D:
+    glProgramUniform1iv(id, location, count, i);
+    break;
+
+  case UniformType::Float:
+    glProgramUniform1fv(id, location, count, f);
+    break;
+
+  case UniformType::Vec2:
+    glProgramUniform2fv(id, location, count, f);
+    break;
+
+  case UniformType::IVec2:
+    glProgramUniform2iv(id, location, count, i);
+    break;
+
+  case UniformType::Vec3:
+    glProgramUniform3fv(id, location, count, f);
+    break;
+
+  case UniformType::Vec4:
+    glProgramUniform4fv(id, location, count, f);
+    break;
+
+  case UniformType::Mat2:
+    glProgramUniformMatrix2fv(id, location, count, GL_FALSE, f);
+    break;
+
+  case UniformType::Mat3:
+    glProgramUniformMatrix3fv(id, location, count, GL_FALSE, f);
+    break;
+
+  case UniformType::Mat4:
+    glProgramUniformMatrix4fv(id, location, count, GL_FALSE, f);
+    break;
+
+  default:
+    FGE_FAIL("No such uniform type");
+  }
+}
+
 GLuint Shader::compile_shader(const std::string &program, GLenum type)
 {
   GLuint id = 0;
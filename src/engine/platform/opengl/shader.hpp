@@ -1,9 +1,11 @@
 #pragma once
 
 #include "gl.hpp"
+#include "graphic/program_binary_cache.hpp"
 #include "graphic/shader.hpp"
 #include "log/log.hpp"
 #include "math/math.hpp"
+#include "state_cache.hpp"
 #include "std.hpp"
 
 namespace Fge::Gl
@@ -32,19 +34,31 @@ public:
          const std::string &             fragmentShaderProgram,
          const std::vector<const char *> output_names);
 
+  /**
+   * Creates the program from a binary of get_binary().
+   *
+   * @throws std::runtime_error If the driver rejects the binary
+   */
+  explicit Shader(const ProgramBinary &binary);
+
   ~Shader();
 
   uint32_t get_id() const override { return id; }
 
+  /**
+   * @return The linked program in the format of the driver
+   */
+  ProgramBinary get_binary() const;
+
   /**
    * Binds the shader for rendering
    */
-  void bind() const override { glUseProgram(id); }
+  void bind() const override { StateCache::get_instance().use_program(id); }
 
   /**
    * Unbinds the shader for rendering
    */
-  void unbind() const override { glUseProgram(0); }
+  void unbind() const override { StateCache::get_instance().use_program(0); }
 
   /**
    * Sets a bool variable for the shader
@@ -196,26 +210,24 @@ public:
     return glGetAttribLocation(id, name.c_str());
   }
 
-  int get_uniform_location(const std::string &name)
+  int32_t get_uniform_location(const std::string &name) const override
   {
-    if (uniform_location_cache.find(name) != uniform_location_cache.end())
+    const auto iter = uniform_locations.find(name);
+    if (iter == uniform_locations.end())
     {
-      return uniform_location_cache[name];
+      return -1;
     }
-    auto location = glGetUniformLocation(id, name.c_str());
-
-    if (location == -1)
-    {
-      warning("Shader", "Uniform {} doesn't exist!", name);
-    }
-
-    uniform_location_cache[name] = location;
-    return location;
+    return iter->second;
   }
 
+  void set_uniform(int32_t     location,
+                   UniformType type,
+                   const void *data,
+                   uint32_t    count = 1) override;
+
 private:
-  uint32_t                             id = 0;
-  std::unordered_map<std::string, int32_t> uniform_location_cache;
+  uint32_t                                 id = 0;
+  std::unordered_map<std::string, int32_t> uniform_locations;
 
   enum class ShaderType
   {
@@ -240,6 +252,8 @@ private:
   void check_shader_compile_errors(GLuint id, GLenum shader_type);
 
   void check_for_program_compile_errors(GLuint program_id);
+
+  void load_uniform_locations();
 };
 
 } // namespace Fge::Gl
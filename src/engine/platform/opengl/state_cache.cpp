@@ -0,0 +1,113 @@
+#include "state_cache.hpp"
+#include "util/assert.hpp"
+
+namespace Fge::Gl
+{
+
+StateCache &StateCache::get_instance()
+{
+  static StateCache instance;
+  return instance;
+}
+
+StateCache::StateCache() { invalidate(); }
+
+void StateCache::use_program(GLuint id)
+{
+  if (program == id)
+  {
+    ++counts.elided_change_count;
+    return;
+  }
+
+  glUseProgram(id);
+  program = id;
+  ++counts.program_change_count;
+}
+
+void StateCache::bind_vertex_array(GLuint id)
+{
+  if (vertex_array == id)
+  {
+    ++counts.elided_change_count;
+    return;
+  }
+
+  glBindVertexArray(id);
+  vertex_array = id;
+  ++counts.vertex_array_change_count;
+}
+
+void StateCache::bind_texture(uint32_t unit, GLenum target, GLuint id)
+{
+  FGE_ASSERT(unit < max_texture_units);
+
+  if (textures[unit] == id)
+  {
+    ++counts.elided_change_count;
+    return;
+  }
+
+  set_active_unit(unit);
+  glBindTexture(target, id);
+  textures[unit] = id;
+  ++counts.texture_change_count;
+}
+
+void StateCache::bind_texture(GLenum target, GLuint id)
+{
+  if (active_unit == unknown)
+  {
+    set_active_unit(0);
+  }
+
+  bind_texture(active_unit, target, id);
+}
+
+void StateCache::on_program_deleted(GLuint id)
+{
+  if (program == id)
+  {
+    program = unknown;
+  }
+}
+
+void StateCache::on_vertex_array_deleted(GLuint id)
+{
+  if (vertex_array == id)
+  {
+    vertex_array = unknown;
+  }
+}
+
+void StateCache::on_texture_deleted(GLuint id)
+{
+  for (auto &texture : textures)
+  {
+    if (texture == id)
+    {
+      texture = unknown;
+    }
+  }
+}
+
+void StateCache::invalidate()
+{
+  program      = unknown;
+  vertex_array = unknown;
+  active_unit  = unknown;
+  textures.fill(unknown);
+}
+
+void StateCache::set_active_unit(uint32_t unit)
+{
+  if (active_unit == unit)
+  {
+    return;
+  }
+
+  glActiveTexture(GL_TEXTURE0 + unit);
+  active_unit = unit;
+}
+
+} // namespace Fge::Gl
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "gl.hpp"
+#include "std.hpp"
+
+namespace Fge::Gl
+{
+
+/**
+ * Number of GL state changes that went to the driver and that were
+ * skipped because the state was already set.
+ */
+struct StateChangeCounts
+{
+  uint32_t program_change_count      = 0;
+  uint32_t vertex_array_change_count = 0;
+  uint32_t texture_change_count      = 0;
+  uint32_t elided_change_count       = 0;
+};
+
+/**
+ * Shadows the bound program, vertex array and textures of the GL context
+ * and skips binds that would not change anything.
+ *
+ * All binds of these objects must go through the cache. Code that changes
+ * them behind its back must call invalidate() afterwards.
+ */
+class StateCache
+{
+public:
+  static constexpr uint32_t max_texture_units = 32;
+
+  static StateCache &get_instance();
+
+  void use_program(GLuint id);
+
+  void bind_vertex_array(GLuint id);
+
+  /**
+   * Binds the texture to the given unit. Makes the unit active.
+   */
+  void bind_texture(uint32_t unit, GLenum target, GLuint id);
+
+  /**
+   * Binds the texture to the active unit.
+   */
+  void bind_texture(GLenum target, GLuint id);
+
+  // GL unbinds deleted objects, so their ids must be forgotten. Otherwise
+  // a new object that reuses the id would never be bound.
+  void on_program_deleted(GLuint id);
+
+  void on_vertex_array_deleted(GLuint id);
+
+  void on_texture_deleted(GLuint id);
+
+  /**
+   * Forgets all shadowed state. The next bind of every object goes to the
+   * driver.
+   */
+  void invalidate();
+
+  const StateChangeCounts &get_counts() const { return counts; }
+
+  void reset_counts() { counts = {}; }
+
+private:
+  // Zero is a valid object, so unknown state gets its own value
+  static constexpr GLuint unknown = std::numeric_limits<GLuint>::max();
+
+  GLuint   program      = unknown;
+  GLuint   vertex_array = unknown;
+  uint32_t active_unit  = unknown;
+
+  std::array<GLuint, max_texture_units> textures{};
+
+  StateChangeCounts counts{};
+
+  StateCache();
+
+  void set_active_unit(uint32_t unit);
+};
+
+} // namespace Fge::Gl
@@ -1,6 +1,7 @@
 #include "texture2d.hpp"
 #include "graphic/texture.hpp"
 #include "log/log.hpp"
+#include "state_cache.hpp"
 #include "util/assert.hpp"
 
 namespace Fge::Gl
@@ -71,15 +72,20 @@ Texture2D::Texture2D(const Texture2DConfig &config)
   }
 
   glGenTextures(1, &id);
-  trace("Texture2D", "Created texture2d with id: {}", id);
+  trace("Texture2D", FMT_STRING("Created texture2d with id: {}"), id);
 
-  glBindTexture(target, id);
+  StateCache::get_instance().bind_texture(target, id);
 
   switch (target)
   {
   case GL_TEXTURE_2D:
   {
-    auto gl_format = format_to_gl_format(config.format);
+    auto gl_format     = format_to_gl_format(config.format);
+    auto gl_pixel_type = pixel_type_to_gl_pixel_type(config.pixel_data_type);
+
+    // Rows of small levels and odd sized RGB images aren't 4 byte aligned
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
     glTexImage2D(GL_TEXTURE_2D,
                  0,
                  gl_format,
@@ -87,8 +93,30 @@ Texture2D::Texture2D(const Texture2DConfig &config)
                  config.height,
                  0,
                  gl_format,
-                 pixel_type_to_gl_pixel_type(config.pixel_data_type),
+                 gl_pixel_type,
                  config.data);
+
+    for (std::size_t i = 0; i < config.mip_data.size(); ++i)
+    {
+      const auto level = static_cast<GLint>(i + 1);
+      glTexImage2D(GL_TEXTURE_2D,
+                   level,
+                   gl_format,
+                   std::max(config.width >> level, 1u),
+                   std::max(config.height >> level, 1u),
+                   0,
+                   gl_format,
+                   gl_pixel_type,
+                   config.mip_data[i]);
+    }
+    if (!config.mip_data.empty())
+    {
+      glTexParameteri(GL_TEXTURE_2D,
+                      GL_TEXTURE_MAX_LEVEL,
+                      static_cast<GLint>(config.mip_data.size()));
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     break;
   }
 
@@ -108,7 +136,7 @@ Texture2D::Texture2D(const Texture2DConfig &config)
     FGE_FAIL("Can not handle texture target");
   }
 
-  if (config.generate_mipmap)
+  if (config.generate_mipmap && config.mip_data.empty())
   {
     glGenerateMipmap(target);
   }
@@ -130,21 +158,21 @@ Texture2D::Texture2D(const Texture2DConfig &config)
                     filter_mode_to_gl_filter_mode(config.filter_max));
   }
 
-  glBindTexture(target, 0);
+  StateCache::get_instance().bind_texture(target, 0);
 }
 
 Texture2D::~Texture2D()
 {
-  trace("Texture2D", "Delete texture2d with id: {}", id);
+  trace("Texture2D", FMT_STRING("Delete texture2d with id: {}"), id);
+  StateCache::get_instance().on_texture_deleted(id);
   glDeleteTextures(1, &id);
 }
 
 void Texture2D::bind(uint32_t slot)
 {
-  glActiveTexture(GL_TEXTURE0 + slot);
-  glBindTexture(target, id);
+  StateCache::get_instance().bind_texture(slot, target, id);
 }
 
-void Texture2D::unbind() { glBindTexture(target, 0); }
+void Texture2D::unbind() { StateCache::get_instance().bind_texture(target, 0); }
 
 } // namespace Fge::Gl
@@ -0,0 +1,42 @@
+#include "uniform_buffer.hpp"
+#include "gl.hpp"
+#include "log/log.hpp"
+#include "util/assert.hpp"
+
+namespace Fge::Gl
+{
+
+UniformBuffer::UniformBuffer(std::size_t size) : size(size)
+{
+  glGenBuffers(1, &id);
+  trace("UniformBuffer", FMT_STRING("Created uniform buffer with id: {}"), id);
+  glBindBuffer(GL_UNIFORM_BUFFER, id);
+  glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+  trace("UniformBuffer", FMT_STRING("Delete uniform buffer with id: {}"), id);
+  glDeleteBuffers(1, &id);
+}
+
+void UniformBuffer::set_data(const void *data,
+                             std::size_t size,
+                             std::size_t offset)
+{
+  FGE_ASSERT(offset + size <= this->size);
+
+  glBindBuffer(GL_UNIFORM_BUFFER, id);
+  glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBuffer::bind(uint32_t binding_point) const
+{
+  glBindBufferBase(GL_UNIFORM_BUFFER, binding_point, id);
+}
+
+std::size_t UniformBuffer::get_size() const { return size; }
+
+} // namespace Fge::Gl
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "graphic/uniform_buffer.hpp"
+
+namespace Fge::Gl
+{
+
+class UniformBuffer : public Fge::UniformBuffer
+{
+public:
+  UniformBuffer(std::size_t size);
+
+  ~UniformBuffer();
+
+  void set_data(const void *data,
+                std::size_t size,
+                std::size_t offset = 0) override;
+
+  void bind(uint32_t binding_point) const override;
+
+  std::size_t get_size() const override;
+
+  using Fge::UniformBuffer::set_data;
+
+private:
+  uint32_t    id = 0;
+  std::size_t size{};
+};
+
+} // namespace Fge::Gl
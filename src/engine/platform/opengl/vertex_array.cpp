@@ -1,6 +1,8 @@
 #include "vertex_array.hpp"
 #include "gl.hpp"
 #include "log/log.hpp"
+#include "math/math.hpp"
+#include "state_cache.hpp"
 #include "util/assert.hpp"
 
 namespace Fge::Gl
@@ -9,12 +11,13 @@ namespace Fge::Gl
 VertexArray::VertexArray()
 {
   glGenVertexArrays(1, &id);
-  trace("VertexArray", "Created vertex array with id: {}", id);
+  trace("VertexArray", FMT_STRING("Created vertex array with id: {}"), id);
 }
 
 VertexArray::~VertexArray()
 {
-  trace("VertexArray", "Delete vertex array with id: {}", id);
+  trace("VertexArray", FMT_STRING("Delete vertex array with id: {}"), id);
+  StateCache::get_instance().on_vertex_array_deleted(id);
   glDeleteVertexArrays(1, &id);
 }
 
@@ -39,8 +42,9 @@ void VertexArray::add_buffer(std::shared_ptr<Fge::VertexBuffer> vertex_buffer)
     auto stride     = layout.get_stride();
 
     trace("VertexArray",
-          "Create vertex attribute pointer with index: {}, size: {}, , "
-          "type: {}, normalized: {}, stride: {}, offset: {}",
+          FMT_STRING(
+              "Create vertex attribute pointer with index: {}, size: {}, "
+              "type: {}, normalized: {}, stride: {}, offset: {}"),
           index,
           size,
           type,
@@ -51,6 +55,8 @@ void VertexArray::add_buffer(std::shared_ptr<Fge::VertexBuffer> vertex_buffer)
     switch (elements[i]->get_type())
     {
     case GL_FLOAT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
       glVertexAttribPointer(index,
                             size,
                             type,
@@ -73,6 +79,27 @@ void VertexArray::add_buffer(std::shared_ptr<Fge::VertexBuffer> vertex_buffer)
                              stride,
                              reinterpret_cast<const void *>(offset));
       break;
+
+    // Normalized bytes are read as floats, the others as integers
+    case GL_UNSIGNED_BYTE:
+      if (normalized)
+      {
+        glVertexAttribPointer(index,
+                              size,
+                              type,
+                              normalized,
+                              stride,
+                              reinterpret_cast<const void *>(offset));
+      }
+      else
+      {
+        glVertexAttribIPointer(index,
+                               size,
+                               GL_UNSIGNED_BYTE,
+                               stride,
+                               reinterpret_cast<const void *>(offset));
+      }
+      break;
     default:
       FGE_FAIL("No such type");
     }
@@ -98,9 +125,46 @@ void VertexArray::add_buffer(std::shared_ptr<Fge::IndexBuffer> index_buffer)
   index_buffers.push_back(index_buffer);
 }
 
-void VertexArray::bind() const { glBindVertexArray(id); }
+void VertexArray::bind() const
+{
+  StateCache::get_instance().bind_vertex_array(id);
+}
+
+void VertexArray::unbind() const
+{
+  StateCache::get_instance().bind_vertex_array(0);
+}
+
+uint32_t VertexArray::get_id() const { return id; }
+
+void VertexArray::set_instance_buffer(GLuint buffer) const
+{
+  if (instance_buffer == buffer)
+  {
+    return;
+  }
+
+  bind();
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
 
-void VertexArray::unbind() const { glBindVertexArray(0); }
+  // A mat4 attribute takes one location per column
+  for (GLuint column = 0; column < 4; ++column)
+  {
+    const auto location = instance_world_mat_location + column;
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(
+        location,
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(glm::mat4),
+        reinterpret_cast<const void *>(column * sizeof(glm::vec4)));
+    glVertexAttribDivisor(location, 1);
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  instance_buffer = buffer;
+}
 
 uint32_t VertexArray::get_count() const { return count; }
 
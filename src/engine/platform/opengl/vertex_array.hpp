@@ -1,5 +1,6 @@
 #pragma once
 
+#include "gl.hpp"
 #include "graphic/index_buffer.hpp"
 #include "graphic/vertex_array.hpp"
 #include "graphic/vertex_buffer.hpp"
@@ -10,6 +11,10 @@ namespace Fge::Gl
 class VertexArray : public Fge::VertexArray
 {
 public:
+  // First of the four locations of the per instance world matrix. Must be
+  // the same as in blinn_phong.vert.
+  static constexpr GLuint instance_world_mat_location = 8;
+
   VertexArray();
 
   ~VertexArray();
@@ -24,12 +29,22 @@ public:
 
   uint32_t get_count() const override;
 
+  uint32_t get_id() const override;
+
+  /**
+   * Sources the per instance world matrix from the given buffer. Only
+   * touches the vertex array if the buffer changed.
+   */
+  void set_instance_buffer(GLuint buffer) const;
+
 private:
   uint32_t id    = 0;
   uint32_t count = 0;
 
   uint32_t index = 0;
 
+  mutable GLuint instance_buffer = 0;
+
   std::vector<std::shared_ptr<Fge::VertexBuffer>> vertex_buffers;
   std::vector<std::shared_ptr<Fge::IndexBuffer>>  index_buffers;
 };
@@ -5,28 +5,31 @@
 namespace Fge::Gl
 {
 
-VertexBufferPNTBT::VertexBufferPNTBT(const std::vector<VertexPNTBT> &vertices)
+VertexBufferPNTBT::VertexBufferPNTBT(
+    const std::vector<PackedVertexPNTBT> &vertices)
     : count(vertices.size())
 {
   glGenBuffers(1, &id);
-  trace("VertexBufferPNTBT", "Created vertex buffer with id: {}", id);
+  trace("VertexBufferPNTBT",
+        FMT_STRING("Created vertex buffer with id: {}"),
+        id);
   glBindBuffer(GL_ARRAY_BUFFER, id);
 
   glBufferData(GL_ARRAY_BUFFER,
-               vertices.size() * sizeof(VertexPNTBT),
+               vertices.size() * sizeof(PackedVertexPNTBT),
                vertices.data(),
                GL_STATIC_DRAW);
 
-  vertex_buffer_layout.push_float(3); // position
-  vertex_buffer_layout.push_float(3); // normal
-  vertex_buffer_layout.push_float(3); // tangent
-  vertex_buffer_layout.push_float(3); // bitangent
-  vertex_buffer_layout.push_float(2); // tex_coord
+  vertex_buffer_layout.push_float(3);            // position
+  vertex_buffer_layout.push_short_normalized(4); // normal_tangent
+  vertex_buffer_layout.push_half_float(2);       // tex_coord
 }
 
 VertexBufferPNTBT::~VertexBufferPNTBT()
 {
-  trace("VertexBufferPNTBT", "Delete vertex buffer with id: {}", id);
+  trace("VertexBufferPNTBT",
+        FMT_STRING("Delete vertex buffer with id: {}"),
+        id);
   glDeleteBuffers(1, &id);
 }
 
@@ -42,30 +45,32 @@ void VertexBufferPNTBT::unbind() { glBindBuffer(GL_ARRAY_BUFFER, 0); }
 uint32_t VertexBufferPNTBT::get_count() const { return count; }
 
 VertexBufferPNTBBWT::VertexBufferPNTBBWT(
-    const std::vector<VertexPNTBBWT> &vertices)
+    const std::vector<PackedVertexPNTBBWT> &vertices)
     : count(vertices.size())
 {
   glGenBuffers(1, &id);
-  trace("VertexBufferPNTBBWT", "Created vertex buffer with id: {}", id);
+  trace("VertexBufferPNTBBWT",
+        FMT_STRING("Created vertex buffer with id: {}"),
+        id);
   glBindBuffer(GL_ARRAY_BUFFER, id);
 
   glBufferData(GL_ARRAY_BUFFER,
-               vertices.size() * sizeof(VertexPNTBBWT),
+               vertices.size() * sizeof(PackedVertexPNTBBWT),
                vertices.data(),
                GL_STATIC_DRAW);
 
-  vertex_buffer_layout.push_float(3); // position
-  vertex_buffer_layout.push_float(3); // normal
-  vertex_buffer_layout.push_float(3); // tangent
-  vertex_buffer_layout.push_float(3); // bitangent
-  vertex_buffer_layout.push_int(4);   // skin_bones
-  vertex_buffer_layout.push_float(4); // skin_weights
-  vertex_buffer_layout.push_float(2); // tex_coord
+  vertex_buffer_layout.push_float(3);            // position
+  vertex_buffer_layout.push_short_normalized(4); // normal_tangent
+  vertex_buffer_layout.push_ubyte(4);            // skin_bones
+  vertex_buffer_layout.push_ubyte_normalized(4); // skin_weights
+  vertex_buffer_layout.push_half_float(2);       // tex_coord
 }
 
 VertexBufferPNTBBWT::~VertexBufferPNTBBWT()
 {
-  trace("VertexBufferPNTBBWT", "Delete vertex buffer with id: {}", id);
+  trace("VertexBufferPNTBBWT",
+        FMT_STRING("Delete vertex buffer with id: {}"),
+        id);
   glDeleteBuffers(1, &id);
 }
 
@@ -84,7 +89,7 @@ VertexBufferP::VertexBufferP(const std::vector<VertexP> &vertices)
     : count(vertices.size())
 {
   glGenBuffers(1, &id);
-  trace("VertexBufferP", "Created vertex buffer with id: {}", id);
+  trace("VertexBufferP", FMT_STRING("Created vertex buffer with id: {}"), id);
   glBindBuffer(GL_ARRAY_BUFFER, id);
 
   glBufferData(GL_ARRAY_BUFFER,
@@ -97,7 +102,7 @@ VertexBufferP::VertexBufferP(const std::vector<VertexP> &vertices)
 
 VertexBufferP::~VertexBufferP()
 {
-  trace("VertexBufferP", "Delete vertex buffer with id: {}", id);
+  trace("VertexBufferP", FMT_STRING("Delete vertex buffer with id: {}"), id);
   glDeleteBuffers(1, &id);
 }
 
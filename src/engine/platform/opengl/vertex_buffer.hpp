@@ -11,7 +11,7 @@ namespace Fge::Gl
 class VertexBufferPNTBT : public Fge::VertexBuffer
 {
 public:
-  VertexBufferPNTBT(const std::vector<VertexPNTBT> &vertices);
+  VertexBufferPNTBT(const std::vector<PackedVertexPNTBT> &vertices);
 
   ~VertexBufferPNTBT();
 
@@ -33,7 +33,7 @@ private:
 class VertexBufferPNTBBWT : public Fge::VertexBuffer
 {
 public:
-  VertexBufferPNTBBWT(const std::vector<VertexPNTBBWT> &vertices);
+  VertexBufferPNTBBWT(const std::vector<PackedVertexPNTBBWT> &vertices);
 
   ~VertexBufferPNTBBWT();
 
@@ -23,6 +23,12 @@ uint32_t VertexBufferLayoutElement::get_size_of_type(int32_t type)
     return sizeof(GL_UNSIGNED_INT);
   case GL_INT:
     return sizeof(GL_INT);
+  case GL_SHORT:
+    return sizeof(GLshort);
+  case GL_HALF_FLOAT:
+    return sizeof(GLhalf);
+  case GL_UNSIGNED_BYTE:
+    return sizeof(GLubyte);
   default:
     FGE_FAIL("No such type");
   }
@@ -53,4 +59,34 @@ void VertexBufferLayout::push_int(std::size_t size)
   stride += element->get_size_of_type(GL_INT) * size;
 }
 
+void VertexBufferLayout::push_short_normalized(std::size_t size)
+{
+  push(size, GL_SHORT, GL_TRUE);
+}
+
+void VertexBufferLayout::push_half_float(std::size_t size)
+{
+  push(size, GL_HALF_FLOAT, GL_FALSE);
+}
+
+void VertexBufferLayout::push_ubyte(std::size_t size)
+{
+  push(size, GL_UNSIGNED_BYTE, GL_FALSE);
+}
+
+void VertexBufferLayout::push_ubyte_normalized(std::size_t size)
+{
+  push(size, GL_UNSIGNED_BYTE, GL_TRUE);
+}
+
+void VertexBufferLayout::push(std::size_t size,
+                              int32_t     type,
+                              uint32_t    normalized)
+{
+  auto element =
+      std::make_shared<VertexBufferLayoutElement>(size, type, normalized);
+  elements.push_back(element);
+  stride += element->get_size_of_type(type) * size;
+}
+
 } // namespace Fge::Gl
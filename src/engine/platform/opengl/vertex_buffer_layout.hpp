@@ -21,6 +21,17 @@ public:
   void push_uint(std::size_t size) override;
 
   void push_int(std::size_t size) override;
+
+  void push_short_normalized(std::size_t size) override;
+
+  void push_half_float(std::size_t size) override;
+
+  void push_ubyte(std::size_t size) override;
+
+  void push_ubyte_normalized(std::size_t size) override;
+
+private:
+  void push(std::size_t size, int32_t type, uint32_t normalized);
 };
 
 } // namespace Fge::Gl
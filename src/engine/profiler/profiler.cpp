@@ -0,0 +1,245 @@
+#include "profiler.hpp"
+#include "util/time.hpp"
+
+#include <iomanip>
+
+namespace Fge
+{
+
+namespace
+{
+
+void write_json_string(std::ostream &out, const char *str)
+{
+  out << '"';
+  for (; *str != '\0'; ++str)
+  {
+    const auto c = *str;
+    if (c == '"' || c == '\\')
+    {
+      out << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      out << ' ';
+    }
+    else
+    {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+} // namespace
+
+Profiler &Profiler::get_instance()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+Profiler::Profiler() : frame_begin_time(get_current_time_nanos()) {}
+
+Profiler::ThreadBufferOwner::~ThreadBufferOwner()
+{
+  if (buffer)
+  {
+    Profiler::get_instance().release_thread_buffer(buffer);
+  }
+}
+
+Profiler::ThreadBuffer &Profiler::get_thread_buffer()
+{
+  thread_local ThreadBufferOwner owner;
+
+  if (!owner.buffer)
+  {
+    owner.buffer = acquire_thread_buffer();
+  }
+
+  return *owner.buffer;
+}
+
+Profiler::ThreadBuffer *Profiler::acquire_thread_buffer()
+{
+  std::lock_guard<std::mutex> lock(thread_buffers_mutex);
+
+  // The ring buffer indices keep counting, so zones of the exited thread that
+  // were not drained yet stay valid
+  for (auto &buffer : thread_buffers)
+  {
+    if (!buffer->in_use)
+    {
+      buffer->in_use = true;
+      return buffer.get();
+    }
+  }
+
+  auto buffer = std::make_shared<ThreadBuffer>();
+  buffer->begin_times.reserve(64);
+  buffer->thread_index = static_cast<uint32_t>(thread_buffers.size());
+  thread_buffers.push_back(buffer);
+  return buffer.get();
+}
+
+void Profiler::release_thread_buffer(ThreadBuffer *buffer)
+{
+  std::lock_guard<std::mutex> lock(thread_buffers_mutex);
+  buffer->depth = 0;
+  buffer->begin_times.clear();
+  buffer->in_use = false;
+}
+
+void Profiler::begin_zone()
+{
+  auto &buffer = get_thread_buffer();
+  buffer.begin_times.push_back(get_current_time_nanos());
+  ++buffer.depth;
+}
+
+void Profiler::end_zone(const char *name)
+{
+  const auto end_time = get_current_time_nanos();
+  auto &     buffer   = get_thread_buffer();
+
+  --buffer.depth;
+  const auto begin_time = buffer.begin_times.back();
+  buffer.begin_times.pop_back();
+
+  const auto write_index = buffer.write_index.load(std::memory_order_relaxed);
+  const auto read_index  = buffer.read_index.load(std::memory_order_acquire);
+  if (write_index - read_index >= ring_buffer_size)
+  {
+    buffer.dropped_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  auto &zone        = buffer.zones[write_index % ring_buffer_size];
+  zone.name         = name;
+  zone.begin_time   = begin_time;
+  zone.end_time     = end_time;
+  zone.depth        = buffer.depth;
+  zone.thread_index = buffer.thread_index;
+
+  buffer.write_index.store(write_index + 1, std::memory_order_release);
+}
+
+void Profiler::end_frame()
+{
+  ProfileFrame frame;
+  frame.begin_time = frame_begin_time;
+  frame.end_time   = get_current_time_nanos();
+  frame_begin_time = frame.end_time;
+
+  std::lock_guard<std::mutex> lock(thread_buffers_mutex);
+  for (auto &buffer : thread_buffers)
+  {
+    const auto write_index =
+        buffer->write_index.load(std::memory_order_acquire);
+    auto read_index = buffer->read_index.load(std::memory_order_relaxed);
+
+    if (!paused)
+    {
+      for (; read_index != write_index; ++read_index)
+      {
+        frame.zones.push_back(buffer->zones[read_index % ring_buffer_size]);
+      }
+    }
+
+    buffer->read_index.store(write_index, std::memory_order_release);
+  }
+
+  if (paused)
+  {
+    return;
+  }
+
+  // Parents first, makes drawing and exporting straight forward
+  std::sort(frame.zones.begin(),
+            frame.zones.end(),
+            [](const ProfileZone &a, const ProfileZone &b) {
+              if (a.thread_index != b.thread_index)
+              {
+                return a.thread_index < b.thread_index;
+              }
+              if (a.begin_time != b.begin_time)
+              {
+                return a.begin_time < b.begin_time;
+              }
+              return a.depth < b.depth;
+            });
+
+  frames.push_back(std::move(frame));
+  while (frames.size() > max_frame_count)
+  {
+    frames.pop_front();
+  }
+}
+
+void Profiler::set_max_frame_count(std::size_t max_frame_count)
+{
+  this->max_frame_count = std::max<std::size_t>(max_frame_count, 1);
+  while (frames.size() > this->max_frame_count)
+  {
+    frames.pop_front();
+  }
+}
+
+uint64_t Profiler::get_dropped_zone_count() const
+{
+  std::lock_guard<std::mutex> lock(thread_buffers_mutex);
+
+  uint64_t dropped_count = 0;
+  for (const auto &buffer : thread_buffers)
+  {
+    dropped_count += buffer->dropped_count.load(std::memory_order_relaxed);
+  }
+  return dropped_count;
+}
+
+void Profiler::clear() { frames.clear(); }
+
+void Profiler::export_chrome_trace(std::ostream &out) const
+{
+  // Chrome expects microseconds
+  const auto to_micros = [](int64_t nanos) { return nanos / 1000.0; };
+
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  bool first = true;
+  for (const auto &frame : frames)
+  {
+    for (const auto &zone : frame.zones)
+    {
+      if (!first)
+      {
+        out << ',';
+      }
+      first = false;
+
+      out << "{\"name\":";
+      write_json_string(out, zone.name);
+      out << ",\"cat\":\"fge\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+          << zone.thread_index << ",\"ts\":" << to_micros(zone.begin_time)
+          << ",\"dur\":" << to_micros(zone.end_time - zone.begin_time) << '}';
+    }
+  }
+
+  out << "]}\n";
+}
+
+void Profiler::export_chrome_trace(const std::filesystem::path &filepath) const
+{
+  std::ofstream file(filepath);
+  if (!file.is_open())
+  {
+    throw std::runtime_error("Could not open file " + filepath.string() +
+                             " for writing");
+  }
+
+  export_chrome_trace(file);
+}
+
+} // namespace Fge
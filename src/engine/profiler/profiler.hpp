@@ -0,0 +1,178 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * A finished profile scope. Times are nanoseconds from
+ * get_current_time_nanos().
+ */
+struct ProfileZone
+{
+  const char *name{};
+  int64_t     begin_time{};
+  int64_t     end_time{};
+  uint32_t    depth{};
+  uint32_t    thread_index{};
+};
+
+struct ProfileFrame
+{
+  int64_t                  begin_time{};
+  int64_t                  end_time{};
+  std::vector<ProfileZone> zones;
+};
+
+/**
+ * Collects scoped CPU timings of all threads.
+ *
+ * Every thread writes its zones into its own ring buffer without locking.
+ * end_frame(), called once per frame by the main loop, drains the buffers
+ * and keeps the zones of the last frames around for inspection and export.
+ * If a ring buffer runs full between two frames, new zones get dropped.
+ * Buffers of exited threads get reused by new threads.
+ */
+class Profiler
+{
+public:
+  static Profiler &get_instance();
+
+  Profiler(const Profiler &other) = delete;
+
+  Profiler &operator=(const Profiler &other) = delete;
+
+  void begin_zone();
+
+  void end_zone(const char *name);
+
+  /**
+   * Drains the zones of all threads into a new frame. Must be called from
+   * one thread only, usually the main thread.
+   */
+  void end_frame();
+
+  /**
+   * Frames are not recorded while paused, but ring buffers still get
+   * drained.
+   */
+  void set_paused(bool paused) { this->paused = paused; }
+
+  bool is_paused() const { return paused; }
+
+  void set_max_frame_count(std::size_t max_frame_count);
+
+  const std::deque<ProfileFrame> &get_frames() const { return frames; }
+
+  uint64_t get_dropped_zone_count() const;
+
+  void clear();
+
+  /**
+   * Writes the recorded frames in the Chrome trace event format, which can be
+   * opened with chrome://tracing or Perfetto.
+   */
+  void export_chrome_trace(std::ostream &out) const;
+
+  void export_chrome_trace(const std::filesystem::path &filepath) const;
+
+private:
+  static constexpr std::size_t ring_buffer_size = 1 << 13;
+
+  struct ThreadBuffer
+  {
+    uint32_t thread_index{};
+    bool     in_use = true; // Guarded by thread_buffers_mutex
+
+    // Only touched by the owning thread
+    uint32_t             depth{};
+    std::vector<int64_t> begin_times;
+
+    std::array<ProfileZone, ring_buffer_size> zones;
+    std::atomic<std::size_t>                  write_index{0};
+    std::atomic<std::size_t>                  read_index{0};
+    std::atomic<uint64_t>                     dropped_count{0};
+  };
+
+  /**
+   * Hands the buffer of a thread back to the profiler when the thread exits.
+   */
+  struct ThreadBufferOwner
+  {
+    ThreadBuffer *buffer = nullptr;
+
+    ~ThreadBufferOwner();
+  };
+
+  mutable std::mutex                         thread_buffers_mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> thread_buffers;
+
+  int64_t                  frame_begin_time{};
+  std::deque<ProfileFrame> frames;
+  std::size_t              max_frame_count = 300;
+  bool                     paused          = false;
+
+  Profiler();
+
+  ThreadBuffer &get_thread_buffer();
+
+  ThreadBuffer *acquire_thread_buffer();
+
+  void release_thread_buffer(ThreadBuffer *buffer);
+};
+
+/**
+ * Records the time between construction and destruction as a zone. The name
+ * has to outlive the profiler, so use string literals.
+ */
+class ProfileScope
+{
+public:
+  explicit ProfileScope(const char *name) : name(name)
+  {
+    Profiler::get_instance().begin_zone();
+  }
+
+  ~ProfileScope() { Profiler::get_instance().end_zone(name); }
+
+  ProfileScope(const ProfileScope &other) = delete;
+
+  ProfileScope &operator=(const ProfileScope &other) = delete;
+
+private:
+  const char *name{};
+};
+
+} // namespace Fge
+
+#ifndef FGE_PROFILE_DISABLE
+
+#define FGE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FGE_PROFILE_CONCAT(a, b)      FGE_PROFILE_CONCAT_IMPL(a, b)
+
+#define FGE_PROFILE_SCOPE(name)                                                \
+  ::Fge::ProfileScope FGE_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+
+#define FGE_PROFILE_FUNCTION() FGE_PROFILE_SCOPE(__func__)
+
+#define FGE_PROFILE_END_FRAME() ::Fge::Profiler::get_instance().end_frame()
+
+#else // FGE_PROFILE_DISABLE
+
+#define FGE_PROFILE_SCOPE(name)                                                \
+  do                                                                           \
+  {                                                                            \
+  } while (false)
+
+#define FGE_PROFILE_FUNCTION()                                                 \
+  do                                                                           \
+  {                                                                            \
+  } while (false)
+
+#define FGE_PROFILE_END_FRAME()                                                \
+  do                                                                           \
+  {                                                                            \
+  } while (false)
+
+#endif // FGE_PROFILE_DISABLE
@@ -0,0 +1,367 @@
+#include "cooked_mesh_cache.hpp"
+#include "file/atomic_write.hpp"
+#include "file/mapped_file.hpp"
+#include "log/log.hpp"
+#include "profiler/profiler.hpp"
+#include "util/binary_stream.hpp"
+
+namespace Fge
+{
+
+namespace
+{
+
+// "FGEM" in a little endian file
+constexpr uint32_t cooked_mesh_magic = 0x4d454746;
+
+enum class MeshKind : uint32_t
+{
+  Static  = 0,
+  Skinned = 1
+};
+
+struct Header
+{
+  uint32_t magic{};
+  uint32_t version{};
+  MeshKind kind{};
+
+  // Catches changes of the vertex layout without a version bump
+  uint32_t vertex_size{};
+
+  uint64_t source_size{};
+  int64_t  source_write_time{};
+};
+
+bool is_same_header(const Header &a, const Header &b)
+{
+  return a.magic == b.magic && a.version == b.version && a.kind == b.kind &&
+         a.vertex_size == b.vertex_size && a.source_size == b.source_size &&
+         a.source_write_time == b.source_write_time;
+}
+
+/**
+ * @return std::nullopt if the source file can not be inspected
+ */
+std::optional<Header> create_header(MeshKind                     kind,
+                                    uint32_t                     vertex_size,
+                                    const std::filesystem::path &source_path)
+{
+  std::error_code error;
+  const auto      source_size = std::filesystem::file_size(source_path, error);
+  if (error)
+  {
+    return std::nullopt;
+  }
+  const auto source_write_time =
+      std::filesystem::last_write_time(source_path, error);
+  if (error)
+  {
+    return std::nullopt;
+  }
+
+  Header header{};
+  header.magic             = cooked_mesh_magic;
+  header.version           = CookedMeshCache::format_version;
+  header.kind              = kind;
+  header.vertex_size       = vertex_size;
+  header.source_size       = source_size;
+  header.source_write_time = source_write_time.time_since_epoch().count();
+
+  return header;
+}
+
+std::filesystem::path get_entry_path(const std::filesystem::path &cache_path,
+                                     const std::string &          name,
+                                     MeshKind                     kind)
+{
+  // A file can be loaded as static and as skinned mesh
+  return cache_path /
+         (name + (kind == MeshKind::Skinned ? ".skinned.mesh" : ".mesh"));
+}
+
+void write_material(BinaryWriter &writer, const MaterialData &material)
+{
+  writer.write_string(material.ambient_texture);
+  writer.write_string(material.diffuse_texture);
+  writer.write_string(material.specular_texture);
+  writer.write(material.specular_power);
+}
+
+MaterialData read_material(BinaryReader &reader)
+{
+  MaterialData material{};
+  material.ambient_texture  = reader.read_string();
+  material.diffuse_texture  = reader.read_string();
+  material.specular_texture = reader.read_string();
+  material.specular_power   = reader.read<float>();
+
+  return material;
+}
+
+template <typename TVertex>
+void write_sub_meshes(BinaryWriter &                             writer,
+                      const std::vector<SubMeshData<TVertex>> &sub_meshes)
+{
+  writer.write<uint32_t>(static_cast<uint32_t>(sub_meshes.size()));
+
+  for (const auto &sub_mesh : sub_meshes)
+  {
+    writer.write_string(sub_mesh.name);
+    write_material(writer, sub_mesh.material);
+    writer.write(sub_mesh.bounds);
+    writer.write_vector(*sub_mesh.vertices);
+    writer.write_vector(*sub_mesh.indices);
+    writer.write_vector(sub_mesh.lods);
+  }
+}
+
+void check_vertex(const VertexPNTBT & /*vertex*/, uint32_t /*bones_count*/) {}
+
+void check_vertex(const VertexPNTBBWT &vertex, uint32_t bones_count)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    if (vertex.skin_bones[i] < 0 ||
+        static_cast<uint32_t>(vertex.skin_bones[i]) >= bones_count)
+    {
+      throw std::runtime_error("Vertex references a missing bone");
+    }
+  }
+}
+
+/**
+ * @param bones_count Number of bones of the skeleton, skin bones of vertices
+ * must be below it
+ */
+template <typename TVertex>
+std::vector<SubMeshData<TVertex>> read_sub_meshes(BinaryReader &reader,
+                                                  uint32_t      bones_count)
+{
+  std::vector<SubMeshData<TVertex>> sub_meshes(reader.read<uint32_t>());
+
+  for (auto &sub_mesh : sub_meshes)
+  {
+    sub_mesh.name     = reader.read_string();
+    sub_mesh.material = read_material(reader);
+    sub_mesh.bounds   = reader.read<Bounds>();
+    sub_mesh.vertices = std::make_shared<std::vector<TVertex>>(
+        reader.read_vector<TVertex>());
+    sub_mesh.indices = std::make_shared<std::vector<uint32_t>>(
+        reader.read_vector<uint32_t>());
+    sub_mesh.lods = reader.read_vector<MeshLod>();
+
+    // The renderer draws all of this without checking it
+    for (const auto &vertex : *sub_mesh.vertices)
+    {
+      check_vertex(vertex, bones_count);
+    }
+    for (const auto index : *sub_mesh.indices)
+    {
+      if (index >= sub_mesh.vertices->size())
+      {
+        throw std::runtime_error("Index is out of the vertices");
+      }
+    }
+    for (const auto &lod : sub_mesh.lods)
+    {
+      if (static_cast<uint64_t>(lod.first_index) + lod.index_count >
+          sub_mesh.indices->size())
+      {
+        throw std::runtime_error("LOD is out of the indices");
+      }
+    }
+  }
+
+  return sub_meshes;
+}
+
+void write_skeleton(BinaryWriter &writer, const SkeletonAsset &skeleton)
+{
+  writer.write<uint32_t>(skeleton.get_bones_count());
+  for (unsigned i = 0; i < skeleton.get_bones_count(); ++i)
+  {
+    const auto &bone = skeleton.get_bone(i);
+    writer.write_string(bone.name);
+    writer.write<int32_t>(bone.parent_index);
+    writer.write(bone.local_bind_pose);
+    writer.write(bone.global_inv_bind_pose);
+  }
+
+  writer.write<uint32_t>(
+      static_cast<uint32_t>(skeleton.get_animations_count()));
+  for (std::size_t i = 0; i < skeleton.get_animations_count(); ++i)
+  {
+    skeleton.get_animation(static_cast<SkeletonAsset::AnimationHandle>(i))
+        .write(writer);
+  }
+}
+
+std::shared_ptr<SkeletonAsset> read_skeleton(BinaryReader &reader)
+{
+  std::vector<SkeletonAsset::Bone> bones(reader.read<uint32_t>());
+  for (std::size_t i = 0; i < bones.size(); ++i)
+  {
+    auto &bone                = bones[i];
+    bone.name                 = reader.read_string();
+    bone.parent_index         = reader.read<int32_t>();
+    bone.local_bind_pose      = reader.read<glm::mat4>();
+    bone.global_inv_bind_pose = reader.read<glm::mat4>();
+
+    // The asset asserts this, a broken file must not get that far
+    if (bone.parent_index >= static_cast<int>(i) || bone.parent_index < -1)
+    {
+      throw std::runtime_error("Bone has no valid parent");
+    }
+  }
+
+  auto skeleton = std::make_shared<SkeletonAsset>(bones);
+
+  const auto animations_count = reader.read<uint32_t>();
+  for (uint32_t i = 0; i < animations_count; ++i)
+  {
+    skeleton->add_animation(CompiledAnimation::read(reader));
+  }
+
+  return skeleton;
+}
+
+template <typename TData, typename TRead>
+std::optional<TData> load_entry(const std::filesystem::path & entry_path,
+                                const std::optional<Header> &expected_header,
+                                TRead                         read)
+{
+  std::error_code error;
+  if (!expected_header || !std::filesystem::exists(entry_path, error))
+  {
+    return std::nullopt;
+  }
+
+  try
+  {
+    const MappedFile file(entry_path);
+    BinaryReader     reader(file.get_data(), file.get_size());
+
+    if (!is_same_header(reader.read<Header>(), *expected_header))
+    {
+      trace("CookedMeshCache",
+            FMT_STRING("Entry is stale: {}"),
+            entry_path.string());
+      return std::nullopt;
+    }
+
+    auto data = read(reader);
+    if (reader.get_remaining() != 0)
+    {
+      throw std::runtime_error("Entry has data after the mesh");
+    }
+
+    return data;
+  }
+  catch (const std::exception &exception)
+  {
+    warning("CookedMeshCache",
+            FMT_STRING("Could not read entry {}: {}"),
+            entry_path.string(),
+            exception.what());
+    return std::nullopt;
+  }
+}
+
+template <typename TWrite>
+void store_entry(const std::filesystem::path & entry_path,
+                 const std::optional<Header> &header,
+                 TWrite                        write)
+{
+  // Without a source there is nothing to tell a stale entry from
+  if (!header)
+  {
+    return;
+  }
+
+  BinaryWriter writer;
+  writer.write(*header);
+  write(writer);
+
+  try
+  {
+    write_file_atomic(entry_path, writer.get_data());
+  }
+  catch (const std::exception &exception)
+  {
+    warning("CookedMeshCache",
+            FMT_STRING("Could not write entry: {}"),
+            exception.what());
+  }
+}
+
+} // namespace
+
+CookedMeshCache::CookedMeshCache(const std::filesystem::path &cache_path)
+    : cache_path(cache_path)
+{
+}
+
+std::optional<MeshData>
+CookedMeshCache::load_mesh(const std::string &          name,
+                           const std::filesystem::path &source_path)
+{
+  FGE_PROFILE_SCOPE("CookedMeshCache::load_mesh");
+
+  return load_entry<MeshData>(
+      get_entry_path(cache_path, name, MeshKind::Static),
+      create_header(MeshKind::Static, sizeof(VertexPNTBT), source_path),
+      [](BinaryReader &reader) {
+        MeshData data{};
+        data.sub_meshes = read_sub_meshes<VertexPNTBT>(reader, 0);
+        return data;
+      });
+}
+
+std::optional<SkinnedMeshData>
+CookedMeshCache::load_skinned_mesh(const std::string &          name,
+                                   const std::filesystem::path &source_path)
+{
+  FGE_PROFILE_SCOPE("CookedMeshCache::load_skinned_mesh");
+
+  return load_entry<SkinnedMeshData>(
+      get_entry_path(cache_path, name, MeshKind::Skinned),
+      create_header(MeshKind::Skinned, sizeof(VertexPNTBBWT), source_path),
+      [](BinaryReader &reader) {
+        SkinnedMeshData data{};
+        data.skeleton   = read_skeleton(reader);
+        data.sub_meshes = read_sub_meshes<VertexPNTBBWT>(
+            reader, data.skeleton->get_bones_count());
+        return data;
+      });
+}
+
+void CookedMeshCache::store_mesh(const std::string &          name,
+                                 const std::filesystem::path &source_path,
+                                 const MeshData &             data)
+{
+  FGE_PROFILE_SCOPE("CookedMeshCache::store_mesh");
+
+  store_entry(
+      get_entry_path(cache_path, name, MeshKind::Static),
+      create_header(MeshKind::Static, sizeof(VertexPNTBT), source_path),
+      [&](BinaryWriter &writer) { write_sub_meshes(writer, data.sub_meshes); });
+}
+
+void CookedMeshCache::store_skinned_mesh(
+    const std::string &          name,
+    const std::filesystem::path &source_path,
+    const SkinnedMeshData &      data)
+{
+  FGE_PROFILE_SCOPE("CookedMeshCache::store_skinned_mesh");
+
+  store_entry(
+      get_entry_path(cache_path, name, MeshKind::Skinned),
+      create_header(MeshKind::Skinned, sizeof(VertexPNTBBWT), source_path),
+      [&](BinaryWriter &writer) {
+        write_skeleton(writer, *data.skeleton);
+        write_sub_meshes(writer, data.sub_meshes);
+      });
+}
+
+} // namespace Fge
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "mesh_data.hpp"
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Imported meshes in a binary format in the app cache directory.
+ *
+ * A cooked mesh holds the vertices and indices in the layout they get
+ * uploaded in, the sub mesh table with materials and bounds, and for skinned
+ * meshes the skeleton with its compiled clips. Loading maps the file and
+ * copies every block with one memcpy, nothing is converted per vertex.
+ *
+ * Every entry stores the format version and the size and last write time of
+ * its source file. Entries that don't match are treated as missing and get
+ * replaced on the next store.
+ */
+class CookedMeshCache
+{
+public:
+  /**
+   * Bump on every change of the format or of what the importers produce.
+   */
+  static constexpr uint32_t format_version = 4;
+
+  explicit CookedMeshCache(const std::filesystem::path &cache_path);
+
+  /**
+   * @param name Path of the mesh relative to the meshes directory
+   *
+   * @return Nothing if there is no entry, it is stale or can't be read
+   */
+  std::optional<MeshData> load_mesh(const std::string &          name,
+                                    const std::filesystem::path &source_path);
+
+  std::optional<SkinnedMeshData>
+  load_skinned_mesh(const std::string &          name,
+                    const std::filesystem::path &source_path);
+
+  /**
+   * Failing to write only gets logged. The mesh is imported again next time.
+   */
+  void store_mesh(const std::string &          name,
+                  const std::filesystem::path &source_path,
+                  const MeshData &             data);
+
+  void store_skinned_mesh(const std::string &          name,
+                          const std::filesystem::path &source_path,
+                          const SkinnedMeshData &      data);
+
+private:
+  std::filesystem::path cache_path;
+};
+
+} // namespace Fge
@@ -0,0 +1,103 @@
+#include "mesh_data.hpp"
+#include "application.hpp"
+#include "graphic/default_material.hpp"
+#include "graphic/mesh.hpp"
+#include "graphic/skinned_mesh.hpp"
+
+namespace Fge
+{
+
+namespace
+{
+
+std::shared_ptr<DefaultMaterial> create_material(const MaterialData &data)
+{
+  auto material    = std::make_shared<DefaultMaterial>();
+  auto res_manager = Application::get_instance()->get_resource_manager();
+
+  // Textures are flipped, like for all meshes
+  if (!data.ambient_texture.empty())
+  {
+    material->set_ambient_texture(
+        res_manager->load_texture2d(data.ambient_texture, true));
+  }
+  if (!data.diffuse_texture.empty())
+  {
+    material->set_diffuse_texture(
+        res_manager->load_texture2d(data.diffuse_texture, true));
+  }
+  if (!data.specular_texture.empty())
+  {
+    material->set_specular_texture(
+        res_manager->load_texture2d(data.specular_texture, true));
+  }
+
+  material->set_specular_power(data.specular_power);
+
+  return material;
+}
+
+template <typename TVertex>
+void pack_sub_meshes(std::vector<SubMeshData<TVertex>> &sub_meshes)
+{
+  for (auto &sub_mesh : sub_meshes)
+  {
+    sub_mesh.packed_vertices = pack_vertices(*sub_mesh.vertices);
+  }
+}
+
+} // namespace
+
+void pack_mesh_data(MeshData &data) { pack_sub_meshes(data.sub_meshes); }
+
+void pack_mesh_data(SkinnedMeshData &data)
+{
+  pack_sub_meshes(data.sub_meshes);
+}
+
+std::shared_ptr<Mesh> create_mesh(const MeshData &data)
+{
+  std::vector<std::shared_ptr<SubMesh>> sub_meshes;
+
+  for (const auto &sub_mesh_data : data.sub_meshes)
+  {
+    auto sub_mesh =
+        std::make_shared<SubMesh>(sub_mesh_data.name,
+                                  sub_mesh_data.vertices,
+                                  sub_mesh_data.packed_vertices,
+                                  sub_mesh_data.indices,
+                                  create_material(sub_mesh_data.material));
+    sub_mesh->set_bounds(sub_mesh_data.bounds);
+    sub_mesh->set_lods(sub_mesh_data.lods);
+
+    sub_meshes.push_back(sub_mesh);
+  }
+
+  return std::make_shared<Mesh>(sub_meshes);
+}
+
+std::shared_ptr<SkinnedMesh> create_skinned_mesh(const SkinnedMeshData &data)
+{
+  std::vector<std::shared_ptr<SkinnedSubMesh>> sub_meshes;
+
+  for (const auto &sub_mesh_data : data.sub_meshes)
+  {
+    auto sub_mesh = std::make_shared<SkinnedSubMesh>(
+        sub_mesh_data.name,
+        sub_mesh_data.vertices,
+        sub_mesh_data.packed_vertices,
+        sub_mesh_data.indices,
+        create_material(sub_mesh_data.material));
+
+    // Bind pose bounds. Animations that move vertices far away from the
+    // bind pose can get culled too early.
+    sub_mesh->set_bounds(sub_mesh_data.bounds);
+    sub_mesh->set_lods(sub_mesh_data.lods);
+
+    sub_meshes.push_back(sub_mesh);
+  }
+
+  return std::make_shared<SkinnedMesh>(sub_meshes, Skeleton(data.skeleton));
+}
+
+} // namespace Fge
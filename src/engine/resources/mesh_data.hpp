@@ -0,0 +1,77 @@
+#pragma once
+
+#include "graphic/mesh_lod.hpp"
+#include "graphic/skeleton_asset.hpp"
+#include "graphic/vertex_packing.hpp"
+#include "graphic/vertices.hpp"
+#include "math/bounds.hpp"
+#include "std.hpp"
+
+namespace Fge
+{
+
+class Mesh;
+class SkinnedMesh;
+
+/**
+ * Textures of a material, relative to the textures directory. Empty if the
+ * material has none.
+ */
+struct MaterialData
+{
+  std::string ambient_texture;
+  std::string diffuse_texture;
+  std::string specular_texture;
+  float       specular_power = 200.0f;
+};
+
+template <typename TVertex> struct SubMeshData
+{
+  std::string name;
+
+  std::shared_ptr<std::vector<TVertex>>  vertices{};
+  std::shared_ptr<std::vector<uint32_t>> indices{};
+
+  // The vertices as they get uploaded. Not cooked, filled by
+  // pack_mesh_data() on the loading thread.
+  std::vector<PackedVertex<TVertex>> packed_vertices{};
+
+  // Index ranges of the LODs, full detail first. Empty if the sub mesh has
+  // no LODs, then all indices are one LOD.
+  std::vector<MeshLod> lods{};
+
+  MaterialData material{};
+  Bounds       bounds{};
+};
+
+/**
+ * Imported mesh before anything got uploaded. This is what the importers
+ * produce and what the cooked mesh cache stores.
+ */
+struct MeshData
+{
+  std::vector<SubMeshData<VertexPNTBT>> sub_meshes;
+};
+
+struct SkinnedMeshData
+{
+  std::vector<SubMeshData<VertexPNTBBWT>> sub_meshes;
+  std::shared_ptr<SkeletonAsset>          skeleton{};
+};
+
+/**
+ * Packs the vertices of all sub meshes for the upload. Call this on the
+ * loading thread, the upload then only copies.
+ */
+void pack_mesh_data(MeshData &data);
+
+void pack_mesh_data(SkinnedMeshData &data);
+
+/**
+ * Uploads the packed vertices and loads the textures of the materials.
+ */
+std::shared_ptr<Mesh> create_mesh(const MeshData &data);
+
+std::shared_ptr<SkinnedMesh> create_skinned_mesh(const SkinnedMeshData &data);
+
+} // namespace Fge
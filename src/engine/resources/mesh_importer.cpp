@@ -1,11 +1,8 @@
 #include "mesh_importer.hpp"
-#include "application.hpp"
-#include "graphic/default_material.hpp"
-#include "graphic/mesh.hpp"
-#include "graphic/skinned_mesh.hpp"
 #include "graphic/vertices.hpp"
 #include "log/log.hpp"
 #include "mesh_importer_common.hpp"
+#include "profiler/profiler.hpp"
 #include "util/assert.hpp"
 
 namespace Fge
@@ -14,7 +11,8 @@ namespace Fge
 void do_load_mesh(const aiScene *                        ai_scene,
                   aiNode *                               ai_node,
                   aiMatrix4x4 &                          parent_transform,
-                  std::vector<std::shared_ptr<SubMesh>> &sub_meshes)
+                  bool                                   optimize,
+                  std::vector<SubMeshData<VertexPNTBT>> &sub_meshes)
 {
   auto transform = parent_transform * ai_node->mTransformation;
 
@@ -84,34 +82,44 @@ void do_load_mesh(const aiScene *                        ai_scene,
       indices->push_back(ai_face.mIndices[2]);
     }
 
-    auto material = load_material(ai_scene, ai_mesh);
+    SubMeshData<VertexPNTBT> sub_mesh{};
+    sub_mesh.name     = ai_mesh->mName.C_Str();
+    sub_mesh.vertices = vertices;
+    sub_mesh.indices  = indices;
+    sub_mesh.material = load_material(ai_scene, ai_mesh);
 
-    auto sub_mesh = std::make_shared<SubMesh>(ai_mesh->mName.C_Str(),
-                                              vertices,
-                                              indices,
-                                              material);
+    if (optimize)
+    {
+      log_mesh_optimization(sub_mesh.name, optimize_sub_mesh(sub_mesh));
+    }
+
+    sub_mesh.bounds = compute_bounds(*vertices);
     sub_meshes.emplace_back(sub_mesh);
   }
 
   for (uint32_t i = 0; i < ai_node->mNumChildren; ++i)
   {
-    do_load_mesh(ai_scene, ai_node->mChildren[i], transform, sub_meshes);
+    do_load_mesh(
+        ai_scene, ai_node->mChildren[i], transform, optimize, sub_meshes);
   }
 }
 
-std::shared_ptr<Mesh> load_mesh(const aiScene *ai_scene)
+MeshData load_mesh(const aiScene *ai_scene, bool optimize)
 {
   aiMatrix4x4 transform;
   FGE_ASSERT(transform.IsIdentity());
 
-  std::vector<std::shared_ptr<SubMesh>> sub_meshes;
-  do_load_mesh(ai_scene, ai_scene->mRootNode, transform, sub_meshes);
+  MeshData mesh{};
+  do_load_mesh(
+      ai_scene, ai_scene->mRootNode, transform, optimize, mesh.sub_meshes);
 
-  return std::make_shared<Mesh>(sub_meshes);
+  return mesh;
 }
 
-std::shared_ptr<Mesh> import_mesh_from_file(const std::string &filename)
+MeshData import_mesh_from_file(const std::string &filename, bool optimize)
 {
+  FGE_PROFILE_SCOPE("import_mesh_from_file");
+
   Assimp::Importer importer;
   const aiScene *  ai_scene =
       importer.ReadFile(filename,
@@ -126,7 +134,7 @@ std::shared_ptr<Mesh> import_mesh_from_file(const std::string &filename)
                              importer.GetErrorString());
   }
 
-  auto mesh = load_mesh(ai_scene);
+  auto mesh = load_mesh(ai_scene, optimize);
 
   return mesh;
 }
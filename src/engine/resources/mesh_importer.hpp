@@ -1,12 +1,16 @@
 #pragma once
 
+#include "mesh_data.hpp"
 #include "std.hpp"
 
 namespace Fge
 {
 
-class Mesh;
-
-std::shared_ptr<Mesh> import_mesh_from_file(const std::string &filename);
+/**
+ * @param optimize Runs every sub mesh through optimize_sub_mesh. Only worth
+ * turning off to compare against the mesh as it is stored in the file.
+ */
+MeshData import_mesh_from_file(const std::string &filename,
+                               bool               optimize = true);
 
 } // namespace Fge
@@ -1,61 +1,67 @@
 #include "mesh_importer_common.hpp"
-#include "application.hpp"
 #include "log/log.hpp"
 
 namespace Fge
 {
 
-std::shared_ptr<Texture2D> load_texture(aiMaterial *  ai_material,
-                                        aiTextureType ai_texture_type,
-                                        bool          flip = false)
+std::string load_texture_path(aiMaterial *  ai_material,
+                              aiTextureType ai_texture_type)
 {
   uint32_t texture_count = ai_material->GetTextureCount(ai_texture_type);
   if (texture_count == 0)
   {
-    return nullptr;
+    return {};
   }
   else if (texture_count > 1)
   {
     warning("MeshLoader",
-            "Mesh has more than one texture defined. Can just handle one.");
+            FMT_STRING("Mesh has more than one texture defined. Can just "
+                       "handle one."));
   }
 
   aiString path;
   ai_material->GetTexture(ai_texture_type, 0, &path);
 
-  auto app         = Application::get_instance();
-  auto res_manager = app->get_resource_manager();
-
-  return res_manager->load_texture2d(path.C_Str(), flip);
+  return path.C_Str();
 }
 
-std::shared_ptr<DefaultMaterial> load_material(const aiScene *ai_scene,
-                                               aiMesh *       ai_mesh)
+MaterialData load_material(const aiScene *ai_scene, aiMesh *ai_mesh)
 {
-  auto material = std::make_shared<DefaultMaterial>();
+  MaterialData material{};
 
   aiMaterial *ai_material = ai_scene->mMaterials[ai_mesh->mMaterialIndex];
 
-  auto ambient_tex  = load_texture(ai_material, aiTextureType_AMBIENT, true);
-  auto diffuse_tex  = load_texture(ai_material, aiTextureType_DIFFUSE, true);
-  auto specular_tex = load_texture(ai_material, aiTextureType_SPECULAR, true);
+  material.ambient_texture =
+      load_texture_path(ai_material, aiTextureType_AMBIENT);
+  material.diffuse_texture =
+      load_texture_path(ai_material, aiTextureType_DIFFUSE);
+  material.specular_texture =
+      load_texture_path(ai_material, aiTextureType_SPECULAR);
 
-  if (ambient_tex)
-  {
-    material->set_ambient_texture(ambient_tex);
-  }
-  if (diffuse_tex)
-  {
-    material->set_diffuse_texture(diffuse_tex);
-  }
-  if (specular_tex)
+  return material;
+}
+
+void log_mesh_optimization(const std::string &           name,
+                           const MeshOptimizationReport &report)
+{
+  std::string lod_triangle_counts;
+  for (const auto triangle_count : report.lod_triangle_counts)
   {
-    material->set_specular_texture(specular_tex);
+    lod_triangle_counts += (lod_triangle_counts.empty() ? "" : ", ") +
+                           std::to_string(triangle_count);
   }
 
-  material->set_specular_power(200.0f);
-
-  return material;
+  debug("MeshLoader",
+        FMT_STRING("Optimized sub mesh {}: {} -> {} vertices, ACMR {:.3f} -> "
+                   "{:.3f}, ATVR {:.3f} -> {:.3f}, LOD triangles {}"),
+        name,
+        report.vertex_count_before,
+        report.vertex_count_after,
+        report.before.acmr,
+        report.after.acmr,
+        report.before.atvr,
+        report.after.atvr,
+        lod_triangle_counts);
 }
 
 } // namespace Fge
@@ -4,10 +4,13 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
-#include "graphic/default_material.hpp"
+#include "mesh_data.hpp"
+#include "mesh_optimizer.hpp"
 
 namespace Fge
 {
-std::shared_ptr<DefaultMaterial> load_material(const aiScene *ai_scene,
-                                               aiMesh *       ai_mesh);
+MaterialData load_material(const aiScene *ai_scene, aiMesh *ai_mesh);
+
+void log_mesh_optimization(const std::string &           name,
+                           const MeshOptimizationReport &report);
 }
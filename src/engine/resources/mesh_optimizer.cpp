@@ -0,0 +1,955 @@
+#include "mesh_optimizer.hpp"
+
+namespace Fge
+{
+
+namespace
+{
+
+/**
+ * FIFO cache of vertex indices. A vertex is in the cache as long as less
+ * than cache size vertices got added after it.
+ */
+class VertexCache
+{
+public:
+  explicit VertexCache(std::size_t vertex_count)
+      : timestamps(vertex_count, 0)
+  {
+  }
+
+  /**
+   * @return True if the vertex was not in the cache
+   */
+  bool add(uint32_t vertex)
+  {
+    if (contains(vertex))
+    {
+      return false;
+    }
+
+    timestamps[vertex] = time++;
+    return true;
+  }
+
+  bool contains(uint32_t vertex) const
+  {
+    return time - timestamps[vertex] <= vertex_cache_size;
+  }
+
+  /**
+   * @return How many vertices got added after the vertex
+   */
+  uint32_t get_age(uint32_t vertex) const { return time - timestamps[vertex]; }
+
+  void clear()
+  {
+    std::fill(timestamps.begin(), timestamps.end(), 0);
+    time = vertex_cache_size + 1;
+  }
+
+private:
+  std::vector<uint32_t> timestamps;
+  uint32_t              time = vertex_cache_size + 1;
+};
+
+/**
+ * Triangles that use a vertex.
+ */
+struct Adjacency
+{
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> triangles;
+
+  Adjacency(const std::vector<uint32_t> &indices, std::size_t vertex_count)
+      : offsets(vertex_count + 1, 0),
+        triangles(indices.size())
+  {
+    for (const auto index : indices)
+    {
+      ++offsets[index + 1];
+    }
+    for (std::size_t i = 0; i < vertex_count; ++i)
+    {
+      offsets[i + 1] += offsets[i];
+    }
+
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+  }
+
+  uint32_t get_count(uint32_t vertex) const
+  {
+    return offsets[vertex + 1] - offsets[vertex];
+  }
+};
+
+struct Cluster
+{
+  std::size_t begin{};
+  std::size_t end{};
+  float       sort_key{};
+};
+
+std::size_t count_misses(const std::vector<uint32_t> &indices,
+                         std::size_t                  begin,
+                         std::size_t                  end,
+                         VertexCache &                cache)
+{
+  std::size_t misses = 0;
+  for (auto i = begin * 3; i < end * 3; ++i)
+  {
+    misses += cache.add(indices[i]) ? 1 : 0;
+  }
+
+  return misses;
+}
+
+/**
+ * Clusters start where all vertices of a triangle miss the cache. Clusters
+ * that are longer get split where their ACMR drops to the threshold, so
+ * every cluster stays about as cache efficient as the whole run.
+ */
+std::vector<Cluster> split_clusters(const std::vector<uint32_t> &indices,
+                                    std::size_t                  vertex_count,
+                                    float                        threshold)
+{
+  const auto triangle_count = indices.size() / 3;
+
+  std::vector<std::size_t> hard_boundaries;
+  VertexCache              cache(vertex_count);
+  for (std::size_t i = 0; i < triangle_count; ++i)
+  {
+    if (count_misses(indices, i, i + 1, cache) == 3)
+    {
+      hard_boundaries.push_back(i);
+    }
+  }
+  hard_boundaries.push_back(triangle_count);
+
+  std::vector<Cluster> clusters;
+  for (std::size_t i = 0; i + 1 < hard_boundaries.size(); ++i)
+  {
+    const auto run_begin = hard_boundaries[i];
+    const auto run_end   = hard_boundaries[i + 1];
+
+    cache.clear();
+    const auto run_acmr =
+        static_cast<float>(count_misses(indices, run_begin, run_end, cache)) /
+        static_cast<float>(run_end - run_begin);
+
+    cache.clear();
+    auto        begin  = run_begin;
+    std::size_t misses = 0;
+    for (auto j = run_begin; j < run_end; ++j)
+    {
+      misses += count_misses(indices, j, j + 1, cache);
+
+      const auto acmr =
+          static_cast<float>(misses) / static_cast<float>(j + 1 - begin);
+      if (j + 1 < run_end && acmr <= threshold * run_acmr)
+      {
+        clusters.push_back(Cluster{begin, j + 1});
+        begin  = j + 1;
+        misses = 0;
+        cache.clear();
+      }
+    }
+    clusters.push_back(Cluster{begin, run_end});
+  }
+
+  return clusters;
+}
+
+/**
+ * Sum of the weighted squared distances to a set of planes, as symmetric
+ * 4x4 matrix. Doubles, as the terms cancel out close to the planes.
+ */
+struct Quadric
+{
+  double a2{};
+  double ab{};
+  double ac{};
+  double ad{};
+  double b2{};
+  double bc{};
+  double bd{};
+  double c2{};
+  double cd{};
+  double d2{};
+  double weight{};
+
+  /**
+   * @param normal Unit normal of the plane
+   */
+  static Quadric
+  from_plane(const glm::vec3 &normal, const glm::vec3 &point, double weight)
+  {
+    const double a = normal.x;
+    const double b = normal.y;
+    const double c = normal.z;
+    const double d = -glm::dot(normal, point);
+
+    Quadric quadric{};
+    quadric.a2     = a * a * weight;
+    quadric.ab     = a * b * weight;
+    quadric.ac     = a * c * weight;
+    quadric.ad     = a * d * weight;
+    quadric.b2     = b * b * weight;
+    quadric.bc     = b * c * weight;
+    quadric.bd     = b * d * weight;
+    quadric.c2     = c * c * weight;
+    quadric.cd     = c * d * weight;
+    quadric.d2     = d * d * weight;
+    quadric.weight = weight;
+
+    return quadric;
+  }
+
+  void add(const Quadric &other)
+  {
+    a2 += other.a2;
+    ab += other.ab;
+    ac += other.ac;
+    ad += other.ad;
+    b2 += other.b2;
+    bc += other.bc;
+    bd += other.bd;
+    c2 += other.c2;
+    cd += other.cd;
+    d2 += other.d2;
+    weight += other.weight;
+  }
+
+  /**
+   * Weighted mean of the squared distances of the point to the planes.
+   */
+  double evaluate(const glm::vec3 &point) const
+  {
+    if (weight <= 0.0)
+    {
+      return 0.0;
+    }
+
+    const double x = point.x;
+    const double y = point.y;
+    const double z = point.z;
+
+    const auto sum = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z +
+                     2.0 * ad * x + b2 * y * y + 2.0 * bc * y * z +
+                     2.0 * bd * y + c2 * z * z + 2.0 * cd * z + d2;
+
+    return std::max(sum / weight, 0.0);
+  }
+};
+
+enum class VertexKind : uint8_t
+{
+  Manifold,
+
+  // On an open border, moves only along it
+  Border,
+
+  // On an attribute seam or a non-manifold edge, never moves
+  Locked
+};
+
+struct Collapse
+{
+  uint32_t source{};
+  uint32_t target{};
+  double   cost{};
+};
+
+// How much the border planes count compared to the triangle planes
+constexpr double border_weight = 10.0;
+
+// How much a changed normal or texture coordinate counts compared to a
+// moved position, both relative to the radius
+constexpr double attribute_weight = 0.01;
+
+// How much changed skin weights count. Moving a vertex from one bone to
+// another entirely costs 2 * skin_weight, more than max_lod_error allows.
+constexpr double skin_weight = 0.1;
+
+// A collapse may rotate a triangle's normal by at most about 75 degrees
+constexpr float min_normal_cosine = 0.25f;
+
+// A LOD needs at least a quarter less indices than the one before
+constexpr std::size_t min_lod_reduction = 4;
+
+uint64_t make_edge_key(uint32_t from, uint32_t to)
+{
+  return (static_cast<uint64_t>(from) << 32) | to;
+}
+
+/**
+ * Classifies the vertices and sums up the planes of their triangles and
+ * borders per position.
+ */
+class SimplifyTopology
+{
+public:
+  SimplifyTopology(const std::vector<uint32_t> & indices,
+                   const std::vector<glm::vec3> &positions)
+  {
+    generate_weld_remap(
+        positions.data(), sizeof(glm::vec3), positions.size(), position_ids);
+
+    std::vector<uint32_t> wedge_counts(positions.size(), 0);
+    std::vector<bool>     used(positions.size(), false);
+    for (const auto index : indices)
+    {
+      if (!used[index])
+      {
+        used[index] = true;
+        ++wedge_counts[position_ids[index]];
+      }
+    }
+
+    std::unordered_map<uint64_t, uint32_t> edge_counts;
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      const auto next = i - i % 3 + (i + 1) % 3;
+      ++edge_counts[make_edge_key(position_ids[indices[i]],
+                                  position_ids[indices[next]])];
+    }
+
+    std::vector<VertexKind> position_kinds(positions.size(),
+                                           VertexKind::Manifold);
+    quadrics.resize(positions.size());
+    for (std::size_t i = 0; i < indices.size(); i += 3)
+    {
+      const auto &a = positions[indices[i]];
+      const auto &b = positions[indices[i + 1]];
+      const auto &c = positions[indices[i + 2]];
+
+      const auto normal = glm::cross(b - a, c - a);
+      const auto length = glm::length(normal);
+      if (length == 0.0f)
+      {
+        continue;
+      }
+
+      const auto unit_normal = normal / length;
+      const auto plane       = Quadric::from_plane(unit_normal, a, length);
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        quadrics[position_ids[indices[i + j]]].add(plane);
+      }
+
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        const auto from = position_ids[indices[i + j]];
+        const auto to   = position_ids[indices[i + (j + 1) % 3]];
+
+        if (edge_counts[make_edge_key(from, to)] > 1)
+        {
+          position_kinds[from] = VertexKind::Locked;
+          position_kinds[to]   = VertexKind::Locked;
+        }
+        else if (edge_counts.count(make_edge_key(to, from)) == 0)
+        {
+          border_edges.insert(make_edge_key(from, to));
+          for (const auto position_id : {from, to})
+          {
+            if (position_kinds[position_id] == VertexKind::Manifold)
+            {
+              position_kinds[position_id] = VertexKind::Border;
+            }
+          }
+
+          // Perpendicular to the triangle through the edge, keeps the
+          // border in place
+          const auto &edge_from   = positions[indices[i + j]];
+          const auto &edge_to     = positions[indices[i + (j + 1) % 3]];
+          const auto  edge_normal =
+              glm::cross(edge_to - edge_from, unit_normal);
+          const auto  edge_length = glm::length(edge_normal);
+          if (edge_length > 0.0f)
+          {
+            const auto border_plane =
+                Quadric::from_plane(edge_normal / edge_length,
+                                    edge_from,
+                                    edge_length * edge_length * border_weight);
+            quadrics[from].add(border_plane);
+            quadrics[to].add(border_plane);
+          }
+        }
+      }
+    }
+
+    kinds.resize(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+      kinds[i] = wedge_counts[position_ids[i]] > 1
+                     ? VertexKind::Locked
+                     : position_kinds[position_ids[i]];
+    }
+  }
+
+  bool can_collapse(uint32_t source, uint32_t target) const
+  {
+    const auto source_position = position_ids[source];
+    const auto target_position = position_ids[target];
+    if (source_position == target_position)
+    {
+      return false;
+    }
+
+    switch (kinds[source])
+    {
+    case VertexKind::Manifold:
+      return true;
+
+    case VertexKind::Border:
+      return border_edges.count(
+                 make_edge_key(source_position, target_position)) > 0 ||
+             border_edges.count(
+                 make_edge_key(target_position, source_position)) > 0;
+
+    default:
+      return false;
+    }
+  }
+
+  const Quadric &get_quadric(uint32_t vertex) const
+  {
+    return quadrics[position_ids[vertex]];
+  }
+
+  void collapse(uint32_t source, uint32_t target)
+  {
+    quadrics[position_ids[target]].add(quadrics[position_ids[source]]);
+  }
+
+private:
+  std::vector<uint32_t>        position_ids;
+  std::vector<VertexKind>      kinds;
+  std::vector<Quadric>         quadrics;
+  std::unordered_set<uint64_t> border_edges;
+};
+
+double get_attribute_distance2(const SimplifyVertex &a, const SimplifyVertex &b)
+{
+  const auto normal    = a.normal - b.normal;
+  const auto tex_coord = a.tex_coord - b.tex_coord;
+
+  return glm::dot(normal, normal) + glm::dot(tex_coord, tex_coord);
+}
+
+/**
+ * Squared difference of the weight every bone has in a and b.
+ */
+double get_skin_distance2(const SimplifyVertex &a, const SimplifyVertex &b)
+{
+  // A bone can be listed more than once, so sum up per bone first
+  std::array<int, 8>    bones{};
+  std::array<double, 8> weight_differences{};
+  std::size_t           bone_count = 0;
+
+  const auto add_weight = [&](int bone, double weight) {
+    for (std::size_t i = 0; i < bone_count; ++i)
+    {
+      if (bones[i] == bone)
+      {
+        weight_differences[i] += weight;
+        return;
+      }
+    }
+    bones[bone_count]              = bone;
+    weight_differences[bone_count] = weight;
+    ++bone_count;
+  };
+
+  for (int i = 0; i < 4; ++i)
+  {
+    add_weight(a.skin_bones[i], a.skin_weights[i]);
+  }
+  for (int i = 0; i < 4; ++i)
+  {
+    add_weight(b.skin_bones[i], -b.skin_weights[i]);
+  }
+
+  double distance2 = 0.0;
+  for (std::size_t i = 0; i < bone_count; ++i)
+  {
+    distance2 += weight_differences[i] * weight_differences[i];
+  }
+
+  return distance2;
+}
+
+} // namespace
+
+VertexCacheStats analyze_vertex_cache(const std::vector<uint32_t> &indices,
+                                      std::size_t vertex_count)
+{
+  FGE_ASSERT(indices.size() % 3 == 0);
+
+  VertexCache cache(vertex_count);
+  const auto  misses = count_misses(indices, 0, indices.size() / 3, cache);
+
+  VertexCacheStats stats{};
+  if (!indices.empty())
+  {
+    stats.acmr = static_cast<float>(misses * 3) /
+                 static_cast<float>(indices.size());
+  }
+  if (vertex_count > 0)
+  {
+    stats.atvr =
+        static_cast<float>(misses) / static_cast<float>(vertex_count);
+  }
+
+  return stats;
+}
+
+std::size_t generate_weld_remap(const void *           vertices,
+                                std::size_t            vertex_size,
+                                std::size_t            vertex_count,
+                                std::vector<uint32_t> &remap)
+{
+  FGE_PROFILE_SCOPE("generate_weld_remap");
+
+  const auto bytes = static_cast<const char *>(vertices);
+
+  std::unordered_map<std::string_view, uint32_t> unique_vertices;
+  unique_vertices.reserve(vertex_count);
+
+  remap.resize(vertex_count);
+  for (std::size_t i = 0; i < vertex_count; ++i)
+  {
+    const std::string_view vertex(bytes + i * vertex_size, vertex_size);
+    const auto             next_index =
+        static_cast<uint32_t>(unique_vertices.size());
+
+    remap[i] = unique_vertices.emplace(vertex, next_index).first->second;
+  }
+
+  return unique_vertices.size();
+}
+
+std::vector<uint32_t>
+optimize_vertex_cache(const std::vector<uint32_t> &indices,
+                      std::size_t                  vertex_count)
+{
+  FGE_PROFILE_SCOPE("optimize_vertex_cache");
+  FGE_ASSERT(indices.size() % 3 == 0);
+
+  const Adjacency adjacency(indices, vertex_count);
+
+  // Triangles that are not emitted yet per vertex
+  std::vector<uint32_t> live_counts(vertex_count);
+  for (std::size_t i = 0; i < vertex_count; ++i)
+  {
+    live_counts[i] = adjacency.get_count(static_cast<uint32_t>(i));
+  }
+
+  std::vector<bool>     emitted(indices.size() / 3, false);
+  std::vector<uint32_t> dead_ends;
+  std::vector<uint32_t> candidates;
+  VertexCache           cache(vertex_count);
+  uint32_t              cursor = 0;
+
+  std::vector<uint32_t> result;
+  result.reserve(indices.size());
+
+  auto fanning = static_cast<uint32_t>(vertex_count > 0 ? 0 : unused_vertex);
+  while (fanning != unused_vertex)
+  {
+    candidates.clear();
+
+    // Emit all triangles around the fanning vertex
+    const auto begin = adjacency.offsets[fanning];
+    const auto end   = adjacency.offsets[fanning + 1];
+    for (auto i = begin; i < end; ++i)
+    {
+      const auto triangle = adjacency.triangles[i];
+      if (emitted[triangle])
+      {
+        continue;
+      }
+
+      for (uint32_t j = 0; j < 3; ++j)
+      {
+        const auto vertex = indices[triangle * 3 + j];
+        result.push_back(vertex);
+        dead_ends.push_back(vertex);
+        candidates.push_back(vertex);
+        --live_counts[vertex];
+        cache.add(vertex);
+      }
+      emitted[triangle] = true;
+    }
+
+    // The next fanning vertex is the one that is oldest in the cache but
+    // will still be in there once all its triangles are emitted
+    fanning            = unused_vertex;
+    int64_t best_score = -1;
+    for (const auto vertex : candidates)
+    {
+      if (live_counts[vertex] == 0)
+      {
+        continue;
+      }
+
+      int64_t score = 0;
+      if (cache.get_age(vertex) + 2 * live_counts[vertex] <= vertex_cache_size)
+      {
+        score = cache.get_age(vertex);
+      }
+
+      if (score > best_score)
+      {
+        best_score = score;
+        fanning    = vertex;
+      }
+    }
+
+    // Dead end, continue with a recently used vertex or the next vertex in
+    // the input that has triangles left
+    while (fanning == unused_vertex && !dead_ends.empty())
+    {
+      const auto vertex = dead_ends.back();
+      dead_ends.pop_back();
+      if (live_counts[vertex] > 0)
+      {
+        fanning = vertex;
+      }
+    }
+    while (fanning == unused_vertex && cursor < vertex_count)
+    {
+      if (live_counts[cursor] > 0)
+      {
+        fanning = cursor;
+      }
+      else
+      {
+        ++cursor;
+      }
+    }
+  }
+
+  return result;
+}
+
+std::vector<uint32_t>
+optimize_overdraw(const std::vector<uint32_t> & indices,
+                  const std::vector<glm::vec3> &positions,
+                  float                         threshold)
+{
+  FGE_PROFILE_SCOPE("optimize_overdraw");
+  FGE_ASSERT(indices.size() % 3 == 0);
+
+  auto clusters = split_clusters(indices, positions.size(), threshold);
+
+  // Area weighted, the normal's length is twice the area
+  const auto get_triangle = [&](std::size_t triangle) {
+    const auto &a = positions[indices[triangle * 3]];
+    const auto &b = positions[indices[triangle * 3 + 1]];
+    const auto &c = positions[indices[triangle * 3 + 2]];
+
+    const auto normal = glm::cross(b - a, c - a);
+    const auto area   = glm::length(normal) * 0.5f;
+    return std::make_pair((a + b + c) * (area / 3.0f), normal);
+  };
+
+  glm::vec3 mesh_center(0.0f);
+  float     mesh_area = 0.0f;
+  for (std::size_t i = 0; i < indices.size() / 3; ++i)
+  {
+    const auto [center, normal] = get_triangle(i);
+    mesh_center += center;
+    mesh_area += glm::length(normal) * 0.5f;
+  }
+  if (mesh_area > 0.0f)
+  {
+    mesh_center /= mesh_area;
+  }
+
+  for (auto &cluster : clusters)
+  {
+    glm::vec3 center(0.0f);
+    glm::vec3 normal(0.0f);
+    float     area = 0.0f;
+    for (auto i = cluster.begin; i < cluster.end; ++i)
+    {
+      const auto [triangle_center, triangle_normal] = get_triangle(i);
+      center += triangle_center;
+      normal += triangle_normal;
+      area += glm::length(triangle_normal) * 0.5f;
+    }
+
+    const auto normal_length = glm::length(normal);
+    if (area > 0.0f && normal_length > 0.0f)
+    {
+      cluster.sort_key =
+          glm::dot(center / area - mesh_center, normal / normal_length);
+    }
+  }
+
+  std::stable_sort(clusters.begin(),
+                   clusters.end(),
+                   [](const Cluster &first, const Cluster &second) {
+                     return first.sort_key > second.sort_key;
+                   });
+
+  std::vector<uint32_t> result;
+  result.reserve(indices.size());
+  for (const auto &cluster : clusters)
+  {
+    result.insert(result.end(),
+                  indices.begin() + cluster.begin * 3,
+                  indices.begin() + cluster.end * 3);
+  }
+
+  return result;
+}
+
+std::size_t generate_fetch_remap(const std::vector<uint32_t> &indices,
+                                 std::size_t                  vertex_count,
+                                 std::vector<uint32_t> &      remap)
+{
+  remap.assign(vertex_count, unused_vertex);
+
+  uint32_t next_index = 0;
+  for (const auto index : indices)
+  {
+    if (remap[index] == unused_vertex)
+    {
+      remap[index] = next_index++;
+    }
+  }
+
+  return next_index;
+}
+
+void remap_indices(std::vector<uint32_t> &      indices,
+                   const std::vector<uint32_t> &remap)
+{
+  for (auto &index : indices)
+  {
+    FGE_ASSERT(remap[index] != unused_vertex);
+    index = remap[index];
+  }
+}
+
+std::vector<uint32_t> simplify(const std::vector<uint32_t> &      indices,
+                               const std::vector<SimplifyVertex> &vertices,
+                               std::size_t target_index_count,
+                               float       max_error,
+                               float &     error)
+{
+  FGE_PROFILE_SCOPE("simplify");
+  FGE_ASSERT(indices.size() % 3 == 0);
+
+  error = 0.0f;
+
+  // In units of the radius, so the errors are relative to it
+  const auto sphere = compute_bounds(vertices).sphere;
+  const auto scale  = sphere.radius > 0.0f ? 1.0f / sphere.radius : 1.0f;
+
+  std::vector<glm::vec3> positions;
+  positions.reserve(vertices.size());
+  for (const auto &vertex : vertices)
+  {
+    positions.push_back((vertex.position - sphere.center) * scale);
+  }
+
+  SimplifyTopology topology(indices, positions);
+
+  const auto max_cost =
+      static_cast<double>(max_error) * static_cast<double>(max_error);
+
+  std::vector<uint32_t> result = indices;
+  std::vector<uint32_t> remap(vertices.size());
+  std::vector<bool>     changed(vertices.size());
+  std::vector<Collapse> collapses;
+
+  const auto get_cost = [&](uint32_t source, uint32_t target) {
+    auto quadric = topology.get_quadric(source);
+    quadric.add(topology.get_quadric(target));
+
+    return quadric.evaluate(positions[target]) +
+           attribute_weight *
+               get_attribute_distance2(vertices[source], vertices[target]) +
+           skin_weight * get_skin_distance2(vertices[source], vertices[target]);
+  };
+
+  // Collapses in the order of their cost. A vertex collapses at most once
+  // per pass, as the costs of its neighbours change with it.
+  while (result.size() > target_index_count)
+  {
+    const Adjacency adjacency(result, vertices.size());
+
+    collapses.clear();
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+      const auto a = result[i];
+      const auto b = result[i - i % 3 + (i + 1) % 3];
+      if (topology.can_collapse(a, b))
+      {
+        collapses.push_back(Collapse{a, b, get_cost(a, b)});
+      }
+      if (topology.can_collapse(b, a))
+      {
+        collapses.push_back(Collapse{b, a, get_cost(b, a)});
+      }
+    }
+    std::sort(collapses.begin(),
+              collapses.end(),
+              [](const Collapse &first, const Collapse &second) {
+                return first.cost < second.cost;
+              });
+
+    for (uint32_t i = 0; i < remap.size(); ++i)
+    {
+      remap[i] = i;
+    }
+    std::fill(changed.begin(), changed.end(), false);
+
+    const auto get_triangle = [&](uint32_t triangle) {
+      return std::array<uint32_t, 3>{remap[result[triangle * 3]],
+                                     remap[result[triangle * 3 + 1]],
+                                     remap[result[triangle * 3 + 2]]};
+    };
+
+    // Triangles that keep their area must not flip, the others vanish
+    const auto get_removed_count = [&](const Collapse &collapse) {
+      std::size_t removed_count = 0;
+      for (auto i = adjacency.offsets[collapse.source];
+           i < adjacency.offsets[collapse.source + 1];
+           ++i)
+      {
+        const auto triangle = get_triangle(adjacency.triangles[i]);
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] ||
+            triangle[0] == triangle[2])
+        {
+          continue;
+        }
+
+        if (std::find(triangle.begin(), triangle.end(), collapse.target) !=
+            triangle.end())
+        {
+          ++removed_count;
+          continue;
+        }
+
+        std::array<glm::vec3, 3> moved{};
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+          moved[j] = positions[triangle[j] == collapse.source ? collapse.target
+                                                              : triangle[j]];
+        }
+
+        const auto normal = glm::cross(positions[triangle[1]] -
+                                           positions[triangle[0]],
+                                       positions[triangle[2]] -
+                                           positions[triangle[0]]);
+        const auto moved_normal =
+            glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+        if (glm::dot(normal, moved_normal) <=
+            min_normal_cosine * glm::length(normal) *
+                glm::length(moved_normal))
+        {
+          return std::optional<std::size_t>{};
+        }
+      }
+
+      return std::optional<std::size_t>(removed_count);
+    };
+
+    auto        index_count    = result.size();
+    std::size_t collapse_count = 0;
+    for (const auto &collapse : collapses)
+    {
+      if (collapse.cost > max_cost || index_count <= target_index_count)
+      {
+        break;
+      }
+      if (changed[collapse.source] || changed[collapse.target])
+      {
+        continue;
+      }
+
+      const auto removed_count = get_removed_count(collapse);
+      if (!removed_count)
+      {
+        continue;
+      }
+
+      remap[collapse.source]   = collapse.target;
+      changed[collapse.source] = true;
+      changed[collapse.target] = true;
+      topology.collapse(collapse.source, collapse.target);
+
+      index_count -= std::min(*removed_count * 3, index_count);
+      error = std::max(error, static_cast<float>(std::sqrt(collapse.cost)));
+      ++collapse_count;
+    }
+
+    if (collapse_count == 0)
+    {
+      break;
+    }
+
+    std::vector<uint32_t> remaining;
+    remaining.reserve(index_count);
+    for (uint32_t i = 0; i < result.size() / 3; ++i)
+    {
+      const auto triangle = get_triangle(i);
+      if (triangle[0] != triangle[1] && triangle[1] != triangle[2] &&
+          triangle[0] != triangle[2])
+      {
+        remaining.insert(remaining.end(), triangle.begin(), triangle.end());
+      }
+    }
+    result.swap(remaining);
+  }
+
+  return result;
+}
+
+std::vector<MeshLod> generate_lods(std::vector<uint32_t> &            indices,
+                                   const std::vector<SimplifyVertex> &vertices)
+{
+  FGE_PROFILE_SCOPE("generate_lods");
+
+  std::vector<MeshLod> lods{
+      MeshLod{0, static_cast<uint32_t>(indices.size()), 0.0f}};
+
+  auto lod_indices = indices;
+  while (lods.size() < max_lod_count && lods.back().error < max_lod_error)
+  {
+    const auto target_index_count = lod_indices.size() / 6 * 3;
+
+    // Each LOD starts from the one before, so the errors add up
+    float      error = 0.0f;
+    const auto simplified =
+        simplify(lod_indices,
+                 vertices,
+                 target_index_count,
+                 max_lod_error - lods.back().error,
+                 error);
+    if (simplified.empty() ||
+        simplified.size() * min_lod_reduction >
+            lod_indices.size() * (min_lod_reduction - 1))
+    {
+      break;
+    }
+
+    lod_indices = optimize_vertex_cache(simplified, vertices.size());
+    lods.push_back(MeshLod{static_cast<uint32_t>(indices.size()),
+                           static_cast<uint32_t>(lod_indices.size()),
+                           lods.back().error + error});
+    indices.insert(indices.end(), lod_indices.begin(), lod_indices.end());
+  }
+
+  return lods;
+}
+
+} // namespace Fge
\ No newline at end of file
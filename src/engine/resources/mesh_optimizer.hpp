@@ -0,0 +1,241 @@
+#pragma once
+
+#include "mesh_data.hpp"
+#include "profiler/profiler.hpp"
+#include "std.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+/**
+ * Size of the FIFO post-transform cache the optimizer assumes and the
+ * analysis simulates.
+ */
+constexpr uint32_t vertex_cache_size = 16;
+
+/**
+ * Remap entry of a vertex no triangle uses.
+ */
+constexpr uint32_t unused_vertex = std::numeric_limits<uint32_t>::max();
+
+struct VertexCacheStats
+{
+  // Average cache miss ratio, transformed vertices per triangle. 0.5 is
+  // the best a regular grid can get, 3 means no vertex gets reused.
+  float acmr{};
+
+  // Average transformed vertex ratio, transformed vertices per vertex.
+  // 1 means every vertex gets transformed once.
+  float atvr{};
+};
+
+/**
+ * Simulates a FIFO post-transform cache.
+ */
+VertexCacheStats analyze_vertex_cache(const std::vector<uint32_t> &indices,
+                                      std::size_t vertex_count);
+
+/**
+ * Maps vertices with the same bytes to the first of them.
+ *
+ * @return Number of unique vertices
+ */
+std::size_t generate_weld_remap(const void *           vertices,
+                                std::size_t            vertex_size,
+                                std::size_t            vertex_count,
+                                std::vector<uint32_t> &remap);
+
+/**
+ * Reorders the triangles for the post-transform cache with Tipsify (Sander
+ * et al., "Fast Triangle Reordering for Vertex Locality and Reduced
+ * Overdraw"). Runs in linear time.
+ */
+std::vector<uint32_t>
+optimize_vertex_cache(const std::vector<uint32_t> &indices,
+                      std::size_t                  vertex_count);
+
+/**
+ * Splits cache optimized triangles into clusters and draws clusters that
+ * face away from the center of the mesh first, as they are more likely to
+ * occlude the others.
+ *
+ * @param threshold How much the ACMR of a cluster may be above the ACMR of
+ * the whole run it is split from. Higher gives smaller clusters and less
+ * overdraw for more cache misses.
+ */
+std::vector<uint32_t>
+optimize_overdraw(const std::vector<uint32_t> & indices,
+                  const std::vector<glm::vec3> &positions,
+                  float                         threshold = 1.05f);
+
+/**
+ * Numbers the vertices in the order the indices first use them, so the
+ * vertex fetch reads the vertex buffer front to back. Vertices no triangle
+ * uses get unused_vertex.
+ *
+ * @return Number of used vertices
+ */
+std::size_t generate_fetch_remap(const std::vector<uint32_t> &indices,
+                                 std::size_t                  vertex_count,
+                                 std::vector<uint32_t> &      remap);
+
+void remap_indices(std::vector<uint32_t> &      indices,
+                   const std::vector<uint32_t> &remap);
+
+/**
+ * Most LODs a sub mesh gets, including the full detail one.
+ */
+constexpr std::size_t max_lod_count = 4;
+
+/**
+ * Largest error a LOD may have, relative to the radius of the bounds.
+ */
+constexpr float max_lod_error = 0.25f;
+
+/**
+ * What the simplifier looks at of a vertex. Vertices without skin have no
+ * skin weights.
+ */
+struct SimplifyVertex
+{
+  glm::vec3  position{};
+  glm::vec3  normal{};
+  glm::vec2  tex_coord{};
+  glm::ivec4 skin_bones{0};
+  glm::vec4  skin_weights{0.0f};
+};
+
+inline SimplifyVertex create_simplify_vertex(const VertexPNTBT &vertex)
+{
+  return SimplifyVertex{vertex.position, vertex.normal, vertex.tex_coord};
+}
+
+inline SimplifyVertex create_simplify_vertex(const VertexPNTBBWT &vertex)
+{
+  return SimplifyVertex{vertex.position,
+                        vertex.normal,
+                        vertex.tex_coord,
+                        vertex.skin_bones,
+                        vertex.skin_weights};
+}
+
+/**
+ * Removes triangles with quadric error edge collapses (Garland and
+ * Heckbert, "Surface Simplification Using Quadric Error Metrics") until
+ * target_index_count indices are left or the next collapse would exceed
+ * max_error. Vertices only collapse onto a neighbour, so the result indexes
+ * the same vertices.
+ *
+ * Vertices that share a position with other vertices, i.e. lie on a seam
+ * of the normals or texture coordinates, are kept. Vertices on an open
+ * border only move along it. Collapses that change the normal, texture
+ * coordinates or skin influences of a vertex add to the error. Moving a
+ * vertex to other bones entirely costs more than any LOD may have.
+ *
+ * @param error Error of the result, relative to the radius of the bounds
+ * of the vertices.
+ */
+std::vector<uint32_t> simplify(const std::vector<uint32_t> &      indices,
+                               const std::vector<SimplifyVertex> &vertices,
+                               std::size_t target_index_count,
+                               float       max_error,
+                               float &     error);
+
+/**
+ * Appends LODs with about half the triangles of the one before to the
+ * indices, until max_lod_count or max_lod_error is reached or a LOD would
+ * save too little.
+ *
+ * @return Index ranges of the LODs, the first one is the full detail one.
+ */
+std::vector<MeshLod> generate_lods(std::vector<uint32_t> &            indices,
+                                   const std::vector<SimplifyVertex> &vertices);
+
+template <typename TVertex>
+void remap_vertices(std::vector<TVertex> &       vertices,
+                    const std::vector<uint32_t> &remap,
+                    std::size_t                  vertex_count)
+{
+  FGE_ASSERT(remap.size() == vertices.size());
+
+  std::vector<TVertex> remapped(vertex_count);
+  for (std::size_t i = 0; i < vertices.size(); ++i)
+  {
+    if (remap[i] != unused_vertex)
+    {
+      remapped[remap[i]] = vertices[i];
+    }
+  }
+
+  vertices.swap(remapped);
+}
+
+struct MeshOptimizationReport
+{
+  std::size_t      vertex_count_before{};
+  std::size_t      vertex_count_after{};
+  VertexCacheStats before{};
+  VertexCacheStats after{};
+
+  std::vector<std::size_t> lod_triangle_counts{};
+};
+
+/**
+ * Welds vertices that are the same, orders the triangles for the vertex
+ * cache and for overdraw, generates the LODs and orders the vertices for
+ * fetching. The triangles of the full detail LOD and their winding stay the
+ * same, only their order changes.
+ */
+template <typename TVertex>
+MeshOptimizationReport optimize_sub_mesh(SubMeshData<TVertex> &sub_mesh)
+{
+  FGE_PROFILE_SCOPE("optimize_sub_mesh");
+
+  auto &vertices = *sub_mesh.vertices;
+  auto &indices  = *sub_mesh.indices;
+
+  MeshOptimizationReport report{};
+  report.vertex_count_before = vertices.size();
+  report.before              = analyze_vertex_cache(indices, vertices.size());
+
+  std::vector<uint32_t> remap;
+  auto                  vertex_count = generate_weld_remap(
+      vertices.data(), sizeof(TVertex), vertices.size(), remap);
+  remap_indices(indices, remap);
+  remap_vertices(vertices, remap, vertex_count);
+
+  std::vector<glm::vec3>      positions;
+  std::vector<SimplifyVertex> simplify_vertices;
+  positions.reserve(vertices.size());
+  simplify_vertices.reserve(vertices.size());
+  for (const auto &vertex : vertices)
+  {
+    positions.push_back(vertex.position);
+    simplify_vertices.push_back(create_simplify_vertex(vertex));
+  }
+
+  indices       = optimize_vertex_cache(indices, vertices.size());
+  indices       = optimize_overdraw(indices, positions);
+  sub_mesh.lods = generate_lods(indices, simplify_vertices);
+
+  // The coarser LODs only use vertices of the full detail one, so the
+  // vertices are in the order the full detail one fetches them
+  vertex_count = generate_fetch_remap(indices, vertices.size(), remap);
+  remap_indices(indices, remap);
+  remap_vertices(vertices, remap, vertex_count);
+
+  const std::vector<uint32_t> full_detail_indices(
+      indices.begin(), indices.begin() + sub_mesh.lods.front().index_count);
+
+  report.vertex_count_after = vertices.size();
+  report.after = analyze_vertex_cache(full_detail_indices, vertices.size());
+  for (const auto &lod : sub_mesh.lods)
+  {
+    report.lod_triangle_counts.push_back(lod.index_count / 3);
+  }
+
+  return report;
+}
+
+} // namespace Fge
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "std.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+enum class ResourceStatus
+{
+  Loading,
+  Ready,
+  Failed
+};
+
+/**
+ * Resource that gets loaded in the background.
+ *
+ * Copies of a handle share the same load. The resource manager resolves or
+ * fails the handle on the GL thread, so the resource can be used right away
+ * once the handle is ready. The status can be polled from any thread.
+ */
+template <typename TResource> class ResourceHandle
+{
+public:
+  /**
+   * Handle that isn't tied to any load.
+   */
+  ResourceHandle() = default;
+
+  static ResourceHandle create_loading()
+  {
+    ResourceHandle handle{};
+    handle.state = std::make_shared<State>();
+    return handle;
+  }
+
+  static ResourceHandle create_ready(std::shared_ptr<TResource> resource)
+  {
+    auto handle = create_loading();
+    handle.resolve(std::move(resource));
+    return handle;
+  }
+
+  bool is_valid() const { return state != nullptr; }
+
+  ResourceStatus get_status() const
+  {
+    FGE_ASSERT(state);
+    return state->status.load(std::memory_order_acquire);
+  }
+
+  bool is_loading() const { return get_status() == ResourceStatus::Loading; }
+
+  bool is_ready() const { return get_status() == ResourceStatus::Ready; }
+
+  bool has_failed() const { return get_status() == ResourceStatus::Failed; }
+
+  /**
+   * @return The resource, null as long as the handle isn't ready
+   */
+  std::shared_ptr<TResource> get() const
+  {
+    return is_ready() ? state->resource : nullptr;
+  }
+
+  /**
+   * @return Why the load failed, empty as long as it didn't
+   */
+  std::string get_error() const
+  {
+    return has_failed() ? state->error : std::string();
+  }
+
+  void resolve(std::shared_ptr<TResource> resource)
+  {
+    FGE_ASSERT(is_loading());
+    state->resource = std::move(resource);
+    state->status.store(ResourceStatus::Ready, std::memory_order_release);
+  }
+
+  void fail(std::string error)
+  {
+    FGE_ASSERT(is_loading());
+    state->error = std::move(error);
+    state->status.store(ResourceStatus::Failed, std::memory_order_release);
+  }
+
+private:
+  struct State
+  {
+    std::atomic<ResourceStatus> status{ResourceStatus::Loading};
+    std::shared_ptr<TResource>  resource{};
+    std::string                 error;
+  };
+
+  std::shared_ptr<State> state{};
+};
+
+} // namespace Fge
@@ -1,13 +1,14 @@
-#include <stb_image.h>
-
 #include "application.hpp"
 #include "graphic/mesh.hpp"
 #include "graphic/mesh_material.hpp"
 #include "graphic/skinned_mesh.hpp"
 #include "graphic/texture.hpp"
+#include "log/log.hpp"
 #include "mesh_importer.hpp"
+#include "profiler/profiler.hpp"
 #include "resource_manager.hpp"
 #include "skinned_mesh_importer.hpp"
+#include "texture_data.hpp"
 #include "util/assert.hpp"
 
 #define MESH_DIR    "meshes"
@@ -16,7 +17,24 @@
 namespace Fge
 {
 
+namespace
+{
+
+// Imports are mostly waiting on the disk, two threads keep the cores free
+// for the frame
+constexpr std::size_t loader_thread_count = 2;
+
+std::filesystem::path get_cooked_meshes_path()
+{
+  auto file_manager = Application::get_instance()->get_file_manager();
+  return file_manager->get_app_cache_path() / MESH_DIR;
+}
+
+} // namespace
+
 ResourceManager::ResourceManager()
+    : cooked_meshes(get_cooked_meshes_path()),
+      loader(std::make_unique<JobSystem>(loader_thread_count))
 {
   auto app                = Application::get_instance();
   auto filesystem_manager = app->get_file_manager();
@@ -43,6 +61,8 @@ std::shared_ptr<Mesh> create_mesh_instance(std::shared_ptr<Mesh> mesh)
                                                   material,
                                                   vertex_array,
                                                   index_buffer);
+    new_sub_mesh->set_bounds(sub_mesh->get_bounds());
+    new_sub_mesh->set_lods(sub_mesh->get_lods());
 
     new_sub_meshes.push_back(new_sub_mesh);
   }
@@ -71,11 +91,15 @@ create_mesh_instance(std::shared_ptr<SkinnedMesh> mesh)
                                                          material,
                                                          vertex_array,
                                                          index_buffer);
+    new_sub_mesh->set_bounds(sub_mesh->get_bounds());
+    new_sub_mesh->set_lods(sub_mesh->get_lods());
 
     new_sub_meshes.push_back(new_sub_mesh);
   }
 
-  return std::make_shared<SkinnedMesh>(new_sub_meshes, mesh->get_skeleton());
+  // The instance shares the bones and animations, but plays on its own
+  return std::make_shared<SkinnedMesh>(
+      new_sub_meshes, Skeleton(mesh->get_skeleton().get_asset()));
 }
 
 std::shared_ptr<Mesh> ResourceManager::load_mesh(const std::string &filepath)
@@ -89,8 +113,7 @@ std::shared_ptr<Mesh> ResourceManager::load_mesh(const std::string &filepath)
   }
   else
   {
-    mesh =
-        import_mesh_from_file((resource_path / MESH_DIR / filepath).string());
+    mesh                 = create_mesh(load_mesh_data(filepath));
     mesh_cache[filepath] = mesh;
   }
 
@@ -111,8 +134,7 @@ ResourceManager::load_skinned_mesh(const std::string &filepath)
   }
   else
   {
-    mesh = import_skinned_mesh_from_file(
-        (resource_path / MESH_DIR / filepath).string());
+    mesh = create_skinned_mesh(load_skinned_mesh_data(filepath));
     skinned_mesh_cache[filepath] = mesh;
   }
 
@@ -121,51 +143,70 @@ ResourceManager::load_skinned_mesh(const std::string &filepath)
   return mesh_instance;
 }
 
-std::shared_ptr<Texture2D> load_texture2d_from_file(const std::string &filepath,
-                                                    bool               flip)
+MeshData ResourceManager::load_mesh_data(const std::string &filepath)
 {
-  if (flip)
-  {
-    stbi_set_flip_vertically_on_load(true);
-  }
-  int32_t        width, height, nr_channels;
-  unsigned char *data =
-      stbi_load(filepath.c_str(), &width, &height, &nr_channels, 0);
+  const auto source_path = resource_path / MESH_DIR / filepath;
 
+  auto data = cooked_meshes.load_mesh(filepath, source_path);
   if (!data)
   {
-    throw std::runtime_error("Could not load texture " + filepath);
+    data = import_mesh_from_file(source_path.string());
+    cooked_meshes.store_mesh(filepath, source_path, *data);
   }
 
-  ImageFormat format = ImageFormat::Rgb;
+  // Still on the loading thread, create_mesh() only copies
+  pack_mesh_data(*data);
+
+  return std::move(*data);
+}
+
+SkinnedMeshData
+ResourceManager::load_skinned_mesh_data(const std::string &filepath)
+{
+  const auto source_path = resource_path / MESH_DIR / filepath;
 
-  switch (nr_channels)
+  auto data = cooked_meshes.load_skinned_mesh(filepath, source_path);
+  if (!data)
   {
-  case 1:
-    format = ImageFormat::Red;
-    break;
-  case 3:
-    format = ImageFormat::Rgb;
-    break;
-  case 4:
-    format = ImageFormat::Rgba;
-    break;
-  default:
-    FGE_FAIL("No such channel");
+    data = import_skinned_mesh_from_file(source_path.string());
+    cooked_meshes.store_skinned_mesh(filepath, source_path, *data);
   }
 
+  pack_mesh_data(*data);
+
+  return std::move(*data);
+}
+
+/**
+ * Textures are cached per path and flip, a flipped texture is a different
+ * texture.
+ */
+std::string get_texture2d_key(const std::string &filepath, bool flip)
+{
+  return flip ? filepath + "#flipped" : filepath;
+}
+
+std::shared_ptr<Texture2D> create_texture2d(const TextureData &texture)
+{
   Texture2DConfig texture_config{};
-  texture_config.name            = filepath;
-  texture_config.width           = width;
-  texture_config.height          = height;
-  texture_config.data            = data;
-  texture_config.format          = format;
+  texture_config.name            = texture.name;
+  texture_config.width           = texture.width;
+  texture_config.height          = texture.height;
+  texture_config.data            = texture.pixels.data();
+  texture_config.format          = texture.format;
   texture_config.wrap_s          = WrapMode::Repeat;
   texture_config.wrap_t          = WrapMode::Repeat;
   texture_config.filter_min      = FilterMode::LinearMipmapLinear;
   texture_config.filter_max      = FilterMode::Linear;
   texture_config.pixel_data_type = PixelDataType::UnsignedByte;
-  texture_config.generate_mipmap = true;
+
+  // The mip chain got generated on the loading thread
+  for (std::size_t i = 1; i < texture.level_offsets.size(); ++i)
+  {
+    texture_config.mip_data.push_back(texture.pixels.data() +
+                                      texture.level_offsets[i]);
+  }
+  texture_config.generate_mipmap = texture_config.mip_data.empty();
 
   auto app = Application::get_instance();
 
@@ -176,19 +217,332 @@ std::shared_ptr<Texture2D> load_texture2d_from_file(const std::string &filepath,
 std::shared_ptr<Texture2D>
 ResourceManager::load_texture2d(const std::string &filepath, bool flip)
 {
-  auto iter = texture2d_cache.find(filepath);
+  const auto key  = get_texture2d_key(filepath, flip);
+  auto       iter = texture2d_cache.find(key);
   if (iter != texture2d_cache.end())
   {
     return iter->second;
   }
 
-  auto texture = load_texture2d_from_file(
-      (resource_path / TEXTURE_DIR / filepath).string(),
-      flip);
+  const auto path    = (resource_path / TEXTURE_DIR / filepath).string();
+  auto       texture = create_texture2d(load_texture2d_data(path, flip));
 
-  texture2d_cache[filepath] = texture;
+  texture2d_cache[key] = texture;
 
   return texture;
 }
 
+template <typename TLoad, typename TUpload, typename TFail>
+void ResourceManager::schedule_load(TLoad load, TUpload upload, TFail fail)
+{
+  FGE_ASSERT(loader);
+
+  loader->schedule([this, load, upload, fail]() mutable {
+    try
+    {
+      auto data = std::make_shared<decltype(load())>(load());
+      uploads.push([data, upload]() mutable { return upload(*data); });
+    }
+    catch (const std::exception &exception)
+    {
+      uploads.push([fail, error = std::string(exception.what())]() mutable {
+        fail(error);
+        return true;
+      });
+    }
+  });
+}
+
+/**
+ * Starts loading the textures of the materials.
+ */
+template <typename TVertex>
+std::vector<ResourceHandle<Texture2D>>
+load_textures_async(ResourceManager &                        resource_manager,
+                    const std::vector<SubMeshData<TVertex>> &sub_meshes)
+{
+  std::vector<ResourceHandle<Texture2D>> textures;
+
+  for (const auto &sub_mesh : sub_meshes)
+  {
+    const auto &material = sub_mesh.material;
+    for (const auto *filepath : {&material.ambient_texture,
+                                 &material.diffuse_texture,
+                                 &material.specular_texture})
+    {
+      // Flipped, like create_mesh loads them
+      if (!filepath->empty())
+      {
+        textures.push_back(
+            resource_manager.load_texture2d_async(*filepath, true));
+      }
+    }
+  }
+
+  return textures;
+}
+
+template <typename TMesh, typename TLoadData, typename TCreate>
+ResourceHandle<TMesh> ResourceManager::load_shared_mesh_async(
+    const std::string &                                      filepath,
+    std::unordered_map<std::string, std::shared_ptr<TMesh>> &cache,
+    std::unordered_map<std::string, ResourceHandle<TMesh>> & pending,
+    TLoadData                                                load_data,
+    TCreate                                                  create)
+{
+  auto iter = cache.find(filepath);
+  if (iter != cache.end())
+  {
+    return ResourceHandle<TMesh>::create_ready(iter->second);
+  }
+
+  auto pending_iter = pending.find(filepath);
+  if (pending_iter != pending.end())
+  {
+    return pending_iter->second;
+  }
+
+  auto handle       = ResourceHandle<TMesh>::create_loading();
+  pending[filepath] = handle;
+
+  schedule_load(
+      load_data,
+      [this,
+       filepath,
+       &cache,
+       &pending,
+       create,
+       handle,
+       textures = std::optional<std::vector<ResourceHandle<Texture2D>>>{}](
+          const auto &data) mutable {
+        // create_mesh would decode the textures on this thread otherwise
+        if (!textures)
+        {
+          textures = load_textures_async(*this, data.sub_meshes);
+        }
+
+        for (const auto &texture : *textures)
+        {
+          if (texture.is_loading())
+          {
+            return false;
+          }
+        }
+
+        pending.erase(filepath);
+
+        for (const auto &texture : *textures)
+        {
+          if (texture.has_failed())
+          {
+            handle.fail(texture.get_error());
+            return true;
+          }
+        }
+
+        try
+        {
+          // A blocking load of the same file can have been faster
+          auto cached = cache.find(filepath);
+          auto mesh   = cached != cache.end() ? cached->second : create(data);
+
+          cache[filepath] = mesh;
+          handle.resolve(mesh);
+        }
+        catch (const std::exception &exception)
+        {
+          handle.fail(exception.what());
+        }
+
+        return true;
+      },
+      [filepath, &pending, handle](const std::string &error) mutable {
+        pending.erase(filepath);
+        handle.fail(error);
+      });
+
+  return handle;
+}
+
+template <typename TMesh>
+ResourceHandle<TMesh>
+ResourceManager::create_instance_async(ResourceHandle<TMesh> shared_mesh)
+{
+  if (shared_mesh.is_ready())
+  {
+    return ResourceHandle<TMesh>::create_ready(
+        create_mesh_instance(shared_mesh.get()));
+  }
+
+  auto handle = ResourceHandle<TMesh>::create_loading();
+
+  uploads.push([shared_mesh, handle]() mutable {
+    if (shared_mesh.is_loading())
+    {
+      return false;
+    }
+
+    if (shared_mesh.has_failed())
+    {
+      handle.fail(shared_mesh.get_error());
+    }
+    else
+    {
+      handle.resolve(create_mesh_instance(shared_mesh.get()));
+    }
+
+    return true;
+  });
+
+  return handle;
+}
+
+ResourceHandle<Mesh>
+ResourceManager::load_mesh_async(const std::string &filepath)
+{
+  return create_instance_async(load_shared_mesh_async(
+      filepath,
+      mesh_cache,
+      pending_meshes,
+      [this, filepath]() { return load_mesh_data(filepath); },
+      create_mesh));
+}
+
+ResourceHandle<SkinnedMesh>
+ResourceManager::load_skinned_mesh_async(const std::string &filepath)
+{
+  return create_instance_async(load_shared_mesh_async(
+      filepath,
+      skinned_mesh_cache,
+      pending_skinned_meshes,
+      [this, filepath]() { return load_skinned_mesh_data(filepath); },
+      create_skinned_mesh));
+}
+
+ResourceHandle<Texture2D>
+ResourceManager::load_texture2d_async(const std::string &filepath, bool flip)
+{
+  const auto key  = get_texture2d_key(filepath, flip);
+  auto       iter = texture2d_cache.find(key);
+  if (iter != texture2d_cache.end())
+  {
+    return ResourceHandle<Texture2D>::create_ready(iter->second);
+  }
+
+  auto pending_iter = pending_textures.find(key);
+  if (pending_iter != pending_textures.end())
+  {
+    return pending_iter->second;
+  }
+
+  auto handle           = ResourceHandle<Texture2D>::create_loading();
+  pending_textures[key] = handle;
+
+  schedule_load(
+      [path = (resource_path / TEXTURE_DIR / filepath).string(), flip]() {
+        return load_texture2d_data(path, flip);
+      },
+      [this, key, handle](const TextureData &data) mutable {
+        pending_textures.erase(key);
+
+        try
+        {
+          // A blocking load of the same file can have been faster
+          auto cached  = texture2d_cache.find(key);
+          auto texture = cached != texture2d_cache.end()
+                             ? cached->second
+                             : create_texture2d(data);
+
+          texture2d_cache[key] = texture;
+          handle.resolve(texture);
+        }
+        catch (const std::exception &exception)
+        {
+          handle.fail(exception.what());
+        }
+
+        return true;
+      },
+      [this, key, handle](const std::string &error) mutable {
+        pending_textures.erase(key);
+        handle.fail(error);
+      });
+
+  return handle;
+}
+
+void ResourceManager::preload_textures2d(
+    const std::vector<std::string> &filepaths,
+    bool                            flip)
+{
+  FGE_PROFILE_SCOPE("ResourceManager::preload_textures2d");
+
+  // Textures that are cached or loading already are left alone
+  std::vector<std::string> missing;
+  for (const auto &filepath : filepaths)
+  {
+    const auto key = get_texture2d_key(filepath, flip);
+    if (texture2d_cache.count(key) == 0 && pending_textures.count(key) == 0 &&
+        std::find(missing.begin(), missing.end(), filepath) == missing.end())
+    {
+      missing.push_back(filepath);
+    }
+  }
+
+  std::vector<std::optional<TextureData>> textures(missing.size());
+
+  auto job_system = Application::get_instance()->get_job_system();
+  job_system->parallel_for(
+      missing.size(),
+      1,
+      [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          const auto path = (resource_path / TEXTURE_DIR / missing[i]).string();
+          try
+          {
+            textures[i] = load_texture2d_data(path, flip);
+          }
+          catch (const std::exception &exception)
+          {
+            warning("ResourceManager",
+                    FMT_STRING("Could not preload texture: {}"),
+                    exception.what());
+          }
+        }
+      });
+
+  // Only the uploads run on this thread one after another
+  for (std::size_t i = 0; i < missing.size(); ++i)
+  {
+    if (textures[i])
+    {
+      texture2d_cache[get_texture2d_key(missing[i], flip)] =
+          create_texture2d(*textures[i]);
+    }
+  }
+}
+
+void ResourceManager::process_uploads(std::chrono::microseconds budget)
+{
+  FGE_PROFILE_SCOPE("ResourceManager::process_uploads");
+
+  uploads.process(budget);
+}
+
+void ResourceManager::terminate()
+{
+  // Joins the workers, running loads finish and push their uploads first
+  loader = nullptr;
+  uploads.clear();
+
+  pending_meshes.clear();
+  pending_skinned_meshes.clear();
+  pending_textures.clear();
+
+  mesh_cache.clear();
+  skinned_mesh_cache.clear();
+  texture2d_cache.clear();
+}
+
 } // namespace Fge
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "cooked_mesh_cache.hpp"
+#include "job/job_system.hpp"
+#include "resource_handle.hpp"
 #include "std.hpp"
+#include "upload_queue.hpp"
 
 namespace Fge
 {
@@ -9,6 +13,14 @@ class Mesh;
 class SkinnedMesh;
 class Texture2D;
 
+/**
+ * Loads and caches meshes and textures.
+ *
+ * The load functions block until the resource is created. The async
+ * variants read and decode on loader threads and create the GL objects in
+ * process_uploads, which runs on the GL thread. All functions must be called
+ * from the GL thread.
+ */
 class ResourceManager
 {
 public:
@@ -21,15 +33,99 @@ public:
   std::shared_ptr<Texture2D> load_texture2d(const std::string &filepath,
                                             bool               flip = false);
 
+  /**
+   * Every handle gets its own mesh instance, loads of the same file share
+   * the import.
+   */
+  ResourceHandle<Mesh> load_mesh_async(const std::string &filepath);
+
+  ResourceHandle<SkinnedMesh>
+  load_skinned_mesh_async(const std::string &filepath);
+
+  ResourceHandle<Texture2D> load_texture2d_async(const std::string &filepath,
+                                                 bool flip = false);
+
+  /**
+   * Loads several textures at once and blocks until they are created. The
+   * files get decoded in parallel on the job system. Textures that can't be
+   * loaded only get logged.
+   */
+  void preload_textures2d(const std::vector<std::string> &filepaths,
+                          bool                            flip = false);
+
+  /**
+   * Creates the GL objects of finished loads and resolves their handles.
+   * Stops once the budget is used up, the rest waits for the next frame.
+   */
+  void process_uploads(std::chrono::microseconds budget);
+
+  /**
+   * Stops the loader threads and releases all cached resources. Loads that
+   * are still running get dropped, their handles never resolve. Must be
+   * called before the GL context goes away.
+   */
+  void terminate();
+
 private:
   std::filesystem::path resource_path;
 
+  CookedMeshCache cooked_meshes;
+
   std::unordered_map<std::string, std::shared_ptr<Mesh>> mesh_cache;
 
   std::unordered_map<std::string, std::shared_ptr<SkinnedMesh>>
       skinned_mesh_cache;
 
+  // Keyed by path and flip
   std::unordered_map<std::string, std::shared_ptr<Texture2D>> texture2d_cache;
+
+  // Loads that are still running, so a file is only loaded once
+  std::unordered_map<std::string, ResourceHandle<Mesh>> pending_meshes;
+
+  std::unordered_map<std::string, ResourceHandle<SkinnedMesh>>
+      pending_skinned_meshes;
+
+  std::unordered_map<std::string, ResourceHandle<Texture2D>>
+      pending_textures;
+
+  UploadQueue uploads;
+
+  /**
+   * Own threads for loading, so waits of the frame never pick up an import.
+   * Last member, the workers are joined before anything they use goes away.
+   * Null after terminate.
+   */
+  std::unique_ptr<JobSystem> loader;
+
+  /**
+   * Loads the cooked mesh. Imports the source file and cooks it if the
+   * cache has no up to date entry.
+   */
+  MeshData load_mesh_data(const std::string &filepath);
+
+  SkinnedMeshData load_skinned_mesh_data(const std::string &filepath);
+
+  /**
+   * Runs load on a loader thread and hands its result to upload on the GL
+   * thread. fail gets called on the GL thread if load throws.
+   */
+  template <typename TLoad, typename TUpload, typename TFail>
+  void schedule_load(TLoad load, TUpload upload, TFail fail);
+
+  /**
+   * Loads the mesh all instances of the file share.
+   */
+  template <typename TMesh, typename TLoadData, typename TCreate>
+  ResourceHandle<TMesh> load_shared_mesh_async(
+      const std::string &                                      filepath,
+      std::unordered_map<std::string, std::shared_ptr<TMesh>> &cache,
+      std::unordered_map<std::string, ResourceHandle<TMesh>> & pending,
+      TLoadData                                                load_data,
+      TCreate                                                  create);
+
+  template <typename TMesh>
+  ResourceHandle<TMesh>
+  create_instance_async(ResourceHandle<TMesh> shared_mesh);
 };
 
 } // namespace Fge
@@ -1,8 +1,7 @@
 #include "skinned_mesh_importer.hpp"
-#include "application.hpp"
-#include "graphic/default_material.hpp"
-#include "graphic/skinned_mesh.hpp"
+#include "graphic/vertex_packing.hpp"
 #include "mesh_importer_common.hpp"
+#include "profiler/profiler.hpp"
 #include "util/assert.hpp"
 
 namespace Fge
@@ -209,7 +208,7 @@ aiMatrix4x4 calculate_skeleton_transform(const aiScene *    ai_scene,
 void do_build_bones(aiNode *                            ai_node,
                     std::unordered_map<aiNode *, bool> &ai_nodes_map,
                     int                                 parent_index,
-                    std::vector<Skeleton::Bone> &       bones)
+                    std::vector<SkeletonAsset::Bone> &  bones)
 {
   auto iter = ai_nodes_map.find(ai_node);
   if (iter == ai_nodes_map.end())
@@ -222,7 +221,7 @@ void do_build_bones(aiNode *                            ai_node,
   auto necessary = iter->second;
   if (necessary)
   {
-    Skeleton::Bone bone;
+    SkeletonAsset::Bone bone;
     bone.name            = ai_node->mName.C_Str();
     bone.parent_index    = parent_index;
     bone.local_bind_pose = mat4_cast(ai_node->mTransformation);
@@ -244,11 +243,11 @@ void do_build_bones(aiNode *                            ai_node,
   }
 }
 
-std::vector<Skeleton::Bone>
+std::vector<SkeletonAsset::Bone>
 build_bones(const aiScene *                     ai_scene,
             std::unordered_map<aiNode *, bool> &ai_nodes_map)
 {
-  std::vector<Skeleton::Bone> bones;
+  std::vector<SkeletonAsset::Bone> bones;
 
   do_build_bones(ai_scene->mRootNode, ai_nodes_map, -1, bones);
 
@@ -260,8 +259,8 @@ build_bones(const aiScene *                     ai_scene,
   return bones;
 }
 
-std::vector<Animation> load_animations(const aiScene *ai_scene,
-                                       Skeleton &     skeleton)
+std::vector<Animation> load_animations(const aiScene *      ai_scene,
+                                       const SkeletonAsset &skeleton)
 {
   std::vector<Animation> animations;
 
@@ -351,7 +350,7 @@ std::vector<Animation> load_animations(const aiScene *ai_scene,
   return animations;
 }
 
-void compute_global_inv_bind_poses(std::vector<Skeleton::Bone> &bones)
+void compute_global_inv_bind_poses(std::vector<SkeletonAsset::Bone> &bones)
 {
   if (bones.size() == 0)
   {
@@ -377,7 +376,7 @@ void compute_global_inv_bind_poses(std::vector<Skeleton::Bone> &bones)
   }
 }
 
-Skeleton load_skeleton(const aiScene *ai_scene)
+std::shared_ptr<SkeletonAsset> load_skeleton(const aiScene *ai_scene)
 {
   // Build up a map with all nodes that are in the scene
   // contained. This map saves for each node if this node is necessary
@@ -399,15 +398,16 @@ Skeleton load_skeleton(const aiScene *ai_scene)
 
   compute_global_inv_bind_poses(bones);
 
-  return Skeleton(bones);
+  return std::make_shared<SkeletonAsset>(bones);
 }
 
 void do_load_skinned_mesh(
-    const aiScene *                               ai_scene,
-    aiNode *                                      ai_node,
-    aiMatrix4x4 &                                 parent_transform,
-    Skeleton &                                    skeleton,
-    std::vector<std::shared_ptr<SkinnedSubMesh>> &sub_meshes)
+    const aiScene *                          ai_scene,
+    aiNode *                                 ai_node,
+    aiMatrix4x4 &                            parent_transform,
+    const SkeletonAsset &                    skeleton,
+    bool                                     optimize,
+    std::vector<SubMeshData<VertexPNTBBWT>> &sub_meshes)
 {
   auto transform = parent_transform * ai_node->mTransformation;
 
@@ -565,13 +565,18 @@ void do_load_skinned_mesh(
       indices->emplace_back(ai_face.mIndices[2]);
     }
 
-    auto material = load_material(ai_scene, ai_mesh);
+    SubMeshData<VertexPNTBBWT> sub_mesh{};
+    sub_mesh.name     = ai_mesh->mName.C_Str();
+    sub_mesh.vertices = vertices;
+    sub_mesh.indices  = indices;
+    sub_mesh.material = load_material(ai_scene, ai_mesh);
 
-    auto sub_mesh = std::make_shared<SkinnedSubMesh>(ai_mesh->mName.C_Str(),
-                                                     vertices,
-                                                     indices,
-                                                     material);
+    if (optimize)
+    {
+      log_mesh_optimization(sub_mesh.name, optimize_sub_mesh(sub_mesh));
+    }
 
+    sub_mesh.bounds = compute_bounds(*vertices);
     sub_meshes.emplace_back(sub_mesh);
   }
 
@@ -581,29 +586,35 @@ void do_load_skinned_mesh(
                          ai_node->mChildren[i],
                          transform,
                          skeleton,
+                         optimize,
                          sub_meshes);
   }
 }
 
-std::shared_ptr<SkinnedMesh> load_skinned_mesh(const aiScene *ai_scene,
-                                               Skeleton &     skeleton)
+SkinnedMeshData load_skinned_mesh(const aiScene *                ai_scene,
+                                  std::shared_ptr<SkeletonAsset> skeleton,
+                                  bool                           optimize)
 {
   aiMatrix4x4 transform;
   FGE_ASSERT(transform.IsIdentity());
 
-  std::vector<std::shared_ptr<SkinnedSubMesh>> sub_meshes;
+  SkinnedMeshData mesh{};
+  mesh.skeleton = skeleton;
   do_load_skinned_mesh(ai_scene,
                        ai_scene->mRootNode,
                        transform,
-                       skeleton,
-                       sub_meshes);
+                       *skeleton,
+                       optimize,
+                       mesh.sub_meshes);
 
-  return std::make_shared<SkinnedMesh>(sub_meshes, skeleton);
+  return mesh;
 }
 
-std::shared_ptr<SkinnedMesh>
-import_skinned_mesh_from_file(const std::string &filename)
+SkinnedMeshData import_skinned_mesh_from_file(const std::string &filename,
+                                              bool               optimize)
 {
+  FGE_PROFILE_SCOPE("import_skinned_mesh_from_file");
+
   Assimp::Importer importer;
   const aiScene *  ai_scene =
       importer.ReadFile(filename,
@@ -618,16 +629,24 @@ import_skinned_mesh_from_file(const std::string &filename)
                              importer.GetErrorString());
   }
 
-  auto skeleton = load_skeleton(ai_scene);
+  auto skeleton_asset = load_skeleton(ai_scene);
+
+  // Packed vertices address bones with 8 bits
+  if (skeleton_asset->get_bones_count() > max_packed_bone_count)
+  {
+    throw std::runtime_error("Skeleton has more than " +
+                             std::to_string(max_packed_bone_count) + " bones");
+  }
 
-  auto animations = load_animations(ai_scene, skeleton);
+  auto animations = load_animations(ai_scene, *skeleton_asset);
 
+  // Playback only uses the compiled clips
   for (auto &animation : animations)
   {
-    skeleton.add_animation(animation);
+    skeleton_asset->add_animation(CompiledAnimation(animation));
   }
 
-  auto mesh = load_skinned_mesh(ai_scene, skeleton);
+  auto mesh = load_skinned_mesh(ai_scene, skeleton_asset, optimize);
 
   return mesh;
 }
@@ -1,12 +1,16 @@
 #pragma once
 
+#include "mesh_data.hpp"
 #include "std.hpp"
 
 namespace Fge
 {
-class SkinnedMesh;
 
-std::shared_ptr<SkinnedMesh>
-import_skinned_mesh_from_file(const std::string &filename);
+/**
+ * @param optimize Like for import_mesh_from_file
+ */
+SkinnedMeshData
+import_skinned_mesh_from_file(const std::string &filename,
+                              bool               optimize = true);
 
 } // namespace Fge
@@ -0,0 +1,155 @@
+#include <stb_image.h>
+
+#include "profiler/profiler.hpp"
+#include "texture_data.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+uint32_t get_channel_count(ImageFormat format)
+{
+  switch (format)
+  {
+  case ImageFormat::Red:
+    return 1;
+  case ImageFormat::Rgb:
+    return 3;
+  case ImageFormat::Rgba:
+    return 4;
+  default:
+    FGE_FAIL("No such format");
+  }
+}
+
+uint32_t get_mip_level_count(uint32_t width, uint32_t height)
+{
+  uint32_t count = 1;
+  for (auto size = std::max(width, height); size > 1; size /= 2)
+  {
+    ++count;
+  }
+
+  return count;
+}
+
+TextureData decode_texture2d(const std::string &filepath, bool flip)
+{
+  FGE_PROFILE_SCOPE("decode_texture2d");
+
+  // Only touches the setting of the calling thread
+  stbi_set_flip_vertically_on_load_thread(flip);
+
+  int32_t        width, height, nr_channels;
+  unsigned char *data =
+      stbi_load(filepath.c_str(), &width, &height, &nr_channels, 0);
+
+  if (!data)
+  {
+    throw std::runtime_error("Could not load texture " + filepath);
+  }
+
+  TextureData texture{};
+  texture.name   = filepath;
+  texture.width  = static_cast<uint32_t>(width);
+  texture.height = static_cast<uint32_t>(height);
+
+  switch (nr_channels)
+  {
+  case 1:
+    texture.format = ImageFormat::Red;
+    break;
+  case 3:
+    texture.format = ImageFormat::Rgb;
+    break;
+  case 4:
+    texture.format = ImageFormat::Rgba;
+    break;
+  default:
+    stbi_image_free(data);
+    throw std::runtime_error("Texture has unsupported channel count " +
+                             filepath);
+  }
+
+  const auto size = texture.width * texture.height *
+                    get_channel_count(texture.format);
+  texture.pixels.assign(data, data + size);
+  texture.level_offsets.push_back(0);
+  stbi_image_free(data);
+
+  return texture;
+}
+
+void generate_mip_chain(TextureData &texture)
+{
+  FGE_PROFILE_SCOPE("generate_mip_chain");
+
+  FGE_ASSERT(texture.level_offsets.size() == 1);
+
+  const auto channels    = get_channel_count(texture.format);
+  const auto level_count = get_mip_level_count(texture.width, texture.height);
+
+  // Reserve everything up front, the source level must not move
+  std::size_t total_size = 0;
+  for (uint32_t level = 0; level < level_count; ++level)
+  {
+    total_size += static_cast<std::size_t>(
+                      std::max(texture.width >> level, 1u)) *
+                  std::max(texture.height >> level, 1u) * channels;
+  }
+  texture.pixels.reserve(total_size);
+
+  for (uint32_t level = 1; level < level_count; ++level)
+  {
+    const auto src_width  = std::max(texture.width >> (level - 1), 1u);
+    const auto src_height = std::max(texture.height >> (level - 1), 1u);
+    const auto width      = std::max(texture.width >> level, 1u);
+    const auto height     = std::max(texture.height >> level, 1u);
+
+    const auto src_offset = texture.level_offsets.back();
+    const auto offset     = texture.pixels.size();
+    texture.level_offsets.push_back(offset);
+    texture.pixels.resize(offset + static_cast<std::size_t>(width) * height *
+                                       channels);
+
+    const uint8_t *src = texture.pixels.data() + src_offset;
+    uint8_t *      dst = texture.pixels.data() + offset;
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+      const auto y0 = std::min(y * 2, src_height - 1);
+      const auto y1 = std::min(y * 2 + 1, src_height - 1);
+
+      for (uint32_t x = 0; x < width; ++x)
+      {
+        const auto x0 = std::min(x * 2, src_width - 1);
+        const auto x1 = std::min(x * 2 + 1, src_width - 1);
+
+        for (uint32_t c = 0; c < channels; ++c)
+        {
+          const auto texel = [&](uint32_t tx, uint32_t ty) {
+            return static_cast<uint32_t>(
+                src[(static_cast<std::size_t>(ty) * src_width + tx) *
+                        channels +
+                    c]);
+          };
+
+          const auto sum =
+              texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1);
+          dst[(static_cast<std::size_t>(y) * width + x) * channels + c] =
+              static_cast<uint8_t>((sum + 2) / 4);
+        }
+      }
+    }
+  }
+}
+
+TextureData load_texture2d_data(const std::string &filepath, bool flip)
+{
+  auto texture = decode_texture2d(filepath, flip);
+  generate_mip_chain(texture);
+
+  return texture;
+}
+
+} // namespace Fge
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "graphic/texture.hpp"
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Decoded texture with its mip chain, before anything got uploaded.
+ */
+struct TextureData
+{
+  std::string name;
+  uint32_t    width{};
+  uint32_t    height{};
+  ImageFormat format = ImageFormat::Rgb;
+
+  // Levels back to back without row padding, level 0 first
+  std::vector<uint8_t>     pixels;
+  std::vector<std::size_t> level_offsets;
+};
+
+uint32_t get_channel_count(ImageFormat format);
+
+/**
+ * @return Number of levels down to 1x1, including level 0
+ */
+uint32_t get_mip_level_count(uint32_t width, uint32_t height);
+
+/**
+ * Decodes level 0 of an image file. Can be called from several threads at
+ * once.
+ *
+ * @param flip Flips the image vertically, like OpenGL expects it
+ *
+ * @throws std::runtime_error If the file can't be decoded
+ */
+TextureData decode_texture2d(const std::string &filepath, bool flip);
+
+/**
+ * Adds all levels below level 0. Every texel of a level is the average of
+ * the 2x2 texels above it, texels past an odd edge get clamped.
+ */
+void generate_mip_chain(TextureData &texture);
+
+/**
+ * Decodes the image and generates its mip chain.
+ */
+TextureData load_texture2d_data(const std::string &filepath, bool flip);
+
+} // namespace Fge
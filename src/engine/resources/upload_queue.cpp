@@ -0,0 +1,74 @@
+#include "upload_queue.hpp"
+#include "profiler/profiler.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+void UploadQueue::push(Upload upload)
+{
+  FGE_ASSERT(upload);
+
+  std::lock_guard<std::mutex> lock(incoming_mutex);
+  incoming.push_back(std::move(upload));
+  count.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t UploadQueue::process(std::chrono::microseconds budget)
+{
+  FGE_PROFILE_SCOPE("UploadQueue::process");
+
+  using Clock      = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  {
+    std::lock_guard<std::mutex> lock(incoming_mutex);
+    for (auto &upload : incoming)
+    {
+      uploads.push_back(std::move(upload));
+    }
+    incoming.clear();
+  }
+
+  // Every upload gets called at most once per call, also waiting ones
+  std::size_t done      = 0;
+  std::size_t remaining = uploads.size();
+  while (remaining > 0)
+  {
+    auto upload = std::move(uploads.front());
+    uploads.pop_front();
+    --remaining;
+
+    if (upload())
+    {
+      ++done;
+      count.fetch_sub(1, std::memory_order_relaxed);
+    }
+    else
+    {
+      uploads.push_back(std::move(upload));
+    }
+
+    if (Clock::now() - start >= budget)
+    {
+      break;
+    }
+  }
+
+  return done;
+}
+
+void UploadQueue::clear()
+{
+  std::lock_guard<std::mutex> lock(incoming_mutex);
+  incoming.clear();
+  uploads.clear();
+  count = 0;
+}
+
+std::size_t UploadQueue::get_count() const
+{
+  return count.load(std::memory_order_relaxed);
+}
+
+} // namespace Fge
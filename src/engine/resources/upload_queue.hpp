@@ -0,0 +1,57 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Work that has to run on the GL thread, handed over from loader threads.
+ *
+ * An upload returns true once it is done. An upload that returns false waits
+ * for something else and gets called again by the next process call.
+ */
+class UploadQueue
+{
+public:
+  using Upload = std::function<bool()>;
+
+  /**
+   * Can be called from any thread.
+   */
+  void push(Upload upload);
+
+  /**
+   * Runs the queued uploads in order until the budget is used up. At least
+   * one upload runs per call, so a single slow upload can't stall the queue.
+   * Must always be called from the same thread.
+   *
+   * @return Number of uploads that are done
+   */
+  std::size_t process(std::chrono::microseconds budget);
+
+  /**
+   * Can be called from any thread.
+   *
+   * @return Number of uploads that are queued or waiting
+   */
+  std::size_t get_count() const;
+
+  /**
+   * Drops all uploads without running them. Must be called from the
+   * processing thread.
+   */
+  void clear();
+
+private:
+  std::mutex          incoming_mutex;
+  std::vector<Upload> incoming;
+
+  // Can be read from any thread, unlike uploads
+  std::atomic<std::size_t> count{0};
+
+  // Only touched by the processing thread
+  std::deque<Upload> uploads;
+};
+
+} // namespace Fge
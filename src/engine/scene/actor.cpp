@@ -1,5 +1,6 @@
 #include "actor.hpp"
 #include "component.hpp"
+#include "scene.hpp"
 #include "util/assert.hpp"
 
 namespace Fge
@@ -16,24 +17,22 @@ Actor::~Actor() { clear(); }
 
 void Actor::on_create()
 {
-  compute_world_transform();
+  update_local_transform();
 
-  for (auto component : components)
+  for (auto &component : components)
   {
     component->on_create();
   }
 
-  compute_world_transform();
+  update_local_transform();
 }
 
 void Actor::on_fixed_update(float frametime)
 {
   if (state == State::ACTIVE)
   {
-    update_components(frametime);
+    update_components_fixed(frametime);
     update_actor_fixed(frametime);
-
-    compute_world_transform();
   }
 }
 
@@ -43,8 +42,6 @@ void Actor::on_update(float delta_time)
   {
     update_components(delta_time);
     update_actor(delta_time);
-
-    compute_world_transform();
   }
 }
 
@@ -86,6 +83,12 @@ void Actor::remove_component(std::shared_ptr<Component> component)
   }
 }
 
+void Actor::attach_to_registry(Registry *registry, Entity entity)
+{
+  this->registry = registry;
+  this->entity   = entity;
+}
+
 void Actor::update_actor_fixed(float /*frametime*/) {}
 
 void Actor::update_actor(float /*delta_time*/) {}
@@ -97,10 +100,8 @@ void Actor::update_components_fixed(float frametime)
   const auto size = components.size();
   for (std::size_t i = 0; i < size; ++i)
   {
-    compute_world_transform();
     components[i]->on_fixed_update(frametime);
   }
-  compute_world_transform();
 }
 
 void Actor::update_components(float delta_time)
@@ -108,10 +109,8 @@ void Actor::update_components(float delta_time)
   const auto size = components.size();
   for (std::size_t i = 0; i < size; ++i)
   {
-    compute_world_transform();
     components[i]->on_update(delta_time);
   }
-  compute_world_transform();
 }
 
 void Actor::render_components()
@@ -129,18 +128,64 @@ void Actor::update_forward() { forward = glm::rotate(rotation, FORWARD_VEC); }
 
 void Actor::update_up() { up = glm::rotate(rotation, UP_VEC); }
 
-void Actor::compute_world_transform()
+void Actor::update_local_transform()
 {
-  if (!recompute_world_transform)
+  if (!local_transform_dirty)
   {
     return;
   }
 
-  recompute_world_transform = false;
+  local_transform_dirty = false;
+
+  local_transform = glm::translate(glm::mat4(1.0f), position);
+  local_transform *= glm::toMat4(rotation);
+  local_transform = glm::scale(local_transform, scale);
 
-  world_transform = glm::translate(glm::mat4(1.0f), position);
-  world_transform *= glm::toMat4(rotation);
-  world_transform = glm::scale(world_transform, scale);
+  if (transform_handle != TransformHierarchy::null_handle)
+  {
+    scene->get_transform_hierarchy().set_local_matrix(transform_handle,
+                                                      local_transform);
+    return;
+  }
+
+  // Without a scene there is no parent
+  apply_world_transform(local_transform);
+}
+
+void Actor::apply_world_transform(const glm::mat4 &world_transform)
+{
+  this->world_transform = world_transform;
+  world_bounds          = transform_aabb(local_bounds, world_transform);
+  ++transform_version;
+
+  if (scene)
+  {
+    scene->update_spatial_proxy(*this);
+  }
+}
+
+void Actor::set_local_bounds(const Aabb &local_bounds)
+{
+  this->local_bounds = local_bounds;
+  world_bounds       = transform_aabb(local_bounds, world_transform);
+
+  if (scene)
+  {
+    scene->update_spatial_proxy(*this);
+  }
+}
+
+void Actor::set_parent(Actor *parent)
+{
+  FGE_ASSERT(scene);
+  FGE_ASSERT(!parent || parent->get_scene() == scene);
+
+  scene->set_parent(*this, parent);
+}
+
+std::shared_ptr<Actor> Actor::get_parent() const
+{
+  return scene ? scene->get_parent(*this) : nullptr;
 }
 
 void Actor::clear()
@@ -153,21 +198,21 @@ void Actor::clear()
 
 void Actor::set_position(const glm::vec3 &position)
 {
-  this->position            = position;
-  recompute_world_transform = true;
+  this->position        = position;
+  local_transform_dirty = true;
 }
 
 void Actor::set_scale(const glm::vec3 &scale)
 {
-  this->scale               = scale;
-  recompute_world_transform = true;
+  this->scale           = scale;
+  local_transform_dirty = true;
 }
 
 void Actor::set_rotation(const glm::quat &rotation)
 {
-  this->rotation            = rotation;
-  rotation_euler            = glm::eulerAngles(this->rotation);
-  recompute_world_transform = true;
+  this->rotation        = rotation;
+  rotation_euler        = glm::eulerAngles(this->rotation);
+  local_transform_dirty = true;
 
   update_up();
   update_right();
@@ -176,9 +221,9 @@ void Actor::set_rotation(const glm::quat &rotation)
 
 void Actor::set_rotation_euler(const glm::vec3 &degrees)
 {
-  rotation_euler            = degrees;
-  this->rotation            = glm::quat(degrees);
-  recompute_world_transform = true;
+  rotation_euler        = degrees;
+  this->rotation        = glm::quat(degrees);
+  local_transform_dirty = true;
 
   update_up();
   update_right();
@@ -188,7 +233,7 @@ void Actor::set_rotation_euler(const glm::vec3 &degrees)
 std::shared_ptr<Component>
 Actor::find_component_by_type_name(const std::string &type_name)
 {
-  for (auto component : components)
+  for (auto &component : components)
   {
     if (component->type_name == type_name)
     {
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "component.hpp"
+#include "math/dynamic_aabb_tree.hpp"
 #include "math/math.hpp"
+#include "registry.hpp"
+#include "transform_hierarchy.hpp"
 #include "std.hpp"
+#include "util/assert.hpp"
 
 namespace Fge
 {
@@ -31,7 +35,9 @@ public:
 
   void on_render();
 
-  template <typename T> std::shared_ptr<T> add_component(int update_order)
+  template <typename T>
+  std::enable_if_t<std::is_base_of_v<Component, T>, std::shared_ptr<T>>
+  add_component(int update_order)
   {
     auto component = std::make_shared<T>(this, update_order);
 
@@ -40,7 +46,9 @@ public:
     return component;
   }
 
-  template <typename T> std::shared_ptr<T> add_component()
+  template <typename T>
+  std::enable_if_t<std::is_base_of_v<Component, T>, std::shared_ptr<T>>
+  add_component()
   {
     auto component = std::make_shared<T>(this);
 
@@ -49,14 +57,47 @@ public:
     return component;
   }
 
+  /**
+   * Adds a plain data component. It is not owned by the actor but stored
+   * densely in the registry of the scene, where systems can iterate it. The
+   * actor needs to be added to a scene first.
+   */
+  template <typename T, typename... TArgs>
+  std::enable_if_t<!std::is_base_of_v<Component, T>, T &>
+  add_component(TArgs &&... args)
+  {
+    FGE_ASSERT(registry);
+    return registry->emplace<T>(entity, std::forward<TArgs>(args)...);
+  }
+
+  template <typename T> T *get_component()
+  {
+    static_assert(!std::is_base_of_v<Component, T>,
+                  "Use find_component_by_type_name for actor components");
+    return registry ? registry->try_get<T>(entity) : nullptr;
+  }
+
+  template <typename T> bool has_component() const
+  {
+    return registry && registry->has<T>(entity);
+  }
+
+  template <typename T> void remove_component()
+  {
+    if (registry)
+    {
+      registry->remove<T>(entity);
+    }
+  }
+
   void add_component(std::shared_ptr<Component> component);
 
   void remove_component(std::shared_ptr<Component> component);
 
-  std::vector<std::shared_ptr<Component>> get_components()
+  const std::vector<std::shared_ptr<Component>> &get_components() const
   {
     return components;
-  };
+  }
 
   void set_position(const glm::vec3 &position);
 
@@ -80,10 +121,78 @@ public:
 
   State get_state() const { return state; }
 
+  /**
+   * Transform relative to the parent, made from position, rotation and
+   * scale.
+   */
+  const glm::mat4 &get_local_transform() const { return local_transform; }
+
+  /**
+   * World transform of the last transform update of the scene. It does not
+   * change while the actors of the scene get updated.
+   */
   const glm::mat4 &get_world_transform() const { return world_transform; }
 
+  /**
+   * Increases every time the world transform changes.
+   */
+  uint32_t get_transform_version() const { return transform_version; }
+
+  /**
+   * Position, rotation and scale become relative to the parent. Nullptr
+   * makes the actor a root again. Both actors need to be in the same scene.
+   */
+  void set_parent(Actor *parent);
+
+  std::shared_ptr<Actor> get_parent() const;
+
+  /**
+   * Recomputes the local transform if position, rotation or scale changed
+   * and passes it on to the transform hierarchy of the scene.
+   */
+  void update_local_transform();
+
+  /**
+   * Called by the scene with the new world transform.
+   */
+  void apply_world_transform(const glm::mat4 &world_transform);
+
+  void attach_to_transform_hierarchy(TransformHierarchy::Handle handle)
+  {
+    transform_handle = handle;
+  }
+
+  TransformHierarchy::Handle get_transform_handle() const
+  {
+    return transform_handle;
+  }
+
+  /**
+   * Box around the actor in its own space. Components with geometry set it,
+   * all other actors keep a unit box around their origin.
+   */
+  void set_local_bounds(const Aabb &local_bounds);
+
+  const Aabb &get_local_bounds() const { return local_bounds; }
+
+  /**
+   * Local bounds transformed by the world transform of the last update.
+   */
+  const Aabb &get_world_bounds() const { return world_bounds; }
+
+  void attach_to_spatial_index(int32_t spatial_proxy)
+  {
+    this->spatial_proxy = spatial_proxy;
+  }
+
+  int32_t get_spatial_proxy() const { return spatial_proxy; }
+
   std::size_t get_id() const { return id; }
 
+  Entity get_entity() const { return entity; }
+
+  void attach_to_registry(Registry *registry, Entity entity);
+
   const std::string &get_name() const { return name; }
 
   void set_name(const std::string &name) { this->name = name; }
@@ -101,6 +210,9 @@ protected:
   std::string name{};
   std::size_t id{};
 
+  Registry *registry{};
+  Entity    entity = null_entity;
+
   State state = State::ACTIVE;
 
   glm::vec3 position       = glm::vec3(0.0f);
@@ -112,8 +224,16 @@ protected:
   glm::vec3 forward = FORWARD_VEC;
   glm::vec3 right   = RIGHT_VEC;
 
-  bool      recompute_world_transform = true;
-  glm::mat4 world_transform           = glm::mat4(1.0f);
+  bool      local_transform_dirty = true;
+  glm::mat4 local_transform       = glm::mat4(1.0f);
+  glm::mat4 world_transform       = glm::mat4(1.0f);
+  uint32_t  transform_version     = 0;
+
+  TransformHierarchy::Handle transform_handle = TransformHierarchy::null_handle;
+
+  Aabb    local_bounds{glm::vec3(-0.5f), glm::vec3(0.5f)};
+  Aabb    world_bounds{glm::vec3(-0.5f), glm::vec3(0.5f)};
+  int32_t spatial_proxy = DynamicAabbTree::null_node;
 
   std::vector<std::shared_ptr<Component>> components{};
 
@@ -135,8 +255,6 @@ protected:
 
   void update_up();
 
-  void compute_world_transform();
-
   void clear();
 };
 
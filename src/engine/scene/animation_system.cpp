@@ -0,0 +1,53 @@
+#include "animation_system.hpp"
+#include "application.hpp"
+#include "graphic/skinned_mesh.hpp"
+#include "profiler/profiler.hpp"
+#include "util/time.hpp"
+
+namespace Fge
+{
+
+void AnimationSystem::operator()(Registry &registry, float /*delta_time*/)
+{
+  FGE_PROFILE_SCOPE("AnimationSystem::update");
+
+  auto &animated_meshes = registry.storage<AnimatedMeshes>().get_components();
+
+  batch.clear();
+  for (auto &animated_mesh : animated_meshes)
+  {
+    for (auto &mesh : animated_mesh.meshes)
+    {
+      batch.add(mesh->get_skeleton());
+    }
+  }
+
+  // One time for all skeletons, so they stay in sync
+  double current_time = static_cast<double>(get_current_time_millis());
+  current_time /= 1000;
+  auto app = Application::get_instance();
+  batch.evaluate(current_time, app->get_job_system());
+
+  // One upload for all skinned meshes. Sub meshes only reference the bones
+  // of their mesh.
+  app->get_graphic_manager()->get_renderer()->upload_bone_palette(
+      batch.get_packed_palette());
+
+  // Skeletons were added in this order
+  std::size_t index = 0;
+  for (auto &animated_mesh : animated_meshes)
+  {
+    for (auto &mesh : animated_mesh.meshes)
+    {
+      const auto first_bone = batch.get_first_bone(index);
+      ++index;
+
+      for (auto sub_mesh : mesh->get_sub_meshes())
+      {
+        sub_mesh->get_material()->set_first_bone(first_bone);
+      }
+    }
+  }
+}
+
+} // namespace Fge
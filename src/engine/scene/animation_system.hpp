@@ -0,0 +1,37 @@
+#pragma once
+
+#include "graphic/animation_batch.hpp"
+#include "registry.hpp"
+
+namespace Fge
+{
+
+class SkinnedMesh;
+
+/**
+ * Registry component that lists the skinned meshes of an actor. Their
+ * skeletons get animated by the animation system.
+ */
+struct AnimatedMeshes
+{
+  std::vector<std::shared_ptr<SkinnedMesh>> meshes{};
+};
+
+/**
+ * Scene system that animates all skinned meshes at once.
+ *
+ * Gathers the skeletons of all AnimatedMeshes components, evaluates them on
+ * the job system into one bone palette and uploads it once. Every material
+ * then gets the first bone of its mesh. Materials are only touched on the
+ * calling thread.
+ */
+class AnimationSystem
+{
+public:
+  void operator()(Registry &registry, float delta_time);
+
+private:
+  AnimationBatch batch;
+};
+
+} // namespace Fge
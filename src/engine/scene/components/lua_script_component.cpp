@@ -8,6 +8,7 @@
 #include "scene/actor.hpp"
 #include "scene/component.hpp"
 #include "scene/components/skinned_mesh_component.hpp"
+#include "scene/scene.hpp"
 #include "sol/raii.hpp"
 #include "sol/types.hpp"
 #include "util/time.hpp"
@@ -47,7 +48,9 @@ void LuaScriptComponent::update(float delta_time)
   if (!result.valid())
   {
     sol::error e = result;
-    warning("LuaScriptComponent", "Execution of update() failed: {}", e.what());
+    warning("LuaScriptComponent",
+            FMT_STRING("Execution of update() failed: {}"),
+            e.what());
   }
 }
 
@@ -186,7 +189,36 @@ void LuaScriptComponent::lua_bind_scene(sol::state &lua)
                               "get_right",
                               &Actor::get_right,
                               "find_component_by_type_name",
-                              &Actor::find_component_by_type_name);
+                              &Actor::find_component_by_type_name,
+                              "get_name",
+                              &Actor::get_name,
+                              "set_parent",
+                              &Actor::set_parent,
+                              "get_parent",
+                              &Actor::get_parent);
+
+  lua.new_usertype<Scene>(
+      "Scene",
+      sol::no_constructor,
+      "raycast",
+      [](Scene &          scene,
+         const glm::vec3 &origin,
+         const glm::vec3 &direction,
+         float            max_distance) {
+        Ray ray{};
+        ray.origin       = origin;
+        ray.direction    = glm::normalize(direction);
+        ray.max_distance = max_distance;
+        return scene.raycast(ray);
+      },
+      "find_actors_in_sphere",
+      [](Scene &scene, const glm::vec3 &center, float radius) {
+        return sol::as_table(scene.find_actors_in_sphere(center, radius));
+      },
+      "find_nearest_actors",
+      [](Scene &scene, const glm::vec3 &point, std::size_t count) {
+        return sol::as_table(scene.find_nearest_actors(point, count));
+      });
 
   lua.new_usertype<Component>("Component",
                               sol::no_constructor,
@@ -205,6 +237,7 @@ void LuaScriptComponent::lua_bind_scene(sol::state &lua)
   lua["cast_skinned_mesh_component"] = cast_component<SkinnedMeshComponent>;
 
   lua["owner"] = owner;
+  lua["scene"] = owner->get_scene();
 }
 
 void LuaScriptComponent::load_script()
@@ -214,7 +247,7 @@ void LuaScriptComponent::load_script()
     return;
   }
 
-  trace("LuaScriptComponent", "Load script: {}", script_filepath);
+  trace("LuaScriptComponent", FMT_STRING("Load script: {}"), script_filepath);
 
   auto app          = Application::get_instance();
   auto file_manager = app->get_file_manager();
@@ -233,7 +266,7 @@ void LuaScriptComponent::load_script()
   }
   catch (std::exception &e)
   {
-    warning("LuaScriptComponent", "Script failed: {}", e.what());
+    warning("LuaScriptComponent", FMT_STRING("Script failed: {}"), e.what());
   }
 
   script_loaded = true;
@@ -22,13 +22,7 @@ void MeshComponent::set_mesh_from_file(const std::string &filepath)
   mesh_filepath = filepath;
 
   load_mesh();
-
-  if (component_created)
-  {
-    unregister_render_infos();
-    create_render_infos();
-    register_render_infos();
-  }
+  adopt_loaded_mesh();
 }
 
 void MeshComponent::create()
@@ -36,26 +30,36 @@ void MeshComponent::create()
   component_created = true;
   create_render_infos();
   register_render_infos();
-
-  const auto &world_mat = owner->get_world_transform();
-  for (auto sub_mesh : mesh->get_sub_meshes())
-  {
-    sub_mesh->get_material()->set_uniform("world_mat", world_mat);
-  }
+  sync_world_matrix();
 }
 
-void MeshComponent::update(float /*delta_time*/)
+void MeshComponent::update(float /*delta_time*/) { adopt_loaded_mesh(); }
+
+void MeshComponent::render() { sync_world_matrix(); }
+
+void MeshComponent::sync_world_matrix()
 {
   FGE_ASSERT(owner);
-  const auto &world_mat = owner->get_world_transform();
 
+  // Only actors that moved since the last frame cost anything here
+  const auto transform_version = owner->get_transform_version();
+  if (!mesh || synced_transform_version == transform_version)
+  {
+    return;
+  }
+  synced_transform_version = transform_version;
+
+  const auto &world_mat = owner->get_world_transform();
   for (auto sub_mesh : mesh->get_sub_meshes())
   {
-    sub_mesh->get_material()->set_uniform("world_mat", world_mat);
+    sub_mesh->get_material()->set_world_matrix(world_mat);
   }
-}
 
-void MeshComponent::render() {}
+  for (auto render_info : render_infos)
+  {
+    render_info->set_world_matrix(world_mat);
+  }
+}
 
 void MeshComponent::create_render_infos()
 {
@@ -64,21 +68,33 @@ void MeshComponent::create_render_infos()
     return;
   }
 
-  trace("MeshComponent", "Create render infos");
+  trace("MeshComponent", FMT_STRING("Create render infos"));
 
   render_infos.clear();
+  synced_transform_version.reset();
 
+  Aabb mesh_bounds{};
   for (auto sub_mesh : mesh->get_sub_meshes())
   {
     auto render_info =
         std::make_shared<RenderInfo>(sub_mesh->get_vertex_array(),
                                      sub_mesh->get_index_buffer(),
                                      sub_mesh->get_material());
+    render_info->set_local_bounds(sub_mesh->get_bounds());
+    render_info->set_lods(sub_mesh->get_lods());
+    mesh_bounds = merge(mesh_bounds, sub_mesh->get_bounds().aabb);
 
     render_infos.push_back(render_info);
   }
 
-  trace("MeshComponent", "Created {} render infos", render_infos.size());
+  if (!mesh_bounds.is_empty())
+  {
+    owner->set_local_bounds(mesh_bounds);
+  }
+
+  trace("MeshComponent",
+        FMT_STRING("Created {} render infos"),
+        render_infos.size());
 }
 
 void MeshComponent::load_mesh()
@@ -88,25 +104,48 @@ void MeshComponent::load_mesh()
     return;
   }
 
-  trace("MeshComponent", "Load mesh");
+  trace("MeshComponent", FMT_STRING("Load mesh"));
 
   auto app         = Application::get_instance();
   auto res_manager = app->get_resource_manager();
 
-  try
+  loading_mesh = res_manager->load_mesh_async(mesh_filepath);
+}
+
+void MeshComponent::adopt_loaded_mesh()
+{
+  if (!loading_mesh.is_valid() || loading_mesh.is_loading())
   {
-    auto mesh  = res_manager->load_mesh(mesh_filepath);
-    this->mesh = mesh;
+    return;
   }
-  catch (std::runtime_error &error)
+
+  if (loading_mesh.has_failed())
   {
-    warning("MeshComponent", "Could not load mesh: {}", error.what());
+    warning("MeshComponent",
+            FMT_STRING("Could not load mesh: {}"),
+            loading_mesh.get_error());
+    loading_mesh = {};
+    return;
+  }
+
+  if (component_created)
+  {
+    unregister_render_infos();
+  }
+
+  mesh         = loading_mesh.get();
+  loading_mesh = {};
+
+  if (component_created)
+  {
+    create_render_infos();
+    register_render_infos();
   }
 }
 
 void MeshComponent::register_render_infos()
 {
-  trace("MeshComponent", "Register render infos");
+  trace("MeshComponent", FMT_STRING("Register render infos"));
 
   auto app             = Application::get_instance();
   auto graphic_manager = app->get_graphic_manager();
@@ -114,14 +153,14 @@ void MeshComponent::register_render_infos()
 
   for (auto render_info : render_infos)
   {
-    trace("MeshComponent", "Register render info");
+    trace("MeshComponent", FMT_STRING("Register render info"));
     renderer->register_renderable(render_info);
   }
 }
 
 void MeshComponent::unregister_render_infos()
 {
-  trace("MeshComponent", "Unregister render infos");
+  trace("MeshComponent", FMT_STRING("Unregister render infos"));
 
   auto app             = Application::get_instance();
   auto graphic_manager = app->get_graphic_manager();
@@ -129,7 +168,7 @@ void MeshComponent::unregister_render_infos()
 
   for (auto render_info : render_infos)
   {
-    trace("MeshComponent", "Unregister render info");
+    trace("MeshComponent", FMT_STRING("Unregister render info"));
     renderer->unregister_renderable(render_info);
   }
 }
@@ -2,6 +2,7 @@
 
 #include "graphic/mesh.hpp"
 #include "graphic/render_info.hpp"
+#include "resources/resource_handle.hpp"
 #include "scene/component.hpp"
 
 namespace Fge
@@ -16,6 +17,10 @@ public:
 
   ~MeshComponent();
 
+  /**
+   * Loads the mesh in the background. The render infos get registered once
+   * it is loaded, until then the previous mesh stays.
+   */
   void set_mesh_from_file(const std::string &filepath);
 
   const std::string &get_mesh_filepath() const { return mesh_filepath; }
@@ -34,12 +39,27 @@ private:
 
   std::shared_ptr<Mesh> mesh{};
 
+  ResourceHandle<Mesh> loading_mesh{};
+
   std::vector<std::shared_ptr<RenderInfo>> render_infos{};
 
+  std::optional<uint32_t> synced_transform_version{};
+
   void create_render_infos();
 
+  /**
+   * Passes the world transform of the owner on to materials and render
+   * infos, if it changed since the last call.
+   */
+  void sync_world_matrix();
+
   void load_mesh();
 
+  /**
+   * Switches to the loading mesh once it is ready.
+   */
+  void adopt_loaded_mesh();
+
   void register_render_infos();
 
   void unregister_render_infos();
@@ -18,6 +18,14 @@ void RigidBodyComponent::create()
   create_rigid_body();
 }
 
+void RigidBodyComponent::fixed_update(float /*frametime*/)
+{
+  if (rigid_body)
+  {
+    store_previous_pose();
+  }
+}
+
 void RigidBodyComponent::update(float /*delta_time*/)
 {
   if (!rigid_body)
@@ -25,13 +33,24 @@ void RigidBodyComponent::update(float /*delta_time*/)
     return;
   }
 
-  const auto position = rigid_body->get_position();
-  const auto rotation = rigid_body->get_rotation();
+  // The physics step ran after fixed_update, so the body is one tick ahead
+  // of the stored pose
+  const auto alpha = Application::get_instance()->get_interpolation_alpha();
+  const auto position =
+      glm::mix(previous_position, rigid_body->get_position(), alpha);
+  const auto rotation = glm::normalize(
+      glm::slerp(previous_rotation, rigid_body->get_rotation(), alpha));
 
   owner->set_position(position);
   owner->set_rotation(rotation);
 }
 
+void RigidBodyComponent::store_previous_pose()
+{
+  previous_position = rigid_body->get_position();
+  previous_rotation = rigid_body->get_rotation();
+}
+
 void RigidBodyComponent::render() {}
 
 void RigidBodyComponent::set_collision_shape(
@@ -81,6 +100,7 @@ void RigidBodyComponent::create_rigid_body()
 
   rigid_body =
       physic_world->create_rigid_body(mass, collision_shape, world_transform);
+  store_previous_pose();
 }
 
 } // namespace Fge
@@ -23,6 +23,15 @@ protected:
 
   void create() override;
 
+  /**
+   * Remembers the pose before the physics step of the tick.
+   */
+  void fixed_update(float frametime) override;
+
+  /**
+   * Moves the owner between the poses before and after the last physics
+   * step, by the interpolation alpha of the application.
+   */
   void update(float delta_time) override;
 
   void render() override;
@@ -35,6 +44,11 @@ private:
   bool created = false;
 
   std::shared_ptr<RigidBody> rigid_body{};
+
+  glm::vec3 previous_position{};
+  glm::quat previous_rotation{};
+
+  void store_previous_pose();
 };
 
 } // namespace Fge
@@ -2,6 +2,7 @@
 #include "application.hpp"
 #include "graphic/render_info.hpp"
 #include "log/log.hpp"
+#include "scene/animation_system.hpp"
 #include "scene/actor.hpp"
 #include "util/assert.hpp"
 
@@ -15,35 +16,50 @@ SkinnedMeshComponent::SkinnedMeshComponent(Actor *            owner,
 {
 }
 
-SkinnedMeshComponent::~SkinnedMeshComponent() { unregister_render_infos(); }
+SkinnedMeshComponent::~SkinnedMeshComponent()
+{
+  unregister_render_infos();
+  unregister_animation();
+}
 
 void SkinnedMeshComponent::set_mesh_from_file(const std::string &filepath)
 {
   mesh_filepath = filepath;
 
   load_mesh();
-
-  if (component_created)
-  {
-    unregister_render_infos();
-    create_render_infos();
-    register_render_infos();
-  }
+  adopt_loaded_mesh();
 }
 
 void SkinnedMeshComponent::play_animation(const std::string &name)
 {
+  if (!mesh || loading_mesh.is_valid())
+  {
+    pending_animation = PendingAnimation{name, false};
+    return;
+  }
+
   mesh->play_animation(name);
 }
 
 void SkinnedMeshComponent::play_animation_endless(const std::string &name)
 {
+  if (!mesh || loading_mesh.is_valid())
+  {
+    pending_animation = PendingAnimation{name, true};
+    return;
+  }
+
   mesh->play_animation_endless(name);
 }
 
 void SkinnedMeshComponent::stop_current_animation()
 {
-  mesh->stop_current_animation();
+  pending_animation.reset();
+
+  if (mesh)
+  {
+    mesh->stop_current_animation();
+  }
 }
 
 void SkinnedMeshComponent::create()
@@ -51,29 +67,40 @@ void SkinnedMeshComponent::create()
   component_created = true;
   create_render_infos();
   register_render_infos();
-
-  const auto &world_mat = owner->get_world_transform();
-  for (auto sub_mesh : mesh->get_sub_meshes())
-  {
-    sub_mesh->get_material()->set_uniform("world_mat", world_mat);
-  }
+  register_animation();
+  sync_world_matrix();
 }
 
 void SkinnedMeshComponent::update(float /*delta_time*/)
+{
+  adopt_loaded_mesh();
+}
+
+void SkinnedMeshComponent::render() { sync_world_matrix(); }
+
+void SkinnedMeshComponent::sync_world_matrix()
 {
   FGE_ASSERT(owner);
-  const auto &world_mat = owner->get_world_transform();
 
-  const auto &bone_transforms = mesh->compute_bone_transforms();
+  // Only actors that moved since the last frame cost anything here
+  const auto transform_version = owner->get_transform_version();
+  if (!mesh || synced_transform_version == transform_version)
+  {
+    return;
+  }
+  synced_transform_version = transform_version;
 
+  const auto &world_mat = owner->get_world_transform();
   for (auto sub_mesh : mesh->get_sub_meshes())
   {
     sub_mesh->get_material()->set_world_matrix(world_mat);
-    sub_mesh->get_material()->set_bone_transforms(bone_transforms);
   }
-}
 
-void SkinnedMeshComponent::render() {}
+  for (auto render_info : render_infos)
+  {
+    render_info->set_world_matrix(world_mat);
+  }
+}
 
 void SkinnedMeshComponent::create_render_infos()
 {
@@ -82,21 +109,33 @@ void SkinnedMeshComponent::create_render_infos()
     return;
   }
 
-  trace("SkinnedMeshComponent", "Create render infos");
+  trace("SkinnedMeshComponent", FMT_STRING("Create render infos"));
 
   render_infos.clear();
+  synced_transform_version.reset();
 
+  Aabb mesh_bounds{};
   for (auto sub_mesh : mesh->get_sub_meshes())
   {
     auto render_info =
         std::make_shared<RenderInfo>(sub_mesh->get_vertex_array(),
                                      sub_mesh->get_index_buffer(),
                                      sub_mesh->get_material());
+    render_info->set_local_bounds(sub_mesh->get_bounds());
+    render_info->set_lods(sub_mesh->get_lods());
+    mesh_bounds = merge(mesh_bounds, sub_mesh->get_bounds().aabb);
 
     render_infos.push_back(render_info);
   }
 
-  trace("SkinnedMeshComponent", "Created {} render infos", render_infos.size());
+  if (!mesh_bounds.is_empty())
+  {
+    owner->set_local_bounds(mesh_bounds);
+  }
+
+  trace("SkinnedMeshComponent",
+        FMT_STRING("Created {} render infos"),
+        render_infos.size());
 }
 
 void SkinnedMeshComponent::load_mesh()
@@ -106,25 +145,63 @@ void SkinnedMeshComponent::load_mesh()
     return;
   }
 
-  trace("SkinnedMeshComponent", "Load mesh");
+  trace("SkinnedMeshComponent", FMT_STRING("Load mesh"));
 
   auto app         = Application::get_instance();
   auto res_manager = app->get_resource_manager();
 
-  try
+  loading_mesh = res_manager->load_skinned_mesh_async(mesh_filepath);
+}
+
+void SkinnedMeshComponent::adopt_loaded_mesh()
+{
+  if (!loading_mesh.is_valid() || loading_mesh.is_loading())
+  {
+    return;
+  }
+
+  if (loading_mesh.has_failed())
+  {
+    warning("SkinnedMeshComponent",
+            FMT_STRING("Could not load mesh: {}"),
+            loading_mesh.get_error());
+    loading_mesh = {};
+    return;
+  }
+
+  if (component_created)
+  {
+    unregister_animation();
+    unregister_render_infos();
+  }
+
+  mesh         = loading_mesh.get();
+  loading_mesh = {};
+
+  if (component_created)
   {
-    auto mesh  = res_manager->load_skinned_mesh(mesh_filepath);
-    this->mesh = mesh;
+    create_render_infos();
+    register_render_infos();
+    register_animation();
   }
-  catch (std::runtime_error &error)
+
+  if (pending_animation)
   {
-    warning("SkinnedMeshComponent", "Could not load mesh: {}", error.what());
+    if (pending_animation->endless)
+    {
+      mesh->play_animation_endless(pending_animation->name);
+    }
+    else
+    {
+      mesh->play_animation(pending_animation->name);
+    }
+    pending_animation.reset();
   }
 }
 
 void SkinnedMeshComponent::register_render_infos()
 {
-  trace("SkinnedMeshComponent", "Register render infos");
+  trace("SkinnedMeshComponent", FMT_STRING("Register render infos"));
 
   auto app             = Application::get_instance();
   auto graphic_manager = app->get_graphic_manager();
@@ -132,14 +209,14 @@ void SkinnedMeshComponent::register_render_infos()
 
   for (auto render_info : render_infos)
   {
-    trace("SkinnedMeshComponent", "Register render info");
+    trace("SkinnedMeshComponent", FMT_STRING("Register render info"));
     renderer->register_renderable(render_info);
   }
 }
 
 void SkinnedMeshComponent::unregister_render_infos()
 {
-  trace("SkinnedMeshComponent", "Unregister render infos");
+  trace("SkinnedMeshComponent", FMT_STRING("Unregister render infos"));
 
   auto app             = Application::get_instance();
   auto graphic_manager = app->get_graphic_manager();
@@ -147,9 +224,46 @@ void SkinnedMeshComponent::unregister_render_infos()
 
   for (auto render_info : render_infos)
   {
-    trace("SkinnedMeshComponent", "Unregister render info");
+    trace("SkinnedMeshComponent", FMT_STRING("Unregister render info"));
     renderer->unregister_renderable(render_info);
   }
 }
 
+void SkinnedMeshComponent::register_animation()
+{
+  FGE_ASSERT(owner);
+
+  if (!mesh)
+  {
+    return;
+  }
+
+  auto animated_meshes = owner->get_component<AnimatedMeshes>();
+  if (!animated_meshes)
+  {
+    animated_meshes = &owner->add_component<AnimatedMeshes>();
+  }
+  animated_meshes->meshes.push_back(mesh);
+}
+
+void SkinnedMeshComponent::unregister_animation()
+{
+  FGE_ASSERT(owner);
+
+  // The registry is gone if the actor got removed from the scene
+  auto animated_meshes = owner->get_component<AnimatedMeshes>();
+  if (!animated_meshes)
+  {
+    return;
+  }
+
+  auto &meshes = animated_meshes->meshes;
+  meshes.erase(std::remove(meshes.begin(), meshes.end(), mesh), meshes.end());
+
+  if (meshes.empty())
+  {
+    owner->remove_component<AnimatedMeshes>();
+  }
+}
+
 } // namespace Fge
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "graphic/render_info.hpp"
+#include "resources/resource_handle.hpp"
 #include "graphic/skinned_mesh.hpp"
 #include "scene/component.hpp"
 
@@ -19,6 +20,10 @@ public:
 
   ~SkinnedMeshComponent();
 
+  /**
+   * Loads the mesh in the background. The render infos get registered once
+   * it is loaded, until then the previous mesh stays.
+   */
   void set_mesh_from_file(const std::string &filepath);
 
   const std::string &get_mesh_filepath() const { return mesh_filepath; }
@@ -43,15 +48,47 @@ private:
 
   std::shared_ptr<SkinnedMesh> mesh{};
 
+  ResourceHandle<SkinnedMesh> loading_mesh{};
+
+  struct PendingAnimation
+  {
+    std::string name;
+    bool        endless = false;
+  };
+
+  // Requested before the mesh was loaded
+  std::optional<PendingAnimation> pending_animation{};
+
   std::vector<std::shared_ptr<RenderInfo>> render_infos{};
 
+  std::optional<uint32_t> synced_transform_version{};
+
   void create_render_infos();
 
+  /**
+   * Passes the world transform of the owner on to materials and render
+   * infos, if it changed since the last call.
+   */
+  void sync_world_matrix();
+
   void load_mesh();
 
+  /**
+   * Switches to the loading mesh once it is ready.
+   */
+  void adopt_loaded_mesh();
+
   void register_render_infos();
 
   void unregister_render_infos();
+
+  /**
+   * Lists the mesh in the AnimatedMeshes component of the owner, so the
+   * animation system picks it up.
+   */
+  void register_animation();
+
+  void unregister_animation();
 };
 
 } // namespace Fge
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "std.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+/**
+ * Stable handle to an entity in a Registry.
+ *
+ * The index addresses the sparse arrays, the generation is bumped every time
+ * an index gets recycled so stale handles can be detected.
+ */
+struct Entity
+{
+  uint32_t index      = std::numeric_limits<uint32_t>::max();
+  uint32_t generation = 0;
+
+  bool operator==(const Entity &other) const
+  {
+    return index == other.index && generation == other.generation;
+  }
+
+  bool operator!=(const Entity &other) const { return !(*this == other); }
+};
+
+const Entity null_entity{};
+
+class SparseSetBase
+{
+public:
+  virtual ~SparseSetBase() = default;
+
+  virtual bool contains(Entity entity) const = 0;
+
+  virtual void remove(Entity entity) = 0;
+
+  virtual std::size_t size() const = 0;
+};
+
+/**
+ * Stores components of one type densely packed.
+ *
+ * The sparse array maps entity indices to positions in the dense arrays.
+ * Removing swaps the last element into the hole so the dense arrays never
+ * contain gaps. References to components are therefore only valid until the
+ * next insertion or removal of a component of the same type.
+ */
+template <typename T> class SparseSet : public SparseSetBase
+{
+public:
+  template <typename... TArgs> T &emplace(Entity entity, TArgs &&... args)
+  {
+    FGE_ASSERT(!contains(entity));
+
+    if (entity.index >= sparse.size())
+    {
+      sparse.resize(entity.index + 1, invalid_index);
+    }
+
+    sparse[entity.index] = static_cast<uint32_t>(dense_entities.size());
+    dense_entities.push_back(entity);
+    if constexpr (std::is_constructible_v<T, TArgs...>)
+    {
+      dense_components.emplace_back(std::forward<TArgs>(args)...);
+    }
+    else
+    {
+      // Plain aggregates have no constructor emplace_back could call
+      dense_components.push_back(T{std::forward<TArgs>(args)...});
+    }
+
+    return dense_components.back();
+  }
+
+  bool contains(Entity entity) const override
+  {
+    if (entity.index >= sparse.size())
+    {
+      return false;
+    }
+
+    const auto dense_index = sparse[entity.index];
+    return dense_index != invalid_index &&
+           dense_entities[dense_index] == entity;
+  }
+
+  void remove(Entity entity) override
+  {
+    if (!contains(entity))
+    {
+      return;
+    }
+
+    const auto dense_index = sparse[entity.index];
+    const auto last_index  = dense_entities.size() - 1;
+
+    if (dense_index != last_index)
+    {
+      dense_entities[dense_index]   = dense_entities[last_index];
+      dense_components[dense_index] = std::move(dense_components[last_index]);
+      sparse[dense_entities[dense_index].index] = dense_index;
+    }
+
+    dense_entities.pop_back();
+    dense_components.pop_back();
+    sparse[entity.index] = invalid_index;
+  }
+
+  T &get(Entity entity)
+  {
+    FGE_ASSERT(contains(entity));
+    return dense_components[sparse[entity.index]];
+  }
+
+  const T &get(Entity entity) const
+  {
+    FGE_ASSERT(contains(entity));
+    return dense_components[sparse[entity.index]];
+  }
+
+  T *try_get(Entity entity)
+  {
+    return contains(entity) ? &dense_components[sparse[entity.index]]
+                            : nullptr;
+  }
+
+  std::size_t size() const override { return dense_components.size(); }
+
+  std::vector<T> &get_components() { return dense_components; }
+
+  const std::vector<Entity> &get_entities() const { return dense_entities; }
+
+private:
+  static constexpr uint32_t invalid_index =
+      std::numeric_limits<uint32_t>::max();
+
+  std::vector<uint32_t> sparse;
+  std::vector<Entity>   dense_entities;
+  std::vector<T>        dense_components;
+};
+
+/**
+ * Entity registry with one SparseSet per component type.
+ *
+ * Systems iterate the dense arrays directly via each(), which walks the
+ * storage of the first component type and skips entities that miss one of
+ * the other requested types.
+ */
+class Registry
+{
+public:
+  Entity create()
+  {
+    if (!free_indices.empty())
+    {
+      const auto index = free_indices.back();
+      free_indices.pop_back();
+      return Entity{index, generations[index]};
+    }
+
+    generations.push_back(0);
+    return Entity{static_cast<uint32_t>(generations.size() - 1), 0};
+  }
+
+  void destroy(Entity entity)
+  {
+    if (!valid(entity))
+    {
+      return;
+    }
+
+    for (auto &[type, storage] : storages)
+    {
+      storage->remove(entity);
+    }
+
+    ++generations[entity.index];
+    free_indices.push_back(entity.index);
+  }
+
+  bool valid(Entity entity) const
+  {
+    return entity.index < generations.size() &&
+           generations[entity.index] == entity.generation;
+  }
+
+  template <typename T, typename... TArgs>
+  T &emplace(Entity entity, TArgs &&... args)
+  {
+    FGE_ASSERT(valid(entity));
+    return storage<T>().emplace(entity, std::forward<TArgs>(args)...);
+  }
+
+  template <typename T> void remove(Entity entity)
+  {
+    storage<T>().remove(entity);
+  }
+
+  template <typename T> bool has(Entity entity) const
+  {
+    auto iter = storages.find(typeid(T));
+    if (iter == storages.end())
+    {
+      return false;
+    }
+    return iter->second->contains(entity);
+  }
+
+  template <typename T> T &get(Entity entity)
+  {
+    return storage<T>().get(entity);
+  }
+
+  template <typename T> T *try_get(Entity entity)
+  {
+    auto iter = storages.find(typeid(T));
+    if (iter == storages.end())
+    {
+      return nullptr;
+    }
+    return static_cast<SparseSet<T> *>(iter->second.get())->try_get(entity);
+  }
+
+  template <typename T> SparseSet<T> &storage()
+  {
+    auto &base = storages[typeid(T)];
+    if (!base)
+    {
+      base = std::make_unique<SparseSet<T>>();
+    }
+    return *static_cast<SparseSet<T> *>(base.get());
+  }
+
+  /**
+   * Calls function(entity, T &, TOthers &...) for every entity that has all
+   * requested components. The callback must not add or remove components of
+   * the iterated types.
+   */
+  template <typename T, typename... TOthers, typename TFunction>
+  void each(TFunction function)
+  {
+    auto &      set        = storage<T>();
+    auto &      components = set.get_components();
+    const auto &entities   = set.get_entities();
+
+    for (std::size_t i = 0; i < components.size(); ++i)
+    {
+      const auto entity = entities[i];
+      if ((storage<TOthers>().contains(entity) && ...))
+      {
+        function(entity, components[i], storage<TOthers>().get(entity)...);
+      }
+    }
+  }
+
+  std::size_t get_alive_count() const
+  {
+    return generations.size() - free_indices.size();
+  }
+
+private:
+  std::vector<uint32_t> generations;
+  std::vector<uint32_t> free_indices;
+
+  std::unordered_map<std::type_index, std::unique_ptr<SparseSetBase>> storages;
+};
+
+} // namespace Fge
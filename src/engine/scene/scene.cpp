@@ -1,115 +1,90 @@
 #include "scene.hpp"
+#include "animation_system.hpp"
+#include "profiler/profiler.hpp"
 #include "util/assert.hpp"
 
 namespace Fge
 {
 
+Scene::Scene() { add_system(AnimationSystem{}); }
+
 Scene::~Scene() { clear(); }
 
 void Scene::on_create()
 {
+  // Components may read the world transform of their actor on create
+  update_transforms();
+
   updating_actors = true;
-  for (auto actor : actors)
+  for (auto &actor : actors)
   {
     actor->on_create();
   }
   updating_actors = false;
 
-  // Move pending actors to actors
-  for (auto pending_actor : pending_actors)
-  {
-    actors.emplace_back(pending_actor);
-  }
-  pending_actors.clear();
-
-  // Add any dead actors to temp vector
-  std::vector<std::shared_ptr<Actor>> dead_actors;
-  for (auto actor : actors)
-  {
-    if (actor->get_state() == Actor::State::DEAD)
-    {
-      dead_actors.emplace_back(actor);
-    }
-  }
-
-  // Remove dead actors
-  for (auto actor : dead_actors)
-  {
-    remove_actor(actor);
-  }
+  activate_pending_actors();
+  remove_dead_actors();
+  update_transforms();
 }
 
 void Scene::on_fixed_update(float frametime)
 {
+  FGE_PROFILE_SCOPE("Scene::on_fixed_update");
+
   updating_actors = true;
-  for (auto actor : actors)
+  // Actors added while updating land in pending_actors, so the dense array
+  // does not grow during the loop
+  auto &     actor_refs = registry.storage<ActorRef>().get_components();
+  const auto count      = actor_refs.size();
+  for (std::size_t i = 0; i < count; ++i)
   {
-    actor->on_fixed_update(frametime);
+    actor_refs[i].actor->on_fixed_update(frametime);
   }
   updating_actors = false;
 
-  // Move pending actors to actors
-  for (auto pending_actor : pending_actors)
+  for (auto &system : fixed_systems)
   {
-    actors.emplace_back(pending_actor);
-  }
-  pending_actors.clear();
-
-  // Add any dead actors to temp vector
-  std::vector<std::shared_ptr<Actor>> dead_actors;
-  for (auto actor : actors)
-  {
-    if (actor->get_state() == Actor::State::DEAD)
-    {
-      dead_actors.emplace_back(actor);
-    }
+    system(registry, frametime);
   }
 
-  // Remove dead actors
-  for (auto actor : dead_actors)
-  {
-    remove_actor(actor);
-  }
+  activate_pending_actors();
+  remove_dead_actors();
+  update_transforms();
 }
 
 void Scene::on_update(float delta_time)
 {
+  FGE_PROFILE_SCOPE("Scene::on_update");
+
   updating_actors = true;
-  for (auto actor : actors)
+  auto &     actor_refs = registry.storage<ActorRef>().get_components();
+  const auto count      = actor_refs.size();
+  for (std::size_t i = 0; i < count; ++i)
   {
-    actor->on_update(delta_time);
+    actor_refs[i].actor->on_update(delta_time);
   }
   updating_actors = false;
 
-  // Move pending actors to actors
-  for (auto pending_actor : pending_actors)
-  {
-    actors.emplace_back(pending_actor);
-  }
-  pending_actors.clear();
-
-  // Add any dead actors to temp vector
-  std::vector<std::shared_ptr<Actor>> dead_actors;
-  for (auto actor : actors)
   {
-    if (actor->get_state() == Actor::State::DEAD)
+    FGE_PROFILE_SCOPE("Scene::systems");
+    for (auto &system : systems)
     {
-      dead_actors.emplace_back(actor);
+      system(registry, delta_time);
     }
   }
 
-  // Remove dead actors
-  for (auto actor : dead_actors)
-  {
-    remove_actor(actor);
-  }
+  activate_pending_actors();
+  remove_dead_actors();
+  update_transforms();
 }
 
 void Scene::on_render()
 {
-  for (auto actor : actors)
+  auto &     actor_refs = registry.storage<ActorRef>().get_components();
+  const auto count      = actor_refs.size();
+  for (std::size_t i = 0; i < count; ++i)
   {
-    actor->on_render();
+    actor_refs[i].actor->on_render();
   }
 }
 
@@ -125,6 +100,14 @@ void Scene::add_actor(std::shared_ptr<Actor> actor)
   }
   ids_to_actors_map[actor->get_id()] = actor;
 
+  // The entity exists right away so data components can be added before the
+  // actor becomes active
+  actor->attach_to_registry(&registry, registry.create());
+  actor->attach_to_spatial_index(
+      spatial_index.create_proxy(actor->get_world_bounds(), actor->get_id()));
+  actor->attach_to_transform_hierarchy(
+      transform_hierarchy.create(actor->get_id()));
+
   if (updating_actors)
   {
     pending_actors.emplace_back(actor);
@@ -132,35 +115,48 @@ void Scene::add_actor(std::shared_ptr<Actor> actor)
   }
 
   actors.emplace_back(actor);
+  registry.emplace<ActorRef>(actor->get_entity(), actor.get());
 }
 
 void Scene::remove_actor(std::shared_ptr<Actor> actor)
 {
-  std::size_t actor_id{};
+  if (!actor)
+  {
+    return;
+  }
 
   // Is it in pending actors?
   auto iter = std::find(pending_actors.begin(), pending_actors.end(), actor);
   if (iter != pending_actors.end())
   {
-    actor_id = (*iter)->get_id();
     // Swap to end of vector and pop off (avoid erase copies)
     std::iter_swap(iter, pending_actors.end() - 1);
     pending_actors.pop_back();
-    return;
   }
-
-  // Is it in actors?
-  iter = std::find(actors.begin(), actors.end(), actor);
-  if (iter != actors.end())
+  else
   {
-    actor_id = (*iter)->get_id();
+    // Is it in actors?
+    iter = std::find(actors.begin(), actors.end(), actor);
+    if (iter == actors.end())
+    {
+      return;
+    }
+
     // Swap to end of vector and pop off (avoid erase copies)
     std::iter_swap(iter, actors.end() - 1);
     actors.pop_back();
-    return;
   }
 
-  ids_to_actors_map.erase(actor_id);
+  registry.destroy(actor->get_entity());
+  actor->attach_to_registry(nullptr, null_entity);
+
+  spatial_index.destroy_proxy(actor->get_spatial_proxy());
+  actor->attach_to_spatial_index(DynamicAabbTree::null_node);
+
+  transform_hierarchy.destroy(actor->get_transform_handle());
+  actor->attach_to_transform_hierarchy(TransformHierarchy::null_handle);
+
+  ids_to_actors_map.erase(actor->get_id());
 }
 
 std::size_t Scene::generate_actor_id()
@@ -175,11 +171,202 @@ std::size_t Scene::generate_actor_id()
   return actor_id_count;
 }
 
+std::shared_ptr<Actor> Scene::get_actor(std::size_t id)
+{
+  const auto iter = ids_to_actors_map.find(id);
+  return iter != ids_to_actors_map.end() ? iter->second : nullptr;
+}
+
+bool Scene::set_parent(Actor &child, Actor *parent)
+{
+  FGE_ASSERT(child.get_transform_handle() != TransformHierarchy::null_handle);
+
+  const auto parent_handle =
+      parent ? parent->get_transform_handle() : TransformHierarchy::null_handle;
+
+  return transform_hierarchy.set_parent(child.get_transform_handle(),
+                                        parent_handle);
+}
+
+std::shared_ptr<Actor> Scene::get_parent(const Actor &child)
+{
+  if (child.get_transform_handle() == TransformHierarchy::null_handle)
+  {
+    return nullptr;
+  }
+
+  const auto parent_handle =
+      transform_hierarchy.get_parent(child.get_transform_handle());
+  if (parent_handle == TransformHierarchy::null_handle)
+  {
+    return nullptr;
+  }
+
+  return get_actor(transform_hierarchy.get_user_data(parent_handle));
+}
+
+void Scene::update_transforms()
+{
+  FGE_PROFILE_SCOPE("Scene::update_transforms");
+
+  for (auto &actor : actors)
+  {
+    actor->update_local_transform();
+  }
+  for (auto &actor : pending_actors)
+  {
+    actor->update_local_transform();
+  }
+
+  transform_hierarchy.update();
+
+  // Only actors in changed subtrees get their new transform
+  for (const auto handle : transform_hierarchy.get_changed())
+  {
+    auto actor = ids_to_actors_map[transform_hierarchy.get_user_data(handle)];
+    actor->apply_world_transform(transform_hierarchy.get_world_matrix(handle));
+  }
+}
+
+std::shared_ptr<Actor> Scene::raycast(const Ray &ray, float *hit_distance)
+{
+  std::shared_ptr<Actor> hit_actor{};
+  float                  closest_distance = ray.max_distance;
+
+  spatial_index.raycast(ray, [&](const Ray &clipped_ray, int32_t proxy) {
+    auto actor = get_spatial_proxy_actor(proxy);
+
+    // The index only knows the fat boxes
+    float distance = 0.0f;
+    if (!intersects(clipped_ray, actor->get_world_bounds(), distance))
+    {
+      return clipped_ray.max_distance;
+    }
+
+    hit_actor        = actor;
+    closest_distance = distance;
+    return distance;
+  });
+
+  if (hit_distance && hit_actor)
+  {
+    *hit_distance = closest_distance;
+  }
+
+  return hit_actor;
+}
+
+std::vector<std::shared_ptr<Actor>> Scene::find_actors_in_box(const Aabb &aabb)
+{
+  std::vector<std::shared_ptr<Actor>> result;
+
+  spatial_index.query(aabb, [&](int32_t proxy) {
+    auto actor = get_spatial_proxy_actor(proxy);
+    if (actor->get_world_bounds().overlaps(aabb))
+    {
+      result.push_back(actor);
+    }
+    return true;
+  });
+
+  return result;
+}
+
+std::vector<std::shared_ptr<Actor>>
+Scene::find_actors_in_sphere(const glm::vec3 &center, float radius)
+{
+  std::vector<std::shared_ptr<Actor>> result;
+
+  BoundingSphere sphere{};
+  sphere.center = center;
+  sphere.radius = radius;
+
+  spatial_index.query(sphere, [&](int32_t proxy) {
+    auto actor = get_spatial_proxy_actor(proxy);
+    if (actor->get_world_bounds().get_distance2(center) <= radius * radius)
+    {
+      result.push_back(actor);
+    }
+    return true;
+  });
+
+  return result;
+}
+
+std::vector<std::shared_ptr<Actor>>
+Scene::find_nearest_actors(const glm::vec3 &point, std::size_t count)
+{
+  spatial_index.query_nearest(point, count, spatial_query_result);
+
+  std::vector<std::shared_ptr<Actor>> result;
+  result.reserve(spatial_query_result.size());
+  for (const auto proxy : spatial_query_result)
+  {
+    result.push_back(get_spatial_proxy_actor(proxy));
+  }
+
+  return result;
+}
+
+void Scene::update_spatial_proxy(Actor &actor)
+{
+  if (actor.get_spatial_proxy() == DynamicAabbTree::null_node)
+  {
+    return;
+  }
+
+  spatial_index.move_proxy(actor.get_spatial_proxy(), actor.get_world_bounds());
+}
+
+std::shared_ptr<Actor> Scene::get_spatial_proxy_actor(int32_t proxy)
+{
+  const auto iter = ids_to_actors_map.find(spatial_index.get_user_data(proxy));
+  FGE_ASSERT(iter != ids_to_actors_map.end());
+
+  return iter->second;
+}
+
+void Scene::add_system(System system) { systems.push_back(system); }
+
+void Scene::add_fixed_system(System system)
+{
+  fixed_systems.push_back(system);
+}
+
+void Scene::activate_pending_actors()
+{
+  for (auto &pending_actor : pending_actors)
+  {
+    actors.emplace_back(pending_actor);
+    registry.emplace<ActorRef>(pending_actor->get_entity(),
+                               pending_actor.get());
+  }
+  pending_actors.clear();
+}
+
+void Scene::remove_dead_actors()
+{
+  // Add any dead actors to temp vector
+  std::vector<std::shared_ptr<Actor>> dead_actors;
+  registry.each<ActorRef>([&](Entity /*entity*/, ActorRef &actor_ref) {
+    if (actor_ref.actor->get_state() == Actor::State::DEAD)
+    {
+      dead_actors.emplace_back(ids_to_actors_map[actor_ref.actor->get_id()]);
+    }
+  });
+
+  // Remove dead actors
+  for (auto &actor : dead_actors)
+  {
+    remove_actor(actor);
+  }
+}
+
 void Scene::clear()
 {
   while (pending_actors.size() != 0)
   {
-    remove_actor(actors[0]);
+    remove_actor(pending_actors[0]);
   }
 
   while (actors.size() != 0)
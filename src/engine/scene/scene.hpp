@@ -1,13 +1,32 @@
 #pragma once
 
 #include "actor.hpp"
+#include "math/dynamic_aabb_tree.hpp"
+#include "transform_hierarchy.hpp"
+#include "registry.hpp"
 
 namespace Fge
 {
 
+/**
+ * Dense per entity reference from the registry back to the actor facade. The
+ * scene update loops walk these instead of the shared_ptr vector.
+ */
+struct ActorRef
+{
+  Actor *actor{};
+};
+
 class Scene
 {
 public:
+  using System = std::function<void(Registry &registry, float delta_time)>;
+
+  /**
+   * Adds the animation system, so skinned meshes of the scene get animated.
+   */
+  Scene();
+
   ~Scene();
 
   void on_create();
@@ -34,8 +53,69 @@ public:
 
   std::vector<std::shared_ptr<Actor>> &get_actors() { return actors; }
 
+  /**
+   * @return Nullptr if no actor with this id is in the scene
+   */
+  std::shared_ptr<Actor> get_actor(std::size_t id);
+
+  /**
+   * @return False if the parent is the child or one of its descendants
+   */
+  bool set_parent(Actor &child, Actor *parent);
+
+  std::shared_ptr<Actor> get_parent(const Actor &child);
+
+  /**
+   * Collects the changed local transforms of all actors, recomputes the
+   * world transforms of the changed subtrees and hands them to the actors.
+   * Runs once after every update, so actors and components read the same
+   * world transform during the whole update.
+   */
+  void update_transforms();
+
+  TransformHierarchy &get_transform_hierarchy() { return transform_hierarchy; }
+
   std::size_t generate_actor_id();
 
+  Registry &get_registry() { return registry; }
+
+  /**
+   * Closest actor whose world bounds the ray hits.
+   *
+   * @param hit_distance Distance along the ray to the hit, if not null
+   *
+   * @return Nullptr if nothing got hit
+   */
+  std::shared_ptr<Actor> raycast(const Ray &ray, float *hit_distance = nullptr);
+
+  std::vector<std::shared_ptr<Actor>> find_actors_in_box(const Aabb &aabb);
+
+  std::vector<std::shared_ptr<Actor>>
+  find_actors_in_sphere(const glm::vec3 &center, float radius);
+
+  /**
+   * The count actors closest to the point, nearest first. Distances are
+   * measured to the bounds grown by the margin of the spatial index.
+   */
+  std::vector<std::shared_ptr<Actor>>
+  find_nearest_actors(const glm::vec3 &point, std::size_t count);
+
+  /**
+   * Moves the proxy of the actor to its current world bounds. Actors call
+   * this whenever their world transform changes.
+   */
+  void update_spatial_proxy(Actor &actor);
+
+  const DynamicAabbTree &get_spatial_index() const { return spatial_index; }
+
+  /**
+   * Adds a system that runs after all actors got updated. Systems are executed
+   * in the order they were added.
+   */
+  void add_system(System system);
+
+  void add_fixed_system(System system);
+
 private:
   bool updating_actors = false;
 
@@ -45,7 +125,27 @@ private:
   std::vector<std::shared_ptr<Actor>>                     pending_actors;
   std::unordered_map<std::size_t, std::shared_ptr<Actor>> ids_to_actors_map;
 
+  Registry registry;
+
+  // Parent links and world transforms of all actors, including pending ones.
+  // User data is the actor id.
+  TransformHierarchy transform_hierarchy;
+
+  // World bounds of all actors, including pending ones. User data is the
+  // actor id.
+  DynamicAabbTree      spatial_index;
+  std::vector<int32_t> spatial_query_result;
+
+  std::vector<System> systems;
+  std::vector<System> fixed_systems;
+
+  void activate_pending_actors();
+
+  void remove_dead_actors();
+
   void clear();
+
+  std::shared_ptr<Actor> get_spatial_proxy_actor(int32_t proxy);
 };
 
 } // namespace Fge
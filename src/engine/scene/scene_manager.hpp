@@ -22,6 +22,8 @@ public:
 
   void set_scene(std::shared_ptr<Scene> scene);
 
+  std::shared_ptr<Scene> get_scene() const { return scene; }
+
   void terminate();
 
 private:
@@ -0,0 +1,269 @@
+#include "transform_hierarchy.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FGE_TRANSFORM_SSE
+#include <emmintrin.h>
+#endif
+
+namespace Fge
+{
+
+namespace
+{
+
+/**
+ * result = a * b. Result must not be a or b.
+ */
+void multiply(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &result)
+{
+#ifdef FGE_TRANSFORM_SSE
+  // Every column of the result is a sum of the columns of a, weighted by
+  // the components of the same column of b
+  const auto a_ptr = glm::value_ptr(a);
+  const auto a0    = _mm_loadu_ps(a_ptr);
+  const auto a1    = _mm_loadu_ps(a_ptr + 4);
+  const auto a2    = _mm_loadu_ps(a_ptr + 8);
+  const auto a3    = _mm_loadu_ps(a_ptr + 12);
+
+  const auto b_ptr      = glm::value_ptr(b);
+  const auto result_ptr = glm::value_ptr(result);
+  for (int i = 0; i < 4; ++i)
+  {
+    const auto b_column = b_ptr + 4 * i;
+
+    auto column = _mm_mul_ps(a0, _mm_set1_ps(b_column[0]));
+    column      = _mm_add_ps(column, _mm_mul_ps(a1, _mm_set1_ps(b_column[1])));
+    column      = _mm_add_ps(column, _mm_mul_ps(a2, _mm_set1_ps(b_column[2])));
+    column      = _mm_add_ps(column, _mm_mul_ps(a3, _mm_set1_ps(b_column[3])));
+
+    _mm_storeu_ps(result_ptr + 4 * i, column);
+  }
+#else
+  result = a * b;
+#endif
+}
+
+} // namespace
+
+TransformHierarchy::Handle TransformHierarchy::create(std::size_t user_data)
+{
+  Handle handle = null_handle;
+  if (free_handles.empty())
+  {
+    handle = static_cast<Handle>(handle_to_index.size());
+    handle_to_index.push_back(null_index);
+  }
+  else
+  {
+    handle = free_handles.back();
+    free_handles.pop_back();
+  }
+
+  handle_to_index[handle] = static_cast<uint32_t>(handles.size());
+
+  local_mats.emplace_back(1.0f);
+  world_mats.emplace_back(1.0f);
+  parent_indices.push_back(null_index);
+  parent_handles.push_back(null_handle);
+  depths.push_back(0);
+  dirty_flags.push_back(1);
+  handles.push_back(handle);
+  user_datas.push_back(user_data);
+
+  // A root behind deeper nodes breaks the grouping by depth
+  order_dirty = true;
+
+  return handle;
+}
+
+void TransformHierarchy::destroy(Handle handle)
+{
+  const auto index = get_index(handle);
+
+  // The entry stays until the order gets rebuilt
+  handles[index]          = null_handle;
+  handle_to_index[handle] = null_index;
+  released_handles.push_back(handle);
+
+  order_dirty = true;
+}
+
+bool TransformHierarchy::set_parent(Handle child, Handle parent)
+{
+  const auto child_index = get_index(child);
+
+  for (auto ancestor = parent; ancestor != null_handle;
+       ancestor      = get_parent(ancestor))
+  {
+    if (ancestor == child)
+    {
+      return false;
+    }
+  }
+
+  parent_handles[child_index] = parent;
+  dirty_flags[child_index]    = 1;
+  order_dirty                 = true;
+
+  return true;
+}
+
+void TransformHierarchy::update()
+{
+  if (order_dirty)
+  {
+    rebuild_order();
+  }
+
+  changed_handles.clear();
+
+  for (std::size_t level = 0; level + 1 < level_offsets.size(); ++level)
+  {
+    const auto begin = level_offsets[level];
+    const auto end   = level_offsets[level + 1];
+
+    if (level == 0)
+    {
+      for (auto i = begin; i < end; ++i)
+      {
+        if (dirty_flags[i])
+        {
+          world_mats[i] = local_mats[i];
+          changed_handles.push_back(handles[i]);
+        }
+      }
+      continue;
+    }
+
+    // Parents are one level up and done already
+    for (auto i = begin; i < end; ++i)
+    {
+      dirty_flags[i] |= dirty_flags[parent_indices[i]];
+    }
+
+    for (auto i = begin; i < end; ++i)
+    {
+      if (dirty_flags[i])
+      {
+        multiply(world_mats[parent_indices[i]], local_mats[i], world_mats[i]);
+        changed_handles.push_back(handles[i]);
+      }
+    }
+  }
+
+  std::fill(dirty_flags.begin(), dirty_flags.end(), uint8_t(0));
+}
+
+void TransformHierarchy::rebuild_order()
+{
+  const auto count = handles.size();
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (handles[i] != null_handle && parent_handles[i] != null_handle &&
+        handle_to_index[parent_handles[i]] == null_index)
+    {
+      parent_handles[i] = null_handle;
+      dirty_flags[i]    = 1;
+    }
+  }
+
+  // Depth of every node that is still alive. Walk up until a node with known
+  // depth, then assign the depths on the way back down.
+  std::vector<uint32_t> new_depths(count, null_index);
+  std::vector<uint32_t> path;
+  uint32_t              max_depth = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (handles[i] == null_handle)
+    {
+      continue;
+    }
+
+    path.clear();
+    auto index = static_cast<uint32_t>(i);
+    while (new_depths[index] == null_index &&
+           parent_handles[index] != null_handle)
+    {
+      path.push_back(index);
+      index = handle_to_index[parent_handles[index]];
+    }
+
+    if (new_depths[index] == null_index)
+    {
+      new_depths[index] = 0;
+    }
+
+    auto depth = new_depths[index];
+    for (auto iter = path.rbegin(); iter != path.rend(); ++iter)
+    {
+      new_depths[*iter] = ++depth;
+    }
+    max_depth = std::max(max_depth, depth);
+  }
+
+  // Counting sort by depth. It is stable, so siblings keep their order.
+  level_offsets.assign(max_depth + 2, 0);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (handles[i] != null_handle)
+    {
+      ++level_offsets[new_depths[i] + 1];
+    }
+  }
+  for (std::size_t level = 1; level < level_offsets.size(); ++level)
+  {
+    level_offsets[level] += level_offsets[level - 1];
+  }
+
+  std::vector<uint32_t> order(level_offsets.back());
+  auto                  next_index = level_offsets;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (handles[i] != null_handle)
+    {
+      order[next_index[new_depths[i]]++] = static_cast<uint32_t>(i);
+    }
+  }
+
+  const auto reorder = [&order](auto &values) {
+    std::remove_reference_t<decltype(values)> sorted_values;
+    sorted_values.reserve(order.size());
+    for (const auto index : order)
+    {
+      sorted_values.push_back(values[index]);
+    }
+    values.swap(sorted_values);
+  };
+
+  reorder(local_mats);
+  reorder(world_mats);
+  reorder(parent_handles);
+  reorder(dirty_flags);
+  reorder(handles);
+  reorder(user_datas);
+  reorder(new_depths);
+  depths.swap(new_depths);
+
+  for (std::size_t i = 0; i < handles.size(); ++i)
+  {
+    handle_to_index[handles[i]] = static_cast<uint32_t>(i);
+  }
+
+  parent_indices.resize(handles.size());
+  for (std::size_t i = 0; i < handles.size(); ++i)
+  {
+    parent_indices[i] = parent_handles[i] == null_handle
+                            ? null_index
+                            : handle_to_index[parent_handles[i]];
+  }
+
+  free_handles.insert(
+      free_handles.end(), released_handles.begin(), released_handles.end());
+  released_handles.clear();
+
+  order_dirty = false;
+}
+
+} // namespace Fge
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "math/math.hpp"
+#include "std.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+/**
+ * Local and world matrices of a forest of transforms.
+ *
+ * Matrices are stored in contiguous arrays, sorted by depth. Roots come
+ * first, then all nodes of depth one and so on. Every parent therefore gets
+ * its world matrix before its children, and one depth level can be
+ * processed in one pass.
+ *
+ * Setting a local matrix marks the node dirty. update() recomputes the
+ * world matrices of the dirty nodes and all nodes below them. Every other
+ * node is left alone.
+ */
+class TransformHierarchy
+{
+public:
+  using Handle = uint32_t;
+
+  static constexpr Handle null_handle = std::numeric_limits<Handle>::max();
+
+  /**
+   * Creates a root with an identity local matrix.
+   */
+  Handle create(std::size_t user_data);
+
+  /**
+   * Children of the node become roots and keep their local matrices.
+   */
+  void destroy(Handle handle);
+
+  /**
+   * The child keeps its local matrix, so it moves with its new parent.
+   *
+   * @param parent Null handle to make the child a root
+   *
+   * @return False if the parent is the child or below it
+   */
+  bool set_parent(Handle child, Handle parent);
+
+  Handle get_parent(Handle handle) const
+  {
+    // Children of destroyed nodes only get detached on the next update
+    const auto parent = parent_handles[get_index(handle)];
+    return parent != null_handle && handle_to_index[parent] != null_index
+               ? parent
+               : null_handle;
+  }
+
+  void set_local_matrix(Handle handle, const glm::mat4 &local_mat)
+  {
+    const auto index   = get_index(handle);
+    local_mats[index]  = local_mat;
+    dirty_flags[index] = 1;
+  }
+
+  const glm::mat4 &get_local_matrix(Handle handle) const
+  {
+    return local_mats[get_index(handle)];
+  }
+
+  /**
+   * World matrix of the last update.
+   */
+  const glm::mat4 &get_world_matrix(Handle handle) const
+  {
+    return world_mats[get_index(handle)];
+  }
+
+  std::size_t get_user_data(Handle handle) const
+  {
+    return user_datas[get_index(handle)];
+  }
+
+  uint32_t get_depth(Handle handle) const { return depths[get_index(handle)]; }
+
+  /**
+   * Recomputes the world matrices of all dirty nodes and their subtrees.
+   */
+  void update();
+
+  /**
+   * Nodes whose world matrix changed in the last update.
+   */
+  const std::vector<Handle> &get_changed() const { return changed_handles; }
+
+  std::size_t get_count() const
+  {
+    return handle_to_index.size() - free_handles.size() -
+           released_handles.size();
+  }
+
+private:
+  static constexpr uint32_t null_index = std::numeric_limits<uint32_t>::max();
+
+  // Sparse, indexed by handle
+  std::vector<uint32_t> handle_to_index;
+  std::vector<Handle>   free_handles;
+
+  // Destroyed since the last update. They are not reused before the next
+  // update, so children can still tell that their parent is gone.
+  std::vector<Handle> released_handles;
+
+  // Dense, sorted by depth once the order is rebuilt
+  std::vector<glm::mat4>   local_mats;
+  std::vector<glm::mat4>   world_mats;
+  std::vector<uint32_t>    parent_indices;
+  std::vector<Handle>      parent_handles;
+  std::vector<uint32_t>    depths;
+  std::vector<uint8_t>     dirty_flags;
+  std::vector<Handle>      handles;
+  std::vector<std::size_t> user_datas;
+
+  // Index of the first node of every depth, plus the end
+  std::vector<uint32_t> level_offsets;
+
+  // Parents got changed or nodes got destroyed since the last update
+  bool order_dirty = false;
+
+  std::vector<Handle> changed_handles;
+
+  uint32_t get_index(Handle handle) const
+  {
+    FGE_ASSERT(handle < handle_to_index.size());
+    FGE_ASSERT(handle_to_index[handle] != null_index);
+    return handle_to_index[handle];
+  }
+
+  /**
+   * Drops destroyed nodes, detaches their children and sorts the remaining
+   * nodes by depth.
+   */
+  void rebuild_order();
+};
+
+} // namespace Fge
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "std.hpp"
+
+namespace Fge
+{
+
+/**
+ * Appends values in their memory layout. Meant for caches that are read back
+ * by the same build on the same platform, so there is no byte swapping.
+ */
+class BinaryWriter
+{
+public:
+  template <typename T> void write(const T &value) { write_array(&value, 1); }
+
+  template <typename T> void write_array(const T *values, std::size_t count)
+  {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only trivially copyable types can be written");
+
+    const auto bytes = reinterpret_cast<const uint8_t *>(values);
+    data.insert(data.end(), bytes, bytes + count * sizeof(T));
+  }
+
+  /**
+   * The elements start at a multiple of 16 bytes, so large blocks are
+   * aligned in a mapped file.
+   */
+  template <typename T> void write_vector(const std::vector<T> &values)
+  {
+    write<uint64_t>(values.size());
+    align(16);
+    write_array(values.data(), values.size());
+  }
+
+  void write_string(const std::string &value)
+  {
+    write<uint32_t>(static_cast<uint32_t>(value.size()));
+    write_array(value.data(), value.size());
+  }
+
+  /**
+   * Pads with zeros up to the next multiple of the alignment.
+   */
+  void align(std::size_t alignment)
+  {
+    data.resize((data.size() + alignment - 1) / alignment * alignment, 0);
+  }
+
+  const std::vector<uint8_t> &get_data() const { return data; }
+
+private:
+  std::vector<uint8_t> data;
+};
+
+/**
+ * Reads values written by a BinaryWriter from a block of memory. Reading
+ * past the end throws, so truncated files are detected.
+ */
+class BinaryReader
+{
+public:
+  BinaryReader(const uint8_t *data, std::size_t size) : data(data), size(size)
+  {
+  }
+
+  template <typename T> T read()
+  {
+    T value;
+    read_array(&value, 1);
+    return value;
+  }
+
+  template <typename T> void read_array(T *values, std::size_t count)
+  {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only trivially copyable types can be read");
+
+    const auto bytes = count * sizeof(T);
+    check_remaining(bytes);
+    std::memcpy(values, data + position, bytes);
+    position += bytes;
+  }
+
+  /**
+   * Copies the elements with one memcpy.
+   */
+  template <typename T> std::vector<T> read_vector()
+  {
+    const auto count = read<uint64_t>();
+    align(16);
+
+    // Checked before allocating, a broken count must not allocate
+    // gigabytes
+    if (count > get_remaining() / sizeof(T))
+    {
+      throw std::runtime_error("Binary data ends before the read vector");
+    }
+
+    std::vector<T> values(count);
+    read_array(values.data(), values.size());
+    return values;
+  }
+
+  std::string read_string()
+  {
+    const auto length = read<uint32_t>();
+    check_remaining(length);
+
+    std::string value(reinterpret_cast<const char *>(data + position), length);
+    position += length;
+    return value;
+  }
+
+  void align(std::size_t alignment)
+  {
+    position = (position + alignment - 1) / alignment * alignment;
+  }
+
+  std::size_t get_remaining() const
+  {
+    return position < size ? size - position : 0;
+  }
+
+private:
+  const uint8_t *data;
+  std::size_t    size;
+  std::size_t    position = 0;
+
+  void check_remaining(std::size_t bytes) const
+  {
+    if (bytes > get_remaining())
+    {
+      throw std::runtime_error("Binary data ends before the read value");
+    }
+  }
+};
+
+} // namespace Fge
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "std.hpp"
+#include "util/assert.hpp"
+
+namespace Fge
+{
+
+/**
+ * Bounded lock-free queue for many producers and one consumer.
+ *
+ * Every slot carries a sequence number that tells producers and the consumer
+ * whether the slot is free or filled for the current lap (Dmitry Vyukov's
+ * bounded queue). Slots are preallocated and written in place, so pushing
+ * never allocates.
+ */
+template <typename T> class MpscRingBuffer
+{
+public:
+  /**
+   * @param capacity Number of slots, gets rounded up to a power of two
+   */
+  explicit MpscRingBuffer(std::size_t capacity)
+  {
+    std::size_t size = 2;
+    while (size < capacity)
+    {
+      size *= 2;
+    }
+
+    mask  = size - 1;
+    cells = std::make_unique<Cell[]>(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRingBuffer(const MpscRingBuffer &other) = delete;
+
+  MpscRingBuffer &operator=(const MpscRingBuffer &other) = delete;
+
+  /**
+   * Claims a free slot and calls write(T &) on it. Returns false without
+   * calling write if the buffer is full. If write throws, the slot still gets
+   * published with whatever write left in it, so the consumer does not wait
+   * for it forever, and the exception is rethrown.
+   */
+  template <typename TWrite> bool try_push(TWrite &&write)
+  {
+    auto  position = enqueue_position.load(std::memory_order_relaxed);
+    Cell *cell     = nullptr;
+
+    while (true)
+    {
+      cell                = &cells[position & mask];
+      const auto sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff     = static_cast<std::intptr_t>(sequence) -
+                        static_cast<std::intptr_t>(position);
+
+      if (diff == 0)
+      {
+        if (enqueue_position.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        position = enqueue_position.load(std::memory_order_relaxed);
+      }
+    }
+
+    try
+    {
+      write(cell->data);
+    }
+    catch (...)
+    {
+      cell->sequence.store(position + 1, std::memory_order_release);
+      throw;
+    }
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Calls read(T &) with the oldest element. Returns false if the buffer is
+   * empty. Must only be called from one thread at a time.
+   */
+  template <typename TRead> bool try_pop(TRead &&read)
+  {
+    const auto position = dequeue_position.load(std::memory_order_relaxed);
+    auto &     cell     = cells[position & mask];
+    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+
+    if (sequence != position + 1)
+    {
+      return false;
+    }
+
+    read(cell.data);
+    cell.sequence.store(position + mask + 1, std::memory_order_release);
+    dequeue_position.store(position + 1, std::memory_order_relaxed);
+
+    return true;
+  }
+
+  /**
+   * @return Number of claimed slots. Only a hint while producers are running.
+   */
+  std::size_t size() const
+  {
+    const auto enqueue = enqueue_position.load(std::memory_order_relaxed);
+    const auto dequeue = dequeue_position.load(std::memory_order_relaxed);
+    return enqueue >= dequeue ? enqueue - dequeue : 0;
+  }
+
+  std::size_t capacity() const { return mask + 1; }
+
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence{0};
+    T                        data{};
+  };
+
+  std::unique_ptr<Cell[]> cells;
+  std::size_t             mask{};
+
+  // Keep producers and the consumer on different cache lines
+  alignas(64) std::atomic<std::size_t> enqueue_position{0};
+  alignas(64) std::atomic<std::size_t> dequeue_position{0};
+};
+
+} // namespace Fge
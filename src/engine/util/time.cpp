@@ -23,4 +23,11 @@ int64_t get_current_time_millis()
 #endif // WIN32
 }
 
+int64_t get_current_time_nanos()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
 } // namespace Fge
@@ -6,4 +6,11 @@ namespace Fge
 {
 
 int64_t get_current_time_millis();
-}
+
+/**
+ * Monotonic time in nanoseconds. Only useful to measure durations, the
+ * point of reference is unspecified.
+ */
+int64_t get_current_time_nanos();
+
+} // namespace Fge
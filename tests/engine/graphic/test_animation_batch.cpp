@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include "graphic/animation_batch.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+/**
+ * Chain of bones with one animation that turns every bone around the y axis
+ * within one second.
+ */
+std::shared_ptr<SkeletonAsset> create_skeleton_asset(unsigned bones_count)
+{
+  std::vector<SkeletonAsset::Bone> bones;
+  for (unsigned i = 0; i < bones_count; ++i)
+  {
+    SkeletonAsset::Bone bone{};
+    bone.name                 = "Bone" + std::to_string(i);
+    bone.parent_index         = static_cast<int>(i) - 1;
+    bone.local_bind_pose      = glm::translate(glm::mat4(1.0f), UP_VEC);
+    bone.global_inv_bind_pose = glm::mat4(1.0f);
+    bones.push_back(bone);
+  }
+
+  std::vector<std::optional<Animation::BoneTransform>> tracks;
+  for (unsigned i = 0; i < bones_count; ++i)
+  {
+    Animation::BoneTransform track{};
+    track.bone_translation = {{0.0, UP_VEC}, {10.0, UP_VEC}};
+    track.bone_scaling     = {{0.0, glm::vec3(1.0f)}, {10.0, glm::vec3(1.0f)}};
+    track.bone_rotation    = {
+        {0.0, glm::angleAxis(0.0f, UP_VEC)},
+        {10.0, glm::angleAxis(0.1f * static_cast<float>(i + 1), UP_VEC)}};
+    tracks.emplace_back(track);
+  }
+
+  auto asset = std::make_shared<SkeletonAsset>(bones);
+  asset->add_animation(
+      CompiledAnimation(Animation("Turn", 10.0, 10.0, tracks)));
+
+  return asset;
+}
+
+std::vector<Skeleton> create_skeletons(std::size_t count)
+{
+  std::vector<std::shared_ptr<SkeletonAsset>> assets;
+  for (unsigned bones_count = 1; bones_count <= 7; ++bones_count)
+  {
+    assets.push_back(create_skeleton_asset(bones_count));
+  }
+
+  std::vector<Skeleton> skeletons;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto &skeleton = skeletons.emplace_back(assets[i % assets.size()]);
+    skeleton.play_animation_endless(skeleton.find_animation("Turn"), 0.01 * i);
+  }
+  return skeletons;
+}
+
+std::vector<glm::mat4> evaluate(std::vector<Skeleton> &           skeletons,
+                                double                            time,
+                                const std::shared_ptr<JobSystem> &job_system)
+{
+  AnimationBatch batch;
+  for (auto &skeleton : skeletons)
+  {
+    batch.add(skeleton);
+  }
+  batch.evaluate(time, job_system);
+
+  return batch.get_bone_palette();
+}
+
+} // namespace
+
+TEST(AnimationBatchTest, Evaluate_DifferentThreadCounts_SamePalette)
+{
+  auto skeletons = create_skeletons(200);
+
+  const auto serial = evaluate(skeletons, 3.37, nullptr);
+  const auto one_thread =
+      evaluate(skeletons, 3.37, std::make_shared<JobSystem>(1));
+  const auto four_threads =
+      evaluate(skeletons, 3.37, std::make_shared<JobSystem>(4));
+
+  ASSERT_EQ(serial.size(), one_thread.size());
+  ASSERT_EQ(serial.size(), four_threads.size());
+  EXPECT_EQ(std::memcmp(serial.data(),
+                        one_thread.data(),
+                        serial.size() * sizeof(glm::mat4)),
+            0);
+  EXPECT_EQ(std::memcmp(serial.data(),
+                        four_threads.data(),
+                        serial.size() * sizeof(glm::mat4)),
+            0);
+}
+
+TEST(AnimationBatchTest, Evaluate_ManySkeletons_RangesMatchSingleEvaluation)
+{
+  auto skeletons = create_skeletons(50);
+
+  AnimationBatch batch;
+  for (auto &skeleton : skeletons)
+  {
+    batch.add(skeleton);
+  }
+  batch.evaluate(1.25, std::make_shared<JobSystem>(3));
+
+  for (std::size_t i = 0; i < skeletons.size(); ++i)
+  {
+    const auto &expected = skeletons[i].compute_bone_transforms(1.25);
+
+    ASSERT_EQ(batch.get_bones_count(i), expected.size());
+    for (std::size_t bone = 0; bone < expected.size(); ++bone)
+    {
+      EXPECT_TRUE(batch.get_bone_transforms(i)[bone] == expected[bone]);
+    }
+  }
+}
+
+TEST(AnimationBatchTest, Evaluate_FinishedAnimation_IdentityTransforms)
+{
+  Skeleton skeleton(create_skeleton_asset(3));
+  skeleton.play_animation(skeleton.find_animation("Turn"), 0.0);
+
+  AnimationBatch batch;
+  batch.add(skeleton);
+
+  batch.evaluate(0.5);
+  EXPECT_FALSE(batch.get_bone_transforms(0)[1] == glm::mat4(1.0f));
+
+  batch.evaluate(2.0);
+  for (unsigned bone = 0; bone < 3; ++bone)
+  {
+    EXPECT_TRUE(batch.get_bone_transforms(0)[bone] == glm::mat4(1.0f));
+  }
+
+  // Stays stopped, even for an earlier time
+  batch.evaluate(0.5);
+  EXPECT_TRUE(batch.get_bone_transforms(0)[1] == glm::mat4(1.0f));
+}
+
+TEST(AnimationBatchTest, Evaluate_PackedPalette_HoldsRowsAtFirstBone)
+{
+  auto skeletons = create_skeletons(40);
+
+  AnimationBatch batch;
+  for (auto &skeleton : skeletons)
+  {
+    batch.add(skeleton);
+  }
+  batch.evaluate(2.5, std::make_shared<JobSystem>(2));
+
+  const auto &packed_palette = batch.get_packed_palette();
+  ASSERT_EQ(packed_palette.size(), batch.get_bone_palette().size());
+
+  for (std::size_t i = 0; i < skeletons.size(); ++i)
+  {
+    const auto first_bone = batch.get_first_bone(i);
+    ASSERT_EQ(batch.get_bone_transforms(i),
+              batch.get_bone_palette().data() + first_bone);
+
+    // Transforming a point with the rows gives the same as the matrix
+    const glm::vec4 point(1.0f, -2.0f, 3.0f, 1.0f);
+    for (uint32_t bone = 0; bone < batch.get_bones_count(i); ++bone)
+    {
+      const auto &packed   = packed_palette[first_bone + bone];
+      const auto  expected = batch.get_bone_transforms(i)[bone] * point;
+      for (int row = 0; row < 3; ++row)
+      {
+        EXPECT_NEAR(glm::dot(packed.rows[row], point), expected[row], 1.0e-5f);
+      }
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "graphic/compiled_animation.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+/**
+ * Bone 0 turns and moves with keys at uneven times, bone 1 has no track and
+ * bone 2 only has constant channels.
+ */
+Animation create_animation()
+{
+  Animation::BoneTransform moving{};
+  moving.bone_rotation    = {{0.0, glm::angleAxis(0.0f, UP_VEC)},
+                          {3.0, glm::angleAxis(1.0f, UP_VEC)},
+                          {10.0, glm::angleAxis(-0.5f, RIGHT_VEC)}};
+  moving.bone_translation = {{0.0, glm::vec3(0.0f, 0.0f, 0.0f)},
+                             {7.0, glm::vec3(2.0f, -1.0f, 4.0f)},
+                             {10.0, glm::vec3(3.0f, 0.0f, 4.0f)}};
+  moving.bone_scaling     = {{0.0, glm::vec3(1.0f)}, {10.0, glm::vec3(2.0f)}};
+
+  Animation::BoneTransform constant{};
+  constant.bone_rotation    = {{0.0, glm::angleAxis(0.3f, FORWARD_VEC)},
+                            {10.0, glm::angleAxis(0.3f, FORWARD_VEC)}};
+  constant.bone_translation = {{0.0, UP_VEC}};
+  constant.bone_scaling     = {{0.0, glm::vec3(1.0f)}, {10.0, glm::vec3(1.0f)}};
+
+  return Animation("Clip", 10.0, 10.0, {moving, std::nullopt, constant});
+}
+
+void expect_near(const glm::mat4 &a, const glm::mat4 &b, float tolerance)
+{
+  for (int column = 0; column < 4; ++column)
+  {
+    for (int row = 0; row < 4; ++row)
+    {
+      EXPECT_NEAR(a[column][row], b[column][row], tolerance);
+    }
+  }
+}
+
+} // namespace
+
+TEST(CompiledAnimationTest, Create_OneSecondClip_ResampledAtSampleRate)
+{
+  const CompiledAnimation compiled(create_animation(), 30.0);
+
+  EXPECT_EQ(compiled.get_name(), "Clip");
+  EXPECT_EQ(compiled.get_frame_count(), 31u);
+  EXPECT_TRUE(compiled.has_track(0));
+  EXPECT_FALSE(compiled.has_track(1));
+  EXPECT_TRUE(compiled.has_track(2));
+}
+
+TEST(CompiledAnimationTest, Sample_AtFrames_MatchesSourceAnimation)
+{
+  const auto              animation = create_animation();
+  const CompiledAnimation compiled(animation, 30.0);
+
+  // Frames fall on every third of a tick
+  for (int frame = 0; frame < 30; ++frame)
+  {
+    const auto time = frame / 3.0;
+
+    glm::mat4 transforms[3]{};
+    compiled.sample(time, transforms);
+
+    expect_near(transforms[0],
+                animation.get_track(0).value().interpolate(time),
+                2.0e-3f);
+    expect_near(transforms[2],
+                animation.get_track(2).value().interpolate(time),
+                1.0e-6f);
+  }
+}
+
+TEST(CompiledAnimationTest, Sample_BetweenFrames_CloseToSourceAnimation)
+{
+  const auto              animation = create_animation();
+  const CompiledAnimation compiled(animation, 30.0);
+
+  glm::mat4 transforms[3]{};
+  compiled.sample(4.9, transforms);
+
+  expect_near(transforms[0],
+              animation.get_track(0).value().interpolate(4.9),
+              1.0e-2f);
+}
+
+TEST(CompiledAnimationTest, Sample_BoneWithoutTrack_LeftUnchanged)
+{
+  const CompiledAnimation compiled(create_animation());
+
+  glm::mat4 transforms[3]{};
+  transforms[1] = glm::translate(glm::mat4(1.0f), FORWARD_VEC);
+  compiled.sample(2.5, transforms);
+
+  EXPECT_TRUE(transforms[1] == glm::translate(glm::mat4(1.0f), FORWARD_VEC));
+}
+
+TEST(CompiledAnimationTest, Create_ConstantChannels_NotStoredPerFrame)
+{
+  Animation::BoneTransform constant{};
+  constant.bone_rotation    = {{0.0, glm::angleAxis(0.3f, FORWARD_VEC)}};
+  constant.bone_translation = {{0.0, UP_VEC}};
+  constant.bone_scaling     = {{0.0, glm::vec3(1.0f)}};
+
+  const CompiledAnimation one_track(
+      Animation("Still", 10.0, 10.0, {constant}), 30.0);
+  const CompiledAnimation many_frames(
+      Animation("Still", 10.0, 10.0, {constant}), 300.0);
+
+  EXPECT_EQ(one_track.get_memory_size(), many_frames.get_memory_size());
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "graphic/mesh_lod.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+std::vector<MeshLod> create_lods()
+{
+  return {MeshLod{0, 3000, 0.0f},
+          MeshLod{3000, 1500, 0.01f},
+          MeshLod{4500, 750, 0.04f},
+          MeshLod{5250, 375, 0.1f}};
+}
+
+} // namespace
+
+TEST(MeshLodTest, GetProjectedRadius_FartherAway_Smaller)
+{
+  const BoundingSphere sphere{glm::vec3(0.0f, 0.0f, -10.0f), 1.0f};
+
+  const auto near_radius =
+      get_projected_radius(sphere, glm::vec3(0.0f), 500.0f);
+  const auto far_radius =
+      get_projected_radius(sphere, glm::vec3(0.0f, 0.0f, 10.0f), 500.0f);
+
+  EXPECT_FLOAT_EQ(near_radius, 50.0f);
+  EXPECT_FLOAT_EQ(far_radius, 25.0f);
+}
+
+TEST(MeshLodTest, GetProjectedRadius_CameraInside_Infinite)
+{
+  const BoundingSphere sphere{glm::vec3(0.0f), 2.0f};
+
+  EXPECT_TRUE(
+      std::isinf(get_projected_radius(sphere, glm::vec3(1.0f), 500.0f)));
+}
+
+TEST(MeshLodTest, SelectLod_NoLods_FullDetail)
+{
+  EXPECT_EQ(select_lod({}, 2, 1.0f, 1.0f), 0u);
+}
+
+TEST(MeshLodTest, SelectLod_ShrinkingOnScreen_GetsCoarser)
+{
+  const auto lods = create_lods();
+
+  EXPECT_EQ(select_lod(lods, 0, 1000.0f, 1.0f), 0u);
+  EXPECT_EQ(select_lod(lods, 0, 50.0f, 1.0f), 1u);
+  EXPECT_EQ(select_lod(lods, 0, 10.0f, 1.0f), 2u);
+  EXPECT_EQ(select_lod(lods, 0, 1.0f, 1.0f), 3u);
+  EXPECT_EQ(select_lod(lods, 3, 1000.0f, 1.0f), 0u);
+}
+
+TEST(MeshLodTest, SelectLod_HigherBias_GetsCoarser)
+{
+  const auto lods = create_lods();
+
+  EXPECT_EQ(select_lod(lods, 0, 50.0f, 1.0f), 1u);
+  EXPECT_EQ(select_lod(lods, 0, 50.0f, 3.0f), 2u);
+}
+
+TEST(MeshLodTest, SelectLod_AroundThreshold_KeepsLod)
+{
+  const auto lods = create_lods();
+
+  // LOD 1 has an error of one pixel at a radius of 100 pixels. It gets
+  // picked once the radius is three quarters of that, but only dropped once
+  // the radius is above it.
+  EXPECT_EQ(select_lod(lods, 0, 90.0f, 1.0f), 0u);
+  EXPECT_EQ(select_lod(lods, 0, 75.0f, 1.0f), 1u);
+  EXPECT_EQ(select_lod(lods, 1, 90.0f, 1.0f), 1u);
+  EXPECT_EQ(select_lod(lods, 1, 101.0f, 1.0f), 0u);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include "graphic/program_binary_cache.hpp"
+#include "log/log.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+class ProgramBinaryCacheTest : public ::testing::Test
+{
+protected:
+  std::filesystem::path directory;
+
+  void SetUp() override
+  {
+    // Broken entries get logged, the base sink drops them
+    start_logger<LogSink>(LogType::Error, LogMode::Sync);
+
+    directory = std::filesystem::temp_directory_path() /
+                ("fge_program_binary_cache_" +
+                 std::string(::testing::UnitTest::GetInstance()
+                                 ->current_test_info()
+                                 ->name()));
+    std::filesystem::remove_all(directory);
+  }
+
+  void TearDown() override
+  {
+    std::filesystem::remove_all(directory);
+    terminate_logger();
+  }
+};
+
+ProgramBinary create_binary()
+{
+  ProgramBinary binary{};
+  binary.format     = 0x8741;
+  binary.data       = {1, 2, 3, 4, 5};
+  binary.compile_ms = 12.5;
+
+  return binary;
+}
+
+} // namespace
+
+TEST_F(ProgramBinaryCacheTest, Load_NoEntry_Nothing)
+{
+  ProgramBinaryCache cache(directory);
+
+  EXPECT_FALSE(cache.load("driver;vertex;fragment").has_value());
+}
+
+TEST_F(ProgramBinaryCacheTest, Load_StoredBinary_SameBinary)
+{
+  ProgramBinaryCache cache(directory);
+  const std::string  key("driver\0vertex\0fragment", 22);
+  cache.store(key, create_binary());
+
+  const auto binary = cache.load(key);
+
+  ASSERT_TRUE(binary.has_value());
+  EXPECT_EQ(binary->format, 0x8741u);
+  EXPECT_EQ(binary->data, (std::vector<uint8_t>{1, 2, 3, 4, 5}));
+  EXPECT_EQ(binary->compile_ms, 12.5);
+}
+
+TEST_F(ProgramBinaryCacheTest, Load_OtherKey_Nothing)
+{
+  ProgramBinaryCache cache(directory);
+  cache.store("driver;vertex;fragment", create_binary());
+
+  EXPECT_FALSE(cache.load("driver;vertex;other fragment").has_value());
+}
+
+TEST_F(ProgramBinaryCacheTest, Load_TruncatedEntry_Nothing)
+{
+  ProgramBinaryCache cache(directory);
+  cache.store("key", create_binary());
+
+  ASSERT_EQ(std::distance(std::filesystem::directory_iterator(directory),
+                          std::filesystem::directory_iterator()),
+            1);
+  const auto entry_path =
+      std::filesystem::directory_iterator(directory)->path();
+  std::filesystem::resize_file(entry_path,
+                               std::filesystem::file_size(entry_path) - 3);
+
+  EXPECT_FALSE(cache.load("key").has_value());
+}
+
+TEST_F(ProgramBinaryCacheTest, Remove_StoredBinary_Nothing)
+{
+  ProgramBinaryCache cache(directory);
+  cache.store("key", create_binary());
+
+  cache.remove("key");
+
+  EXPECT_FALSE(cache.load("key").has_value());
+}
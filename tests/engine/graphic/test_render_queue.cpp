@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "graphic/render_queue.hpp"
+
+using namespace Fge;
+
+TEST(RenderQueueTest, MakeSortKey_ShaderBeforeMaterialBeforeDepth)
+{
+  const auto near_shader_2 = RenderQueue::make_sort_key(2, 1, 1, 1.0f);
+  const auto far_shader_1  = RenderQueue::make_sort_key(1, 9, 9, 500.0f);
+  const auto material_1    = RenderQueue::make_sort_key(1, 1, 9, 500.0f);
+
+  EXPECT_LT(far_shader_1, near_shader_2);
+  EXPECT_LT(material_1, far_shader_1);
+}
+
+TEST(RenderQueueTest, MakeSortKey_SameState_FrontToBack)
+{
+  const auto behind_camera = RenderQueue::make_sort_key(1, 1, 1, -3.0f);
+  const auto near          = RenderQueue::make_sort_key(1, 1, 1, 0.5f);
+  const auto far           = RenderQueue::make_sort_key(1, 1, 1, 80.0f);
+
+  EXPECT_LE(behind_camera, near);
+  EXPECT_LT(near, far);
+}
+
+TEST(RenderQueueTest, Sort_MixedKeys_SameStateAdjacent)
+{
+  std::vector<std::shared_ptr<RenderInfo>> render_infos;
+  for (int i = 0; i < 4; ++i)
+  {
+    render_infos.push_back(std::make_shared<RenderInfo>(nullptr, nullptr));
+  }
+
+  RenderQueue render_queue;
+  render_queue.push(RenderQueue::make_sort_key(2, 1, 1, 1.0f),
+                    *render_infos[0]);
+  render_queue.push(RenderQueue::make_sort_key(1, 1, 1, 1.0f),
+                    *render_infos[1]);
+  render_queue.push(RenderQueue::make_sort_key(2, 1, 1, 2.0f),
+                    *render_infos[2]);
+  render_queue.push(RenderQueue::make_sort_key(1, 1, 1, 2.0f),
+                    *render_infos[3]);
+  render_queue.sort();
+
+  const auto &commands = render_queue.get_commands();
+  ASSERT_EQ(commands.size(), 4u);
+  EXPECT_EQ(commands[0].render_info, render_infos[1].get());
+  EXPECT_EQ(commands[1].render_info, render_infos[3].get());
+  EXPECT_EQ(commands[2].render_info, render_infos[0].get());
+  EXPECT_EQ(commands[3].render_info, render_infos[2].get());
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include "graphic/shader_preprocessor.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+class ShaderPreprocessorTest : public ::testing::Test
+{
+protected:
+  std::filesystem::path directory;
+
+  void SetUp() override
+  {
+    directory = std::filesystem::temp_directory_path() /
+                ("fge_shader_preprocessor_" +
+                 std::string(::testing::UnitTest::GetInstance()
+                                 ->current_test_info()
+                                 ->name()));
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "include");
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  std::filesystem::path write(const std::string &name,
+                              const std::string &contents)
+  {
+    const auto    path = directory / name;
+    std::ofstream file(path, std::ios::trunc);
+    file << contents;
+    return path;
+  }
+
+  ShaderPreprocessor create_preprocessor() const
+  {
+    return ShaderPreprocessor({directory / "include"});
+  }
+
+  std::string get_path(const std::string &name) const
+  {
+    return std::filesystem::weakly_canonical(directory / name).string();
+  }
+};
+
+std::size_t count(const std::string &text, const std::string &word)
+{
+  std::size_t count = 0;
+  auto        i     = text.find(word);
+  while (i != std::string::npos)
+  {
+    ++count;
+    i = text.find(word, i + word.size());
+  }
+
+  return count;
+}
+
+} // namespace
+
+TEST_F(ShaderPreprocessorTest, Preprocess_Defines_AddedAfterVersion)
+{
+  const auto path = write("main.vert", "#version 460 core\nvoid main() {}\n");
+  auto       preprocessor = create_preprocessor();
+
+  const auto shader = preprocessor.preprocess(path, {"A", "B 2"});
+
+  EXPECT_EQ(shader.code,
+            "#version 460 core\n"
+            "#define A\n"
+            "#define B 2\n"
+            "#line 2 0\n"
+            "void main() {}\n");
+  EXPECT_EQ(shader.files, (std::vector<std::string>{get_path("main.vert")}));
+}
+
+TEST_F(ShaderPreprocessorTest, Preprocess_Includes_LineDirectivesMapBack)
+{
+  write("common.glsl", "float a;\n");
+  write("include/lights.glsl", "float b;\n");
+  const auto path = write("main.frag",
+                          "#version 460\n"
+                          "#include \"common.glsl\"\n"
+                          "#include <lights.glsl>\n"
+                          "void main() {}\n");
+  auto       preprocessor = create_preprocessor();
+
+  const auto shader = preprocessor.preprocess(path, {});
+
+  EXPECT_EQ(shader.code,
+            "#version 460\n"
+            "#line 1 1\n"
+            "float a;\n"
+            "#line 1 2\n"
+            "float b;\n"
+            "#line 4 0\n"
+            "void main() {}\n");
+  EXPECT_EQ(shader.files,
+            (std::vector<std::string>{get_path("main.frag"),
+                                      get_path("common.glsl"),
+                                      get_path("include/lights.glsl")}));
+}
+
+TEST_F(ShaderPreprocessorTest, Preprocess_PragmaOnceAndGuard_IncludedOnce)
+{
+  write("once.glsl", "#pragma once\nfloat once_value;\n");
+  write("guarded.glsl",
+        "// Guarded\n#ifndef GUARDED\n#define GUARDED\nfloat guarded_value;\n"
+        "#endif\n");
+  write("twice.glsl", "#include \"once.glsl\"\n#include \"guarded.glsl\"\n");
+  const auto path = write("main.frag",
+                          "#version 460\n"
+                          "#include \"once.glsl\"\n"
+                          "#include \"guarded.glsl\"\n"
+                          "#include \"twice.glsl\"\n");
+  auto       preprocessor = create_preprocessor();
+
+  const auto code = preprocessor.preprocess(path, {}).code;
+
+  EXPECT_EQ(count(code, "once_value"), 1u);
+  EXPECT_EQ(count(code, "guarded_value"), 1u);
+  EXPECT_EQ(count(code, "#pragma once"), 0u);
+}
+
+TEST_F(ShaderPreprocessorTest, Preprocess_NoOnce_IncludedEveryTime)
+{
+  write("common.glsl", "float value;\n");
+  const auto path = write("main.frag",
+                          "#version 460\n"
+                          "#include \"common.glsl\"\n"
+                          "#include \"common.glsl\"\n");
+  auto       preprocessor = create_preprocessor();
+
+  const auto shader = preprocessor.preprocess(path, {});
+
+  EXPECT_EQ(count(shader.code, "float value;"), 2u);
+  EXPECT_EQ(shader.files.size(), 2u);
+}
+
+TEST_F(ShaderPreprocessorTest, Preprocess_IncludeChanged_ParsedAgain)
+{
+  const auto include_path = write("common.glsl", "float old_value;\n");
+  const auto path =
+      write("main.frag", "#version 460\n#include \"common.glsl\"\n");
+  auto preprocessor = create_preprocessor();
+  preprocessor.preprocess(path, {});
+
+  write("common.glsl", "float new_value;\n");
+  std::filesystem::last_write_time(
+      include_path,
+      std::filesystem::last_write_time(include_path) + std::chrono::hours(1));
+
+  const auto code = preprocessor.preprocess(path, {}).code;
+
+  EXPECT_EQ(count(code, "new_value"), 1u);
+  EXPECT_EQ(count(code, "old_value"), 0u);
+}
+
+TEST_F(ShaderPreprocessorTest, Preprocess_MissingInclude_Throws)
+{
+  const auto path =
+      write("main.frag", "#version 460\n#include \"missing.glsl\"\n");
+  auto preprocessor = create_preprocessor();
+
+  Tests::assert_exception<std::runtime_error>(
+      [&]() { preprocessor.preprocess(path, {}); });
+}
+
+TEST_F(ShaderPreprocessorTest, Preprocess_IncludeCycle_Throws)
+{
+  write("a.glsl", "#include \"b.glsl\"\n");
+  write("b.glsl", "#include \"a.glsl\"\n");
+  const auto path = write("main.frag", "#version 460\n#include \"a.glsl\"\n");
+  auto       preprocessor = create_preprocessor();
+
+  Tests::assert_exception<std::runtime_error>(
+      [&]() { preprocessor.preprocess(path, {}); });
+}
+
+TEST_F(ShaderPreprocessorTest, Preprocess_MisformedInclude_Throws)
+{
+  const auto path = write("main.frag", "#version 460\n#include common\n");
+  auto       preprocessor = create_preprocessor();
+
+  Tests::assert_exception<std::runtime_error>(
+      [&]() { preprocessor.preprocess(path, {}); });
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "graphic/skeleton.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+/**
+ * Two bones. Bone 1 turns around the y axis in "Turn" and stays in its bind
+ * pose in "Idle".
+ */
+std::shared_ptr<SkeletonAsset> create_skeleton_asset()
+{
+  SkeletonAsset::Bone root{};
+  root.name                 = "Root";
+  root.local_bind_pose      = glm::mat4(1.0f);
+  root.global_inv_bind_pose = glm::mat4(1.0f);
+
+  SkeletonAsset::Bone arm{};
+  arm.name                 = "Arm";
+  arm.parent_index         = 0;
+  arm.local_bind_pose      = glm::translate(glm::mat4(1.0f), UP_VEC);
+  arm.global_inv_bind_pose = glm::mat4(1.0f);
+
+  Animation::BoneTransform turn{};
+  turn.bone_translation = {{0.0, UP_VEC}};
+  turn.bone_scaling     = {{0.0, glm::vec3(1.0f)}};
+  turn.bone_rotation    = {{0.0, glm::angleAxis(0.0f, UP_VEC)},
+                        {10.0, glm::angleAxis(1.0f, UP_VEC)}};
+
+  auto asset = std::make_shared<SkeletonAsset>(
+      std::vector<SkeletonAsset::Bone>{root, arm});
+  asset->add_animation(CompiledAnimation(
+      Animation("Idle", 10.0, 10.0, {std::nullopt, std::nullopt})));
+  asset->add_animation(CompiledAnimation(
+      Animation("Turn", 10.0, 10.0, {std::nullopt, turn})));
+
+  return asset;
+}
+
+} // namespace
+
+TEST(SkeletonTest, FindAnimation_ByName_ResolvesHandle)
+{
+  const auto asset = create_skeleton_asset();
+
+  EXPECT_EQ(asset->find_animation("Idle"), 0u);
+  EXPECT_EQ(asset->find_animation("Turn"), 1u);
+  EXPECT_EQ(asset->find_animation("Jump"),
+            SkeletonAsset::invalid_animation_handle);
+  EXPECT_EQ(asset->get_bone_index("Arm"), 1);
+}
+
+TEST(SkeletonTest, Copy_ManyInstances_ShareAsset)
+{
+  const auto asset = create_skeleton_asset();
+
+  Skeleton              prototype(asset);
+  std::vector<Skeleton> instances(1000, prototype);
+
+  EXPECT_EQ(asset.use_count(), 1002);
+  EXPECT_EQ(instances.back().get_asset().get(), asset.get());
+}
+
+TEST(SkeletonTest, PlayAnimation_TwoInstances_IndependentPlayback)
+{
+  const auto asset = create_skeleton_asset();
+
+  Skeleton turning(asset);
+  Skeleton idle(asset);
+  turning.play_animation_endless(asset->find_animation("Turn"), 0.0);
+  idle.play_animation_endless(asset->find_animation("Idle"), 0.0);
+
+  const auto turning_transforms = turning.compute_bone_transforms(0.5);
+  const auto idle_transforms    = idle.compute_bone_transforms(0.5);
+
+  EXPECT_FALSE(turning_transforms[1] == idle_transforms[1]);
+  EXPECT_TRUE(idle_transforms[1] ==
+              glm::translate(glm::mat4(1.0f), UP_VEC));
+}
+
+TEST(SkeletonTest, PlayAnimation_InvalidHandle_Ignored)
+{
+  Skeleton skeleton(create_skeleton_asset());
+  skeleton.play_animation(SkeletonAsset::invalid_animation_handle, 0.0);
+
+  const auto transforms = skeleton.compute_bone_transforms(0.5);
+
+  EXPECT_TRUE(transforms[1] == glm::mat4(1.0f));
+}
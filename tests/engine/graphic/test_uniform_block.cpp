@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include "graphic/uniform_block.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+struct UniformCall
+{
+  int32_t     location{};
+  UniformType type{};
+  uint32_t    count{};
+  float       first_value{};
+};
+
+class FakeShader : public Shader
+{
+public:
+  std::unordered_map<std::string, int32_t> locations;
+  std::vector<UniformCall>                 calls;
+  int                                      lookup_count = 0;
+
+  uint32_t get_id() const override { return 1; }
+
+  void bind() const override {}
+
+  void unbind() const override {}
+
+  int32_t get_uniform_location(const std::string &name) const override
+  {
+    ++const_cast<FakeShader *>(this)->lookup_count;
+    const auto iter = locations.find(name);
+    return iter == locations.end() ? -1 : iter->second;
+  }
+
+  void set_uniform(int32_t     location,
+                   UniformType type,
+                   const void *data,
+                   uint32_t    count) override
+  {
+    float first_value{};
+    std::memcpy(&first_value, data, sizeof(float));
+    calls.push_back({location, type, count, first_value});
+  }
+
+  void set_uniform(const std::string &, bool) override {}
+  void set_uniform(const std::string &, int32_t) override {}
+  void set_uniform(const std::string &, const glm::mat4 &) override {}
+  void set_uniform(const std::string &, float) override {}
+  void set_uniform(const std::string &, const glm::vec2 &) override {}
+  void set_uniform(const std::string &, const glm::ivec2 &) override {}
+  void set_uniform(const std::string &, const glm::vec3 &) override {}
+  void set_uniform(const std::string &, const glm::vec4 &) override {}
+  void set_uniform(const std::string &, const glm::mat2 &) override {}
+  void set_uniform(const std::string &, const glm::mat3 &) override {}
+  void set_uniform(const std::string &,
+                   const std::vector<glm::mat4> &) override
+  {
+  }
+};
+
+} // namespace
+
+TEST(UniformBlockTest, GetHandle_SameName_SameHandle)
+{
+  UniformBlock block;
+
+  const auto first  = block.get_handle<float>("specular_power");
+  const auto second = block.get_handle<float>("specular_power");
+
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(block.get_count(), 1u);
+}
+
+TEST(UniformBlockTest, Bind_OnlySetAndActiveUniforms_Sent)
+{
+  auto shader                         = std::make_shared<FakeShader>();
+  shader->locations["specular_power"] = 3;
+  shader->locations["world_mat"]      = 7;
+
+  UniformBlock block;
+  const auto   power  = block.get_handle<float>("specular_power");
+  const auto   world  = block.get_handle<glm::mat4>("world_mat");
+  const auto   unused = block.get_handle<glm::vec3>("not_in_shader");
+  block.get_handle<std::vector<glm::mat4>>("bones");
+
+  block.set(power, 200.0f);
+  block.set(world, glm::mat4(2.0f));
+  block.set(unused, glm::vec3(1.0f));
+  block.bind(shader);
+
+  ASSERT_EQ(shader->calls.size(), 2u);
+  EXPECT_EQ(shader->calls[0].location, 3);
+  EXPECT_EQ(shader->calls[0].type, UniformType::Float);
+  EXPECT_EQ(shader->calls[0].first_value, 200.0f);
+  EXPECT_EQ(shader->calls[1].location, 7);
+  EXPECT_EQ(shader->calls[1].first_value, 2.0f);
+}
+
+TEST(UniformBlockTest, Bind_SameShader_LocationsResolvedOnce)
+{
+  auto shader                    = std::make_shared<FakeShader>();
+  shader->locations["world_mat"] = 0;
+
+  UniformBlock block;
+  block.set(block.get_handle<glm::mat4>("world_mat"), glm::mat4(1.0f));
+
+  block.bind(shader);
+  block.bind(shader);
+  EXPECT_EQ(shader->lookup_count, 1);
+
+  auto other_shader = std::make_shared<FakeShader>();
+  block.bind(other_shader);
+  EXPECT_EQ(other_shader->lookup_count, 1);
+}
+
+TEST(UniformBlockTest, Set_ArrayGrows_AllValuesSent)
+{
+  auto shader                = std::make_shared<FakeShader>();
+  shader->locations["bones"] = 1;
+
+  UniformBlock block;
+  const auto   bones = block.get_handle<std::vector<glm::mat4>>("bones");
+
+  block.set(bones, std::vector<glm::mat4>(2, glm::mat4(1.0f)));
+  block.set(bones, std::vector<glm::mat4>(35, glm::mat4(4.0f)));
+  block.bind(shader);
+
+  ASSERT_EQ(shader->calls.size(), 1u);
+  EXPECT_EQ(shader->calls[0].count, 35u);
+  EXPECT_EQ(shader->calls[0].first_value, 4.0f);
+}
+
+TEST(UniformBlockTest, SharedValues_OnlyPerInstanceDiffers_Equal)
+{
+  UniformBlock first;
+  first.set(first.get_handle<float>("specular_power"), 200.0f);
+  const auto world = first.get_handle<glm::mat4>("world_mat");
+  first.set_per_instance(world);
+  first.set(world, glm::mat4(1.0f));
+
+  auto second = first;
+  second.set(world, glm::mat4(5.0f));
+
+  EXPECT_TRUE(first.has_same_shared_values(second));
+  EXPECT_EQ(first.get_shared_hash(), second.get_shared_hash());
+}
+
+TEST(UniformBlockTest, SharedValues_SharedValueDiffers_NotEqual)
+{
+  UniformBlock first;
+  const auto   power = first.get_handle<float>("specular_power");
+  first.set(power, 200.0f);
+  const auto first_hash = first.get_shared_hash();
+
+  auto second = first;
+  second.set(power, 20.0f);
+
+  EXPECT_FALSE(first.has_same_shared_values(second));
+  EXPECT_NE(first_hash, second.get_shared_hash());
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "graphic/vertex_packing.hpp"
+#include "tests_common.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+using namespace Fge;
+
+namespace
+{
+
+constexpr float direction_tolerance = 1e-3f;
+
+std::vector<glm::vec3> create_directions()
+{
+  std::vector<glm::vec3> directions{glm::vec3(1.0f, 0.0f, 0.0f),
+                                    glm::vec3(-1.0f, 0.0f, 0.0f),
+                                    glm::vec3(0.0f, 1.0f, 0.0f),
+                                    glm::vec3(0.0f, -1.0f, 0.0f),
+                                    glm::vec3(0.0f, 0.0f, 1.0f),
+                                    glm::vec3(0.0f, 0.0f, -1.0f)};
+
+  std::mt19937                          random(7);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  while (directions.size() < 1000)
+  {
+    const glm::vec3 direction(
+        distribution(random), distribution(random), distribution(random));
+    if (glm::length(direction) > 0.1f)
+    {
+      directions.push_back(glm::normalize(direction));
+    }
+  }
+
+  return directions;
+}
+
+void expect_near(const glm::vec3 &actual, const glm::vec3 &expected)
+{
+  EXPECT_NEAR(actual.x, expected.x, direction_tolerance);
+  EXPECT_NEAR(actual.y, expected.y, direction_tolerance);
+  EXPECT_NEAR(actual.z, expected.z, direction_tolerance);
+}
+
+} // namespace
+
+TEST(VertexPackingTest, Octahedral_QuantizedToSnorm16_RoundTrips)
+{
+  for (const auto &direction : create_directions())
+  {
+    const auto encoded = encode_octahedral(direction);
+    const auto decoded =
+        decode_octahedral(glm::vec2(unpack_snorm16(pack_snorm16(encoded.x)),
+                                    unpack_snorm16(pack_snorm16(encoded.y))));
+
+    expect_near(decoded, direction);
+  }
+}
+
+TEST(VertexPackingTest, PackVertex_MirroredTangentFrame_KeepsHandedness)
+{
+  for (const auto handedness : {1.0f, -1.0f})
+  {
+    VertexPNTBT vertex{};
+    vertex.position = glm::vec3(1.0f, 2.0f, 3.0f);
+    vertex.normal   = glm::normalize(glm::vec3(0.2f, -0.3f, -0.9f));
+    vertex.tangent =
+        glm::normalize(glm::cross(vertex.normal, glm::vec3(0.0f, 1.0f, 0.0f)));
+    vertex.bitangent = glm::cross(vertex.normal, vertex.tangent) * handedness;
+    vertex.tex_coord = glm::vec2(0.25f, 0.8f);
+
+    const auto packed = pack_vertex(vertex);
+
+    glm::vec3 normal(0.0f);
+    glm::vec3 tangent(0.0f);
+    glm::vec3 bitangent(0.0f);
+    unpack_normal_tangent(packed.normal_tangent, normal, tangent, bitangent);
+
+    EXPECT_TRUE(packed.position == vertex.position);
+    expect_near(normal, vertex.normal);
+    expect_near(tangent, vertex.tangent);
+    expect_near(bitangent, vertex.bitangent);
+    EXPECT_NEAR(glm::unpackHalf1x16(packed.tex_coord.x), 0.25f, 1e-3f);
+    EXPECT_NEAR(glm::unpackHalf1x16(packed.tex_coord.y), 0.8f, 1e-3f);
+  }
+}
+
+TEST(VertexPackingTest, PackSkinWeights_RoundingErrors_SumUpTo255)
+{
+  const auto packed =
+      pack_skin_weights(glm::vec4(1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f, 0.0f));
+
+  EXPECT_EQ(packed.x + packed.y + packed.z + packed.w, 255);
+  EXPECT_EQ(packed.w, 0);
+  EXPECT_NEAR(packed.y, 85, 1);
+}
+
+TEST(VertexPackingTest, PackVertex_Skinned_KeepsBonesAndWeights)
+{
+  VertexPNTBBWT vertex{};
+  vertex.normal       = glm::vec3(0.0f, 0.0f, 1.0f);
+  vertex.tangent      = glm::vec3(1.0f, 0.0f, 0.0f);
+  vertex.bitangent    = glm::vec3(0.0f, 1.0f, 0.0f);
+  vertex.skin_bones   = glm::ivec4(3, 255, 0, 17);
+  vertex.skin_weights = glm::vec4(0.5f, 0.25f, 0.25f, 0.0f);
+
+  const auto packed = pack_vertex(vertex);
+
+  EXPECT_EQ(packed.skin_bones.x, 3);
+  EXPECT_EQ(packed.skin_bones.y, 255);
+  EXPECT_EQ(packed.skin_bones.w, 17);
+  EXPECT_NEAR(packed.skin_weights.x, 128, 1);
+  EXPECT_NEAR(packed.skin_weights.y, 64, 1);
+  EXPECT_EQ(packed.skin_weights.w, 0);
+}
+
+TEST(VertexPackingTest, PackedVertices_AtMostHalfTheSize)
+{
+  EXPECT_LE(sizeof(PackedVertexPNTBT) * 2, sizeof(VertexPNTBT));
+  EXPECT_LE(sizeof(PackedVertexPNTBBWT) * 2, sizeof(VertexPNTBBWT));
+}
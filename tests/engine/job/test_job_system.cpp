@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "job/job_system.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+TEST(JobSystemTest, Wait_ManyJobsInOneGroup_AllJobsExecuted)
+{
+  JobSystem job_system(4);
+
+  std::atomic<int> executed{0};
+  auto             counter = std::make_shared<JobCounter>();
+  for (int i = 0; i < 1000; ++i)
+  {
+    job_system.schedule([&executed]() { ++executed; }, counter);
+  }
+  job_system.wait(counter);
+
+  EXPECT_TRUE(counter->is_done());
+  EXPECT_EQ(executed.load(), 1000);
+}
+
+TEST(JobSystemTest, ScheduleAfter_Dependency_RunsAfterDependencyFinished)
+{
+  JobSystem job_system(4);
+
+  std::atomic<int> first_done{0};
+  auto             first = std::make_shared<JobCounter>();
+  for (int i = 0; i < 64; ++i)
+  {
+    job_system.schedule(
+        [&first_done]() {
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+          ++first_done;
+        },
+        first);
+  }
+
+  int  seen_by_second = -1;
+  auto second         = job_system.schedule_after(
+      first, [&]() { seen_by_second = first_done.load(); });
+  job_system.wait(second);
+
+  EXPECT_EQ(seen_by_second, 64);
+}
+
+TEST(JobSystemTest, ScheduleAfter_DependencyAlreadyDone_RunsJob)
+{
+  JobSystem job_system(1);
+
+  auto first = job_system.schedule([]() {});
+  job_system.wait(first);
+
+  bool executed = false;
+  job_system.wait(job_system.schedule_after(first, [&]() { executed = true; }));
+
+  EXPECT_TRUE(executed);
+}
+
+TEST(JobSystemTest, ParallelFor_UnevenCount_EveryIndexVisitedOnce)
+{
+  JobSystem job_system(3);
+
+  std::vector<int> visits(1001, 0);
+  job_system.parallel_for(visits.size(),
+                          64,
+                          [&visits](std::size_t begin, std::size_t end) {
+                            for (auto i = begin; i < end; ++i)
+                            {
+                              ++visits[i];
+                            }
+                          });
+
+  for (const auto visit : visits)
+  {
+    EXPECT_EQ(visit, 1);
+  }
+}
+
+TEST(JobSystemTest, ParallelFor_NestedInJob_DoesNotDeadlock)
+{
+  JobSystem job_system(2);
+
+  std::atomic<int> sum{0};
+  auto             counter = std::make_shared<JobCounter>();
+  for (int i = 0; i < 8; ++i)
+  {
+    job_system.schedule(
+        [&]() {
+          job_system.parallel_for(
+              100, 10, [&sum](std::size_t begin, std::size_t end) {
+                sum += static_cast<int>(end - begin);
+              });
+        },
+        counter);
+  }
+  job_system.wait(counter);
+
+  EXPECT_EQ(sum.load(), 800);
+}
+
+TEST(JobSystemTest, Wait_JobThrows_ExceptionRethrown)
+{
+  JobSystem job_system(2);
+
+  auto counter =
+      job_system.schedule([]() { throw std::runtime_error("job failed"); });
+
+  Tests::assert_exception<std::runtime_error>(
+      [&] { job_system.wait(counter); },
+      "No exception rethrown!",
+      [](const std::runtime_error &exception) {
+        EXPECT_STREQ(exception.what(), "job failed");
+      });
+}
+
+TEST(JobSystemTest, ParallelFor_FirstBatchThrows_WaitsForOtherBatches)
+{
+  JobSystem job_system(2);
+
+  std::atomic<int> finished_count{0};
+  const auto       run = [&]() {
+    job_system.parallel_for(64, 1, [&](std::size_t begin, std::size_t) {
+      if (begin == 0)
+      {
+        throw std::runtime_error("first batch failed");
+      }
+
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      ++finished_count;
+    });
+  };
+
+  Tests::assert_exception<std::runtime_error>(
+      run,
+      "No exception rethrown!",
+      [](const std::runtime_error &exception) {
+        EXPECT_STREQ(exception.what(), "first batch failed");
+      });
+  EXPECT_EQ(finished_count.load(), 63);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include "log/log.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+std::mutex           captured_mutex;
+std::vector<LogInfo> captured;
+
+class CaptureLogSink : public LogSink
+{
+public:
+  void process_log_info(const std::vector<LogInfo> &infos) override
+  {
+    std::lock_guard<std::mutex> lock(captured_mutex);
+    captured.insert(captured.end(), infos.begin(), infos.end());
+  }
+
+  void process_log_info(const LogInfo &info) override
+  {
+    std::lock_guard<std::mutex> lock(captured_mutex);
+    captured.push_back(info);
+  }
+};
+
+} // namespace
+
+TEST(LogTest, InternLogTag_EqualNames_SameStorage)
+{
+  const std::string first  = "Renderer";
+  const std::string second = "Renderer";
+
+  const auto first_view  = intern_log_tag(first);
+  const auto second_view = intern_log_tag(second);
+
+  EXPECT_EQ(first_view, "Renderer");
+  EXPECT_EQ(first_view.data(), second_view.data());
+}
+
+TEST(LogTest, LogTag_Literal_ReferencesLiteral)
+{
+  static const char name[] = "Scene";
+  const LogTag      tag(name);
+
+  EXPECT_EQ(tag.get_name().data(), name);
+  EXPECT_EQ(tag.get_name().size(), 5u);
+}
+
+TEST(LogTest, LogTag_StaticView_ReferencesView)
+{
+  static constexpr std::string_view name = "Physics";
+  constexpr auto                    tag  = LogTag::from_static(name);
+
+  EXPECT_EQ(tag.get_name().data(), name.data());
+  static_assert(!std::is_constructible_v<LogTag, char(&)[8]>,
+                "Writable arrays must not be referenced as tags");
+}
+
+TEST(LogTest, Error_AsyncMode_DeliveredWithTagAndMessage)
+{
+  captured.clear();
+  start_logger<CaptureLogSink>(
+      LogType::Warning, LogMode::Async, std::chrono::milliseconds(10));
+
+  const std::string tag = "Test";
+  error(tag, FMT_STRING("Value {} of {}"), 1, 2);
+  info("Test", FMT_STRING("Filtered at runtime"));
+  error("Test", FMT_STRING("{}"), std::string(400, 'x'));
+
+  terminate_logger();
+
+  ASSERT_EQ(captured.size(), 2u);
+  EXPECT_EQ(captured[0].tag, "Test");
+  EXPECT_EQ(captured[0].msg, "Value 1 of 2");
+  EXPECT_EQ(captured[0].type, LogType::Error);
+  EXPECT_EQ(captured[1].msg,
+            std::string(LogRecord::max_msg_size, 'x') + "...");
+}
+
+TEST(LogTest, Error_AsyncModeFormatThrows_QueueKeepsGoing)
+{
+  captured.clear();
+  start_logger<CaptureLogSink>(
+      LogType::Warning, LogMode::Async, std::chrono::milliseconds(10));
+
+  EXPECT_THROW(error("Test", std::string("{")), fmt::format_error);
+  error("Test", FMT_STRING("After"));
+
+  terminate_logger();
+
+  ASSERT_EQ(captured.size(), 2u);
+  EXPECT_EQ(captured[0].msg, "Could not format log message");
+  EXPECT_EQ(captured[1].msg, "After");
+}
+
+TEST(LogTest, Error_AfterTerminate_WrittenSynchronously)
+{
+  captured.clear();
+  start_logger<CaptureLogSink>(
+      LogType::Warning, LogMode::Async, std::chrono::milliseconds(10));
+  terminate_logger();
+
+  error("Test", FMT_STRING("Late"));
+
+  ASSERT_EQ(captured.size(), 1u);
+  EXPECT_EQ(captured[0].msg, "Late");
+}
+
+TEST(LogTest, Error_SyncModeManyThreads_AllDelivered)
+{
+  captured.clear();
+  start_logger<CaptureLogSink>(LogType::Warning, LogMode::Sync);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([i]() {
+      for (int j = 0; j < 100; ++j)
+      {
+        error("Test", FMT_STRING("Thread {} message {}"), i, j);
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  terminate_logger();
+
+  EXPECT_EQ(captured.size(), 400u);
+}
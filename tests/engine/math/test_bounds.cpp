@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "math/bounds.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+struct Vertex
+{
+  glm::vec3 position{};
+};
+
+} // namespace
+
+TEST(BoundsTest, ComputeBounds_Vertices_EnclosesAllPositions)
+{
+  const std::vector<Vertex> vertices = {{glm::vec3(-1.0f, 0.0f, 0.0f)},
+                                        {glm::vec3(3.0f, 2.0f, 0.0f)},
+                                        {glm::vec3(1.0f, -2.0f, 4.0f)}};
+
+  const auto bounds = compute_bounds(vertices);
+
+  EXPECT_EQ(bounds.aabb.min, glm::vec3(-1.0f, -2.0f, 0.0f));
+  EXPECT_EQ(bounds.aabb.max, glm::vec3(3.0f, 2.0f, 4.0f));
+  EXPECT_EQ(bounds.sphere.center, glm::vec3(1.0f, 0.0f, 2.0f));
+  for (const auto &vertex : vertices)
+  {
+    EXPECT_LE(glm::distance(vertex.position, bounds.sphere.center),
+              bounds.sphere.radius + 1e-5f);
+  }
+}
+
+TEST(BoundsTest, TransformAabb_TranslatedAndScaled_EnclosesCorners)
+{
+  Aabb aabb{};
+  aabb.add_point(glm::vec3(-1.0f));
+  aabb.add_point(glm::vec3(1.0f));
+
+  auto transform = glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 0.0f));
+  transform      = glm::scale(transform, glm::vec3(2.0f, 1.0f, 1.0f));
+
+  const auto result = transform_aabb(aabb, transform);
+
+  EXPECT_EQ(result.min, glm::vec3(3.0f, -1.0f, -1.0f));
+  EXPECT_EQ(result.max, glm::vec3(7.0f, 1.0f, 1.0f));
+
+  BoundingSphere sphere{};
+  sphere.radius = 1.0f;
+  sphere        = transform_sphere(sphere, transform);
+  EXPECT_EQ(sphere.center, glm::vec3(5.0f, 0.0f, 0.0f));
+  EXPECT_FLOAT_EQ(sphere.radius, 2.0f);
+}
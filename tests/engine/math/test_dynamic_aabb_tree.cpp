@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include "math/dynamic_aabb_tree.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+Aabb create_box(const glm::vec3 &center, float half_size)
+{
+  Aabb aabb{};
+  aabb.min = center - glm::vec3(half_size);
+  aabb.max = center + glm::vec3(half_size);
+
+  return aabb;
+}
+
+std::vector<Aabb> create_boxes(std::size_t count, uint32_t seed)
+{
+  std::mt19937                          random(seed);
+  std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+  std::vector<Aabb> boxes;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    boxes.push_back(create_box(
+        glm::vec3(position(random), position(random), position(random)),
+        size(random)));
+  }
+
+  return boxes;
+}
+
+std::vector<std::size_t> query_user_data(const DynamicAabbTree &tree,
+                                         const Aabb &           aabb)
+{
+  std::vector<std::size_t> result;
+  tree.query(aabb, [&](int32_t proxy) {
+    result.push_back(tree.get_user_data(proxy));
+    return true;
+  });
+  std::sort(result.begin(), result.end());
+
+  return result;
+}
+
+} // namespace
+
+TEST(DynamicAabbTreeTest, CreateProxy_ManyBoxes_ValidAndBalanced)
+{
+  DynamicAabbTree tree;
+
+  const auto boxes = create_boxes(1000, 1);
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    tree.create_proxy(boxes[i], i);
+  }
+
+  EXPECT_TRUE(tree.validate());
+  EXPECT_EQ(tree.get_proxy_count(), 1000u);
+  EXPECT_LT(tree.get_height(), 25);
+}
+
+TEST(DynamicAabbTreeTest, QueryBox_MatchesBruteForce)
+{
+  DynamicAabbTree tree(0.0f);
+
+  const auto boxes = create_boxes(500, 2);
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    tree.create_proxy(boxes[i], i);
+  }
+
+  const auto query_box = create_box(glm::vec3(10.0f, -5.0f, 20.0f), 30.0f);
+
+  std::vector<std::size_t> expected;
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    if (boxes[i].overlaps(query_box))
+    {
+      expected.push_back(i);
+    }
+  }
+
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(query_user_data(tree, query_box), expected);
+}
+
+TEST(DynamicAabbTreeTest, MoveAndDestroyProxy_TreeStaysValid)
+{
+  DynamicAabbTree tree;
+
+  const auto           boxes = create_boxes(300, 3);
+  std::vector<int32_t> proxies;
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    proxies.push_back(tree.create_proxy(boxes[i], i));
+  }
+
+  // Moves within the margin keep the leaf where it is
+  auto small_move = boxes[0];
+  small_move.min += glm::vec3(0.05f);
+  small_move.max += glm::vec3(0.05f);
+  EXPECT_FALSE(tree.move_proxy(proxies[0], small_move));
+
+  const auto far_box = create_box(glm::vec3(500.0f), 1.0f);
+  EXPECT_TRUE(tree.move_proxy(proxies[1], far_box));
+
+  for (std::size_t i = 2; i < proxies.size(); i += 2)
+  {
+    tree.destroy_proxy(proxies[i]);
+  }
+
+  EXPECT_TRUE(tree.validate());
+  EXPECT_EQ(query_user_data(tree, far_box), std::vector<std::size_t>{1});
+}
+
+TEST(DynamicAabbTreeTest, Raycast_ReturnsClosestHit)
+{
+  DynamicAabbTree tree(0.0f);
+  for (int i = 0; i < 10; ++i)
+  {
+    tree.create_proxy(create_box(glm::vec3(0.0f, 0.0f, -5.0f * i), 1.0f), i);
+  }
+  tree.create_proxy(create_box(glm::vec3(10.0f, 0.0f, -3.0f), 1.0f), 10);
+
+  Ray ray{};
+  ray.origin    = glm::vec3(0.0f, 0.0f, 10.0f);
+  ray.direction = glm::vec3(0.0f, 0.0f, -1.0f);
+
+  std::size_t closest          = 0;
+  float       closest_distance = std::numeric_limits<float>::max();
+  tree.raycast(ray, [&](const Ray &clipped_ray, int32_t proxy) {
+    float distance = 0.0f;
+    if (intersects(clipped_ray, tree.get_fat_aabb(proxy), distance) &&
+        distance < closest_distance)
+    {
+      closest          = tree.get_user_data(proxy);
+      closest_distance = distance;
+      return distance;
+    }
+    return clipped_ray.max_distance;
+  });
+
+  EXPECT_EQ(closest, 0u);
+  EXPECT_FLOAT_EQ(closest_distance, 9.0f);
+}
+
+TEST(DynamicAabbTreeTest, QueryNearest_MatchesBruteForce)
+{
+  DynamicAabbTree tree(0.0f);
+
+  const auto boxes = create_boxes(500, 4);
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    tree.create_proxy(boxes[i], i);
+  }
+
+  const auto point = glm::vec3(3.0f, 7.0f, -11.0f);
+
+  std::vector<std::pair<float, std::size_t>> expected;
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    expected.emplace_back(boxes[i].get_distance2(point), i);
+  }
+  std::sort(expected.begin(), expected.end());
+
+  std::vector<int32_t> result;
+  tree.query_nearest(point, 8, result);
+
+  ASSERT_EQ(result.size(), 8u);
+  for (std::size_t i = 0; i < result.size(); ++i)
+  {
+    EXPECT_EQ(tree.get_user_data(result[i]), expected[i].second);
+  }
+
+  BoundingSphere sphere{};
+  sphere.center = point;
+  sphere.radius = std::sqrt(expected[7].first);
+
+  std::size_t sphere_count = 0;
+  tree.query(sphere, [&](int32_t /*proxy*/) {
+    ++sphere_count;
+    return true;
+  });
+  EXPECT_EQ(sphere_count, 8u);
+}
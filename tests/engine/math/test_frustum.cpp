@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "math/frustum.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+Frustum create_frustum()
+{
+  // Camera at the origin looking down the negative z axis
+  const auto projection_mat =
+      glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+
+  return Frustum(projection_mat);
+}
+
+BoundingSphere create_sphere(float x, float y, float z, float radius)
+{
+  BoundingSphere sphere{};
+  sphere.center = glm::vec3(x, y, z);
+  sphere.radius = radius;
+
+  return sphere;
+}
+
+} // namespace
+
+TEST(FrustumTest, IntersectsSphere_InsideAndOutside)
+{
+  const auto frustum = create_frustum();
+
+  EXPECT_TRUE(frustum.intersects(create_sphere(0, 0, -10, 1)));
+  EXPECT_FALSE(frustum.intersects(create_sphere(0, 0, 10, 1)));
+  EXPECT_FALSE(frustum.intersects(create_sphere(0, 0, -200, 1)));
+  EXPECT_FALSE(frustum.intersects(create_sphere(-20, 0, -10, 1)));
+
+  // Crosses the left plane
+  EXPECT_TRUE(frustum.intersects(create_sphere(-10.5f, 0, -10, 1)));
+}
+
+TEST(FrustumTest, IntersectsAabb_InsideAndOutside)
+{
+  const auto frustum = create_frustum();
+
+  Aabb inside{};
+  inside.add_point(glm::vec3(-1.0f, -1.0f, -11.0f));
+  inside.add_point(glm::vec3(1.0f, 1.0f, -9.0f));
+
+  Aabb outside{};
+  outside.add_point(glm::vec3(-1.0f, 20.0f, -11.0f));
+  outside.add_point(glm::vec3(1.0f, 22.0f, -9.0f));
+
+  EXPECT_TRUE(frustum.intersects(inside));
+  EXPECT_FALSE(frustum.intersects(outside));
+  EXPECT_FALSE(frustum.intersects(Aabb{}));
+}
+
+TEST(FrustumTest, IntersectsBatch_MatchesSingleTests)
+{
+  const auto frustum = create_frustum();
+
+  // Not a multiple of four, so the scalar tail runs too
+  SphereBatch                 batch;
+  std::vector<BoundingSphere> spheres;
+  for (int i = 0; i < 23; ++i)
+  {
+    const auto x = static_cast<float>(i * 3 - 30);
+    const auto z = static_cast<float>(i % 2 == 0 ? -15 : 5);
+    spheres.push_back(create_sphere(x, 0.0f, z, 1.5f));
+    batch.push(spheres.back());
+  }
+
+  std::vector<uint8_t> visible;
+  frustum.intersects(batch, visible);
+
+  ASSERT_EQ(visible.size(), spheres.size());
+  int visible_count = 0;
+  for (std::size_t i = 0; i < spheres.size(); ++i)
+  {
+    EXPECT_EQ(visible[i] == 1, frustum.intersects(spheres[i])) << i;
+    visible_count += visible[i];
+  }
+  EXPECT_GT(visible_count, 0);
+  EXPECT_LT(visible_count, static_cast<int>(spheres.size()));
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "profiler/profiler.hpp"
+
+using namespace Fge;
+
+class ProfilerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    auto &profiler = Profiler::get_instance();
+    profiler.set_paused(false);
+    profiler.end_frame();
+    profiler.clear();
+  }
+};
+
+TEST_F(ProfilerTest, EndFrame_NestedScopes_ParentBeforeChildWithDepth)
+{
+  auto &profiler = Profiler::get_instance();
+
+  {
+    FGE_PROFILE_SCOPE("outer");
+    {
+      FGE_PROFILE_SCOPE("inner");
+    }
+  }
+  profiler.end_frame();
+
+  ASSERT_EQ(profiler.get_frames().size(), 1u);
+  const auto &zones = profiler.get_frames().back().zones;
+  ASSERT_EQ(zones.size(), 2u);
+
+  EXPECT_STREQ(zones[0].name, "outer");
+  EXPECT_EQ(zones[0].depth, 0u);
+  EXPECT_STREQ(zones[1].name, "inner");
+  EXPECT_EQ(zones[1].depth, 1u);
+  EXPECT_LE(zones[0].begin_time, zones[1].begin_time);
+  EXPECT_GE(zones[0].end_time, zones[1].end_time);
+}
+
+TEST_F(ProfilerTest, EndFrame_ZonesOfOtherThread_Collected)
+{
+  auto &profiler = Profiler::get_instance();
+
+  std::thread thread([]() { FGE_PROFILE_SCOPE("worker"); });
+  thread.join();
+  profiler.end_frame();
+
+  const auto &zones = profiler.get_frames().back().zones;
+  ASSERT_EQ(zones.size(), 1u);
+  EXPECT_STREQ(zones[0].name, "worker");
+}
+
+TEST_F(ProfilerTest, EndFrame_ThreadsOneAfterAnother_ShareBuffer)
+{
+  auto &profiler = Profiler::get_instance();
+
+  std::thread first_thread([]() { FGE_PROFILE_SCOPE("first"); });
+  first_thread.join();
+  std::thread second_thread([]() { FGE_PROFILE_SCOPE("second"); });
+  second_thread.join();
+  profiler.end_frame();
+
+  const auto &zones = profiler.get_frames().back().zones;
+  ASSERT_EQ(zones.size(), 2u);
+  EXPECT_STREQ(zones[0].name, "first");
+  EXPECT_STREQ(zones[1].name, "second");
+  EXPECT_EQ(zones[0].thread_index, zones[1].thread_index);
+}
+
+TEST_F(ProfilerTest, EndFrame_Paused_NoFrameRecorded)
+{
+  auto &profiler = Profiler::get_instance();
+
+  profiler.set_paused(true);
+  {
+    FGE_PROFILE_SCOPE("ignored");
+  }
+  profiler.end_frame();
+  profiler.set_paused(false);
+  profiler.end_frame();
+
+  EXPECT_EQ(profiler.get_frames().size(), 1u);
+  EXPECT_TRUE(profiler.get_frames().back().zones.empty());
+}
+
+TEST_F(ProfilerTest, SetMaxFrameCount_MoreFrames_OldestDropped)
+{
+  auto &profiler = Profiler::get_instance();
+
+  profiler.set_max_frame_count(3);
+  for (int i = 0; i < 5; ++i)
+  {
+    profiler.end_frame();
+  }
+
+  EXPECT_EQ(profiler.get_frames().size(), 3u);
+  profiler.set_max_frame_count(300);
+}
+
+TEST_F(ProfilerTest, ExportChromeTrace_Zone_WritesCompleteEvent)
+{
+  auto &profiler = Profiler::get_instance();
+
+  {
+    FGE_PROFILE_SCOPE("say \"hi\"");
+  }
+  profiler.end_frame();
+
+  std::stringstream out;
+  profiler.export_chrome_trace(out);
+  const auto trace = out.str();
+
+  EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  EXPECT_NE(trace.find("\"name\":\"say \\\"hi\\\"\""), std::string::npos);
+  EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+}
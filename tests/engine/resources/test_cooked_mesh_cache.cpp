@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+
+#include "log/log.hpp"
+#include "resources/cooked_mesh_cache.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+class CookedMeshCacheTest : public ::testing::Test
+{
+protected:
+  std::filesystem::path directory;
+  std::filesystem::path source_path;
+
+  void SetUp() override
+  {
+    // Stale and broken entries get logged, the base sink drops them
+    start_logger<LogSink>(LogType::Error, LogMode::Sync);
+
+    directory = std::filesystem::temp_directory_path() /
+                ("fge_cooked_mesh_cache_" +
+                 std::string(::testing::UnitTest::GetInstance()
+                                 ->current_test_info()
+                                 ->name()));
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    source_path = directory / "mesh.dae";
+    write_source("<COLLADA/>");
+  }
+
+  void TearDown() override
+  {
+    std::filesystem::remove_all(directory);
+    terminate_logger();
+  }
+
+  void write_source(const std::string &contents)
+  {
+    std::ofstream file(source_path, std::ios::trunc);
+    file << contents;
+  }
+
+  std::filesystem::path get_cache_path() const { return directory / "cache"; }
+};
+
+template <typename TVertex>
+SubMeshData<TVertex> create_sub_mesh(const std::string &name)
+{
+  SubMeshData<TVertex> sub_mesh{};
+  sub_mesh.name     = name;
+  sub_mesh.vertices = std::make_shared<std::vector<TVertex>>(3);
+  sub_mesh.indices =
+      std::make_shared<std::vector<uint32_t>>(std::vector<uint32_t>{0, 2, 1});
+  sub_mesh.lods = {MeshLod{0, 3, 0.0f}};
+
+  for (std::size_t i = 0; i < sub_mesh.vertices->size(); ++i)
+  {
+    auto &vertex     = (*sub_mesh.vertices)[i];
+    vertex.position  = glm::vec3(static_cast<float>(i), 1.0f, -2.0f);
+    vertex.normal    = UP_VEC;
+    vertex.tex_coord = glm::vec2(0.5f, static_cast<float>(i));
+  }
+
+  sub_mesh.material.diffuse_texture = "wood.png";
+  sub_mesh.material.specular_power  = 32.0f;
+  sub_mesh.bounds                   = compute_bounds(*sub_mesh.vertices);
+
+  return sub_mesh;
+}
+
+MeshData create_mesh_data()
+{
+  MeshData data{};
+  data.sub_meshes.push_back(create_sub_mesh<VertexPNTBT>("Body"));
+  data.sub_meshes.push_back(create_sub_mesh<VertexPNTBT>("Wheel"));
+  return data;
+}
+
+SkinnedMeshData create_skinned_mesh_data()
+{
+  SkeletonAsset::Bone root{};
+  root.name                 = "Root";
+  root.local_bind_pose      = glm::mat4(1.0f);
+  root.global_inv_bind_pose = glm::mat4(1.0f);
+
+  SkeletonAsset::Bone arm{};
+  arm.name                 = "Arm";
+  arm.parent_index         = 0;
+  arm.local_bind_pose      = glm::translate(glm::mat4(1.0f), UP_VEC);
+  arm.global_inv_bind_pose = glm::translate(glm::mat4(1.0f), -UP_VEC);
+
+  Animation::BoneTransform turn{};
+  turn.bone_translation = {{0.0, UP_VEC}};
+  turn.bone_scaling     = {{0.0, glm::vec3(1.0f)}};
+  turn.bone_rotation    = {{0.0, glm::angleAxis(0.0f, UP_VEC)},
+                        {10.0, glm::angleAxis(1.0f, UP_VEC)}};
+
+  SkinnedMeshData data{};
+  data.skeleton = std::make_shared<SkeletonAsset>(
+      std::vector<SkeletonAsset::Bone>{root, arm});
+  data.skeleton->add_animation(CompiledAnimation(
+      Animation("Turn", 10.0, 10.0, {std::nullopt, turn})));
+
+  auto sub_mesh = create_sub_mesh<VertexPNTBBWT>("Body");
+  for (auto &vertex : *sub_mesh.vertices)
+  {
+    vertex.skin_bones   = glm::ivec4(0, 1, 0, 0);
+    vertex.skin_weights = glm::vec4(0.25f, 0.75f, 0.0f, 0.0f);
+  }
+  data.sub_meshes.push_back(sub_mesh);
+
+  return data;
+}
+
+template <typename TVertex>
+void expect_equal(const SubMeshData<TVertex> &a, const SubMeshData<TVertex> &b)
+{
+  EXPECT_EQ(a.name, b.name);
+  EXPECT_EQ(a.material.ambient_texture, b.material.ambient_texture);
+  EXPECT_EQ(a.material.diffuse_texture, b.material.diffuse_texture);
+  EXPECT_EQ(a.material.specular_texture, b.material.specular_texture);
+  EXPECT_EQ(a.material.specular_power, b.material.specular_power);
+  EXPECT_EQ(std::memcmp(&a.bounds, &b.bounds, sizeof(Bounds)), 0);
+
+  ASSERT_EQ(a.vertices->size(), b.vertices->size());
+  EXPECT_EQ(std::memcmp(a.vertices->data(),
+                        b.vertices->data(),
+                        a.vertices->size() * sizeof(TVertex)),
+            0);
+  EXPECT_EQ(*a.indices, *b.indices);
+
+  ASSERT_EQ(a.lods.size(), b.lods.size());
+  for (std::size_t i = 0; i < a.lods.size(); ++i)
+  {
+    EXPECT_EQ(a.lods[i].first_index, b.lods[i].first_index);
+    EXPECT_EQ(a.lods[i].index_count, b.lods[i].index_count);
+    EXPECT_EQ(a.lods[i].error, b.lods[i].error);
+  }
+}
+
+} // namespace
+
+TEST_F(CookedMeshCacheTest, Load_NoEntry_Nothing)
+{
+  CookedMeshCache cache(get_cache_path());
+
+  EXPECT_FALSE(cache.load_mesh("mesh.dae", source_path).has_value());
+  EXPECT_FALSE(cache.load_skinned_mesh("mesh.dae", source_path).has_value());
+}
+
+TEST_F(CookedMeshCacheTest, Load_StoredMesh_SameData)
+{
+  const auto      data = create_mesh_data();
+  CookedMeshCache cache(get_cache_path());
+  cache.store_mesh("mesh.dae", source_path, data);
+
+  const auto loaded = cache.load_mesh("mesh.dae", source_path);
+
+  ASSERT_TRUE(loaded.has_value());
+  ASSERT_EQ(loaded->sub_meshes.size(), data.sub_meshes.size());
+  for (std::size_t i = 0; i < data.sub_meshes.size(); ++i)
+  {
+    expect_equal(loaded->sub_meshes[i], data.sub_meshes[i]);
+  }
+
+  // Static and skinned entries of one file are separate
+  EXPECT_FALSE(cache.load_skinned_mesh("mesh.dae", source_path).has_value());
+}
+
+TEST_F(CookedMeshCacheTest, Load_StoredSkinnedMesh_SameDataAndSkeleton)
+{
+  const auto      data = create_skinned_mesh_data();
+  CookedMeshCache cache(get_cache_path());
+  cache.store_skinned_mesh("mesh.dae", source_path, data);
+
+  const auto loaded = cache.load_skinned_mesh("mesh.dae", source_path);
+
+  ASSERT_TRUE(loaded.has_value());
+  ASSERT_EQ(loaded->sub_meshes.size(), 1u);
+  expect_equal(loaded->sub_meshes[0], data.sub_meshes[0]);
+
+  const auto &skeleton = *loaded->skeleton;
+  ASSERT_EQ(skeleton.get_bones_count(), 2u);
+  EXPECT_EQ(skeleton.get_bone_index("Arm"), 1);
+  EXPECT_EQ(skeleton.get_bone(1).parent_index, 0);
+  EXPECT_TRUE(skeleton.get_bone(1).global_inv_bind_pose ==
+              data.skeleton->get_bone(1).global_inv_bind_pose);
+
+  const auto handle = skeleton.find_animation("Turn");
+  ASSERT_NE(handle, SkeletonAsset::invalid_animation_handle);
+  EXPECT_EQ(skeleton.get_animation(handle).get_memory_size(),
+            data.skeleton->get_animation(0).get_memory_size());
+
+  glm::mat4 expected[2]{};
+  glm::mat4 sampled[2]{};
+  data.skeleton->get_animation(0).sample(4.2, expected);
+  skeleton.get_animation(handle).sample(4.2, sampled);
+  EXPECT_TRUE(sampled[1] == expected[1]);
+}
+
+TEST_F(CookedMeshCacheTest, Load_SourceChanged_Nothing)
+{
+  CookedMeshCache cache(get_cache_path());
+  cache.store_mesh("mesh.dae", source_path, create_mesh_data());
+
+  write_source("<COLLADA></COLLADA>");
+
+  EXPECT_FALSE(cache.load_mesh("mesh.dae", source_path).has_value());
+}
+
+TEST_F(CookedMeshCacheTest, Load_TruncatedEntry_Nothing)
+{
+  CookedMeshCache cache(get_cache_path());
+  cache.store_mesh("mesh.dae", source_path, create_mesh_data());
+
+  const auto entry_path = get_cache_path() / "mesh.dae.mesh";
+  ASSERT_TRUE(std::filesystem::exists(entry_path));
+  std::filesystem::resize_file(entry_path,
+                               std::filesystem::file_size(entry_path) - 8);
+
+  EXPECT_FALSE(cache.load_mesh("mesh.dae", source_path).has_value());
+}
+
+TEST_F(CookedMeshCacheTest, LoadAndStore_SourceMissing_Nothing)
+{
+  CookedMeshCache cache(get_cache_path());
+  cache.store_mesh("mesh.dae", source_path, create_mesh_data());
+  std::filesystem::remove(source_path);
+
+  EXPECT_FALSE(cache.load_mesh("mesh.dae", source_path).has_value());
+
+  cache.store_mesh("other.dae", source_path, create_mesh_data());
+  EXPECT_FALSE(std::filesystem::exists(get_cache_path() / "other.dae.mesh"));
+}
+
+TEST_F(CookedMeshCacheTest, Load_IndexOutOfVertices_Nothing)
+{
+  auto data = create_mesh_data();
+  data.sub_meshes[1].indices->back() = 3;
+
+  CookedMeshCache cache(get_cache_path());
+  cache.store_mesh("mesh.dae", source_path, data);
+
+  EXPECT_FALSE(cache.load_mesh("mesh.dae", source_path).has_value());
+}
+
+TEST_F(CookedMeshCacheTest, Load_BoneOutOfSkeleton_Nothing)
+{
+  auto data = create_skinned_mesh_data();
+  data.sub_meshes[0].vertices->back().skin_bones.w = 2;
+
+  CookedMeshCache cache(get_cache_path());
+  cache.store_skinned_mesh("mesh.dae", source_path, data);
+
+  EXPECT_FALSE(cache.load_skinned_mesh("mesh.dae", source_path).has_value());
+}
+
+TEST_F(CookedMeshCacheTest, Store_MeshInSubdirectory_CreatesDirectories)
+{
+  CookedMeshCache cache(get_cache_path());
+  cache.store_mesh("props/mesh.dae", source_path, create_mesh_data());
+
+  EXPECT_TRUE(cache.load_mesh("props/mesh.dae", source_path).has_value());
+}
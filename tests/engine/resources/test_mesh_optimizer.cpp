@@ -0,0 +1,457 @@
+#include <gtest/gtest.h>
+
+#include "resources/mesh_optimizer.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+using Triangle = std::array<std::array<float, 3>, 3>;
+
+/**
+ * Grid of size x size quads in the xy plane facing +z, every triangle with
+ * its own vertices like an unindexed import.
+ */
+SubMeshData<VertexPNTBT> create_grid(uint32_t size, float z = 0.0f)
+{
+  SubMeshData<VertexPNTBT> sub_mesh{};
+  sub_mesh.vertices = std::make_shared<std::vector<VertexPNTBT>>();
+  sub_mesh.indices  = std::make_shared<std::vector<uint32_t>>();
+
+  const auto add_vertex = [&](uint32_t x, uint32_t y) {
+    VertexPNTBT vertex{};
+    vertex.position =
+        glm::vec3(static_cast<float>(x), static_cast<float>(y), z);
+    vertex.normal   = glm::vec3(0.0f, 0.0f, 1.0f);
+    sub_mesh.indices->push_back(
+        static_cast<uint32_t>(sub_mesh.vertices->size()));
+    sub_mesh.vertices->push_back(vertex);
+  };
+
+  for (uint32_t y = 0; y < size; ++y)
+  {
+    for (uint32_t x = 0; x < size; ++x)
+    {
+      add_vertex(x, y);
+      add_vertex(x + 1, y);
+      add_vertex(x + 1, y + 1);
+
+      add_vertex(x, y);
+      add_vertex(x + 1, y + 1);
+      add_vertex(x, y + 1);
+    }
+  }
+
+  return sub_mesh;
+}
+
+/**
+ * Indexed grid of (size + 1)^2 vertices with its triangles shuffled.
+ */
+std::vector<uint32_t> create_shuffled_grid_indices(uint32_t size)
+{
+  std::vector<std::array<uint32_t, 3>> triangles;
+  const auto index = [&](uint32_t x, uint32_t y) { return y * (size + 1) + x; };
+  for (uint32_t y = 0; y < size; ++y)
+  {
+    for (uint32_t x = 0; x < size; ++x)
+    {
+      triangles.push_back({index(x, y), index(x + 1, y), index(x + 1, y + 1)});
+      triangles.push_back({index(x, y), index(x + 1, y + 1), index(x, y + 1)});
+    }
+  }
+
+  std::mt19937 random(42);
+  std::shuffle(triangles.begin(), triangles.end(), random);
+
+  std::vector<uint32_t> indices;
+  for (const auto &triangle : triangles)
+  {
+    indices.insert(indices.end(), triangle.begin(), triangle.end());
+  }
+
+  return indices;
+}
+
+std::vector<std::array<uint32_t, 3>>
+get_sorted_triangles(const std::vector<uint32_t> &indices)
+{
+  std::vector<std::array<uint32_t, 3>> triangles;
+  for (std::size_t i = 0; i < indices.size(); i += 3)
+  {
+    triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+  }
+  std::sort(triangles.begin(), triangles.end());
+
+  return triangles;
+}
+
+/**
+ * Triangles of the full detail LOD.
+ */
+std::vector<Triangle>
+get_sorted_triangles(const SubMeshData<VertexPNTBT> &sub_mesh)
+{
+  std::vector<Triangle> triangles;
+  const auto &          indices = *sub_mesh.indices;
+  const auto            index_count =
+      sub_mesh.lods.empty() ? indices.size() : sub_mesh.lods[0].index_count;
+  for (std::size_t i = 0; i < index_count; i += 3)
+  {
+    Triangle triangle{};
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      const auto &position = (*sub_mesh.vertices)[indices[i + j]].position;
+      triangle[j]          = {position.x, position.y, position.z};
+    }
+    triangles.push_back(triangle);
+  }
+  std::sort(triangles.begin(), triangles.end());
+
+  return triangles;
+}
+
+/**
+ * Vertices of an indexed grid in the xy plane facing +z.
+ */
+std::vector<SimplifyVertex> create_grid_vertices(uint32_t size)
+{
+  std::vector<SimplifyVertex> vertices;
+  for (uint32_t y = 0; y <= size; ++y)
+  {
+    for (uint32_t x = 0; x <= size; ++x)
+    {
+      SimplifyVertex vertex{};
+      vertex.position =
+          glm::vec3(static_cast<float>(x), static_cast<float>(y), 0.0f);
+      vertex.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+      vertices.push_back(vertex);
+    }
+  }
+
+  return vertices;
+}
+
+float get_area(const std::vector<uint32_t> &         indices,
+               const std::vector<SimplifyVertex> &vertices)
+{
+  float area = 0.0f;
+  for (std::size_t i = 0; i < indices.size(); i += 3)
+  {
+    const auto &a = vertices[indices[i]].position;
+    const auto &b = vertices[indices[i + 1]].position;
+    const auto &c = vertices[indices[i + 2]].position;
+
+    // Flipped triangles count negative
+    area += glm::cross(b - a, c - a).z * 0.5f;
+  }
+
+  return area;
+}
+
+} // namespace
+
+TEST(MeshOptimizerTest, AnalyzeVertexCache_Unindexed_TransformsEveryVertex)
+{
+  const auto grid  = create_grid(2);
+  const auto stats = analyze_vertex_cache(*grid.indices, grid.vertices->size());
+
+  EXPECT_FLOAT_EQ(stats.acmr, 3.0f);
+  EXPECT_FLOAT_EQ(stats.atvr, 1.0f);
+}
+
+TEST(MeshOptimizerTest, AnalyzeVertexCache_SharedVertices_CountsHits)
+{
+  // Two triangles of a quad share two vertices
+  const std::vector<uint32_t> indices{0, 1, 2, 0, 2, 3};
+
+  const auto stats = analyze_vertex_cache(indices, 4);
+
+  EXPECT_FLOAT_EQ(stats.acmr, 2.0f);
+  EXPECT_FLOAT_EQ(stats.atvr, 1.0f);
+}
+
+TEST(MeshOptimizerTest, GenerateWeldRemap_DuplicateVertices_MapsToFirst)
+{
+  const std::vector<glm::vec3> vertices{glm::vec3(0.0f, 0.0f, 0.0f),
+                                        glm::vec3(1.0f, 0.0f, 0.0f),
+                                        glm::vec3(0.0f, 0.0f, 0.0f),
+                                        glm::vec3(2.0f, 0.0f, 0.0f),
+                                        glm::vec3(1.0f, 0.0f, 0.0f)};
+
+  std::vector<uint32_t> remap;
+  const auto            count = generate_weld_remap(
+      vertices.data(), sizeof(glm::vec3), vertices.size(), remap);
+
+  EXPECT_EQ(count, 3u);
+  EXPECT_EQ(remap, (std::vector<uint32_t>{0, 1, 0, 2, 1}));
+}
+
+TEST(MeshOptimizerTest, OptimizeVertexCache_ShuffledGrid_LowersAcmr)
+{
+  const uint32_t size         = 32;
+  const auto     vertex_count = (size + 1) * (size + 1);
+  const auto     indices      = create_shuffled_grid_indices(size);
+
+  const auto optimized = optimize_vertex_cache(indices, vertex_count);
+
+  EXPECT_EQ(get_sorted_triangles(optimized), get_sorted_triangles(indices));
+
+  const auto before = analyze_vertex_cache(indices, vertex_count);
+  const auto after  = analyze_vertex_cache(optimized, vertex_count);
+  EXPECT_GT(before.acmr, 2.0f);
+  EXPECT_LT(after.acmr, 1.0f);
+  EXPECT_LT(after.atvr, before.atvr);
+}
+
+TEST(MeshOptimizerTest, OptimizeOverdraw_TwoLayers_DrawsOuterLayerFirst)
+{
+  // Both layers face +z, the one at z = 1 covers the one at z = -1
+  const auto inner = create_grid(2, -1.0f);
+  const auto outer = create_grid(2, 1.0f);
+
+  std::vector<glm::vec3> positions;
+  std::vector<uint32_t>  indices;
+  for (const auto *layer : {&inner, &outer})
+  {
+    const auto offset = static_cast<uint32_t>(positions.size());
+    for (const auto &vertex : *layer->vertices)
+    {
+      positions.push_back(vertex.position);
+    }
+    for (const auto index : *layer->indices)
+    {
+      indices.push_back(offset + index);
+    }
+  }
+
+  const auto optimized = optimize_overdraw(indices, positions);
+
+  EXPECT_EQ(get_sorted_triangles(optimized), get_sorted_triangles(indices));
+  EXPECT_FLOAT_EQ(positions[optimized[0]].z, 1.0f);
+  EXPECT_FLOAT_EQ(positions[optimized.back()].z, -1.0f);
+}
+
+TEST(MeshOptimizerTest, GenerateFetchRemap_UnusedVertex_NumbersByFirstUse)
+{
+  std::vector<uint32_t> indices{3, 1, 0, 3, 0, 4};
+
+  std::vector<uint32_t> remap;
+  const auto            count = generate_fetch_remap(indices, 5, remap);
+  remap_indices(indices, remap);
+
+  EXPECT_EQ(count, 4u);
+  EXPECT_EQ(remap, (std::vector<uint32_t>{2, 1, unused_vertex, 0, 3}));
+  EXPECT_EQ(indices, (std::vector<uint32_t>{0, 1, 2, 0, 2, 3}));
+}
+
+TEST(MeshOptimizerTest, OptimizeSubMesh_UnindexedGrid_WeldsAndKeepsTriangles)
+{
+  const uint32_t size      = 16;
+  auto           sub_mesh  = create_grid(size);
+  const auto     triangles = get_sorted_triangles(sub_mesh);
+
+  const auto report = optimize_sub_mesh(sub_mesh);
+
+  EXPECT_EQ(get_sorted_triangles(sub_mesh), triangles);
+  EXPECT_EQ(report.vertex_count_before, size * size * 6);
+  EXPECT_EQ(report.vertex_count_after, (size + 1) * (size + 1));
+  EXPECT_EQ(sub_mesh.vertices->size(), report.vertex_count_after);
+  EXPECT_FLOAT_EQ(report.before.acmr, 3.0f);
+  EXPECT_LT(report.after.acmr, 1.0f);
+  EXPECT_LT(report.after.atvr, 1.5f);
+}
+
+TEST(MeshOptimizerTest, OptimizeSubMesh_UnindexedGrid_GeneratesLods)
+{
+  auto sub_mesh = create_grid(16);
+
+  const auto report = optimize_sub_mesh(sub_mesh);
+
+  ASSERT_GT(sub_mesh.lods.size(), 1u);
+  EXPECT_EQ(report.lod_triangle_counts.size(), sub_mesh.lods.size());
+  EXPECT_EQ(sub_mesh.lods[0].first_index, 0u);
+  EXPECT_EQ(sub_mesh.lods[0].index_count, 16u * 16u * 6u);
+
+  for (std::size_t i = 1; i < sub_mesh.lods.size(); ++i)
+  {
+    const auto &lod  = sub_mesh.lods[i];
+    const auto &prev = sub_mesh.lods[i - 1];
+    EXPECT_EQ(lod.first_index, prev.first_index + prev.index_count);
+    EXPECT_LT(lod.index_count * 4, prev.index_count * 3);
+    EXPECT_GE(lod.error, prev.error);
+  }
+
+  const auto &last = sub_mesh.lods.back();
+  EXPECT_EQ(sub_mesh.indices->size(), last.first_index + last.index_count);
+}
+
+TEST(MeshOptimizerTest, Simplify_FlatGrid_KeepsShapeWithoutError)
+{
+  const uint32_t size     = 16;
+  const auto     vertices = create_grid_vertices(size);
+  const auto     indices  = create_shuffled_grid_indices(size);
+
+  float      error = 1.0f;
+  const auto simplified =
+      simplify(indices, vertices, indices.size() / 4, max_lod_error, error);
+
+  EXPECT_LE(simplified.size(), indices.size() / 4);
+  EXPECT_FALSE(simplified.empty());
+  EXPECT_NEAR(error, 0.0f, 1e-3f);
+
+  // Neither holes nor flipped triangles, the border stays in place
+  EXPECT_NEAR(get_area(simplified, vertices), 256.0f, 1e-3f);
+  const auto last_row = size * (size + 1);
+  for (const auto corner : {0u, size, last_row, last_row + size})
+  {
+    EXPECT_NE(std::find(simplified.begin(), simplified.end(), corner),
+              simplified.end());
+  }
+}
+
+TEST(MeshOptimizerTest, Simplify_SeamVertices_AreKept)
+{
+  const uint32_t size     = 8;
+  auto           vertices = create_grid_vertices(size);
+  auto           indices  = create_shuffled_grid_indices(size);
+
+  // Triangles right of x = 4 use copies of the vertices at x = 4 with other
+  // texture coordinates
+  std::vector<uint32_t> seam_vertices;
+  for (uint32_t y = 0; y <= size; ++y)
+  {
+    auto copy = vertices[y * (size + 1) + 4];
+    copy.tex_coord.x += 0.5f;
+    seam_vertices.push_back(static_cast<uint32_t>(vertices.size()));
+    vertices.push_back(copy);
+  }
+  for (std::size_t i = 0; i < indices.size(); i += 3)
+  {
+    const auto &a = vertices[indices[i]].position;
+    const auto &b = vertices[indices[i + 1]].position;
+    const auto &c = vertices[indices[i + 2]].position;
+    if ((a.x + b.x + c.x) / 3.0f < 4.0f)
+    {
+      continue;
+    }
+
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      const auto &position = vertices[indices[i + j]].position;
+      if (position.x == 4.0f)
+      {
+        indices[i + j] = seam_vertices[static_cast<uint32_t>(position.y)];
+      }
+    }
+  }
+
+  float      error = 0.0f;
+  const auto simplified =
+      simplify(indices, vertices, indices.size() / 4, max_lod_error, error);
+
+  EXPECT_LT(simplified.size(), indices.size() / 2);
+  EXPECT_NEAR(get_area(simplified, vertices), 64.0f, 1e-3f);
+  for (const auto vertex : seam_vertices)
+  {
+    EXPECT_NE(std::find(simplified.begin(), simplified.end(), vertex),
+              simplified.end());
+  }
+}
+
+TEST(MeshOptimizerTest, Simplify_ChangingTexCoords_AddsError)
+{
+  const uint32_t size     = 16;
+  auto           vertices = create_grid_vertices(size);
+  for (auto &vertex : vertices)
+  {
+    vertex.tex_coord = glm::vec2(vertex.position) / static_cast<float>(size);
+  }
+  const auto indices = create_shuffled_grid_indices(size);
+
+  float      error = 0.0f;
+  const auto simplified =
+      simplify(indices, vertices, indices.size() / 4, max_lod_error, error);
+
+  EXPECT_LE(simplified.size(), indices.size() / 4);
+  EXPECT_GT(error, 0.0f);
+}
+
+TEST(MeshOptimizerTest, Simplify_EveryVertexOtherBone_NothingCollapses)
+{
+  const uint32_t size     = 8;
+  auto           vertices = create_grid_vertices(size);
+  for (std::size_t i = 0; i < vertices.size(); ++i)
+  {
+    vertices[i].skin_bones   = glm::ivec4(static_cast<int>(i), 0, 0, 0);
+    vertices[i].skin_weights = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+  }
+  const auto indices = create_shuffled_grid_indices(size);
+
+  float      error = 1.0f;
+  const auto simplified =
+      simplify(indices, vertices, indices.size() / 4, max_lod_error, error);
+
+  EXPECT_EQ(simplified.size(), indices.size());
+  EXPECT_FLOAT_EQ(error, 0.0f);
+}
+
+TEST(MeshOptimizerTest, Simplify_SameBonesListedDifferently_Collapses)
+{
+  const uint32_t size     = 8;
+  auto           vertices = create_grid_vertices(size);
+  for (std::size_t i = 0; i < vertices.size(); ++i)
+  {
+    // Bone 3 fully, split over two slots on every other vertex
+    if (i % 2 == 0)
+    {
+      vertices[i].skin_bones   = glm::ivec4(3, 0, 0, 0);
+      vertices[i].skin_weights = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+    }
+    else
+    {
+      vertices[i].skin_bones   = glm::ivec4(1, 3, 3, 2);
+      vertices[i].skin_weights = glm::vec4(0.0f, 0.5f, 0.5f, 0.0f);
+    }
+  }
+  const auto indices = create_shuffled_grid_indices(size);
+
+  float      error = 1.0f;
+  const auto simplified =
+      simplify(indices, vertices, indices.size() / 4, max_lod_error, error);
+
+  EXPECT_LE(simplified.size(), indices.size() / 4);
+  EXPECT_NEAR(error, 0.0f, 1e-3f);
+}
+
+TEST(MeshOptimizerTest, Simplify_MaxErrorZero_KeepsCurvedSurface)
+{
+  // A tent with its ridge along y, collapses across the ridge move the
+  // surface
+  const uint32_t size     = 8;
+  auto           vertices = create_grid_vertices(size);
+  for (auto &vertex : vertices)
+  {
+    vertex.position.z = -std::abs(vertex.position.x - 4.0f);
+  }
+  const auto indices = create_shuffled_grid_indices(size);
+
+  float      error = 1.0f;
+  const auto simplified = simplify(indices, vertices, 0, 0.0f, error);
+
+  EXPECT_LT(simplified.size(), indices.size());
+  EXPECT_FLOAT_EQ(error, 0.0f);
+  for (std::size_t i = 0; i < simplified.size(); i += 3)
+  {
+    float min_x = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      min_x = std::min(min_x, vertices[simplified[i + j]].position.x);
+      max_x = std::max(max_x, vertices[simplified[i + j]].position.x);
+    }
+    EXPECT_TRUE(max_x <= 4.0f || min_x >= 4.0f);
+  }
+}
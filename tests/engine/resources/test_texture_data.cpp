@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "resources/texture_data.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+TextureData create_texture(uint32_t                    width,
+                           uint32_t                    height,
+                           ImageFormat                 format,
+                           const std::vector<uint8_t> &pixels)
+{
+  TextureData texture{};
+  texture.width         = width;
+  texture.height        = height;
+  texture.format        = format;
+  texture.pixels        = pixels;
+  texture.level_offsets = {0};
+
+  return texture;
+}
+
+/**
+ * Writes a binary PPM, which stb decodes like any other format.
+ */
+std::filesystem::path write_ppm(const std::string &         name,
+                                uint32_t                    width,
+                                uint32_t                    height,
+                                const std::vector<uint8_t> &pixels)
+{
+  const auto    path = std::filesystem::temp_directory_path() / name;
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << "P6\n" << width << " " << height << "\n255\n";
+  file.write(reinterpret_cast<const char *>(pixels.data()),
+             static_cast<std::streamsize>(pixels.size()));
+
+  return path;
+}
+
+} // namespace
+
+TEST(TextureDataTest, GetMipLevelCount_NonSquare_CountsDownToOne)
+{
+  EXPECT_EQ(get_mip_level_count(1, 1), 1u);
+  EXPECT_EQ(get_mip_level_count(256, 256), 9u);
+  EXPECT_EQ(get_mip_level_count(256, 16), 9u);
+  EXPECT_EQ(get_mip_level_count(5, 3), 3u);
+}
+
+TEST(TextureDataTest, GenerateMipChain_Square_AveragesTexels)
+{
+  auto texture = create_texture(
+      2, 2, ImageFormat::Red, std::vector<uint8_t>{0, 100, 200, 255});
+
+  generate_mip_chain(texture);
+
+  ASSERT_EQ(texture.level_offsets, (std::vector<std::size_t>{0, 4}));
+  ASSERT_EQ(texture.pixels.size(), 5u);
+  EXPECT_EQ(texture.pixels[4], (0 + 100 + 200 + 255 + 2) / 4);
+}
+
+TEST(TextureDataTest, GenerateMipChain_OddSizeRgb_ClampsAtEdges)
+{
+  // 3x1, one row of red, green and blue
+  auto texture = create_texture(
+      3, 1, ImageFormat::Rgb, {255, 0, 0, 0, 255, 0, 0, 0, 255});
+
+  generate_mip_chain(texture);
+
+  // 1x1 from the first two texels, the blue one falls off
+  ASSERT_EQ(texture.level_offsets, (std::vector<std::size_t>{0, 9}));
+  ASSERT_EQ(texture.pixels.size(), 12u);
+  EXPECT_EQ(texture.pixels[9], 128);
+  EXPECT_EQ(texture.pixels[10], 128);
+  EXPECT_EQ(texture.pixels[11], 0);
+}
+
+TEST(TextureDataTest, GenerateMipChain_Large_LevelsHalveEachTime)
+{
+  auto texture = create_texture(
+      64, 16, ImageFormat::Rgba, std::vector<uint8_t>(64 * 16 * 4, 7));
+
+  generate_mip_chain(texture);
+
+  ASSERT_EQ(texture.level_offsets.size(), 7u);
+  std::size_t expected_offset = 0;
+  for (uint32_t level = 0; level < 7; ++level)
+  {
+    EXPECT_EQ(texture.level_offsets[level], expected_offset);
+    expected_offset += std::max(64u >> level, 1u) *
+                       std::max(16u >> level, 1u) * 4;
+  }
+  EXPECT_EQ(texture.pixels.size(), expected_offset);
+
+  // A flat image stays flat on every level
+  for (auto pixel : texture.pixels)
+  {
+    ASSERT_EQ(pixel, 7);
+  }
+}
+
+TEST(TextureDataTest, DecodeTexture2d_Flip_RowsReversed)
+{
+  const auto path = write_ppm(
+      "fge_test_texture_data.ppm", 1, 2, {10, 20, 30, 40, 50, 60});
+
+  const auto texture = decode_texture2d(path.string(), false);
+  const auto flipped = decode_texture2d(path.string(), true);
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(texture.width, 1u);
+  EXPECT_EQ(texture.height, 2u);
+  EXPECT_EQ(texture.format, ImageFormat::Rgb);
+  EXPECT_EQ(texture.pixels, (std::vector<uint8_t>{10, 20, 30, 40, 50, 60}));
+  EXPECT_EQ(flipped.pixels, (std::vector<uint8_t>{40, 50, 60, 10, 20, 30}));
+}
+
+TEST(TextureDataTest, DecodeTexture2d_NoFile_Throws)
+{
+  Tests::assert_exception<std::runtime_error>([]() {
+    decode_texture2d("fge_no_such_texture.png", false);
+  });
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include "resources/resource_handle.hpp"
+#include "resources/upload_queue.hpp"
+#include "tests_common.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+constexpr std::chrono::microseconds unlimited_budget = std::chrono::hours(1);
+
+} // namespace
+
+TEST(UploadQueueTest, Process_SeveralUploads_RunInOrder)
+{
+  UploadQueue      queue;
+  std::vector<int> order;
+  for (int i = 0; i < 3; ++i)
+  {
+    queue.push([&order, i]() {
+      order.push_back(i);
+      return true;
+    });
+  }
+
+  EXPECT_EQ(queue.process(unlimited_budget), 3u);
+
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(queue.get_count(), 0u);
+}
+
+TEST(UploadQueueTest, Process_WaitingUpload_CalledAgainNextProcess)
+{
+  UploadQueue queue;
+  int         calls = 0;
+  queue.push([&calls]() { return ++calls == 2; });
+
+  EXPECT_EQ(queue.process(unlimited_budget), 0u);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(queue.get_count(), 1u);
+
+  EXPECT_EQ(queue.process(unlimited_budget), 1u);
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(queue.get_count(), 0u);
+}
+
+TEST(UploadQueueTest, Process_BudgetUsedUp_RestWaitsForNextProcess)
+{
+  UploadQueue queue;
+  int         done = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    queue.push([&done]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      ++done;
+      return true;
+    });
+  }
+
+  // Runs one upload even though it takes longer than the budget
+  EXPECT_EQ(queue.process(std::chrono::microseconds(1)), 1u);
+  EXPECT_EQ(done, 1);
+
+  EXPECT_EQ(queue.process(unlimited_budget), 2u);
+  EXPECT_EQ(done, 3);
+}
+
+TEST(UploadQueueTest, Push_FromManyThreads_AllProcessed)
+{
+  UploadQueue              queue;
+  std::atomic<int>         done{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&queue, &done]() {
+      for (int j = 0; j < 100; ++j)
+      {
+        queue.push([&done]() {
+          ++done;
+          return true;
+        });
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(queue.process(unlimited_budget), 400u);
+  EXPECT_EQ(done.load(), 400);
+}
+
+TEST(UploadQueueTest, GetCount_WhileProcessing_NeverAboveQueued)
+{
+  UploadQueue queue;
+  for (int i = 0; i < 100; ++i)
+  {
+    queue.push([]() { return true; });
+  }
+
+  std::atomic<bool> stop{false};
+  std::size_t       max_count = 0;
+  std::thread       observer([&]() {
+    while (!stop)
+    {
+      max_count = std::max(max_count, queue.get_count());
+    }
+  });
+
+  EXPECT_EQ(queue.process(unlimited_budget), 100u);
+  stop = true;
+  observer.join();
+
+  EXPECT_LE(max_count, 100u);
+  EXPECT_EQ(queue.get_count(), 0u);
+}
+
+TEST(UploadQueueTest, Clear_QueuedAndWaitingUploads_NoneRuns)
+{
+  UploadQueue queue;
+  int         calls = 0;
+  queue.push([&calls]() { return ++calls > 5; });
+  EXPECT_EQ(queue.process(unlimited_budget), 0u);
+  queue.push([&calls]() { return ++calls > 5; });
+
+  queue.clear();
+
+  EXPECT_EQ(queue.get_count(), 0u);
+  EXPECT_EQ(queue.process(unlimited_budget), 0u);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(ResourceHandleTest, Resolve_LoadingHandle_CopiesSeeResource)
+{
+  auto       handle = ResourceHandle<int>::create_loading();
+  const auto copy   = handle;
+
+  EXPECT_TRUE(copy.is_loading());
+  EXPECT_EQ(copy.get(), nullptr);
+
+  handle.resolve(std::make_shared<int>(42));
+
+  ASSERT_TRUE(copy.is_ready());
+  EXPECT_EQ(*copy.get(), 42);
+}
+
+TEST(ResourceHandleTest, Fail_LoadingHandle_HasErrorAndNoResource)
+{
+  auto handle = ResourceHandle<int>::create_loading();
+
+  handle.fail("Could not load");
+
+  EXPECT_TRUE(handle.has_failed());
+  EXPECT_EQ(handle.get(), nullptr);
+  EXPECT_EQ(handle.get_error(), "Could not load");
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "scene/registry.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+struct Position
+{
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+struct Velocity
+{
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+} // namespace
+
+TEST(RegistryTest, Destroy_RecycledIndex_OldHandleInvalid)
+{
+  Registry registry;
+
+  auto first = registry.create();
+  registry.destroy(first);
+  auto second = registry.create();
+
+  EXPECT_EQ(first.index, second.index);
+  EXPECT_NE(first.generation, second.generation);
+  EXPECT_FALSE(registry.valid(first));
+  EXPECT_TRUE(registry.valid(second));
+}
+
+TEST(RegistryTest, Destroy_EntityWithComponents_ComponentsRemoved)
+{
+  Registry registry;
+
+  auto entity = registry.create();
+  registry.emplace<Position>(entity, 1.0f, 2.0f);
+  registry.destroy(entity);
+
+  EXPECT_FALSE(registry.has<Position>(entity));
+  EXPECT_EQ(registry.storage<Position>().size(), 0u);
+}
+
+TEST(RegistryTest, Remove_MiddleComponent_DenseArrayStaysPacked)
+{
+  Registry registry;
+
+  auto a = registry.create();
+  auto b = registry.create();
+  auto c = registry.create();
+  registry.emplace<Position>(a, 1.0f, 0.0f);
+  registry.emplace<Position>(b, 2.0f, 0.0f);
+  registry.emplace<Position>(c, 3.0f, 0.0f);
+
+  registry.remove<Position>(b);
+
+  EXPECT_EQ(registry.storage<Position>().size(), 2u);
+  EXPECT_FLOAT_EQ(registry.get<Position>(a).x, 1.0f);
+  EXPECT_FLOAT_EQ(registry.get<Position>(c).x, 3.0f);
+  EXPECT_EQ(registry.try_get<Position>(b), nullptr);
+}
+
+TEST(RegistryTest, Each_MultipleComponents_VisitsOnlyMatchingEntities)
+{
+  Registry registry;
+
+  auto moving = registry.create();
+  registry.emplace<Position>(moving);
+  registry.emplace<Velocity>(moving, 1.0f, 2.0f);
+
+  auto still = registry.create();
+  registry.emplace<Position>(still, 5.0f, 5.0f);
+
+  int visited = 0;
+  registry.each<Position, Velocity>(
+      [&](Entity entity, Position &position, Velocity &velocity) {
+        EXPECT_EQ(entity, moving);
+        position.x += velocity.x;
+        position.y += velocity.y;
+        ++visited;
+      });
+
+  EXPECT_EQ(visited, 1);
+  EXPECT_FLOAT_EQ(registry.get<Position>(moving).x, 1.0f);
+  EXPECT_FLOAT_EQ(registry.get<Position>(moving).y, 2.0f);
+  EXPECT_FLOAT_EQ(registry.get<Position>(still).x, 5.0f);
+}
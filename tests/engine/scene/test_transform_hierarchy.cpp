@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "scene/transform_hierarchy.hpp"
+
+using namespace Fge;
+
+namespace
+{
+
+glm::mat4 create_translation(float x, float y, float z)
+{
+  return glm::translate(glm::mat4(1.0f), glm::vec3(x, y, z));
+}
+
+bool contains(const std::vector<TransformHierarchy::Handle> &handles,
+              TransformHierarchy::Handle                     handle)
+{
+  return std::find(handles.begin(), handles.end(), handle) != handles.end();
+}
+
+} // namespace
+
+TEST(TransformHierarchyTest, Update_Chain_ComposesParentMatrices)
+{
+  TransformHierarchy hierarchy;
+
+  const auto root       = hierarchy.create(0);
+  const auto child      = hierarchy.create(1);
+  const auto grandchild = hierarchy.create(2);
+  EXPECT_TRUE(hierarchy.set_parent(grandchild, child));
+  EXPECT_TRUE(hierarchy.set_parent(child, root));
+
+  hierarchy.set_local_matrix(root, create_translation(1.0f, 0.0f, 0.0f));
+  hierarchy.set_local_matrix(child, create_translation(0.0f, 2.0f, 0.0f));
+  hierarchy.set_local_matrix(grandchild, create_translation(0.0f, 0.0f, 3.0f));
+  hierarchy.update();
+
+  EXPECT_EQ(hierarchy.get_depth(grandchild), 2u);
+  EXPECT_EQ(hierarchy.get_world_matrix(grandchild),
+            create_translation(1.0f, 2.0f, 3.0f));
+  EXPECT_EQ(hierarchy.get_changed().size(), 3u);
+}
+
+TEST(TransformHierarchyTest, Update_DirtyParent_OnlyUpdatesSubtree)
+{
+  TransformHierarchy hierarchy;
+
+  const auto root    = hierarchy.create(0);
+  const auto child   = hierarchy.create(1);
+  const auto other   = hierarchy.create(2);
+  const auto unknown = hierarchy.create(3);
+  hierarchy.set_parent(child, root);
+  hierarchy.set_parent(unknown, other);
+  hierarchy.update();
+
+  hierarchy.set_local_matrix(root, create_translation(5.0f, 0.0f, 0.0f));
+  hierarchy.update();
+
+  const auto &changed = hierarchy.get_changed();
+  EXPECT_EQ(changed.size(), 2u);
+  EXPECT_TRUE(contains(changed, root));
+  EXPECT_TRUE(contains(changed, child));
+  EXPECT_EQ(hierarchy.get_world_matrix(child),
+            create_translation(5.0f, 0.0f, 0.0f));
+
+  hierarchy.update();
+  EXPECT_TRUE(hierarchy.get_changed().empty());
+}
+
+TEST(TransformHierarchyTest, SetParent_Cycle_Rejected)
+{
+  TransformHierarchy hierarchy;
+
+  const auto root  = hierarchy.create(0);
+  const auto child = hierarchy.create(1);
+  hierarchy.set_parent(child, root);
+
+  EXPECT_FALSE(hierarchy.set_parent(root, child));
+  EXPECT_FALSE(hierarchy.set_parent(root, root));
+  EXPECT_EQ(hierarchy.get_parent(root), TransformHierarchy::null_handle);
+}
+
+TEST(TransformHierarchyTest, Destroy_Parent_ChildrenBecomeRoots)
+{
+  TransformHierarchy hierarchy;
+
+  const auto root  = hierarchy.create(10);
+  const auto child = hierarchy.create(11);
+  hierarchy.set_parent(child, root);
+  hierarchy.set_local_matrix(root, create_translation(5.0f, 0.0f, 0.0f));
+  hierarchy.set_local_matrix(child, create_translation(0.0f, 1.0f, 0.0f));
+  hierarchy.update();
+
+  hierarchy.destroy(root);
+  const auto created = hierarchy.create(12);
+  hierarchy.update();
+
+  EXPECT_EQ(hierarchy.get_count(), 2u);
+  EXPECT_EQ(hierarchy.get_parent(child), TransformHierarchy::null_handle);
+  EXPECT_EQ(hierarchy.get_world_matrix(child),
+            create_translation(0.0f, 1.0f, 0.0f));
+  EXPECT_EQ(hierarchy.get_user_data(child), 11u);
+  EXPECT_EQ(hierarchy.get_user_data(created), 12u);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "util/mpsc_ring_buffer.hpp"
+
+using namespace Fge;
+
+TEST(MpscRingBufferTest, Constructor_CapacityNotPowerOfTwo_RoundedUp)
+{
+  MpscRingBuffer<int> ring_buffer(100);
+
+  EXPECT_EQ(ring_buffer.capacity(), 128u);
+}
+
+TEST(MpscRingBufferTest, TryPush_BufferFull_ReturnsFalse)
+{
+  MpscRingBuffer<int> ring_buffer(4);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(ring_buffer.try_push([i](int &value) { value = i; }));
+  }
+
+  bool written = false;
+  EXPECT_FALSE(ring_buffer.try_push([&](int &) { written = true; }));
+  EXPECT_FALSE(written);
+  EXPECT_EQ(ring_buffer.size(), 4u);
+}
+
+TEST(MpscRingBufferTest, TryPop_AfterWrapAround_KeepsOrder)
+{
+  MpscRingBuffer<int> ring_buffer(4);
+
+  int next_pushed = 0;
+  int next_popped = 0;
+  for (int round = 0; round < 10; ++round)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      ASSERT_TRUE(ring_buffer.try_push(
+          [&](int &value) { value = next_pushed++; }));
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      ASSERT_TRUE(ring_buffer.try_pop(
+          [&](int &value) { EXPECT_EQ(value, next_popped++); }));
+    }
+  }
+
+  EXPECT_FALSE(ring_buffer.try_pop([](int &) {}));
+}
+
+TEST(MpscRingBufferTest, TryPush_WriteThrows_SlotPublished)
+{
+  MpscRingBuffer<int> ring_buffer(4);
+
+  const auto throwing_write = [](int &value) {
+    value = 1;
+    throw std::runtime_error("Write failed");
+  };
+  EXPECT_THROW(ring_buffer.try_push(throwing_write), std::runtime_error);
+  ASSERT_TRUE(ring_buffer.try_push([](int &value) { value = 2; }));
+
+  EXPECT_TRUE(ring_buffer.try_pop([](int &value) { EXPECT_EQ(value, 1); }));
+  EXPECT_TRUE(ring_buffer.try_pop([](int &value) { EXPECT_EQ(value, 2); }));
+}
+
+TEST(MpscRingBufferTest, TryPush_ManyProducers_EveryValuePoppedOnce)
+{
+  constexpr int producer_count = 4;
+  constexpr int value_count    = 10000;
+
+  MpscRingBuffer<int> ring_buffer(256);
+
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < producer_count; ++producer)
+  {
+    producers.emplace_back([&ring_buffer, producer]() {
+      for (int i = 0; i < value_count; ++i)
+      {
+        const auto value = producer * value_count + i;
+        while (!ring_buffer.try_push([value](int &slot) { slot = value; }))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> seen(producer_count * value_count, 0);
+  int              popped = 0;
+  while (popped < producer_count * value_count)
+  {
+    if (!ring_buffer.try_pop([&](int &value) { ++seen[value]; }))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ++popped;
+  }
+
+  for (auto &producer : producers)
+  {
+    producer.join();
+  }
+
+  for (const auto count : seen)
+  {
+    EXPECT_EQ(count, 1);
+  }
+}